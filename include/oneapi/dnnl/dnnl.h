@@ -1528,7 +1528,7 @@ dnnl_status_t DNNL_API dnnl_binary_primitive_desc_create(
 ///     #dnnl_forward_training and #dnnl_forward_inference.
 /// @param alg_kind Convolution algorithm. Possible values are
 ///     #dnnl_convolution_direct, #dnnl_convolution_winograd,
-///     #dnnl_convolution_auto.
+///     #dnnl_convolution_fft, #dnnl_convolution_auto.
 /// @param src_desc Source memory descriptor.
 /// @param weights_desc Weights memory descriptor.
 /// @param bias_desc Bias memory descriptor. Passing NULL, a zero memory
@@ -1909,6 +1909,32 @@ dnnl_status_t DNNL_API dnnl_softmax_forward_primitive_desc_create(
         const_dnnl_memory_desc_t src_desc, const_dnnl_memory_desc_t dst_desc,
         int softmax_axis, const_dnnl_primitive_attr_t attr);
 
+/// Creates a primitive descriptor for a softmax forward propagation primitive
+///     with additional per-row outputs.
+///
+/// @param primitive_desc Output primitive descriptor.
+/// @param engine Engine to use.
+/// @param prop_kind Propagation kind. Possible values are
+///     #dnnl_forward_training and #dnnl_forward_inference.
+/// @param alg_kind Softmax algorithm kind: either #dnnl_softmax_accurate, or
+///     #dnnl_softmax_log.
+/// @param src_desc Source memory descriptor.
+/// @param dst_desc Destination memory descriptor.
+/// @param softmax_axis Axis over which softmax is computed.
+/// @param flags Softmax flags (@ref dnnl_softmax_flags_t).
+/// @param num_candidates Number of candidates per row. Must be positive and
+///     must not exceed the size of the softmax axis if
+///     #dnnl_softmax_output_candidates is specified, ignored otherwise.
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_softmax_forward_primitive_desc_create_v2(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        dnnl_prop_kind_t prop_kind, dnnl_alg_kind_t alg_kind,
+        const_dnnl_memory_desc_t src_desc, const_dnnl_memory_desc_t dst_desc,
+        int softmax_axis, unsigned flags, dnnl_dim_t num_candidates,
+        const_dnnl_primitive_attr_t attr);
+
 /// Creates a primitive descriptor for a softmax backward propagation primitive.
 ///
 /// @param primitive_desc Output primitive descriptor.
@@ -3509,7 +3535,11 @@ dnnl_status_t DNNL_API dnnl_resampling_backward_primitive_desc_create(
 ///     #dnnl_reduction_max, #dnnl_reduction_min, #dnnl_reduction_sum,
 ///     #dnnl_reduction_mul, #dnnl_reduction_mean, #dnnl_reduction_norm_lp_max,
 ///     #dnnl_reduction_norm_lp_sum, #dnnl_reduction_norm_lp_power_p_max,
-///     #dnnl_reduction_norm_lp_power_p_sum.
+///     #dnnl_reduction_norm_lp_power_p_sum, #dnnl_reduction_argmax,
+///     #dnnl_reduction_argmin, #dnnl_reduction_topk. The last three reduce
+///     exactly one dimension and additionally output the s32 indices of the
+///     selected elements as #DNNL_ARG_DST_1. For #dnnl_reduction_topk the
+///     size of the reduced dimension in @p dst_desc defines k.
 /// @param p Algorithm specific parameter.
 /// @param eps Algorithm specific parameter.
 /// @param src_desc Source memory descriptor.
@@ -3525,6 +3555,73 @@ dnnl_status_t DNNL_API dnnl_reduction_primitive_desc_create(
 
 /// @} dnnl_api_reduction
 
+/// @addtogroup dnnl_api_embedding_bag Embedding Bag
+/// @{
+
+/// Creates a primitive descriptor for an embedding bag forward propagation
+///     primitive.
+///
+/// @note
+///     Destination memory descriptor is allowed to be initialized with
+///     #dnnl_format_tag_any or with format_kind set to #dnnl_format_kind_any.
+///
+/// @param primitive_desc Output primitive descriptor.
+/// @param engine Engine to use.
+/// @param prop_kind Propagation kind. Possible values are
+///     #dnnl_forward_training and #dnnl_forward_inference.
+/// @param alg_kind Embedding bag algorithm kind. Possible values:
+///     #dnnl_embedding_bag_sum, #dnnl_embedding_bag_mean.
+/// @param src_desc Source (embedding table) memory descriptor.
+/// @param indices_desc Indices memory descriptor.
+/// @param offsets_desc Bag offsets memory descriptor.
+/// @param dst_desc Destination memory descriptor.
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_embedding_bag_forward_primitive_desc_create(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        dnnl_prop_kind_t prop_kind, dnnl_alg_kind_t alg_kind,
+        const_dnnl_memory_desc_t src_desc,
+        const_dnnl_memory_desc_t indices_desc,
+        const_dnnl_memory_desc_t offsets_desc,
+        const_dnnl_memory_desc_t dst_desc, const_dnnl_primitive_attr_t attr);
+
+/// @} dnnl_api_embedding_bag
+
+/// @addtogroup dnnl_api_softmax_merge Softmax Merge
+/// @{
+
+/// Creates a primitive descriptor for a softmax merge forward propagation
+///     primitive.
+///
+/// @note
+///     Destination memory descriptor is allowed to be initialized with
+///     #dnnl_format_tag_any or with format_kind set to #dnnl_format_kind_any.
+///
+/// @param primitive_desc Output primitive descriptor.
+/// @param engine Engine to use.
+/// @param prop_kind Propagation kind. Possible values are
+///     #dnnl_forward_training and #dnnl_forward_inference.
+/// @param src_desc Source memory descriptor with softmax results of chunks
+///     stacked along @p axis.
+/// @param lse_desc Memory descriptor for the log-sum-exp of each chunk.
+/// @param dst_desc Destination memory descriptor. The size of @p axis is
+///     either the number of chunks to rescale the chunks, or 1 to rescale and
+///     sum them up.
+/// @param axis Axis along which the chunks are stacked.
+/// @param flags Softmax flags. Possible values are #dnnl_softmax_flags_none
+///     and #dnnl_softmax_output_stats to output the merged log-sum-exp.
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_softmax_merge_forward_primitive_desc_create(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        dnnl_prop_kind_t prop_kind, const_dnnl_memory_desc_t src_desc,
+        const_dnnl_memory_desc_t lse_desc, const_dnnl_memory_desc_t dst_desc,
+        int axis, unsigned flags, const_dnnl_primitive_attr_t attr);
+
+/// @} dnnl_api_softmax_merge
+
 /// @} dnnl_api_primitives
 
 /// @addtogroup dnnl_api_primitive_cache
@@ -148,6 +148,10 @@ struct primitive : public handle<dnnl_primitive_t> {
         layer_normalization = dnnl_layer_normalization,
         /// A group normalization primitive
         group_normalization = dnnl_group_normalization,
+        /// An embedding bag primitive.
+        embedding_bag = dnnl_embedding_bag,
+        /// A softmax merge primitive.
+        softmax_merge = dnnl_softmax_merge,
     };
 
     using handle::handle;
@@ -353,13 +357,15 @@ inline dnnl_prop_kind_t convert_to_c(prop_kind akind) {
 enum class algorithm {
     /// Undefined algorithm
     undef = dnnl_alg_kind_undef,
-    /// Convolution algorithm that is chosen to be either direct or Winograd
-    /// automatically
+    /// Convolution algorithm that is chosen to be either direct, Winograd or
+    /// FFT automatically
     convolution_auto = dnnl_convolution_auto,
     /// Direct convolution
     convolution_direct = dnnl_convolution_direct,
     /// Winograd convolution
     convolution_winograd = dnnl_convolution_winograd,
+    /// FFT convolution
+    convolution_fft = dnnl_convolution_fft,
     /// Direct deconvolution
     deconvolution_direct = dnnl_deconvolution_direct,
     /// Winograd deconvolution
@@ -492,10 +498,20 @@ enum class algorithm {
     reduction_norm_lp_power_p_max = dnnl_reduction_norm_lp_power_p_max,
     /// Reduction using norm_lp_power_p_sum operation
     reduction_norm_lp_power_p_sum = dnnl_reduction_norm_lp_power_p_sum,
+    /// Reduction selecting the maximum value and its index
+    reduction_argmax = dnnl_reduction_argmax,
+    /// Reduction selecting the minimum value and its index
+    reduction_argmin = dnnl_reduction_argmin,
+    /// Reduction selecting the k largest values and their indices
+    reduction_topk = dnnl_reduction_topk,
     /// Softmax, numerically stable
     softmax_accurate = dnnl_softmax_accurate,
     /// LogSoftmax, numerically stable
     softmax_log = dnnl_softmax_log,
+    /// Embedding bag using sum pooling
+    embedding_bag_sum = dnnl_embedding_bag_sum,
+    /// Embedding bag using mean pooling
+    embedding_bag_mean = dnnl_embedding_bag_mean,
 };
 
 /// Converts algorithm kind enum value from C++ API to C API type.
@@ -556,6 +572,29 @@ inline dnnl_normalization_flags_t convert_to_c(normalization_flags flags) {
     return static_cast<dnnl_normalization_flags_t>(flags);
 }
 
+/// Flags for softmax primitive.
+enum class softmax_flags : unsigned {
+    /// Use no softmax flags.
+    none = dnnl_softmax_flags_none,
+
+    /// Output per-row statistics on forward propagation: the maximum of the
+    /// source along the softmax axis (#DNNL_ARG_DST_1) and the log-sum-exp of
+    /// the source along the softmax axis (#DNNL_ARG_DST_2).
+    output_stats = dnnl_softmax_output_stats,
+
+    /// Output per-row candidates on forward propagation: the indices of the
+    /// largest destination values along the softmax axis sorted in descending
+    /// order of the values (#DNNL_ARG_DST_3).
+    output_candidates = dnnl_softmax_output_candidates,
+};
+
+/// Converts softmax flags enum value from C++ API to C API type.
+/// @param flags C++ API softmax flags enum value.
+/// @returns Corresponding C API softmax flags enum value.
+inline dnnl_softmax_flags_t convert_to_c(softmax_flags flags) {
+    return static_cast<dnnl_softmax_flags_t>(flags);
+}
+
 /// @} dnnl_api_primitives_common
 
 /// @addtogroup dnnl_api_rnn
@@ -578,6 +617,7 @@ inline dnnl_rnn_flags_t convert_to_c(rnn_flags flags) {
 
 DNNL_DEFINE_BITMASK_OPS(normalization_flags)
 DNNL_DEFINE_BITMASK_OPS(rnn_flags)
+DNNL_DEFINE_BITMASK_OPS(softmax_flags)
 
 /// A direction of RNN primitive execution
 enum class rnn_direction {
@@ -5403,7 +5443,8 @@ struct convolution_forward : public primitive {
         ///     #dnnl::prop_kind::forward_inference.
         /// @param aalgorithm Convolution algorithm. Possible values are
         ///     #dnnl::algorithm::convolution_direct,
-        ///     #dnnl::algorithm::convolution_winograd, and
+        ///     #dnnl::algorithm::convolution_winograd,
+        ///     #dnnl::algorithm::convolution_fft, and
         ///     #dnnl::algorithm::convolution_auto.
         /// @param src_desc Source memory descriptor.
         /// @param weights_desc Weights memory descriptor.
@@ -5451,7 +5492,8 @@ struct convolution_forward : public primitive {
         ///     #dnnl::prop_kind::forward_inference.
         /// @param aalgorithm Convolution algorithm. Possible values are
         ///     #dnnl::algorithm::convolution_direct,
-        ///     #dnnl::algorithm::convolution_winograd, and
+        ///     #dnnl::algorithm::convolution_winograd,
+        ///     #dnnl::algorithm::convolution_fft, and
         ///     #dnnl::algorithm::convolution_auto.
         /// @param src_desc Source memory descriptor.
         /// @param weights_desc Weights memory descriptor.
@@ -5497,7 +5539,8 @@ struct convolution_forward : public primitive {
         ///     #dnnl::prop_kind::forward_inference.
         /// @param aalgorithm Convolution algorithm. Possible values are
         ///     #dnnl::algorithm::convolution_direct,
-        ///     #dnnl::algorithm::convolution_winograd, and
+        ///     #dnnl::algorithm::convolution_winograd,
+        ///     #dnnl::algorithm::convolution_fft, and
         ///     #dnnl::algorithm::convolution_auto.
         /// @param src_desc Source memory descriptor.
         /// @param weights_desc Weights memory descriptor.
@@ -5548,7 +5591,8 @@ struct convolution_forward : public primitive {
         ///     #dnnl::prop_kind::forward_inference.
         /// @param aalgorithm Convolution algorithm. Possible values are
         ///     #dnnl::algorithm::convolution_direct,
-        ///     #dnnl::algorithm::convolution_winograd, and
+        ///     #dnnl::algorithm::convolution_winograd,
+        ///     #dnnl::algorithm::convolution_fft, and
         ///     #dnnl::algorithm::convolution_auto.
         /// @param src_desc Source memory descriptor.
         /// @param weights_desc Weights memory descriptor.
@@ -7584,6 +7628,54 @@ struct softmax_forward : public primitive {
             reset(pd);
         }
 
+        /// Constructs a primitive descriptor for a softmax forward propagation
+        /// primitive with additional per-row outputs.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aprop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::forward_training, and
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param aalgorithm Softmax algorithm kind: either
+        ///     #dnnl::algorithm::softmax_accurate,
+        ///     or #dnnl::algorithm::softmax_log.
+        /// @param src_desc Source memory descriptor.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param axis Axis over which softmax is computed.
+        /// @param flags Softmax flags. Possible values are
+        ///     #dnnl::softmax_flags::output_stats and
+        ///     #dnnl::softmax_flags::output_candidates.
+        /// @param num_candidates Number of candidates per row. Must be
+        ///     positive and must not exceed the size of the softmax axis if
+        ///     #dnnl::softmax_flags::output_candidates is specified, ignored
+        ///     otherwise.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, prop_kind aprop_kind,
+                algorithm aalgorithm, const memory::desc &src_desc,
+                const memory::desc &dst_desc, int axis, softmax_flags flags,
+                memory::dim num_candidates = 0,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false) {
+
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status
+                    = dnnl_softmax_forward_primitive_desc_create_v2(&pd,
+                            aengine.get(), dnnl::convert_to_c(aprop_kind),
+                            dnnl::convert_to_c(aalgorithm), src_desc.get(),
+                            dst_desc.get(), axis, convert_to_c(flags),
+                            num_candidates, attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for a softmax "
+                        "forward propagation primitive");
+            reset(pd);
+        }
+
         /// Constructs a primitive descriptor for a softmax forward
         /// propagation primitive from a C API primitive descriptor that must
         /// have a matching kind.
@@ -7609,6 +7701,30 @@ struct softmax_forward : public primitive {
 
         /// @copydoc dnnl::primitive_desc_base::get_axis()const
         int get_axis() const { return base::get_axis(); }
+
+        /// Returns softmax flags.
+        /// @return Softmax flags.
+        softmax_flags get_flags() const {
+            return base::get_flags<softmax_flags>();
+        }
+
+        /// Returns memory descriptor for the per-row maximum.
+        /// @returns Memory descriptor for the per-row maximum.
+        /// @returns A zero memory descriptor if the primitive does not output
+        ///     statistics.
+        memory::desc max_desc() const { return base::dst_desc(1); }
+
+        /// Returns memory descriptor for the per-row log-sum-exp.
+        /// @returns Memory descriptor for the per-row log-sum-exp.
+        /// @returns A zero memory descriptor if the primitive does not output
+        ///     statistics.
+        memory::desc lse_desc() const { return base::dst_desc(2); }
+
+        /// Returns memory descriptor for the per-row candidates.
+        /// @returns Memory descriptor for the per-row candidates.
+        /// @returns A zero memory descriptor if the primitive does not output
+        ///     candidates.
+        memory::desc candidates_desc() const { return base::dst_desc(3); }
     };
 
     /// Default constructor. Produces an empty object.
@@ -13486,7 +13602,8 @@ struct reduction : public primitive {
         ///     #dnnl_reduction_mul, #dnnl_reduction_mean,
         ///     #dnnl_reduction_norm_lp_max, #dnnl_reduction_norm_lp_sum,
         ///     #dnnl_reduction_norm_lp_power_p_max,
-        ///     #dnnl_reduction_norm_lp_power_p_sum.
+        ///     #dnnl_reduction_norm_lp_power_p_sum, #dnnl_reduction_argmax,
+        ///     #dnnl_reduction_argmin, #dnnl_reduction_topk.
         /// @param p algorithm specific parameter.
         /// @param eps algorithm specific parameter.
         /// @param src_desc Source memory descriptor.
@@ -13527,6 +13644,14 @@ struct reduction : public primitive {
         /// @copydoc dnnl::primitive_desc_base::dst_desc()const
         memory::desc dst_desc() const { return base::dst_desc(0); }
 
+        /// Returns the memory descriptor of the indices produced by the
+        /// #dnnl::algorithm::reduction_argmax,
+        /// #dnnl::algorithm::reduction_argmin and
+        /// #dnnl::algorithm::reduction_topk algorithms.
+        /// @returns Indices memory descriptor.
+        /// @returns A zero memory descriptor for the other algorithms.
+        memory::desc indices_desc() const { return base::dst_desc(1); }
+
         /// @copydoc dnnl::primitive_desc_base::get_p()const
         float get_p() const { return base::get_p(); }
 
@@ -13553,6 +13678,249 @@ struct reduction : public primitive {
 
 /// @} dnnl_api_reduction
 
+/// @addtogroup dnnl_api_embedding_bag Embedding Bag
+///
+/// A primitive to gather rows of an embedding table and pool them over
+/// variable-length bags using sum or mean operations.
+///
+/// @sa @ref dev_guide_embedding_bag in developer guide
+///
+/// @{
+
+/// Embedding bag forward propagation primitive.
+struct embedding_bag_forward : public primitive {
+    /// Primitive descriptor for an embedding bag forward propagation
+    /// primitive.
+    struct primitive_desc : public dnnl::primitive_desc {
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for an embedding bag forward
+        ///     propagation primitive.
+        ///
+        /// @note
+        ///     Destination memory descriptor may be initialized with
+        ///     #dnnl::memory::format_tag::any value of @p format_tag.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aprop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::forward_training, and
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param aalgorithm Embedding bag algorithm kind. Possible values:
+        ///     #dnnl_embedding_bag_sum, #dnnl_embedding_bag_mean.
+        /// @param src_desc Source (embedding table) memory descriptor.
+        /// @param indices_desc Indices memory descriptor.
+        /// @param offsets_desc Bag offsets memory descriptor.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, prop_kind aprop_kind,
+                algorithm aalgorithm, const memory::desc &src_desc,
+                const memory::desc &indices_desc,
+                const memory::desc &offsets_desc,
+                const memory::desc &dst_desc,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false) {
+
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status
+                    = dnnl_embedding_bag_forward_primitive_desc_create(&pd,
+                            aengine.get(), dnnl::convert_to_c(aprop_kind),
+                            dnnl::convert_to_c(aalgorithm), src_desc.get(),
+                            indices_desc.get(), offsets_desc.get(),
+                            dst_desc.get(), attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for an "
+                        "embedding bag forward propagation primitive");
+            reset(pd);
+        }
+
+        /// Constructs a primitive descriptor for an embedding bag forward
+        /// propagation primitive from a C API primitive descriptor that must
+        /// have a matching kind.
+        ///
+        /// @param pd C API primitive descriptor for an embedding bag forward
+        ///     propagation primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : dnnl::primitive_desc(pd, dnnl::primitive::kind::embedding_bag,
+                    dnnl::prop_kind::forward_training,
+                    dnnl::prop_kind::forward_inference) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// Returns an indices memory descriptor.
+        /// @returns Indices memory descriptor.
+        memory::desc indices_desc() const { return base::src_desc(1); }
+
+        /// Returns a bag offsets memory descriptor.
+        /// @returns Bag offsets memory descriptor.
+        memory::desc offsets_desc() const { return base::src_desc(2); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_algorithm()const
+        algorithm get_algorithm() const { return base::get_algorithm(); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_prop_kind()const
+        prop_kind get_prop_kind() const { return base::get_prop_kind(); }
+    };
+
+    /// Default constructor. Produces an empty object.
+    embedding_bag_forward() = default;
+
+    /// Constructs an embedding bag forward propagation primitive.
+    /// @param pd Primitive descriptor for an embedding bag forward
+    ///     propagation primitive.
+    embedding_bag_forward(const primitive_desc &pd) : primitive(pd) {}
+
+    /// Constructs an embedding bag forward propagation primitive from a cache
+    ///     blob.
+    /// @param pd Primitive descriptor for an embedding bag forward
+    ///     propagation primitive.
+    /// @param cache_blob Cache blob.
+    embedding_bag_forward(
+            const primitive_desc &pd, const std::vector<uint8_t> &cache_blob)
+        : primitive(pd, cache_blob) {}
+};
+
+/// @} dnnl_api_embedding_bag
+
+/// @addtogroup dnnl_api_softmax_merge Softmax Merge
+///
+/// A primitive to combine softmax results computed over chunks of an axis
+/// using the log-sum-exp of each chunk.
+///
+/// @sa @ref dev_guide_softmax_merge in developer guide
+///
+/// @{
+
+/// Softmax merge forward propagation primitive.
+struct softmax_merge_forward : public primitive {
+    /// Primitive descriptor for a softmax merge forward propagation
+    /// primitive.
+    struct primitive_desc : public dnnl::primitive_desc {
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for a softmax merge forward
+        ///     propagation primitive.
+        ///
+        /// @note
+        ///     Destination memory descriptor may be initialized with
+        ///     #dnnl::memory::format_tag::any value of @p format_tag.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aprop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::forward_training, and
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param src_desc Source memory descriptor with softmax results of
+        ///     chunks stacked along @p axis.
+        /// @param chunk_lse_desc Memory descriptor for the log-sum-exp of
+        ///     each chunk.
+        /// @param dst_desc Destination memory descriptor. The size of
+        ///     @p axis is either the number of chunks to rescale the chunks,
+        ///     or 1 to rescale and sum them up.
+        /// @param axis Axis along which the chunks are stacked.
+        /// @param flags Softmax flags. Possible values are
+        ///     #dnnl::softmax_flags::none and
+        ///     #dnnl::softmax_flags::output_stats to output the merged
+        ///     log-sum-exp.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, prop_kind aprop_kind,
+                const memory::desc &src_desc,
+                const memory::desc &chunk_lse_desc,
+                const memory::desc &dst_desc, int axis, softmax_flags flags,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false) {
+
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status
+                    = dnnl_softmax_merge_forward_primitive_desc_create(&pd,
+                            aengine.get(), dnnl::convert_to_c(aprop_kind),
+                            src_desc.get(), chunk_lse_desc.get(),
+                            dst_desc.get(), axis, convert_to_c(flags),
+                            attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for a "
+                        "softmax merge forward propagation primitive");
+            reset(pd);
+        }
+
+        /// Constructs a primitive descriptor for a softmax merge forward
+        /// propagation primitive from a C API primitive descriptor that must
+        /// have a matching kind.
+        ///
+        /// @param pd C API primitive descriptor for a softmax merge forward
+        ///     propagation primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : dnnl::primitive_desc(pd, dnnl::primitive::kind::softmax_merge,
+                    dnnl::prop_kind::forward_training,
+                    dnnl::prop_kind::forward_inference) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// Returns memory descriptor for the log-sum-exp of each chunk.
+        /// @returns Memory descriptor for the log-sum-exp of each chunk.
+        memory::desc chunk_lse_desc() const { return base::src_desc(1); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+
+        /// Returns memory descriptor for the merged log-sum-exp.
+        /// @returns Memory descriptor for the merged log-sum-exp.
+        /// @returns A zero memory descriptor if the primitive does not output
+        ///     statistics.
+        memory::desc lse_desc() const { return base::dst_desc(2); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_prop_kind()const
+        prop_kind get_prop_kind() const { return base::get_prop_kind(); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_axis()const
+        int get_axis() const { return base::get_axis(); }
+
+        /// Returns softmax flags.
+        /// @return Softmax flags.
+        softmax_flags get_flags() const {
+            return base::get_flags<softmax_flags>();
+        }
+    };
+
+    /// Default constructor. Produces an empty object.
+    softmax_merge_forward() = default;
+
+    /// Constructs a softmax merge forward propagation primitive.
+    /// @param pd Primitive descriptor for a softmax merge forward
+    ///     propagation primitive.
+    softmax_merge_forward(const primitive_desc &pd) : primitive(pd) {}
+
+    /// Constructs a softmax merge forward propagation primitive from a cache
+    ///     blob.
+    /// @param pd Primitive descriptor for a softmax merge forward
+    ///     propagation primitive.
+    /// @param cache_blob Cache blob.
+    softmax_merge_forward(
+            const primitive_desc &pd, const std::vector<uint8_t> &cache_blob)
+        : primitive(pd, cache_blob) {}
+};
+
+/// @} dnnl_api_softmax_merge
+
 /// @} dnnl_api_primitives
 
 /// @addtogroup dnnl_api_service Service
@@ -554,6 +554,57 @@ dnnl_status_t DNNL_API dnnl_graph_compiled_partition_get_inplace_ports(
         size_t *num_inplace_pairs,
         const dnnl_graph_inplace_pair_t **inplace_pairs);
 
+/// Controls the execution profiling of compiled partitions. When it is
+/// enabled, the wall time, the memory traffic and the implementation of each
+/// internal operation executed by a compiled partition on CPU are recorded.
+/// The operations are synchronized with the stream to be timed separately, so
+/// profiling slows down the execution. By default, the profiling is disabled
+/// unless the `ONEDNN_GRAPH_EXECUTION_PROFILING` environment variable is set
+/// to a positive value.
+///
+/// @param flag Set to positive value to enable the profiling and set to 0 to
+///     disable it. Negative values are invalid.
+/// @returns #dnnl_invalid_arguments if the @p flag value is invalid, and
+///     #dnnl_success on success.
+dnnl_status_t DNNL_API dnnl_graph_set_execution_profiling(int flag);
+
+/// Returns the enabling status of the execution profiling.
+///
+/// @param flag The execution profiling enabling status to query.
+/// @returns #dnnl_invalid_arguments if the @p flag value is nullptr, and
+///     #dnnl_success on success.
+dnnl_status_t DNNL_API dnnl_graph_get_execution_profiling(int *flag);
+
+/// Returns the profiling records of the last profiled execution of a compiled
+/// partition, one for each internal operation in the order of execution. The
+/// records are valid until the compiled partition is executed again with the
+/// profiling enabled, or destroyed.
+///
+/// @param compiled_partition The target compiled partition.
+/// @param num_records The number of records.
+/// @param records The handle of the records.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_compiled_partition_get_profiling_records(
+        const_dnnl_graph_compiled_partition_t compiled_partition,
+        size_t *num_records, const dnnl_graph_profiling_record_t **records);
+
+/// Returns the profiling records of the last profiled execution of a compiled
+/// partition as a null-terminated JSON string in the Chrome trace event
+/// format, which can be loaded by trace viewers such as `chrome://tracing` or
+/// Perfetto.
+///
+/// @param compiled_partition The target compiled partition.
+/// @param size Size of the trace in bytes, including the terminating null
+///     character.
+/// @param trace Trace of size @p size. If the @p trace is nullptr then the
+///     size of the trace is returned in @p size.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_compiled_partition_get_profiling_trace(
+        const_dnnl_graph_compiled_partition_t compiled_partition, size_t *size,
+        char *trace);
+
 /// @} dnnl_graph_api_compiled_partition
 
 /// @addtogroup dnnl_graph_api_graph
@@ -583,6 +634,23 @@ dnnl_status_t DNNL_API dnnl_graph_graph_create_with_fpmath_mode(
         dnnl_graph_graph_t *graph, dnnl_engine_kind_t engine_kind,
         dnnl_fpmath_mode_t mode);
 
+/// Creates a new graph from the operations of partitions which were returned
+/// by previous partitioning. The partitions must have the same engine kind and
+/// floating-point math mode, which are inherited by the new graph. The graph
+/// is not finalized, so users can add more operations, like End operations
+/// for the tensors which are still consumed outside of the partitions, before
+/// finalizing it and partitioning it again. This allows fusions across
+/// partitions which were returned from different graphs.
+///
+/// @param graph The handle of output graph.
+/// @param num_partitions The number of partitions to be merged.
+/// @param partitions A list of partitions.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_graph_create_from_partitions(
+        dnnl_graph_graph_t *graph, size_t num_partitions,
+        const_dnnl_graph_partition_t *partitions);
+
 /// Destroys a graph.
 ///
 /// @param graph The graph to be destroyed.
@@ -738,6 +806,42 @@ dnnl_status_t DNNL_API dnnl_graph_set_constant_tensor_cache_capacity(
 dnnl_status_t DNNL_API dnnl_graph_get_constant_tensor_cache_capacity(
         dnnl_engine_kind_t eng_kind, size_t *size);
 
+/// Exports the constant tensors cached for an engine to a file. The constant
+/// tensors of a compiled partition are cached after its first execution, so
+/// compiled partitions can be executed once offline to prepare the constant
+/// tensors, e.g. the reordered weights, for export. Constant tensors still
+/// being computed are not exported. The file is written under a temporary
+/// name and renamed once complete.
+///
+/// @param engine The engine that the constant tensor cache is used for. Only
+///     CPU engines are supported.
+/// @param path The path of the file to write.
+/// @returns #dnnl_success on success, #dnnl_unimplemented if the engine is not
+///     a CPU engine, and #dnnl_invalid_arguments if the file can't be written.
+dnnl_status_t DNNL_API dnnl_graph_export_constant_tensor_cache(
+        dnnl_engine_t engine, const char *path);
+
+/// Imports the constant tensors exported by
+/// #dnnl_graph_export_constant_tensor_cache into the constant tensor cache of
+/// an engine. The file is memory-mapped and the constant tensors are used in
+/// place, so the first execution of compiled partitions created the same way
+/// as the exporting ones skips computing them, if the content of their
+/// constant inputs is the same. Constant tensors already in the cache are
+/// kept. Constant tensors exceeding the remaining capacity of the
+/// cache are not imported, and are computed at the first execution instead.
+///
+/// @param engine The engine that the constant tensor cache is used for. Only
+///     CPU engines are supported.
+/// @param path The path of the file to read.
+/// @param num_skipped Output number of constant tensors not imported as they
+///     exceed the remaining capacity of the cache. May be NULL.
+/// @returns #dnnl_success on success, #dnnl_unimplemented if the engine is not
+///     a CPU engine or the platform doesn't support memory mapping, and
+///     #dnnl_invalid_arguments if the file can't be read or was exported by
+///     another library version or for another CPU ISA.
+dnnl_status_t DNNL_API dnnl_graph_import_constant_tensor_cache(
+        dnnl_engine_t engine, const char *path, size_t *num_skipped);
+
 /// @} dnnl_graph_api_constant_tensor_cache
 
 /// @} dnnl_graph_api
@@ -652,6 +652,22 @@ public:
 /// A compiled partition object.
 class compiled_partition : public compiled_partition_handle {
 public:
+    /// Profiling record of an internal operation executed by a compiled
+    /// partition.
+    struct profiling_record {
+        /// The name of the internal operation
+        std::string name;
+        /// The name of the implementation of the operation, or an empty
+        /// string if it is not backed by a primitive
+        std::string impl_info;
+        /// The start time of the operation in milliseconds
+        double start_ms;
+        /// The wall time of the operation in milliseconds
+        double duration_ms;
+        /// The size in bytes of the memory read and written by the operation
+        size_t bytes;
+    };
+
     /// Default constructor. Constructs an empty object.
     compiled_partition() = default;
 
@@ -704,6 +720,49 @@ public:
         return inplace_options;
     }
 
+    /// Returns the profiling records of the last profiled execution of the
+    /// compiled partition, one for each internal operation in the order of
+    /// execution. The records are collected when the execution profiling is
+    /// enabled with #dnnl::graph::set_execution_profiling().
+    ///
+    /// @returns A list of profiling records.
+    std::vector<profiling_record> get_profiling_records() const {
+        size_t num = 0;
+        const dnnl_graph_profiling_record_t *records;
+
+        error::wrap_c_api(dnnl_graph_compiled_partition_get_profiling_records(
+                                  get(), &num, &records),
+                "could not get the profiling records from a compiled "
+                "partition");
+
+        std::vector<profiling_record> ret;
+        ret.reserve(num);
+        for (size_t i = 0; i < num; ++i) {
+            const dnnl_graph_profiling_record_t &r = records[i];
+            ret.push_back({r.name, r.impl_info, r.start_ms, r.duration_ms,
+                    r.bytes});
+        }
+        return ret;
+    }
+
+    /// Returns the profiling records of the last profiled execution of the
+    /// compiled partition as a JSON string in the Chrome trace event format.
+    ///
+    /// @returns The profiling trace.
+    std::string get_profiling_trace() const {
+        size_t size = 0;
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_get_profiling_trace(
+                        get(), &size, nullptr),
+                "could not get profiling trace size from a compiled partition");
+
+        std::vector<char> trace(size);
+        error::wrap_c_api(dnnl_graph_compiled_partition_get_profiling_trace(
+                                  get(), &size, trace.data()),
+                "could not get profiling trace from a compiled partition");
+        return std::string(trace.data());
+    }
+
     /// Execute a compiled partition.
     ///
     /// @param astream Stream object to run over.
@@ -730,6 +789,20 @@ public:
     }
 };
 
+/// @copydoc dnnl_graph_set_execution_profiling(int flag)
+inline void set_execution_profiling(int flag) {
+    error::wrap_c_api(dnnl_graph_set_execution_profiling(flag),
+            "could not set execution profiling");
+}
+
+/// Returns the enabling status of the execution profiling.
+inline int get_execution_profiling() {
+    int result = 0;
+    error::wrap_c_api(dnnl_graph_get_execution_profiling(&result),
+            "could not get execution profiling");
+    return result;
+}
+
 /// @} dnnl_graph_api_compiled_partition
 
 /// @addtogroup dnnl_graph_api_op Op
@@ -1384,6 +1457,28 @@ public:
         reset(g);
     }
 
+    /// Creates a new graph from the operations of partitions which were
+    /// returned by previous partitioning, so that the fusion patterns can be
+    /// applied across the boundaries of the partitions. The partitions must
+    /// have the same engine kind and floating-point math mode, which are
+    /// inherited by the new graph. The graph is not finalized: users can add
+    /// End operations for the tensors which are still consumed outside of the
+    /// partitions before calling #finalize() and #get_partitions().
+    ///
+    /// @param partitions A list of partitions to be merged.
+    explicit graph(const std::vector<partition> &partitions) {
+        std::vector<const_dnnl_graph_partition_t> c_partitions;
+        c_partitions.reserve(partitions.size());
+        for (const auto &p : partitions)
+            c_partitions.push_back(p.get());
+
+        dnnl_graph_graph_t g = nullptr;
+        error::wrap_c_api(dnnl_graph_graph_create_from_partitions(&g,
+                                  c_partitions.size(), c_partitions.data()),
+                "could not create graph from partitions");
+        reset(g);
+    }
+
     /// Adds an op into the graph to construct a computational DAG. The API will
     /// return failure if the operator has already been added to the graph or
     /// the operation cannot pass the schema check in the library (eg. input and
@@ -1560,6 +1655,48 @@ inline size_t get_constant_tensor_cache_capacity(engine::kind kind) {
     return size;
 }
 
+/// Exports the constant tensors cached for an engine to a file. The constant
+/// tensors of a compiled partition are cached after its first execution, so
+/// compiled partitions can be executed once offline to prepare the constant
+/// tensors, e.g. the reordered weights, for export. Constant tensors still
+/// being computed are not exported.
+///
+/// @param aengine The engine that the constant tensor cache is used for. Only
+///     CPU engines are supported.
+/// @param path The path of the file to write.
+inline void export_constant_tensor_cache(
+        const engine &aengine, const std::string &path) {
+    error::wrap_c_api(
+            dnnl_graph_export_constant_tensor_cache(
+                    aengine.get(), path.c_str()),
+            "fail to export constant tensor cache");
+}
+
+/// Imports the constant tensors exported by export_constant_tensor_cache()
+/// into the constant tensor cache of an engine. The file is memory-mapped and
+/// the constant tensors are used in place, so the first execution of compiled
+/// partitions created the same way as the exporting ones skips computing them,
+/// if the content of their constant inputs is the same. Constant tensors
+/// already in the cache are kept. Constant tensors exceeding
+/// the remaining capacity of the cache are not imported, and are computed at
+/// the first execution instead. The import fails if the file was exported by
+/// another library version or for another CPU ISA.
+///
+/// @param aengine The engine that the constant tensor cache is used for. Only
+///     CPU engines are supported.
+/// @param path The path of the file to read.
+/// @returns The number of constant tensors not imported as they exceed the
+///     remaining capacity of the cache.
+inline size_t import_constant_tensor_cache(
+        const engine &aengine, const std::string &path) {
+    size_t num_skipped = 0;
+    error::wrap_c_api(
+            dnnl_graph_import_constant_tensor_cache(
+                    aengine.get(), path.c_str(), &num_skipped),
+            "fail to import constant tensor cache");
+    return num_skipped;
+}
+
 /// @} dnnl_graph_api_constant_tensor_cache
 
 } // namespace graph
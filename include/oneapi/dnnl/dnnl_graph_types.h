@@ -435,6 +435,30 @@ typedef struct {
     size_t output_id;
 } dnnl_graph_inplace_pair_t;
 
+/// Profiling record of an internal operation executed by a compiled
+/// partition. A fused partition is executed as a sequence of internal
+/// operations, e.g. the primitives and the reorders inserted by the library.
+/// The records are collected when the execution profiling is enabled with
+/// #dnnl_graph_set_execution_profiling().
+typedef struct {
+    /// The name of the internal operation
+    const char *name;
+
+    /// The name of the implementation of the operation, e.g.
+    /// `brg:avx512_core`, or an empty string if it is not backed by a
+    /// primitive
+    const char *impl_info;
+
+    /// The start time of the operation in milliseconds
+    double start_ms;
+
+    /// The wall time of the operation in milliseconds
+    double duration_ms;
+
+    /// The size in bytes of the memory read and written by the operation
+    size_t bytes;
+} dnnl_graph_profiling_record_t;
+
 /// An opaque structure to describe a compiled partition.
 struct dnnl_graph_compiled_partition;
 
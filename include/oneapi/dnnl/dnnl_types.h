@@ -2017,6 +2017,10 @@ typedef enum {
     dnnl_layer_normalization,
     /// A group normalization primitive.
     dnnl_group_normalization,
+    /// An embedding bag primitive.
+    dnnl_embedding_bag,
+    /// A softmax merge primitive.
+    dnnl_softmax_merge,
 
     /// Parameter to allow internal only primitives without undefined behavior.
     /// This parameter is chosen to be valid for so long as sizeof(int) >= 2.
@@ -2030,8 +2034,11 @@ typedef enum {
     dnnl_convolution_direct = 0x1,
     /// Winograd convolution
     dnnl_convolution_winograd = 0x2,
-    /// Convolution algorithm(either direct or Winograd) is chosen just in time
+    /// Convolution algorithm(either direct, Winograd or FFT) is chosen just in
+    /// time
     dnnl_convolution_auto = 0x3,
+    /// FFT convolution
+    dnnl_convolution_fft = 0x4,
     /// Direct deconvolution
     dnnl_deconvolution_direct = 0xa,
     /// Winograd deconvolution
@@ -2169,10 +2176,20 @@ typedef enum {
     dnnl_reduction_norm_lp_power_p_max,
     /// Reduction using lp norm without final pth-root
     dnnl_reduction_norm_lp_power_p_sum,
+    /// Reduction selecting the maximum and its index
+    dnnl_reduction_argmax,
+    /// Reduction selecting the minimum and its index
+    dnnl_reduction_argmin,
+    /// Reduction selecting the k largest values and their indices
+    dnnl_reduction_topk,
     /// Softmax
     dnnl_softmax_accurate = 0x30000,
     /// Logsoftmax
     dnnl_softmax_log,
+    /// Embedding bag using sum pooling
+    dnnl_embedding_bag_sum = 0x40000,
+    /// Embedding bag using mean pooling
+    dnnl_embedding_bag_mean,
 } dnnl_alg_kind_t;
 
 /// Flags for normalization primitives.
@@ -2246,6 +2263,22 @@ typedef enum {
 
 } dnnl_normalization_flags_t;
 
+/// Flags for softmax primitive.
+typedef enum {
+    /// Use no softmax flags.
+    dnnl_softmax_flags_none = 0x0U,
+
+    /// Output per-row statistics on forward propagation: the maximum of the
+    /// source along the softmax axis (#DNNL_ARG_DST_1) and the log-sum-exp of
+    /// the source along the softmax axis (#DNNL_ARG_DST_2).
+    dnnl_softmax_output_stats = 0x1U,
+
+    /// Output per-row candidates on forward propagation: the indices of the
+    /// largest destination values along the softmax axis sorted in descending
+    /// order of the values (#DNNL_ARG_DST_3).
+    dnnl_softmax_output_candidates = 0x2U,
+} dnnl_softmax_flags_t;
+
 /// @} dnnl_api_primitives_common
 /// @} dnnl_api_primitives
 
@@ -2464,12 +2497,20 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// for #DNNL_ARG_SRC_1.
 #define DNNL_ARG_SRC_ITER DNNL_ARG_SRC_1
 
+/// A special mnemonic for embedding bag indices. An alias for
+/// #DNNL_ARG_SRC_1.
+#define DNNL_ARG_INDICES DNNL_ARG_SRC_1
+
 /// Source argument #2.
 #define DNNL_ARG_SRC_2 3
 /// A special mnemonic for RNN input recurrent cell state vector. An alias for
 /// #DNNL_ARG_SRC_2.
 #define DNNL_ARG_SRC_ITER_C DNNL_ARG_SRC_2
 
+/// A special mnemonic for embedding bag offsets. An alias for
+/// #DNNL_ARG_SRC_2.
+#define DNNL_ARG_OFFSETS DNNL_ARG_SRC_2
+
 /// Source argument #3.
 #define DNNL_ARG_SRC_3 4
 /// A special mnemonic for RNN input recurrent cell attention vector. An alias for
@@ -2499,6 +2540,9 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// alias for #DNNL_ARG_DST_2.
 #define DNNL_ARG_DST_ITER_C DNNL_ARG_DST_2
 
+/// Destination argument #3.
+#define DNNL_ARG_DST_3 20
+
 /// Weights argument #0.
 #define DNNL_ARG_WEIGHTS_0 33
 /// A special mnemonic for primitives that have a single weights
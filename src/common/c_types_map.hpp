@@ -68,6 +68,7 @@ const alg_kind_t undef = dnnl_alg_kind_undef;
 const alg_kind_t convolution_auto = dnnl_convolution_auto;
 const alg_kind_t convolution_direct = dnnl_convolution_direct;
 const alg_kind_t convolution_winograd = dnnl_convolution_winograd;
+const alg_kind_t convolution_fft = dnnl_convolution_fft;
 const alg_kind_t deconvolution_direct = dnnl_deconvolution_direct;
 const alg_kind_t deconvolution_winograd = dnnl_deconvolution_winograd;
 const alg_kind_t eltwise_relu = dnnl_eltwise_relu;
@@ -139,8 +140,13 @@ const alg_kind_t reduction_norm_lp_power_p_max
         = dnnl_reduction_norm_lp_power_p_max;
 const alg_kind_t reduction_norm_lp_power_p_sum
         = dnnl_reduction_norm_lp_power_p_sum;
+const alg_kind_t reduction_argmax = dnnl_reduction_argmax;
+const alg_kind_t reduction_argmin = dnnl_reduction_argmin;
+const alg_kind_t reduction_topk = dnnl_reduction_topk;
 const alg_kind_t softmax_accurate = dnnl_softmax_accurate;
 const alg_kind_t softmax_log = dnnl_softmax_log;
+const alg_kind_t embedding_bag_sum = dnnl_embedding_bag_sum;
+const alg_kind_t embedding_bag_mean = dnnl_embedding_bag_mean;
 } // namespace alg_kind
 
 using data_type_t = dnnl_data_type_t;
@@ -1894,6 +1900,13 @@ const rnn_flags_t diff_weights_overwrite
         = dnnl_rnn_flags_diff_weights_overwrite;
 } // namespace rnn_flags
 
+using softmax_flags_t = dnnl_softmax_flags_t;
+namespace softmax_flags {
+const softmax_flags_t none = dnnl_softmax_flags_none;
+const softmax_flags_t output_stats = dnnl_softmax_output_stats;
+const softmax_flags_t output_candidates = dnnl_softmax_output_candidates;
+} // namespace softmax_flags
+
 using engine_kind_t = dnnl_engine_kind_t;
 namespace engine_kind {
 const engine_kind_t any_engine = dnnl_any_engine;
@@ -1945,6 +1958,8 @@ const primitive_kind_t reduction = dnnl_reduction;
 const primitive_kind_t softmax = dnnl_softmax;
 const primitive_kind_t layer_normalization = dnnl_layer_normalization;
 const primitive_kind_t group_normalization = dnnl_group_normalization;
+const primitive_kind_t embedding_bag = dnnl_embedding_bag;
+const primitive_kind_t softmax_merge = dnnl_softmax_merge;
 
 // Internal only primitive kinds.
 const primitive_kind_t internal_only_start = (primitive_kind_t)(1 << 12);
@@ -2076,6 +2091,8 @@ struct deconvolution_pd_t;
 struct eltwise_bwd_pd_t;
 struct eltwise_fwd_pd_t;
 struct eltwise_pd_t;
+struct embedding_bag_fwd_pd_t;
+struct embedding_bag_pd_t;
 struct gemm_pd_t;
 struct group_normalization_bwd_pd_t;
 struct group_normalization_fwd_pd_t;
@@ -2104,6 +2121,8 @@ struct rnn_pd_t;
 struct shuffle_pd_t;
 struct softmax_bwd_pd_t;
 struct softmax_fwd_pd_t;
+struct softmax_merge_fwd_pd_t;
+struct softmax_merge_pd_t;
 struct softmax_pd_t;
 struct sum_pd_t;
 
@@ -49,7 +49,7 @@ status_t conv_desc_init(convolution_desc_t *conv_desc, prop_kind_t prop_kind,
                         padding_l),
             VERBOSE_NULL_ARG);
     VCHECK_CONV(one_of(alg_kind, convolution_auto, convolution_direct,
-                        convolution_winograd),
+                        convolution_winograd, convolution_fft),
             VERBOSE_BAD_ALGORITHM);
 
     if (padding_r == nullptr) padding_r = padding_l;
@@ -215,9 +215,20 @@ status_t conv_attr_check(const convolution_desc_t &desc, const engine_t *engine,
                     VERBOSE_UNSUPPORTED_POSTOP);
         }
     } else {
+        const bool is_bwd_w = desc.prop_kind == prop_kind::backward_weights;
         auto bwd_attr_mask = smask_t::fpmath_mode;
+        if (is_bwd_w) bwd_attr_mask |= smask_t::post_ops;
         VCHECK_CONV_UNIMPL(attr->has_default_values(bwd_attr_mask),
                 VERBOSE_UNSUPPORTED_ATTR);
+
+        // Backward by weights accepts a single sum post-op that accumulates
+        // into diff weights and diff bias.
+        if (is_bwd_w && !attr->post_ops_.has_default_values()) {
+            const auto &po = attr->post_ops_;
+            VCHECK_CONV_UNIMPL(po.len() == 1 && po.entry_[0].is_sum()
+                            && po.entry_[0].sum.dt == data_type::undef,
+                    VERBOSE_UNSUPPORTED_POSTOP);
+        }
     }
 
     return status::success;
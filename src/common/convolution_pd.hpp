@@ -217,7 +217,7 @@ protected:
 
     bool set_default_alg_kind(alg_kind_t alg_kind) {
         assert(utils::one_of(alg_kind, alg_kind::convolution_direct,
-                alg_kind::convolution_winograd));
+                alg_kind::convolution_winograd, alg_kind::convolution_fft));
         if (desc_.alg_kind == alg_kind::convolution_auto)
             desc_.alg_kind = alg_kind;
         return desc_.alg_kind == alg_kind;
@@ -464,6 +464,14 @@ struct convolution_bwd_weights_pd_t : public convolution_pd_t {
     int n_inputs() const override { return 2; }
     int n_outputs() const override { return 1 + with_bias(); }
 
+    // A sum post-op adds the computed gradients to the content of diff
+    // weights and diff bias instead of overwriting it.
+    bool with_sum() const {
+        const auto &po = attr()->post_ops_;
+        return po.len() == 1 && po.entry_[0].is_sum()
+                && po.entry_[0].sum.dt == data_type::undef;
+    }
+
 protected:
     memory_desc_t src_md_;
     memory_desc_t diff_weights_md_;
@@ -1751,6 +1751,8 @@ const char *dnnl_prim_kind2str(dnnl_primitive_kind_t v) {
     if (v == dnnl_softmax) return "softmax";
     if (v == dnnl_layer_normalization) return "layer_normalization";
     if (v == dnnl_group_normalization) return "group_normalization";
+    if (v == dnnl_embedding_bag) return "embedding_bag";
+    if (v == dnnl_softmax_merge) return "softmax_merge";
     if (v == dnnl_primitive_kind_max) return "primitive_kind_max";
     if (v == dnnl::impl::primitive_kind::sdpa) return "sdpa";
     assert(!"unknown prim_kind");
@@ -1762,6 +1764,7 @@ const char *dnnl_alg_kind2str(dnnl_alg_kind_t v) {
     if (v == dnnl_convolution_direct) return "convolution_direct";
     if (v == dnnl_convolution_winograd) return "convolution_winograd";
     if (v == dnnl_convolution_auto) return "convolution_auto";
+    if (v == dnnl_convolution_fft) return "convolution_fft";
     if (v == dnnl_deconvolution_direct) return "deconvolution_direct";
     if (v == dnnl_deconvolution_winograd) return "deconvolution_winograd";
     if (v == dnnl_eltwise_relu) return "eltwise_relu";
@@ -1826,8 +1829,13 @@ const char *dnnl_alg_kind2str(dnnl_alg_kind_t v) {
     if (v == dnnl_reduction_norm_lp_sum) return "reduction_norm_lp_sum";
     if (v == dnnl_reduction_norm_lp_power_p_max) return "reduction_norm_lp_power_p_max";
     if (v == dnnl_reduction_norm_lp_power_p_sum) return "reduction_norm_lp_power_p_sum";
+    if (v == dnnl_reduction_argmax) return "reduction_argmax";
+    if (v == dnnl_reduction_argmin) return "reduction_argmin";
+    if (v == dnnl_reduction_topk) return "reduction_topk";
     if (v == dnnl_softmax_accurate) return "softmax_accurate";
     if (v == dnnl_softmax_log) return "softmax_log";
+    if (v == dnnl_embedding_bag_sum) return "embedding_bag_sum";
+    if (v == dnnl_embedding_bag_mean) return "embedding_bag_mean";
     assert(!"unknown alg_kind");
     return "unknown alg_kind";
 }
@@ -178,6 +178,8 @@ PKIND_TRAITS_INST(binary);
 PKIND_TRAITS_INST(matmul);
 PKIND_TRAITS_INST(resampling);
 PKIND_TRAITS_INST(reduction);
+PKIND_TRAITS_INST(embedding_bag);
+PKIND_TRAITS_INST(softmax_merge);
 PKIND_TRAITS_INST(sum);
 PKIND_TRAITS_INST(sdpa);
 #undef PKIND_TRAITS_INST
@@ -0,0 +1,146 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "oneapi/dnnl/dnnl.h"
+#include "opdesc.hpp"
+#include "primitive_desc_iface.hpp"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::utils;
+using namespace dnnl::impl::alg_kind;
+using namespace dnnl::impl::prop_kind;
+
+#define VCHECK_EMB(cond, msg, ...) \
+    VCONDCHECK(primitive, create, check, embedding_bag, (cond), \
+            status::invalid_arguments, msg, ##__VA_ARGS__);
+
+#define VCHECK_EMB_UNIMPL(cond, msg, ...) \
+    VCONDCHECK(primitive, create, check, embedding_bag, (cond), \
+            status::unimplemented, msg, ##__VA_ARGS__);
+
+namespace dnnl {
+namespace impl {
+
+status_t embedding_bag_desc_init(embedding_bag_desc_t *embedding_bag_desc,
+        prop_kind_t prop_kind, alg_kind_t alg_kind,
+        const memory_desc_t *src_desc, const memory_desc_t *indices_desc,
+        const memory_desc_t *offsets_desc, const memory_desc_t *dst_desc) {
+    VCHECK_EMB(!any_null(src_desc, indices_desc, offsets_desc, dst_desc),
+            VERBOSE_NULL_ARG);
+    VCHECK_EMB(one_of(prop_kind, forward_training, forward_inference),
+            VERBOSE_BAD_PROPKIND);
+    VCHECK_EMB(one_of(alg_kind, embedding_bag_sum, embedding_bag_mean),
+            VERBOSE_BAD_ALGORITHM);
+
+    VCHECK_EMB(src_desc->ndims == 2, VERBOSE_BAD_NDIMS, "src", src_desc->ndims);
+    VCHECK_EMB(dst_desc->ndims == 2, VERBOSE_BAD_NDIMS, "dst", dst_desc->ndims);
+    VCHECK_EMB(indices_desc->ndims == 1, VERBOSE_BAD_NDIMS, "indices",
+            indices_desc->ndims);
+    VCHECK_EMB(offsets_desc->ndims == 1, VERBOSE_BAD_NDIMS, "offsets",
+            offsets_desc->ndims);
+
+    VCHECK_EMB(src_desc->dims[1] == dst_desc->dims[1],
+            VERBOSE_INCONSISTENT_DIM, "src", 1, "dst", 1);
+    VCHECK_EMB(offsets_desc->dims[0] == dst_desc->dims[0],
+            VERBOSE_INCONSISTENT_DIM, "offsets", 0, "dst", 0);
+
+    VCHECK_EMB(one_of(indices_desc->data_type, data_type::s32),
+            VERBOSE_INVALID_DATATYPE, "indices");
+    VCHECK_EMB(one_of(offsets_desc->data_type, data_type::s32),
+            VERBOSE_INVALID_DATATYPE, "offsets");
+
+    VCHECK_EMB(!memory_desc_wrapper(src_desc).format_any(),
+            VERBOSE_UNSUPPORTED_TAG_S, "src");
+    VCHECK_EMB(!memory_desc_wrapper(indices_desc).format_any(),
+            VERBOSE_UNSUPPORTED_TAG_S, "indices");
+    VCHECK_EMB(!memory_desc_wrapper(offsets_desc).format_any(),
+            VERBOSE_UNSUPPORTED_TAG_S, "offsets");
+
+    const bool runtime_dims_or_strides
+            = memory_desc_wrapper(src_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(indices_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(offsets_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(dst_desc).has_runtime_dims_or_strides();
+    VCHECK_EMB_UNIMPL(
+            !runtime_dims_or_strides, VERBOSE_RUNTIMEDIM_UNSUPPORTED);
+
+    auto ed = embedding_bag_desc_t();
+    ed.primitive_kind = primitive_kind::embedding_bag;
+    ed.prop_kind = prop_kind;
+    ed.alg_kind = alg_kind;
+
+    ed.src_desc = *src_desc;
+    ed.indices_desc = *indices_desc;
+    ed.offsets_desc = *offsets_desc;
+    ed.dst_desc = *dst_desc;
+
+    (*embedding_bag_desc) = ed;
+    return success;
+}
+
+status_t embedding_bag_attr_check(const embedding_bag_desc_t &desc,
+        const engine_t *engine, const primitive_attr_t *attr) {
+    using smask_t = primitive_attr_t::skip_mask_t;
+
+    if (attr == nullptr) return status::success;
+    if (attr->has_default_values()) return status::success;
+
+    // Check attributes
+    const data_type_t dst_dt = desc.dst_desc.data_type;
+
+    auto attr_mask = smask_t::scales_runtime;
+
+    VCHECK_EMB_UNIMPL(attr->has_default_values(attr_mask, dst_dt),
+            VERBOSE_UNSUPPORTED_ATTR);
+
+    // Check scales: only source scales are supported, either common or
+    // per-row of the embedding table.
+    if (!attr->scales_.has_default_values()) {
+        const auto &sc = attr->scales_;
+        VCHECK_EMB_UNIMPL(sc.has_default_values({DNNL_ARG_SRC}),
+                VERBOSE_UNSUPPORTED_SCALES_CFG);
+        const int mask_src = sc.get(DNNL_ARG_SRC).mask_;
+        VCHECK_EMB_UNIMPL(one_of(mask_src, 0, 1 << 0),
+                VERBOSE_UNSUPPORTED_SCALES_CFG);
+    }
+
+    return status::success;
+}
+
+} // namespace impl
+} // namespace dnnl
+
+dnnl_status_t dnnl_embedding_bag_forward_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        prop_kind_t prop_kind, alg_kind_t alg_kind,
+        const memory_desc_t *src_desc, const memory_desc_t *indices_desc,
+        const memory_desc_t *offsets_desc, const memory_desc_t *dst_desc,
+        const primitive_attr_t *attr) {
+    if (!one_of(prop_kind, forward_training, forward_inference))
+        return invalid_arguments;
+
+    auto embedding_bag_desc = embedding_bag_desc_t();
+    CHECK(embedding_bag_desc_init(&embedding_bag_desc, prop_kind, alg_kind,
+            src_desc, indices_desc, offsets_desc, dst_desc));
+    CHECK(embedding_bag_attr_check(embedding_bag_desc, engine, attr));
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&embedding_bag_desc, nullptr, attr);
+}
@@ -96,6 +96,13 @@
     {}
 #endif
 
+#if BUILD_PRIMITIVE_ALL || BUILD_EMBEDDING_BAG
+#define REG_EMBEDDING_BAG_P(...) __VA_ARGS__
+#else
+#define REG_EMBEDDING_BAG_P(...) \
+    { nullptr }
+#endif
+
 #if BUILD_PRIMITIVE_ALL || BUILD_GROUP_NORMALIZATION
 #define REG_GNORM_P(...) __VA_ARGS__
 #else
@@ -194,6 +201,14 @@
     {}
 #endif
 
+// Softmax merge is a companion of softmax and is built along with it.
+#if BUILD_PRIMITIVE_ALL || BUILD_SOFTMAX
+#define REG_SOFTMAX_MERGE_P(...) __VA_ARGS__
+#else
+#define REG_SOFTMAX_MERGE_P(...) \
+    { nullptr }
+#endif
+
 #if BUILD_PRIMITIVE_ALL || BUILD_SUM
 #define REG_SUM_P(...) __VA_ARGS__
 #else
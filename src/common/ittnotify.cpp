@@ -79,6 +79,8 @@ void primitive_task_start(primitive_kind_t kind) {
             CASE(softmax),
             CASE(layer_normalization),
             CASE(group_normalization),
+            CASE(embedding_bag),
+            CASE(softmax_merge),
             CASE(sdpa),
     };
 #undef CASE
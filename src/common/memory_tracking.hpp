@@ -184,6 +184,9 @@ enum {
     key_conv_cudnn_filter,
     key_conv_cudnn_temp,
     key_conv_dst_bf16_convert_wsp,
+    key_conv_fft_dst,
+    key_conv_fft_src,
+    key_conv_fft_wei,
     key_conv_brgemm_addr_a,
     key_conv_brgemm_addr_b,
     key_conv_brgemm_batch,
@@ -197,6 +200,8 @@ enum {
     key_conv_gemm_col,
     key_conv_gemm_imtr,
     key_conv_gemm_zp_src_comp,
+    key_conv_group_packed_wei,
+    key_conv_group_packed_wei_blocked,
     key_conv_int_dat_in_acc_dt,
     key_conv_padded_bias,
     key_conv_permuted_inputs,
@@ -215,9 +220,15 @@ enum {
     key_conv_wei_bia_reduction_bctx,
     key_conv_zero_point_flag,
     key_conv_zero_point_pad,
+    key_conv_zero_points_dst,
+    key_conv_zero_points_src,
     key_conv_miopen_algo,
     key_conv_miopen_filter,
     key_deconv_bias,
+    key_deconv_subpixel_dst,
+    key_deconv_subpixel_wei,
+    key_deconv_subpixel_wei_blocked,
+    key_deconv_subpixel_wei_plain,
     key_deconv_sum,
     key_deconv_zp,
     key_eltwise_diff_dst,
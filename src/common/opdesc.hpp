@@ -420,6 +420,51 @@ struct reduction_desc_t {
     float p, eps;
 };
 
+// A descriptor of an embedding bag operation.
+struct embedding_bag_desc_t {
+    // The kind of primitive. Used for self-identifying the primitive
+    // descriptor. Must be #dnnl_embedding_bag.
+    primitive_kind_t primitive_kind;
+    // The kind of propagation. Possible values: #dnnl_forward_training and
+    // #dnnl_forward_inference.
+    prop_kind_t prop_kind;
+    // The kind of pooling applied to each bag. Possible values:
+    // #dnnl_embedding_bag_sum and #dnnl_embedding_bag_mean.
+    alg_kind_t alg_kind;
+    // Source (embedding table) memory descriptor, 2D: [rows, dim].
+    memory_desc_t src_desc;
+    // Indices memory descriptor, 1D: [num_indices].
+    memory_desc_t indices_desc;
+    // Bag offsets memory descriptor, 1D: [num_bags]. Bag `i` covers indices
+    // in [offsets[i], offsets[i + 1]), the last bag ends at num_indices.
+    memory_desc_t offsets_desc;
+    // Destination memory descriptor, 2D: [num_bags, dim].
+    memory_desc_t dst_desc;
+};
+
+// A descriptor of a softmax merge operation.
+struct softmax_merge_desc_t {
+    // The kind of primitive. Used for self-identifying the primitive
+    // descriptor. Must be #dnnl_softmax_merge.
+    primitive_kind_t primitive_kind;
+    // The kind of propagation. Possible values: #dnnl_forward_training and
+    // #dnnl_forward_inference.
+    prop_kind_t prop_kind;
+    // Source memory descriptor, softmax results of chunks stacked along the
+    // axis.
+    memory_desc_t src_desc;
+    // Log-sum-exp of each chunk, dimensions of src with a trailing group of
+    // dimensions after the axis possibly set to one.
+    memory_desc_t lse_desc;
+    // Destination memory descriptor, dimensions of src with the axis either
+    // kept or set to one.
+    memory_desc_t dst_desc;
+    // The axis along which the chunks are stacked.
+    int axis;
+    // Softmax flags. Possible values: #dnnl_softmax_output_stats.
+    unsigned flags;
+};
+
 /// A descriptor of a Softmax operation.
 struct softmax_desc_t {
     // The kind of primitive. Used for self-identifying the primitive
@@ -441,6 +486,12 @@ struct softmax_desc_t {
     memory_desc_t dst_desc;
     // Destination gradient memory descriptor.
     memory_desc_t diff_dst_desc;
+    // Softmax flags. Possible values: #dnnl_softmax_output_stats and
+    // #dnnl_softmax_output_candidates.
+    unsigned flags;
+    // Number of candidates per row if #dnnl_softmax_output_candidates is
+    // specified, zero otherwise.
+    dim_t num_candidates;
 };
 
 // A descriptor of a binary operation.
@@ -617,6 +668,8 @@ struct op_desc_t {
         resampling_desc_t resampling;
         zero_pad_desc_t zero_pad;
         reduction_desc_t reduction;
+        embedding_bag_desc_t embedding_bag;
+        softmax_merge_desc_t softmax_merge;
         sdpa_desc_t sdpa;
     };
 
@@ -650,6 +703,8 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(resampling_desc_t);
     DECL_CTOR_AND_CONVERTERS(zero_pad_desc_t);
     DECL_CTOR_AND_CONVERTERS(reduction_desc_t);
+    DECL_CTOR_AND_CONVERTERS(embedding_bag_desc_t);
+    DECL_CTOR_AND_CONVERTERS(softmax_merge_desc_t);
     DECL_CTOR_AND_CONVERTERS(sdpa_desc_t);
 
     // concat_desc_t and sum_desc_t have data members which have non-trivial
@@ -71,6 +71,8 @@ bool key_t::operator==(const key_t &rhs) const {
             CASE(convolution)
             CASE(deconvolution)
             CASE(eltwise)
+            CASE(embedding_bag)
+            CASE(softmax_merge)
             CASE(gemm)
             CASE(group_normalization)
             CASE(inner_product)
@@ -419,6 +421,21 @@ size_t get_desc_hash(const eltwise_desc_t &desc) {
     return seed;
 }
 
+size_t get_desc_hash(const embedding_bag_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    seed = hash_combine(seed, static_cast<size_t>(desc.prop_kind));
+    seed = hash_combine(seed, static_cast<size_t>(desc.alg_kind));
+    // Memory descriptors
+    seed = hash_combine(seed, get_md_hash(desc.src_desc));
+    seed = hash_combine(seed, get_md_hash(desc.indices_desc));
+    seed = hash_combine(seed, get_md_hash(desc.offsets_desc));
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
+    // Combined hash for embedding_bag desc
+    return seed;
+}
+
 size_t get_desc_hash(const gemm_desc_t &desc) {
     size_t seed = 0;
     // Kinds
@@ -692,10 +709,30 @@ size_t get_desc_hash(const softmax_desc_t &desc) {
     seed = hash_combine(seed, get_md_hash(desc.diff_dst_desc));
     // Axis
     seed = hash_combine(seed, desc.softmax_axis);
+    // Flags
+    seed = hash_combine(seed, desc.flags);
+    seed = hash_combine(seed, desc.num_candidates);
     // Combined hash for softmax desc
     return seed;
 }
 
+size_t get_desc_hash(const softmax_merge_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    seed = hash_combine(seed, static_cast<size_t>(desc.prop_kind));
+    // Memory descriptors
+    seed = hash_combine(seed, get_md_hash(desc.src_desc));
+    seed = hash_combine(seed, get_md_hash(desc.lse_desc));
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
+    // Axis
+    seed = hash_combine(seed, desc.axis);
+    // Flags
+    seed = hash_combine(seed, desc.flags);
+    // Combined hash for softmax_merge desc
+    return seed;
+}
+
 size_t get_desc_hash(const sum_desc_t &desc) {
     size_t seed = 0;
     // Kinds
@@ -46,7 +46,8 @@ status_t reduction_desc_init(reduction_desc_t *reduction_desc,
     VCHECK_RED(one_of(alg_kind, reduction_max, reduction_min, reduction_sum,
                        reduction_mul, reduction_mean, reduction_norm_lp_max,
                        reduction_norm_lp_sum, reduction_norm_lp_power_p_max,
-                       reduction_norm_lp_power_p_sum),
+                       reduction_norm_lp_power_p_sum, reduction_argmax,
+                       reduction_argmin, reduction_topk),
             VERBOSE_BAD_ALGORITHM);
     VCHECK_RED(IMPLICATION(one_of(alg_kind, reduction_norm_lp_max,
                                    reduction_norm_lp_sum,
@@ -65,12 +66,24 @@ status_t reduction_desc_init(reduction_desc_t *reduction_desc,
     VCHECK_RED(src_desc->ndims == dst_desc->ndims, VERBOSE_INCONSISTENT_NDIMS,
             "src", "dst");
 
+    // top-k keeps k elements of the reduced dimension instead of one
+    const bool is_topk = alg_kind == reduction_topk;
+    int num_reduced_dims = 0;
     for (auto d = 0; d < src_desc->ndims; ++d) {
         const auto dst_dim_d = dst_desc->dims[d];
-        VCHECK_RED(one_of(dst_dim_d, 1, src_desc->dims[d]),
+        const auto src_dim_d = src_desc->dims[d];
+        VCHECK_RED(one_of(dst_dim_d, 1, src_dim_d)
+                        || (is_topk && 1 < dst_dim_d && dst_dim_d < src_dim_d),
                 VERBOSE_INCONSISTENT_DIM, "src", d, "dst", d);
+        if (dst_dim_d != src_dim_d) num_reduced_dims++;
     }
 
+    // indices are defined along a single reduced dimension only
+    VCHECK_RED(IMPLICATION(one_of(alg_kind, reduction_argmax,
+                                   reduction_argmin, reduction_topk),
+                       num_reduced_dims == 1),
+            VERBOSE_BAD_PARAM, "number of reduced dimensions");
+
     // reduction primitive doesn't support identity operation
     VCHECK_RED(!array_cmp(src_desc->dims, dst_desc->dims, src_desc->ndims),
             VERBOSE_INCONSISTENT_DIM, "src", -1, "dst", -1);
@@ -109,7 +122,10 @@ status_t reduction_attr_check(const reduction_desc_t &desc,
     // Check attributes
     const data_type_t dst_dt = desc.dst_desc.data_type;
 
-    auto attr_mask = smask_t::post_ops;
+    // index-producing algorithms have two outputs and no post-ops
+    const bool is_index_alg = one_of(
+            desc.alg_kind, reduction_argmax, reduction_argmin, reduction_topk);
+    auto attr_mask = is_index_alg ? smask_t::none : smask_t::post_ops;
 
     VCHECK_RED_UNIMPL(attr->has_default_values(attr_mask, dst_dt),
             VERBOSE_UNSUPPORTED_ATTR);
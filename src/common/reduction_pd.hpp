@@ -63,6 +63,9 @@ struct reduction_pd_t : public primitive_desc_t {
         switch (arg) {
             case DNNL_ARG_SRC: return arg_usage_t::input;
             case DNNL_ARG_DST: return arg_usage_t::output;
+            case DNNL_ARG_DST_1:
+                if (is_index_alg()) return arg_usage_t::output;
+                return arg_usage_t::unused;
             default: return primitive_desc_t::arg_usage(arg);
         }
     }
@@ -72,6 +75,7 @@ struct reduction_pd_t : public primitive_desc_t {
         switch (arg) {
             case DNNL_ARG_SRC: return src_md(0);
             case DNNL_ARG_DST: return dst_md(0, user_input);
+            case DNNL_ARG_DST_1: return dst_md(1);
             default: return primitive_desc_t::arg_md(arg);
         }
     }
@@ -84,24 +88,50 @@ struct reduction_pd_t : public primitive_desc_t {
     const memory_desc_t *dst_md(
             int index = 0, bool user_input = false) const override {
         if (index == 0) return user_input ? &desc()->dst_desc : &dst_md_;
+        if (index == 1 && is_index_alg()) return &indices_md_;
         return &glob_zero_md;
     }
 
     int n_inputs() const override { return 1 + n_binary_po_inputs(); }
-    int n_outputs() const override { return 1; }
+    int n_outputs() const override { return 1 + is_index_alg(); }
 
-    static void memory_desc_reduce_dim(memory_desc_t &md, int dim) {
+    /* common reduction aux functions */
+
+    // argmax, argmin and top-k output the indices of the selected elements
+    // along the reduced dimension in addition to their values.
+    bool is_index_alg() const {
+        using namespace alg_kind;
+        return utils::one_of(desc_.alg_kind, reduction_argmax,
+                reduction_argmin, reduction_topk);
+    }
+
+    // Returns the first reduced dimension. Index algorithms have exactly one.
+    int reduce_axis() const {
+        for (int d = 0; d < desc_.src_desc.ndims; ++d)
+            if (desc_.src_desc.dims[d] != desc_.dst_desc.dims[d]) return d;
+        return -1;
+    }
+
+    // Number of elements kept along the reduced dimension: k for top-k and
+    // one otherwise.
+    dim_t topk_k() const {
+        if (desc_.alg_kind != alg_kind::reduction_topk) return 1;
+        return desc_.dst_desc.dims[reduce_axis()];
+    }
+
+    static void memory_desc_reduce_dim(
+            memory_desc_t &md, int dim, dim_t reduced_size = 1) {
         if (md.format_kind != format_kind::blocked) return;
 
         // Update reduced dim
-        md.dims[dim] = 1;
+        md.dims[dim] = reduced_size;
 
         dims_t blocks = {0};
         memory_desc_wrapper(md).compute_blocks(blocks);
 
         // Reduced dim should be padded in case of inner blocks to preserve
         // layout
-        md.padded_dims[dim] = blocks[dim];
+        md.padded_dims[dim] = utils::rnd_up(reduced_size, blocks[dim]);
 
         // Update strides of dimensions which depend on reduced dim
         int perm[DNNL_MAX_NDIMS];
@@ -136,18 +166,24 @@ protected:
 
     memory_desc_t src_md_;
     memory_desc_t dst_md_;
+    // s32 indices with the layout of dst, valid for index algorithms only
+    memory_desc_t indices_md_;
 
     reduction_pd_t(const reduction_desc_t *adesc, const primitive_attr_t *attr,
             const hint_class *hint_fwd)
         : primitive_desc_t(attr, base_pkind)
         , desc_(*adesc)
         , src_md_(desc_.src_desc)
-        , dst_md_(desc_.dst_desc) {}
+        , dst_md_(desc_.dst_desc)
+        , indices_md_(glob_zero_md) {}
 
     status_t set_default_params() {
-        if (dst_md_.format_kind != format_kind::any) return status::success;
-
-        return set_dst_format();
+        if (dst_md_.format_kind == format_kind::any) CHECK(set_dst_format());
+        if (is_index_alg()) {
+            indices_md_ = dst_md_;
+            indices_md_.data_type = data_type::s32;
+        }
+        return status::success;
     }
 
     status_t set_dst_format() {
@@ -155,7 +191,7 @@ protected:
         new_dst_md.data_type = dst_md_.data_type;
         for (int d = 0; d < src_md_.ndims; d++)
             if (src_md_.dims[d] != dst_md_.dims[d])
-                memory_desc_reduce_dim(new_dst_md, d);
+                memory_desc_reduce_dim(new_dst_md, d, dst_md_.dims[d]);
         dst_md_ = new_dst_md;
 
         return status::success;
@@ -36,6 +36,8 @@ status_t serialize_desc(
         CASE(convolution)
         CASE(deconvolution)
         CASE(eltwise)
+        CASE(embedding_bag)
+        CASE(softmax_merge)
         CASE(gemm)
         CASE(group_normalization)
         CASE(inner_product)
@@ -342,6 +344,20 @@ void serialize_desc(
     sstream.write(&desc.beta);
 }
 
+// Embedding bag
+void serialize_desc(
+        serialization_stream_t &sstream, const embedding_bag_desc_t &desc) {
+    // Kinds
+    sstream.write(&desc.primitive_kind);
+    sstream.write(&desc.prop_kind);
+    sstream.write(&desc.alg_kind);
+    // Memory descriptors
+    serialize_md(sstream, desc.src_desc);
+    serialize_md(sstream, desc.indices_desc);
+    serialize_md(sstream, desc.offsets_desc);
+    serialize_md(sstream, desc.dst_desc);
+}
+
 void serialize_desc(serialization_stream_t &sstream, const gemm_desc_t &desc) {
     // Kind
     sstream.write(&desc.primitive_kind);
@@ -585,6 +601,25 @@ void serialize_desc(
     serialize_md(sstream, desc.diff_dst_desc);
     // Axis
     sstream.write(&desc.softmax_axis);
+    // Flags
+    sstream.write(&desc.flags);
+    sstream.write(&desc.num_candidates);
+}
+
+// Softmax merge
+void serialize_desc(
+        serialization_stream_t &sstream, const softmax_merge_desc_t &desc) {
+    // Kinds
+    sstream.write(&desc.primitive_kind);
+    sstream.write(&desc.prop_kind);
+    // Memory descriptors
+    serialize_md(sstream, desc.src_desc);
+    serialize_md(sstream, desc.lse_desc);
+    serialize_md(sstream, desc.dst_desc);
+    // Axis
+    sstream.write(&desc.axis);
+    // Flags
+    sstream.write(&desc.flags);
 }
 
 void serialize_desc(serialization_stream_t &sstream, const sum_desc_t &desc) {
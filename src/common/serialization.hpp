@@ -40,6 +40,8 @@ void serialize_desc(
         serialization_stream_t &sstream, const convolution_desc_t &desc);
 void serialize_desc(
         serialization_stream_t &sstream, const eltwise_desc_t &desc);
+void serialize_desc(
+        serialization_stream_t &sstream, const embedding_bag_desc_t &desc);
 void serialize_desc(serialization_stream_t &sstream, const gemm_desc_t &desc);
 void serialize_desc(serialization_stream_t &sstream,
         const group_normalization_desc_t &desc);
@@ -64,6 +66,8 @@ void serialize_desc(
         serialization_stream_t &sstream, const shuffle_desc_t &desc);
 void serialize_desc(
         serialization_stream_t &sstream, const softmax_desc_t &desc);
+void serialize_desc(
+        serialization_stream_t &sstream, const softmax_merge_desc_t &desc);
 void serialize_desc(serialization_stream_t &sstream, const sum_desc_t &desc);
 
 status_t serialize_desc(
@@ -42,7 +42,8 @@ namespace {
 status_t softmax_desc_init(softmax_desc_t *softmax_desc, prop_kind_t prop_kind,
         alg_kind_t alg_kind, const memory_desc_t *src_desc,
         const memory_desc_t *dst_desc, const memory_desc_t *diff_src_desc,
-        const memory_desc_t *diff_dst_desc, int softmax_axis) {
+        const memory_desc_t *diff_dst_desc, int softmax_axis, unsigned flags,
+        dim_t num_candidates) {
     const bool is_fwd = one_of(prop_kind, forward_training, forward_inference);
     VCHECK_SOFTMAX(!any_null(softmax_desc, dst_desc), VERBOSE_NULL_ARG);
     VCHECK_SOFTMAX(IMPLICATION(is_fwd, src_desc != nullptr), VERBOSE_NULL_ARG);
@@ -53,6 +54,18 @@ status_t softmax_desc_init(softmax_desc_t *softmax_desc, prop_kind_t prop_kind,
             VERBOSE_BAD_ALGORITHM);
     VCHECK_SOFTMAX(0 <= softmax_axis && softmax_axis < dst_desc->ndims,
             VERBOSE_BAD_AXIS);
+
+    const unsigned allowed_flags = softmax_flags::output_stats
+            | softmax_flags::output_candidates;
+    VCHECK_SOFTMAX((flags & ~allowed_flags) == 0, VERBOSE_BAD_FLAGS);
+    VCHECK_SOFTMAX(IMPLICATION(flags != softmax_flags::none, is_fwd),
+            VERBOSE_BAD_FLAGS);
+    const bool with_candidates = flags & softmax_flags::output_candidates;
+    VCHECK_SOFTMAX(IMPLICATION(with_candidates,
+                           0 < num_candidates
+                                   && num_candidates
+                                           <= dst_desc->dims[softmax_axis]),
+            VERBOSE_BAD_PARAM, "num_candidates");
     VCHECK_SOFTMAX(
             IMPLICATION(is_fwd, !memory_desc_wrapper(src_desc).format_any()),
             VERBOSE_UNSUPPORTED_TAG_S, "src");
@@ -85,6 +98,8 @@ status_t softmax_desc_init(softmax_desc_t *softmax_desc, prop_kind_t prop_kind,
     sd.alg_kind = alg_kind;
     sd.dst_desc = *dst_desc;
     if (!is_fwd) sd.diff_dst_desc = *diff_dst_desc;
+    sd.flags = flags;
+    sd.num_candidates = with_candidates ? num_candidates : 0;
 
     *softmax_desc = sd;
     return success;
@@ -142,12 +157,22 @@ status_t dnnl_softmax_forward_primitive_desc_create(
         prop_kind_t prop_kind, alg_kind_t alg_kind,
         const memory_desc_t *src_desc, const memory_desc_t *dst_desc, int axis,
         const primitive_attr_t *attr) {
+    return dnnl_softmax_forward_primitive_desc_create_v2(primitive_desc_iface,
+            engine, prop_kind, alg_kind, src_desc, dst_desc, axis,
+            softmax_flags::none, 0, attr);
+}
+
+status_t dnnl_softmax_forward_primitive_desc_create_v2(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        prop_kind_t prop_kind, alg_kind_t alg_kind,
+        const memory_desc_t *src_desc, const memory_desc_t *dst_desc, int axis,
+        unsigned flags, dim_t num_candidates, const primitive_attr_t *attr) {
     if (!one_of(prop_kind, forward_inference, forward_training))
         return invalid_arguments;
 
     auto softmax_desc = softmax_desc_t();
     CHECK(softmax_desc_init(&softmax_desc, prop_kind, alg_kind, src_desc,
-            dst_desc, nullptr, nullptr, axis));
+            dst_desc, nullptr, nullptr, axis, flags, num_candidates));
     CHECK(softmax_attr_check(softmax_desc, engine, attr));
     return primitive_desc_create(primitive_desc_iface, engine,
             (const op_desc_t *)&softmax_desc, nullptr, attr);
@@ -162,7 +187,8 @@ status_t dnnl_softmax_backward_primitive_desc_create(
 
     auto softmax_desc = softmax_desc_t();
     CHECK(softmax_desc_init(&softmax_desc, prop_kind::backward_data, alg_kind,
-            nullptr, dst_desc, diff_src_desc, diff_dst_desc, axis));
+            nullptr, dst_desc, diff_src_desc, diff_dst_desc, axis,
+            softmax_flags::none, 0));
     CHECK(softmax_attr_check(softmax_desc, engine, attr));
     return primitive_desc_create(primitive_desc_iface, engine,
             (const op_desc_t *)&softmax_desc, hint_fwd_pd, attr);
@@ -0,0 +1,124 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "oneapi/dnnl/dnnl.h"
+#include "opdesc.hpp"
+#include "primitive_desc_iface.hpp"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::utils;
+using namespace dnnl::impl::prop_kind;
+
+#define VCHECK_SM_MERGE(cond, msg, ...) \
+    VCONDCHECK(primitive, create, check, softmax_merge, (cond), \
+            status::invalid_arguments, msg, ##__VA_ARGS__);
+
+#define VCHECK_SM_MERGE_UNIMPL(cond, msg, ...) \
+    VCONDCHECK(primitive, create, check, softmax_merge, (cond), \
+            status::unimplemented, msg, ##__VA_ARGS__);
+
+namespace dnnl {
+namespace impl {
+
+status_t softmax_merge_desc_init(softmax_merge_desc_t *softmax_merge_desc,
+        prop_kind_t prop_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *lse_desc, const memory_desc_t *dst_desc,
+        int axis, unsigned flags) {
+    VCHECK_SM_MERGE(!any_null(src_desc, lse_desc, dst_desc), VERBOSE_NULL_ARG);
+    VCHECK_SM_MERGE(one_of(prop_kind, forward_training, forward_inference),
+            VERBOSE_BAD_PROPKIND);
+    VCHECK_SM_MERGE((flags & ~softmax_flags::output_stats) == 0,
+            VERBOSE_BAD_FLAGS);
+
+    const int ndims = src_desc->ndims;
+    VCHECK_SM_MERGE(0 <= axis && axis < ndims, VERBOSE_BAD_AXIS);
+    VCHECK_SM_MERGE(lse_desc->ndims == ndims, VERBOSE_INCONSISTENT_NDIMS,
+            "src", "lse");
+    VCHECK_SM_MERGE(dst_desc->ndims == ndims, VERBOSE_INCONSISTENT_NDIMS,
+            "src", "dst");
+
+    const dim_t nchunks = src_desc->dims[axis];
+    VCHECK_SM_MERGE(lse_desc->dims[axis] == nchunks, VERBOSE_INCONSISTENT_DIM,
+            "lse", axis, "src", axis);
+    VCHECK_SM_MERGE(one_of(dst_desc->dims[axis], nchunks, 1),
+            VERBOSE_INCONSISTENT_DIM, "dst", axis, "src", axis);
+
+    // lse matches src except for a trailing group of dimensions after the
+    // axis which are set to one, lse values are broadcast along them.
+    bool lse_bcast = false;
+    for (int d = 0; d < ndims; ++d) {
+        if (d != axis)
+            VCHECK_SM_MERGE(dst_desc->dims[d] == src_desc->dims[d],
+                    VERBOSE_INCONSISTENT_DIM, "dst", d, "src", d);
+        if (d > axis && lse_desc->dims[d] != src_desc->dims[d])
+            lse_bcast = true;
+        const dim_t lse_dim = lse_bcast ? 1 : src_desc->dims[d];
+        VCHECK_SM_MERGE(lse_desc->dims[d] == lse_dim, VERBOSE_INCONSISTENT_DIM,
+                "lse", d, "src", d);
+    }
+
+    VCHECK_SM_MERGE(lse_desc->data_type == data_type::f32,
+            VERBOSE_INVALID_DATATYPE, "lse");
+
+    VCHECK_SM_MERGE(!memory_desc_wrapper(src_desc).format_any(),
+            VERBOSE_UNSUPPORTED_TAG_S, "src");
+    VCHECK_SM_MERGE(!memory_desc_wrapper(lse_desc).format_any(),
+            VERBOSE_UNSUPPORTED_TAG_S, "lse");
+
+    const bool runtime_dims_or_strides
+            = memory_desc_wrapper(src_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(lse_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(dst_desc).has_runtime_dims_or_strides();
+    VCHECK_SM_MERGE_UNIMPL(
+            !runtime_dims_or_strides, VERBOSE_RUNTIMEDIM_UNSUPPORTED);
+
+    auto md = softmax_merge_desc_t();
+    md.primitive_kind = primitive_kind::softmax_merge;
+    md.prop_kind = prop_kind;
+    md.src_desc = *src_desc;
+    md.lse_desc = *lse_desc;
+    md.dst_desc = *dst_desc;
+    md.axis = axis;
+    md.flags = flags;
+
+    (*softmax_merge_desc) = md;
+    return success;
+}
+
+} // namespace impl
+} // namespace dnnl
+
+dnnl_status_t dnnl_softmax_merge_forward_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        prop_kind_t prop_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *lse_desc, const memory_desc_t *dst_desc, int axis,
+        unsigned flags, const primitive_attr_t *attr) {
+    if (!one_of(prop_kind, forward_training, forward_inference))
+        return invalid_arguments;
+
+    auto softmax_merge_desc = softmax_merge_desc_t();
+    CHECK(softmax_merge_desc_init(&softmax_merge_desc, prop_kind, src_desc,
+            lse_desc, dst_desc, axis, flags));
+    VCHECK_SM_MERGE_UNIMPL(attr == nullptr || attr->has_default_values(),
+            VERBOSE_UNSUPPORTED_ATTR);
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&softmax_merge_desc, nullptr, attr);
+}
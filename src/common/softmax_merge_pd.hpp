@@ -0,0 +1,182 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_SOFTMAX_MERGE_PD_HPP
+#define COMMON_SOFTMAX_MERGE_PD_HPP
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "utils.hpp"
+
+#define VDISPATCH_SOFTMAX_MERGE(cond, msg, ...) \
+    VCONDCHECK(primitive, create, dispatch, softmax_merge, (cond), \
+            status::unimplemented, "%s," msg, this->info(engine), \
+            ##__VA_ARGS__)
+
+#define VDISPATCH_SOFTMAX_MERGE_SC(f, msg, ...) \
+    VCHECK(primitive, create, dispatch, softmax_merge, (f), "%s," msg, \
+            this->info(engine), ##__VA_ARGS__)
+
+namespace dnnl {
+namespace impl {
+
+status_t softmax_merge_desc_init(softmax_merge_desc_t *softmax_merge_desc,
+        prop_kind_t prop_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *lse_desc, const memory_desc_t *dst_desc,
+        int axis, unsigned flags);
+
+struct softmax_merge_fwd_pd_t;
+
+struct softmax_merge_pd_t : public primitive_desc_t {
+    static constexpr auto base_pkind = primitive_kind::softmax_merge;
+
+    const softmax_merge_desc_t *desc() const { return &desc_; }
+    const op_desc_t *op_desc() const override {
+        return reinterpret_cast<const op_desc_t *>(this->desc());
+    }
+
+    status_t query(query_t what, int idx, void *result) const override {
+        switch (what) {
+            case query::prop_kind:
+                *(prop_kind_t *)result = desc()->prop_kind;
+                break;
+            case query::axis_s32: *(int *)result = desc()->axis; break;
+            case query::flags: *(unsigned *)result = desc()->flags; break;
+            default: return primitive_desc_t::query(what, idx, result);
+        }
+        return status::success;
+    }
+
+    /* common softmax_merge aux functions */
+
+    int ndims() const { return desc_.src_desc.ndims; }
+    int axis() const { return desc_.axis; }
+    dim_t nchunks() const { return desc_.src_desc.dims[axis()]; }
+    dim_t outer_size() const {
+        return utils::array_product(desc_.src_desc.dims, axis());
+    }
+    dim_t inner_size() const {
+        return utils::array_product(
+                desc_.src_desc.dims + axis() + 1, ndims() - axis() - 1);
+    }
+    // Number of distinct lse values per chunk inside an inner block.
+    dim_t lse_inner_size() const {
+        return utils::array_product(
+                desc_.lse_desc.dims + axis() + 1, ndims() - axis() - 1);
+    }
+
+    // The destination keeps one slice per chunk when chunks are rescaled only
+    // and a single slice when the rescaled chunks are summed up.
+    bool is_sum() const { return desc_.dst_desc.dims[axis()] == 1; }
+    bool with_stats() const {
+        return desc_.flags & softmax_flags::output_stats;
+    }
+
+    bool has_zero_dim_memory() const {
+        return memory_desc_wrapper(desc_.src_desc).has_zero_dim();
+    }
+
+protected:
+    softmax_merge_desc_t desc_;
+
+    softmax_merge_pd_t(const softmax_merge_desc_t *adesc,
+            const primitive_attr_t *attr, const softmax_merge_fwd_pd_t *)
+        : primitive_desc_t(attr, base_pkind), desc_(*adesc) {}
+};
+
+struct softmax_merge_fwd_pd_t : public softmax_merge_pd_t {
+    typedef softmax_merge_fwd_pd_t base_class;
+    typedef softmax_merge_fwd_pd_t hint_class;
+
+    arg_usage_t arg_usage(int arg) const override {
+        if (utils::one_of(arg, DNNL_ARG_SRC, DNNL_ARG_SRC_1))
+            return arg_usage_t::input;
+        if (arg == DNNL_ARG_DST) return arg_usage_t::output;
+        if (arg == DNNL_ARG_DST_2 && with_stats()) return arg_usage_t::output;
+        return primitive_desc_t::arg_usage(arg);
+    }
+
+    const memory_desc_t *arg_md(
+            int arg, bool user_input = false) const override {
+        switch (arg) {
+            case DNNL_ARG_SRC: return src_md(0);
+            case DNNL_ARG_SRC_1: return src_md(1);
+            case DNNL_ARG_DST: return dst_md(0, user_input);
+            case DNNL_ARG_DST_2: return dst_md(2);
+            default: return softmax_merge_pd_t::arg_md(arg);
+        }
+    }
+
+    const memory_desc_t *src_md(
+            int index = 0, bool user_input = false) const override {
+        switch (index) {
+            case 0: return user_input ? &desc()->src_desc : &src_md_;
+            case 1: return user_input ? &desc()->lse_desc : &lse_md_;
+            default: return &glob_zero_md;
+        }
+    }
+    const memory_desc_t *dst_md(
+            int index = 0, bool user_input = false) const override {
+        if (index == 0) return user_input ? &desc()->dst_desc : &dst_md_;
+        if (index == 2 && with_stats()) return &stat_md_;
+        return &glob_zero_md;
+    }
+
+    int n_inputs() const override { return 2; }
+    int n_outputs() const override { return 1 + with_stats(); }
+
+protected:
+    memory_desc_t src_md_;
+    memory_desc_t lse_md_;
+    memory_desc_t dst_md_;
+    memory_desc_t stat_md_;
+
+    softmax_merge_fwd_pd_t(const softmax_merge_desc_t *adesc,
+            const primitive_attr_t *attr,
+            const softmax_merge_fwd_pd_t *hint_fwd_pd)
+        : softmax_merge_pd_t(adesc, attr, hint_fwd_pd)
+        , src_md_(desc_.src_desc)
+        , lse_md_(desc_.lse_desc)
+        , dst_md_(desc_.dst_desc)
+        , stat_md_(glob_zero_md) {}
+
+    // The destination defaults to the plain layout. The merged log-sum-exp
+    // has the dimensions of lse with the chunk axis reduced and is plain.
+    status_t set_default_formats() {
+        using namespace format_tag;
+        const auto abx = utils::pick(
+                ndims() - 1, a, ab, abc, abcd, abcde, abcdef);
+        if (dst_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(dst_md_, abx));
+        if (with_stats()) {
+            dims_t dims;
+            utils::array_copy(dims, desc_.lse_desc.dims, ndims());
+            dims[axis()] = 1;
+            CHECK(memory_desc_init_by_tag(
+                    stat_md_, ndims(), dims, data_type::f32, abx));
+        }
+        return status::success;
+    }
+};
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -17,6 +17,8 @@
 #ifndef COMMON_SOFTMAX_PD_HPP
 #define COMMON_SOFTMAX_PD_HPP
 
+#include <algorithm>
+
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
@@ -56,6 +58,7 @@ struct softmax_pd_t : public primitive_desc_t {
                 *(alg_kind_t *)result = desc()->alg_kind;
                 break;
             case query::axis_s32: *(int *)result = desc()->softmax_axis; break;
+            case query::flags: *(uint32_t *)result = desc()->flags; break;
             default: return primitive_desc_t::query(what, idx, result);
         }
         return status::success;
@@ -102,6 +105,14 @@ struct softmax_pd_t : public primitive_desc_t {
     bool is_softmax() const { return alg_kind() == alg_kind::softmax_accurate; }
     bool is_logsoftmax() const { return alg_kind() == alg_kind::softmax_log; }
 
+    bool with_stats() const {
+        return desc_.flags & softmax_flags::output_stats;
+    }
+    bool with_candidates() const {
+        return desc_.flags & softmax_flags::output_candidates;
+    }
+    dim_t num_candidates() const { return desc_.num_candidates; }
+
 protected:
     softmax_desc_t desc_;
     const softmax_fwd_pd_t *hint_fwd_pd_;
@@ -128,6 +139,12 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
 
         if (arg == DNNL_ARG_DST) return arg_usage_t::output;
 
+        if (utils::one_of(arg, DNNL_ARG_DST_1, DNNL_ARG_DST_2) && with_stats())
+            return arg_usage_t::output;
+
+        if (arg == DNNL_ARG_DST_3 && with_candidates())
+            return arg_usage_t::output;
+
         if (arg == DNNL_ARG_WORKSPACE && (!types::is_zero_md(workspace_md())))
             return arg_usage_t::output;
 
@@ -139,6 +156,9 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
         switch (arg) {
             case DNNL_ARG_SRC: return src_md(0);
             case DNNL_ARG_DST: return dst_md(0, user_input);
+            case DNNL_ARG_DST_1: return dst_md(1);
+            case DNNL_ARG_DST_2: return dst_md(2);
+            case DNNL_ARG_DST_3: return dst_md(3);
             default: return softmax_pd_t::arg_md(arg);
         }
     }
@@ -151,29 +171,43 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
     const memory_desc_t *dst_md(
             int index = 0, bool user_input = false) const override {
         if (index == 0) return user_input ? &desc()->dst_desc : &dst_md_;
+        if (utils::one_of(index, 1, 2) && with_stats()) return &stat_md_;
+        if (index == 3 && with_candidates()) return &candidates_md_;
         return &glob_zero_md;
     }
 
     int n_inputs() const override { return 1 + n_binary_po_inputs(); }
     int n_outputs() const override {
-        return 1 + (!types::is_zero_md(workspace_md()));
+        return 1 + 2 * with_stats() + with_candidates()
+                + (!types::is_zero_md(workspace_md()));
     }
 
 protected:
     memory_desc_t src_md_;
+    memory_desc_t stat_md_;
+    memory_desc_t candidates_md_;
 
     softmax_fwd_pd_t(const softmax_desc_t *adesc, const primitive_attr_t *attr,
             const softmax_fwd_pd_t *hint_fwd_pd)
-        : softmax_pd_t(adesc, attr, hint_fwd_pd), src_md_(desc_.src_desc) {}
+        : softmax_pd_t(adesc, attr, hint_fwd_pd)
+        , src_md_(desc_.src_desc)
+        , stat_md_(glob_zero_md)
+        , candidates_md_(glob_zero_md) {}
 
     status_t set_default_formats() {
-        if (dst_md()->format_kind != format_kind::any) return status::success;
+        if (dst_md()->format_kind == format_kind::any) {
+            if (src_md()->format_kind != format_kind::blocked)
+                return status::unimplemented;
 
-        if (src_md()->format_kind != format_kind::blocked)
-            return status::unimplemented;
+            CHECK(memory_desc_init_by_blocking_desc(
+                    dst_md_, src_md_.format_desc.blocking));
+        }
 
-        return memory_desc_init_by_blocking_desc(
-                dst_md_, src_md_.format_desc.blocking);
+        if (with_stats()) CHECK(init_row_md(stat_md_, 1, data_type::f32));
+        if (with_candidates())
+            CHECK(init_row_md(
+                    candidates_md_, num_candidates(), data_type::s32));
+        return status::success;
     }
 
     bool attr_scales_ok() const {
@@ -184,6 +218,35 @@ protected:
         }
         return ok;
     }
+
+private:
+    // Per-row outputs are dense and keep the order of dimensions of dst, so
+    // for a dst with the softmax axis innermost the rows of dst and of these
+    // outputs follow each other in the same order.
+    status_t init_row_md(
+            memory_desc_t &md, dim_t axis_dim, data_type_t dt) const {
+        const memory_desc_wrapper dst_d(dst_md());
+        if (!dst_d.is_blocking_desc()) return status::unimplemented;
+
+        const int nd = ndims();
+        const auto &dst_strides = dst_d.blocking_desc().strides;
+        int perm[DNNL_MAX_NDIMS];
+        for (int d = 0; d < nd; ++d)
+            perm[d] = d;
+        std::stable_sort(perm, perm + nd, [&](int a, int b) {
+            return dst_strides[a] > dst_strides[b];
+        });
+
+        dims_t dims, strides;
+        utils::array_copy(dims, dst_md()->dims, nd);
+        dims[axis()] = axis_dim;
+        dim_t stride = 1;
+        for (int i = nd - 1; i >= 0; --i) {
+            strides[perm[i]] = stride;
+            stride *= dims[perm[i]];
+        }
+        return memory_desc_init_by_strides(md, nd, dims, dt, strides);
+    }
 };
 
 struct softmax_bwd_pd_t : public softmax_pd_t {
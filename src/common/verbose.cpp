@@ -41,6 +41,7 @@
 #include "convolution_pd.hpp"
 #include "deconvolution_pd.hpp"
 #include "eltwise_pd.hpp"
+#include "embedding_bag_pd.hpp"
 #include "gemm_pd.hpp"
 #include "group_normalization_pd.hpp"
 #include "inner_product_pd.hpp"
@@ -54,6 +55,7 @@
 #include "resampling_pd.hpp"
 #include "rnn_pd.hpp"
 #include "shuffle_pd.hpp"
+#include "softmax_merge_pd.hpp"
 #include "softmax_pd.hpp"
 #include "sum_pd.hpp"
 
@@ -233,6 +235,8 @@ uint32_t get_verbose(verbose_t::flag_kind verbosity_kind,
                 REGEX_SEARCH(k, graph, regexp, filter_status);
                 REGEX_SEARCH(k, gemm_api, regexp, filter_status);
                 REGEX_SEARCH(k, ukernel, regexp, filter_status);
+                REGEX_SEARCH(k, embedding_bag, regexp, filter_status);
+                REGEX_SEARCH(k, softmax_merge, regexp, filter_status);
 #undef REGEX_SEARCH
             } catch (const std::exception &e) {
                 filter_status.status = filter_status_t::flags::invalid;
@@ -392,6 +396,13 @@ std::string rnn_flags2str(unsigned flags) {
     return s;
 }
 
+std::string softmax_flags2str(unsigned flags) {
+    std::string s;
+    if (flags & softmax_flags::output_stats) s += "S";
+    if (flags & softmax_flags::output_candidates) s += "C";
+    return s;
+}
+
 std::ostream &operator<<(std::ostream &ss, const memory_extra_desc_t &extra) {
     using namespace memory_extra_flags;
 
@@ -1308,6 +1319,33 @@ std::string init_info_prelu(const engine_t *e, const pd_t *pd) {
     return ss.str();
 }
 
+template <typename pd_t>
+std::string init_info_embedding_bag(const engine_t *e, const pd_t *pd) {
+    std::stringstream ss;
+    ss << e << "," << pd->kind() << "," << pd->name() << ","
+       << pd->desc()->prop_kind << ",";
+
+    auto src_md = pd->invariant_src_md();
+    auto idx_md = pd->invariant_src_md(1);
+    auto off_md = pd->invariant_src_md(2);
+    auto dst_md = pd->invariant_dst_md();
+
+    ss << md2fmt_str("src", src_md, pd->invariant_src_user_format_kind())
+       << " ";
+    ss << md2fmt_str("idx", idx_md, pd->invariant_src_user_format_kind(1))
+       << " ";
+    ss << md2fmt_str("off", off_md, pd->invariant_src_user_format_kind(2))
+       << " ";
+    ss << md2fmt_str("dst", dst_md, pd->invariant_dst_user_format_kind());
+
+    ss << "," << pd->attr() << ",";
+    ss << "alg:" << pd->desc()->alg_kind << ",";
+    ss << "rows:" << pd->rows() << " dim:" << pd->dim()
+       << " indices:" << pd->num_indices() << " bags:" << pd->num_bags();
+
+    return ss.str();
+}
+
 template <typename pd_t>
 std::string init_info_reduction(const engine_t *e, const pd_t *pd) {
     std::stringstream ss;
@@ -1320,6 +1358,8 @@ std::string init_info_reduction(const engine_t *e, const pd_t *pd) {
     ss << md2fmt_str("src", src_md, pd->invariant_src_user_format_kind())
        << " ";
     ss << md2fmt_str("dst", dst_md, pd->invariant_dst_user_format_kind());
+    if (pd->is_index_alg())
+        ss << " " << md2fmt_str("idx", pd->dst_md(1), format_kind::undef);
 
     ss << "," << pd->attr() << ",";
     ss << "alg:" << pd->desc()->alg_kind << " p:" << pd->desc()->p
@@ -1530,12 +1570,41 @@ std::string init_info_softmax(const engine_t *e, const pd_t *pd) {
     }
 
     ss << "," << pd->attr() << ",";
-    ss << "alg:" << pd->alg_kind() << " axis:" << pd->axis() << ",";
+    ss << "alg:" << pd->alg_kind() << " axis:" << pd->axis();
+    if (pd->desc()->flags != softmax_flags::none)
+        ss << " flags:" << softmax_flags2str(pd->desc()->flags);
+    if (pd->with_candidates()) ss << " candidates:" << pd->num_candidates();
+    ss << ",";
     ss << md2dim_str(src_md);
 
     return ss.str();
 }
 
+template <typename pd_t>
+std::string init_info_softmax_merge(const engine_t *e, const pd_t *pd) {
+    std::stringstream ss;
+    ss << e << "," << pd->kind() << "," << pd->name() << ","
+       << pd->desc()->prop_kind << ",";
+
+    auto src_md = pd->invariant_src_md();
+    auto lse_md = pd->invariant_src_md(1);
+    auto dst_md = pd->invariant_dst_md();
+
+    ss << md2fmt_str("src", src_md, pd->invariant_src_user_format_kind())
+       << " ";
+    ss << md2fmt_str("lse", lse_md, pd->invariant_src_user_format_kind(1))
+       << " ";
+    ss << md2fmt_str("dst", dst_md, pd->invariant_dst_user_format_kind());
+
+    ss << "," << pd->attr() << ",";
+    ss << "axis:" << pd->axis();
+    if (pd->desc()->flags)
+        ss << " flags:" << softmax_flags2str(pd->desc()->flags);
+    ss << "," << md2dim_str(src_md) << ":" << md2dim_str(dst_md);
+
+    return ss.str();
+}
+
 template <typename pd_t>
 std::string init_info_sum(const engine_t *e, const pd_t *pd) {
     std::stringstream ss;
@@ -1581,6 +1650,7 @@ std::string rt_mds2str(primitive_kind_t prim_kind, const memory_desc_t *src_md,
         case primitive_kind::convolution:
         case primitive_kind::deconvolution:
         case primitive_kind::eltwise:
+        case primitive_kind::embedding_bag:
         case primitive_kind::inner_product:
         case primitive_kind::layer_normalization:
         case primitive_kind::lrn:
@@ -1591,6 +1661,7 @@ std::string rt_mds2str(primitive_kind_t prim_kind, const memory_desc_t *src_md,
         case primitive_kind::rnn:
         case primitive_kind::shuffle:
         case primitive_kind::softmax:
+        case primitive_kind::softmax_merge:
         case primitive_kind::sum: assert(!"unsupported primitive kind"); break;
         default: assert(!"unknown primitive kind");
     }
@@ -1644,6 +1715,7 @@ std::string rt_dims2fmt_str(primitive_kind_t prim_kind,
         case primitive_kind::convolution:
         case primitive_kind::deconvolution:
         case primitive_kind::eltwise:
+        case primitive_kind::embedding_bag:
         case primitive_kind::inner_product:
         case primitive_kind::layer_normalization:
         case primitive_kind::lrn:
@@ -1654,6 +1726,7 @@ std::string rt_dims2fmt_str(primitive_kind_t prim_kind,
         case primitive_kind::rnn:
         case primitive_kind::shuffle:
         case primitive_kind::softmax:
+        case primitive_kind::softmax_merge:
         case primitive_kind::sum: assert(!"unsupported primitive kind"); break;
         default: assert(!"unknown primitive kind");
     }
@@ -1677,6 +1750,8 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
             CASE(convolution);
             CASE(deconvolution);
             CASE(eltwise);
+            CASE(embedding_bag);
+            CASE(softmax_merge);
             CASE(gemm);
             CASE(group_normalization);
             CASE(inner_product);
@@ -191,6 +191,9 @@ struct component_t {
         graph = 1 << 22,
         gemm_api = 1 << 23,
         ukernel = 1 << 24,
+        // primitive kinds added after the non-primitive components above
+        embedding_bag = 1 << 25,
+        softmax_merge = 1 << 26,
         all = (uint32_t)-1,
     };
 };
@@ -210,6 +213,12 @@ struct filter_status_t {
 
 inline component_t::flag_kind prim_kind2_comp_kind(
         const primitive_kind_t prim_kind) {
+    if (prim_kind == primitive_kind::embedding_bag)
+        return static_cast<component_t::flag_kind>(
+                component_t::embedding_bag | component_t::primitive);
+    if (prim_kind == primitive_kind::softmax_merge)
+        return static_cast<component_t::flag_kind>(
+                component_t::softmax_merge | component_t::primitive);
     return static_cast<component_t::flag_kind>(1 << prim_kind | 1 << 0);
 }
 
@@ -93,7 +93,7 @@ struct acl_softmax_fwd_t : public primitive_t {
 
         status_t init(engine_t *engine) {
 
-            bool ok = is_fwd()
+            bool ok = is_fwd() && !with_stats() && !with_candidates()
                     && set_default_formats() == status::success
                     // ACL only supports matching src/dst (this must come after
                     // set_default_formats() to handle format_kind::any)
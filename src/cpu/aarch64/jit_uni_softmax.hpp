@@ -74,6 +74,7 @@ struct jit_uni_softmax_fwd_t : public primitive_t {
             const auto src_dt = src_md()->data_type;
             const auto dst_dt = dst_md()->data_type;
             bool ok = mayiuse(isa) && is_fwd() && !has_zero_dim_memory()
+                    && !with_stats() && !with_candidates()
                     && utils::one_of(src_dt, f32, bf16, s8, u8)
                     && utils::one_of(dst_dt, f32, bf16, s8, u8)
                     && IMPLICATION(
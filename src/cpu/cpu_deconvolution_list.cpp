@@ -19,6 +19,7 @@
 #include "cpu/cpu_engine.hpp"
 
 #include "cpu/ref_deconvolution.hpp"
+#include "cpu/subpixel_deconvolution.hpp"
 
 #if DNNL_X64
 #include "cpu/x64/jit_avx512_core_amx_deconvolution.hpp"
@@ -66,6 +67,7 @@ const std::map<pk_impl_key_t, std::vector<impl_list_item_t>> &impl_list_map() {
             CPU_INSTANCE_SSE41(jit_uni_x8s8s32x_deconvolution_fwd_t<sse41>)
             CPU_INSTANCE_AARCH64(jit_sve_512_core_x8s8s32x_deconvolution_fwd_t)
             CPU_INSTANCE_AARCH64_ACL(acl_deconvolution_fwd_t)
+            CPU_INSTANCE(subpixel_deconvolution_fwd_t)
             CPU_INSTANCE(ref_deconvolution_fwd_t)
             nullptr,
         }},
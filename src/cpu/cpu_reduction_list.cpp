@@ -17,6 +17,7 @@
 #include "cpu/cpu_engine.hpp"
 
 #include "cpu/ref_reduction.hpp"
+#include "cpu/simple_reduction_topk.hpp"
 
 #if DNNL_X64
 #include "cpu/x64/jit_uni_reduction.hpp"
@@ -33,6 +34,7 @@ using namespace dnnl::impl::data_type;
 // clang-format off
 constexpr impl_list_item_t impl_list[] = REG_REDUCTION_P({
     CPU_INSTANCE_X64(jit_uni_reduction_t)
+    CPU_INSTANCE(simple_reduction_topk_t)
 
     CPU_INSTANCE(ref_reduction_t<f32, f32, f32>)
     CPU_INSTANCE(ref_reduction_t<bf16, bf16, f32>)
@@ -0,0 +1,634 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <cstring>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/platform.hpp"
+
+#include "cpu/fft_convolution.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+using namespace dnnl::impl::data_type;
+using namespace dnnl::impl::format_tag;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+namespace {
+constexpr dim_t simd_w = 16;
+
+// Returns the power of two FFT size that minimizes the transform work for
+// `o` outputs of a kernel spanning `k` points.
+dim_t pick_fft_size(dim_t k, dim_t o, dim_t min_size) {
+    const dim_t max_size = rnd_up_pow2(o + k - 1);
+    dim_t best_size = nstl::max(rnd_up_pow2(k), min_size);
+    double best_cost = 0;
+    for (dim_t n = best_size; n <= nstl::max(max_size, best_size); n *= 2) {
+        const dim_t nb_tiles = div_up(o, n - k + 1);
+        const double cost = (double)nb_tiles * n * (std::log2((double)n) + 1);
+        if (n == best_size || cost < best_cost) {
+            best_size = n;
+            best_cost = cost;
+        }
+    }
+    return best_size;
+}
+
+// In-place radix-2 FFT of `n` complex vectors of `len` channels each. Real
+// and imaginary parts are kept in separate planes and consecutive points
+// are `stride` floats apart. `tw_step` is the ratio between the size of
+// the twiddle table and `n`. The inverse transform is not scaled.
+void fft_c2c(float *re, float *im, dim_t n, dim_t stride, dim_t len,
+        const float *tw_re, const float *tw_im, dim_t tw_step, bool inverse) {
+    for (dim_t i = 1, j = 0; i < n; i++) {
+        dim_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i >= j) continue;
+        float *ar = re + i * stride, *ai = im + i * stride;
+        float *br = re + j * stride, *bi = im + j * stride;
+        PRAGMA_OMP_SIMD()
+        for (dim_t c = 0; c < len; c++) {
+            nstl::swap(ar[c], br[c]);
+            nstl::swap(ai[c], bi[c]);
+        }
+    }
+
+    const float sign = inverse ? -1.f : 1.f;
+    for (dim_t half = 1; half < n; half *= 2) {
+        const dim_t step = tw_step * n / (2 * half);
+        for (dim_t k = 0; k < half; k++) {
+            const float wr = tw_re[k * step];
+            const float wi = sign * tw_im[k * step];
+            for (dim_t base = k; base < n; base += 2 * half) {
+                float *ur = re + base * stride, *ui = im + base * stride;
+                float *vr = ur + half * stride, *vi = ui + half * stride;
+                PRAGMA_OMP_SIMD()
+                for (dim_t c = 0; c < len; c++) {
+                    const float tr = vr[c] * wr - vi[c] * wi;
+                    const float ti = vr[c] * wi + vi[c] * wr;
+                    vr[c] = ur[c] - tr;
+                    vi[c] = ui[c] - ti;
+                    ur[c] += tr;
+                    ui[c] += ti;
+                }
+            }
+        }
+    }
+}
+
+// Turns the FFT of m = n / 2 points z[j] = x[2j] + i * x[2j + 1] of a real
+// sequence x into the first m + 1 points of the FFT of x. Point m must have
+// room in the buffer.
+void fft_r2c_post(float *re, float *im, dim_t m, dim_t stride, dim_t len,
+        const float *tw_re, const float *tw_im, dim_t tw_step) {
+    float *r0 = re, *i0 = im;
+    float *rm = re + m * stride, *im_ = im + m * stride;
+    PRAGMA_OMP_SIMD()
+    for (dim_t c = 0; c < len; c++) {
+        const float zr = r0[c], zi = i0[c];
+        r0[c] = zr + zi;
+        i0[c] = 0.f;
+        rm[c] = zr - zi;
+        im_[c] = 0.f;
+    }
+
+    for (dim_t k = 1; 2 * k <= m; k++) {
+        const float wr = tw_re[k * tw_step], wi = tw_im[k * tw_step];
+        float *pr = re + k * stride, *pi = im + k * stride;
+        float *qr = re + (m - k) * stride, *qi = im + (m - k) * stride;
+        PRAGMA_OMP_SIMD()
+        for (dim_t c = 0; c < len; c++) {
+            // Even and odd halves of x, the odd one rotated by the twiddle.
+            const float er = 0.5f * (pr[c] + qr[c]);
+            const float ei = 0.5f * (pi[c] - qi[c]);
+            const float or_ = 0.5f * (pi[c] + qi[c]);
+            const float oi = 0.5f * (qr[c] - pr[c]);
+            const float tr = wr * or_ - wi * oi;
+            const float ti = wr * oi + wi * or_;
+            pr[c] = er + tr;
+            pi[c] = ei + ti;
+            qr[c] = er - tr;
+            qi[c] = ti - ei;
+        }
+    }
+}
+
+// Inverse of fft_r2c_post: packs m + 1 points of the FFT of a real sequence
+// x into m points whose inverse FFT is n * (x[2j] + i * x[2j + 1]).
+void fft_c2r_pre(float *re, float *im, dim_t m, dim_t stride, dim_t len,
+        const float *tw_re, const float *tw_im, dim_t tw_step) {
+    float *r0 = re, *i0 = im;
+    const float *rm = re + m * stride, *im_ = im + m * stride;
+    PRAGMA_OMP_SIMD()
+    for (dim_t c = 0; c < len; c++) {
+        const float er = r0[c] + rm[c], ei = i0[c] - im_[c];
+        const float or_ = r0[c] - rm[c], oi = i0[c] + im_[c];
+        r0[c] = er - oi;
+        i0[c] = ei + or_;
+    }
+
+    for (dim_t k = 1; 2 * k <= m; k++) {
+        const float wr = tw_re[k * tw_step], wi = tw_im[k * tw_step];
+        float *pr = re + k * stride, *pi = im + k * stride;
+        float *qr = re + (m - k) * stride, *qi = im + (m - k) * stride;
+        const bool is_self = 2 * k == m;
+        PRAGMA_OMP_SIMD()
+        for (dim_t c = 0; c < len; c++) {
+            const float er = pr[c] + qr[c], ei = pi[c] - qi[c];
+            const float dr = pr[c] - qr[c], di = pi[c] + qi[c];
+            const float or_ = dr * wr + di * wi;
+            const float oi = di * wr - dr * wi;
+            pr[c] = er - oi;
+            pi[c] = ei + or_;
+            if (!is_self) {
+                qr[c] = er + oi;
+                qi[c] = or_ - ei;
+            }
+        }
+    }
+}
+} // namespace
+
+bool fft_convolution_fwd_t::pd_t::is_fft_profitable() const {
+    // The FFT path is plain C++ code, so it is only picked automatically for
+    // large kernels when it saves most of the direct convolution work.
+    if (KH() * KW() < 49) return false;
+
+    const dim_t G = with_groups() ? this->G() : 1;
+    const dim_t ICg = IC() / G;
+    const dim_t OCg = OC() / G;
+    const dim_t nb_oc_blocks = is_dw_ ? 1 : div_up(OCg, oc_block_);
+    const double fft_pts = (double)fft_h_ * fft_w_;
+    const double transform = 2.5 * fft_pts * std::log2(fft_pts);
+    const double nb_tiles = (double)MB() * tiles_h_ * tiles_w_;
+    const double fft_ops = nb_tiles
+                    * ((IC() * nb_oc_blocks + OC()) * transform
+                            + 8. * nb_freq_ * G * ICg * OCg)
+            + (double)G * ICg * OCg * transform;
+    const double direct_ops
+            = 2. * MB() * OC() * OH() * OW() * ICg * KH() * KW();
+    return 4 * fft_ops < direct_ops;
+}
+
+status_t fft_convolution_fwd_t::pd_t::init(engine_t *engine) {
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    VDISPATCH_CONV(is_fwd(), VERBOSE_BAD_PROPKIND);
+    VDISPATCH_CONV(utils::one_of(desc()->alg_kind, alg_kind::convolution_fft,
+                           alg_kind::convolution_auto),
+            VERBOSE_BAD_ALGORITHM);
+    VDISPATCH_CONV(
+            expect_data_types(f32, f32, f32, f32, f32), VERBOSE_UNSUPPORTED_DT);
+    VDISPATCH_CONV(!has_zero_dim_memory(), VERBOSE_EMPTY_TENSOR, "");
+    VDISPATCH_CONV(utils::one_of(ndims(), 3, 4), VERBOSE_BAD_NDIMS, "src",
+            ndims());
+    VDISPATCH_CONV(everyone_is(1, KSH(), KSW()), VERBOSE_UNSUPPORTED_FEATURE,
+            "strides");
+    VDISPATCH_CONV(attr()->has_default_values(skip_mask_t::post_ops, f32),
+            VERBOSE_UNSUPPORTED_ATTR);
+    VDISPATCH_CONV(ref_post_ops_t::primitive_kind_ok(attr()->post_ops_)
+                    && attr()->post_ops_.check_sum_consistency(
+                            f32, /* is_int8 */ false),
+            VERBOSE_UNSUPPORTED_POSTOP);
+
+    const bool is_1d = ndims() == 3;
+    const auto dat_tag = is_1d ? nwc : nhwc;
+    const auto wei_tag = with_groups() ? (is_1d ? goiw : goihw)
+                                       : (is_1d ? oiw : oihw);
+    VDISPATCH_CONV(set_default_formats_common(dat_tag, wei_tag, dat_tag),
+            VERBOSE_UNSUPPORTED_TAG);
+    VDISPATCH_CONV(memory_desc_matches_tag(src_md_, dat_tag)
+                    && memory_desc_matches_tag(dst_md_, dat_tag)
+                    && memory_desc_wrapper(weights_md_).is_blocking_desc(),
+            VERBOSE_UNSUPPORTED_TAG);
+    CHECK(attr_.set_default_formats(dst_md(0)));
+
+    const dim_t G = with_groups() ? this->G() : 1;
+    is_dw_ = with_groups() && IC() == G && OC() == G;
+    nthr_ = dnnl_get_max_threads();
+
+    kh_ = (KH() - 1) * (KDH() + 1) + 1;
+    kw_ = (KW() - 1) * (KDW() + 1) + 1;
+    fft_h_ = pick_fft_size(kh_, OH(), 1);
+    fft_w_ = pick_fft_size(kw_, OW(), 2);
+    tile_h_ = fft_h_ - kh_ + 1;
+    tile_w_ = fft_w_ - kw_ + 1;
+    tiles_h_ = div_up(OH(), tile_h_);
+    tiles_w_ = div_up(OW(), tile_w_);
+    nb_freq_ = fft_h_ * (fft_w_ / 2 + 1);
+
+    // Keep the transformed tiles of a thread within half of L2, but always
+    // transform at least a full vector of channels.
+    const dim_t L2 = platform::get_per_core_cache_size(2);
+    const dim_t nb_bufs = is_dw_ ? 1 : 2;
+    const dim_t c_bytes = nb_bufs * 2 * (dim_t)sizeof(float) * nb_freq_;
+    const dim_t c_block = nstl::max(simd_w, rnd_dn(L2 / 2 / c_bytes, simd_w));
+    if (is_dw_) {
+        ic_block_ = nstl::min(c_block, G);
+        // Split channels further when there is not enough work for all
+        // threads.
+        const dim_t nb_tiles = MB() * tiles_h_ * tiles_w_;
+        while (ic_block_ > simd_w && nb_tiles * div_up(G, ic_block_) < nthr_)
+            ic_block_ = rnd_up(ic_block_ / 2, simd_w);
+        oc_block_ = ic_block_;
+    } else {
+        ic_block_ = nstl::min(c_block, IC() / G);
+        oc_block_ = nstl::min(c_block, OC() / G);
+    }
+
+    if (desc()->alg_kind == alg_kind::convolution_auto)
+        VDISPATCH_CONV(is_fft_profitable(), VERBOSE_BAD_ALGORITHM);
+    VDISPATCH_CONV(set_default_alg_kind(alg_kind::convolution_fft),
+            VERBOSE_BAD_ALGORITHM);
+
+    return init_scratchpad(engine);
+}
+
+status_t fft_convolution_fwd_t::pd_t::init_scratchpad(engine_t *engine) {
+    auto scratchpad = scratchpad_registry().registrar();
+    const dim_t G = with_groups() ? this->G() : 1;
+    const dim_t wei_size = is_dw_ ? nb_freq_ * G
+                                  : nb_freq_ * G * (IC() / G) * (OC() / G);
+    const dim_t buf_size = 2 * nb_freq_ * nstl::max(ic_block_, oc_block_);
+
+    // The transformed weights grow with the FFT size rather than with the
+    // kernel size, skip the problems where they dwarf the tensors.
+    const size_t wei_fft_bytes = 2 * wei_size * sizeof(float);
+    const size_t wei_fft_limit = (size_t)64
+            * (memory_desc_wrapper(src_md()).size()
+                    + memory_desc_wrapper(weights_md()).size()
+                    + memory_desc_wrapper(dst_md()).size());
+    VDISPATCH_CONV(wei_fft_bytes <= wei_fft_limit, VERBOSE_SCRATCHPAD_LIMIT);
+
+    scratchpad.template book<float>(key_conv_fft_wei, 2 * wei_size);
+    scratchpad.template book<float>(key_conv_fft_src, nthr_ * buf_size);
+    if (!is_dw_)
+        scratchpad.template book<float>(key_conv_fft_dst, nthr_ * buf_size);
+    return status::success;
+}
+
+status_t fft_convolution_fwd_t::init(engine_t *engine) {
+    const dim_t n = nstl::max(pd()->fft_h_, pd()->fft_w_);
+    const double pi = std::acos(-1.);
+    tw_re_.resize(n / 2);
+    tw_im_.resize(n / 2);
+    for (dim_t j = 0; j < n / 2; j++) {
+        const double phi = 2. * pi * j / n;
+        tw_re_[j] = (float)std::cos(phi);
+        tw_im_[j] = (float)-std::sin(phi);
+    }
+
+    CHECK(safe_ptr_assign(
+            ref_post_ops_, new ref_post_ops_t(pd()->attr()->post_ops_)));
+    CHECK(ref_post_ops_->init(pd()->dst_md()));
+    return status::success;
+}
+
+void fft_convolution_fwd_t::transform_weights(
+        const exec_ctx_t &ctx, float *fft_wei) const {
+    const auto wei = CTX_IN_MEM(const float *, DNNL_ARG_WEIGHTS);
+    const memory_desc_wrapper wei_d(pd()->weights_md(0));
+    const auto scratchpad = ctx.get_scratchpad_grantor();
+    float *fft_buf = scratchpad.template get<float>(key_conv_fft_src);
+
+    const bool is_1d = pd()->ndims() == 3;
+    const bool with_groups = pd()->with_groups();
+    const bool is_dw = pd()->is_dw_;
+    const dim_t G = with_groups ? pd()->G() : 1;
+    const dim_t ICg = pd()->IC() / G;
+    const dim_t OCg = pd()->OC() / G;
+    const dim_t KH = pd()->KH();
+    const dim_t KW = pd()->KW();
+    const dim_t KDH = pd()->KDH();
+    const dim_t KDW = pd()->KDW();
+    const dim_t fft_h = pd()->fft_h_;
+    const dim_t m = pd()->fft_w_ / 2;
+    const dim_t row = m + 1;
+    const dim_t nb_freq = pd()->nb_freq_;
+    const dim_t c_block = pd()->oc_block_;
+    const dim_t cs = nstl::max(pd()->ic_block_, pd()->oc_block_);
+    const dim_t buf_size = 2 * nb_freq * cs;
+    const dim_t wei_size = is_dw ? nb_freq * G : nb_freq * G * ICg * OCg;
+    const dim_t tw_size = 2 * tw_re_.size();
+
+    auto wei_off = [&](dim_t g, dim_t oc, dim_t ic, dim_t kh, dim_t kw) {
+        if (with_groups)
+            return is_1d ? wei_d.off(g, oc, ic, kw)
+                         : wei_d.off(g, oc, ic, kh, kw);
+        return is_1d ? wei_d.off(oc, ic, kw) : wei_d.off(oc, ic, kh, kw);
+    };
+
+    // Depthwise weights are stored as [freq][G], the others as
+    // [G][freq][ICg][OCg], so that the innermost loop of the products runs
+    // over contiguous output channels. Real and imaginary parts are planes
+    // of `wei_size` floats.
+    const dim_t nb_c_blocks = div_up(is_dw ? G : OCg, c_block);
+    const dim_t work_amount = is_dw ? nb_c_blocks : G * ICg * nb_c_blocks;
+    parallel(pd()->nthr_, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(work_amount, nthr, ithr, start, end);
+        if (start >= end) return;
+
+        float *re = fft_buf + ithr * buf_size;
+        float *im = re + nb_freq * cs;
+        dim_t g {0}, ic {0}, cb {0};
+        nd_iterator_init(start, g, is_dw ? 1 : G, ic, is_dw ? 1 : ICg, cb,
+                nb_c_blocks);
+        for (dim_t iwork = start; iwork < end; iwork++) {
+            const dim_t c0 = cb * c_block;
+            const dim_t len = nstl::min(c_block, (is_dw ? G : OCg) - c0);
+
+            std::memset(re, 0, buf_size * sizeof(float));
+            for_(dim_t kh = 0; kh < KH; kh++)
+            for (dim_t kw = 0; kw < KW; kw++) {
+                const dim_t h = kh * (KDH + 1);
+                const dim_t w = kw * (KDW + 1);
+                float *v = (w % 2 ? im : re) + (h * row + w / 2) * cs;
+                for (dim_t c = 0; c < len; c++)
+                    v[c] = is_dw ? wei[wei_off(c0 + c, 0, 0, kh, kw)]
+                                 : wei[wei_off(g, c0 + c, ic, kh, kw)];
+            }
+
+            for (dim_t h = 0; h < pd()->kh_; h += KDH + 1) {
+                float *row_re = re + h * row * cs, *row_im = im + h * row * cs;
+                fft_c2c(row_re, row_im, m, cs, len, tw_re_.data(),
+                        tw_im_.data(), tw_size / m, false);
+                fft_r2c_post(row_re, row_im, m, cs, len, tw_re_.data(),
+                        tw_im_.data(), tw_size / (2 * m));
+            }
+            if (fft_h > 1)
+                for (dim_t w = 0; w < row; w++)
+                    fft_c2c(re + w * cs, im + w * cs, fft_h, row * cs, len,
+                            tw_re_.data(), tw_im_.data(), tw_size / fft_h,
+                            false);
+
+            for (dim_t f = 0; f < nb_freq; f++) {
+                const dim_t off = is_dw ? f * G + c0
+                                        : ((g * nb_freq + f) * ICg + ic) * OCg
+                                + c0;
+                for (dim_t c = 0; c < len; c++) {
+                    fft_wei[off + c] = re[f * cs + c];
+                    fft_wei[wei_size + off + c] = im[f * cs + c];
+                }
+            }
+            nd_iterator_step(g, is_dw ? 1 : G, ic, is_dw ? 1 : ICg, cb,
+                    nb_c_blocks);
+        }
+    });
+}
+
+status_t fft_convolution_fwd_t::execute(const exec_ctx_t &ctx) const {
+    const auto src = CTX_IN_MEM(const float *, DNNL_ARG_SRC);
+    const auto bias = CTX_IN_MEM(const float *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(float *, DNNL_ARG_DST);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+
+    const auto scratchpad = ctx.get_scratchpad_grantor();
+    float *fft_wei = scratchpad.template get<float>(key_conv_fft_wei);
+    float *fft_src = scratchpad.template get<float>(key_conv_fft_src);
+    float *fft_dst = scratchpad.template get<float>(key_conv_fft_dst);
+
+    transform_weights(ctx, fft_wei);
+
+    const bool is_1d = pd()->ndims() == 3;
+    const bool is_dw = pd()->is_dw_;
+    const dim_t MB = pd()->MB();
+    const dim_t G = pd()->with_groups() ? pd()->G() : 1;
+    const dim_t OC = pd()->OC();
+    const dim_t ICg = pd()->IC() / G;
+    const dim_t OCg = OC / G;
+    const dim_t IH = pd()->IH();
+    const dim_t IW = pd()->IW();
+    const dim_t OH = pd()->OH();
+    const dim_t OW = pd()->OW();
+    const dim_t t_pad = pd()->padT();
+    const dim_t l_pad = pd()->padL();
+    const dim_t fft_h = pd()->fft_h_;
+    const dim_t m = pd()->fft_w_ / 2;
+    const dim_t row = m + 1;
+    const dim_t tile_h = pd()->tile_h_;
+    const dim_t tile_w = pd()->tile_w_;
+    const dim_t tiles_h = pd()->tiles_h_;
+    const dim_t tiles_w = pd()->tiles_w_;
+    const dim_t nb_freq = pd()->nb_freq_;
+    const dim_t ic_block = pd()->ic_block_;
+    const dim_t oc_block = pd()->oc_block_;
+    const dim_t cs = nstl::max(ic_block, oc_block);
+    const dim_t buf_size = 2 * nb_freq * cs;
+    const dim_t wei_size = is_dw ? nb_freq * G : nb_freq * G * ICg * OCg;
+    const float *tw_re = tw_re_.data();
+    const float *tw_im = tw_im_.data();
+    const dim_t tw_size = 2 * tw_re_.size();
+    // Steps for the row FFTs of m points, their real-to-complex twiddles
+    // and the column FFTs.
+    const dim_t row_tw_step = tw_size / m;
+    const dim_t r2c_tw_step = tw_size / (2 * m);
+    const dim_t col_tw_step = tw_size / fft_h;
+    const float scale = 1.f / (fft_h * 2 * m);
+    const bool with_post_ops = pd()->attr()->post_ops_.len() > 0;
+
+    auto src_off = [&](dim_t n, dim_t c, dim_t h, dim_t w) {
+        return is_1d ? src_d.blk_off(n, c, w) : src_d.blk_off(n, c, h, w);
+    };
+    auto dst_off = [&](dim_t n, dim_t c, dim_t h, dim_t w) {
+        return is_1d ? dst_d.blk_off(n, c, w) : dst_d.blk_off(n, c, h, w);
+    };
+
+    // Transforms the input window of output tile (th, tw) for `len`
+    // channels starting at `c0`.
+    auto transform_src = [&](float *re, float *im, dim_t n, dim_t c0,
+                                 dim_t len, dim_t th, dim_t tw) {
+        const dim_t ih0 = th * tile_h - t_pad;
+        const dim_t iw0 = tw * tile_w - l_pad;
+        for (dim_t h = 0; h < fft_h; h++) {
+            float *row_re = re + h * row * cs, *row_im = im + h * row * cs;
+            const dim_t ih = ih0 + h;
+            if (ih < 0 || ih >= IH) {
+                std::memset(row_re, 0, row * cs * sizeof(float));
+                std::memset(row_im, 0, row * cs * sizeof(float));
+                continue;
+            }
+            // Even points go to the real plane and odd points to the
+            // imaginary one, as expected by fft_r2c_post.
+            for (dim_t j = 0; j < m; j++) {
+                const dim_t iw = iw0 + 2 * j;
+                const float *s0 = iw >= 0 && iw < IW
+                        ? src + src_off(n, c0, ih, iw)
+                        : nullptr;
+                const float *s1 = iw + 1 >= 0 && iw + 1 < IW
+                        ? src + src_off(n, c0, ih, iw + 1)
+                        : nullptr;
+                float *r = row_re + j * cs, *i = row_im + j * cs;
+                for (dim_t c = 0; c < len; c++) {
+                    r[c] = s0 ? s0[c] : 0.f;
+                    i[c] = s1 ? s1[c] : 0.f;
+                }
+            }
+            fft_c2c(row_re, row_im, m, cs, len, tw_re, tw_im, row_tw_step,
+                    false);
+            fft_r2c_post(
+                    row_re, row_im, m, cs, len, tw_re, tw_im, r2c_tw_step);
+        }
+        if (fft_h > 1)
+            for (dim_t w = 0; w < row; w++)
+                fft_c2c(re + w * cs, im + w * cs, fft_h, row * cs, len, tw_re,
+                        tw_im, col_tw_step, false);
+    };
+
+    // Transforms back the product for output tile (th, tw) and stores the
+    // valid points of `len` channels starting at `c0`.
+    auto transform_dst = [&](float *re, float *im, dim_t n, dim_t c0,
+                                 dim_t len, dim_t th, dim_t tw) {
+        if (fft_h > 1)
+            for (dim_t w = 0; w < row; w++)
+                fft_c2c(re + w * cs, im + w * cs, fft_h, row * cs, len, tw_re,
+                        tw_im, col_tw_step, true);
+
+        const dim_t oh0 = th * tile_h;
+        const dim_t ow0 = tw * tile_w;
+        const dim_t h_len = nstl::min(tile_h, OH - oh0);
+        const dim_t w_len = nstl::min(tile_w, OW - ow0);
+        for (dim_t h = 0; h < h_len; h++) {
+            float *row_re = re + h * row * cs, *row_im = im + h * row * cs;
+            fft_c2r_pre(row_re, row_im, m, cs, len, tw_re, tw_im, r2c_tw_step);
+            fft_c2c(row_re, row_im, m, cs, len, tw_re, tw_im, row_tw_step,
+                    true);
+
+            const dim_t oh = oh0 + h;
+            for (dim_t w = 0; w < w_len; w++) {
+                const dim_t ow = ow0 + w;
+                const float *v = (w % 2 ? row_im : row_re) + (w / 2) * cs;
+                float *d = dst + dst_off(n, c0, oh, ow);
+                for (dim_t c = 0; c < len; c++) {
+                    float res = v[c] * scale;
+                    if (bias) res += bias[c0 + c];
+                    if (with_post_ops) {
+                        ref_post_ops_t::args_t args;
+                        args.dst_val = d[c];
+                        args.ctx = &ctx;
+                        args.l_offset = ((n * OC + c0 + c) * OH + oh) * OW + ow;
+                        args.dst_md = pd()->dst_md();
+                        ref_post_ops_->execute(res, args);
+                    }
+                    d[c] = res;
+                }
+            }
+        }
+    };
+
+    const float *wei_re = fft_wei;
+    const float *wei_im = fft_wei + wei_size;
+
+    if (is_dw) {
+        const dim_t nb_g_blocks = div_up(G, ic_block);
+        const dim_t work_amount = MB * nb_g_blocks * tiles_h * tiles_w;
+        parallel(pd()->nthr_, [&](const int ithr, const int nthr) {
+            dim_t start {0}, end {0};
+            balance211(work_amount, nthr, ithr, start, end);
+            if (start >= end) return;
+
+            float *re = fft_src + ithr * buf_size;
+            float *im = re + nb_freq * cs;
+            dim_t n {0}, gb {0}, th {0}, tw {0};
+            nd_iterator_init(start, n, MB, gb, nb_g_blocks, th, tiles_h, tw,
+                    tiles_w);
+            for (dim_t iwork = start; iwork < end; iwork++) {
+                const dim_t g0 = gb * ic_block;
+                const dim_t len = nstl::min(ic_block, G - g0);
+                transform_src(re, im, n, g0, len, th, tw);
+                for (dim_t f = 0; f < nb_freq; f++) {
+                    float *xr = re + f * cs, *xi = im + f * cs;
+                    const float *wr = wei_re + f * G + g0;
+                    const float *wi = wei_im + f * G + g0;
+                    PRAGMA_OMP_SIMD()
+                    for (dim_t c = 0; c < len; c++) {
+                        const float a = xr[c], b = xi[c];
+                        xr[c] = a * wr[c] + b * wi[c];
+                        xi[c] = b * wr[c] - a * wi[c];
+                    }
+                }
+                transform_dst(re, im, n, g0, len, th, tw);
+                nd_iterator_step(n, MB, gb, nb_g_blocks, th, tiles_h, tw,
+                        tiles_w);
+            }
+        });
+        return status::success;
+    }
+
+    const dim_t nb_oc_blocks = div_up(OCg, oc_block);
+    const dim_t work_amount = MB * G * nb_oc_blocks * tiles_h * tiles_w;
+    parallel(pd()->nthr_, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(work_amount, nthr, ithr, start, end);
+        if (start >= end) return;
+
+        float *x_re = fft_src + ithr * buf_size;
+        float *x_im = x_re + nb_freq * cs;
+        float *y_re = fft_dst + ithr * buf_size;
+        float *y_im = y_re + nb_freq * cs;
+        dim_t n {0}, g {0}, ocb {0}, th {0}, tw {0};
+        nd_iterator_init(start, n, MB, g, G, ocb, nb_oc_blocks, th, tiles_h,
+                tw, tiles_w);
+        for (dim_t iwork = start; iwork < end; iwork++) {
+            const dim_t oc0 = ocb * oc_block;
+            const dim_t oc_len = nstl::min(oc_block, OCg - oc0);
+            std::memset(y_re, 0, buf_size * sizeof(float));
+            for (dim_t ic0 = 0; ic0 < ICg; ic0 += ic_block) {
+                const dim_t ic_len = nstl::min(ic_block, ICg - ic0);
+                transform_src(x_re, x_im, n, g * ICg + ic0, ic_len, th, tw);
+                // Y += X * conj(W) over the input channels of the block.
+                for (dim_t f = 0; f < nb_freq; f++) {
+                    const float *xr = x_re + f * cs, *xi = x_im + f * cs;
+                    float *yr = y_re + f * cs, *yi = y_im + f * cs;
+                    const dim_t w_off
+                            = ((g * nb_freq + f) * ICg + ic0) * OCg + oc0;
+                    for (dim_t ic = 0; ic < ic_len; ic++) {
+                        const float a = xr[ic], b = xi[ic];
+                        const float *wr = wei_re + w_off + ic * OCg;
+                        const float *wi = wei_im + w_off + ic * OCg;
+                        PRAGMA_OMP_SIMD()
+                        for (dim_t oc = 0; oc < oc_len; oc++) {
+                            yr[oc] += a * wr[oc] + b * wi[oc];
+                            yi[oc] += b * wr[oc] - a * wi[oc];
+                        }
+                    }
+                }
+            }
+            transform_dst(y_re, y_im, n, g * OCg + oc0, oc_len, th, tw);
+            nd_iterator_step(
+                    n, MB, g, G, ocb, nb_oc_blocks, th, tiles_h, tw, tiles_w);
+        }
+    });
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
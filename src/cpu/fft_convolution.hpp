@@ -0,0 +1,91 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_FFT_CONVOLUTION_HPP
+#define CPU_FFT_CONVOLUTION_HPP
+
+#include <memory>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+
+#include "cpu/cpu_convolution_pd.hpp"
+#include "cpu/primitive_attr_postops.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// FFT-based forward convolution for 1D and 2D problems with large kernels.
+// The output is split into tiles that are computed with overlap-save: an
+// input window of fft_h x fft_w points is transformed with a real 2D FFT,
+// multiplied by the conjugated transform of the kernel and transformed back,
+// which leaves tile_h x tile_w valid outputs. All transforms work on vectors
+// of channels, so the innermost loops run over contiguous channels of the
+// channels-last activations.
+struct fft_convolution_fwd_t : public primitive_t {
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        using cpu_convolution_fwd_pd_t::cpu_convolution_fwd_pd_t;
+
+        DECLARE_COMMON_PD_T("fft:any", fft_convolution_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        int nthr_ = 0;
+        // Depthwise problems multiply the transforms channel by channel,
+        // the others do a complex IC x OC product per frequency.
+        bool is_dw_ = false;
+        // Dilated kernel size, FFT size and output tile size along height
+        // and width. Height sizes are 1 for 1D convolutions.
+        dim_t kh_ = 0, kw_ = 0;
+        dim_t fft_h_ = 0, fft_w_ = 0;
+        dim_t tile_h_ = 0, tile_w_ = 0;
+        dim_t tiles_h_ = 0, tiles_w_ = 0;
+        // Number of complex points of a transformed tile. Only
+        // fft_w_ / 2 + 1 points of each row are kept since the data is real.
+        dim_t nb_freq_ = 0;
+        // Number of channels transformed at once. For depthwise problems
+        // both are the number of groups in a block.
+        dim_t ic_block_ = 0;
+        dim_t oc_block_ = 0;
+
+    private:
+        bool is_fft_profitable() const;
+        status_t init_scratchpad(engine_t *engine);
+    };
+
+    fft_convolution_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    void transform_weights(const exec_ctx_t &ctx, float *fft_wei) const;
+
+    // exp(-2 * pi * i * j / n) for j < n / 2, where n is the largest of
+    // the FFT sizes. Smaller transforms use every (n / size)-th value.
+    std::vector<float> tw_re_;
+    std::vector<float> tw_im_;
+    std::unique_ptr<ref_post_ops_t> ref_post_ops_;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -451,6 +451,7 @@ status_t ref_convolution_bwd_weights_t::execute_backward_weights(
     const auto padL = pd()->padL();
 
     const auto ndims = pd()->desc()->src_desc.ndims;
+    const bool with_sum = pd()->with_sum();
 
     auto ker = [=](float &dw, dim_t g, dim_t oc, dim_t ic, dim_t kd, dim_t kh,
                        dim_t kw) {
@@ -542,9 +543,11 @@ status_t ref_convolution_bwd_weights_t::execute_backward_weights(
 
     parallel_nd(G, OC, [&](dim_t g, dim_t oc) {
         if (diff_bias) {
-            float db = 0;
-            ker_bias(db, g, oc);
             const auto diff_bias_off = diff_bias_d.off(g * OC + oc);
+            float db = with_sum ? io::load_float_value(diff_bias_d.data_type(),
+                               diff_bias, diff_bias_off)
+                                : 0;
+            ker_bias(db, g, oc);
             io::store_float_value(
                     diff_bias_d.data_type(), db, diff_bias, diff_bias_off);
         }
@@ -553,14 +556,17 @@ status_t ref_convolution_bwd_weights_t::execute_backward_weights(
         for_(dim_t kd = 0; kd < KD; ++kd)
         for_(dim_t kh = 0; kh < KH; ++kh)
         for (dim_t kw = 0; kw < KW; ++kw) {
-            float dw = 0;
+            const dim_t diff_weights_off = ref_conv_utils::get_weights_off(
+                    diff_weights_d, with_groups, ndims, g, oc, ic, kd, kh, kw);
+            float dw = with_sum ? io::load_float_value(
+                               diff_weights_d.data_type(), diff_weights,
+                               diff_weights_off)
+                                : 0;
             if (diff_dst_d.is_plain() && src_d.is_plain())
                 ker_plain(dw, g, oc, ic, kd, kh, kw);
             else
                 ker(dw, g, oc, ic, kd, kh, kw);
 
-            const dim_t diff_weights_off = ref_conv_utils::get_weights_off(
-                    diff_weights_d, with_groups, ndims, g, oc, ic, kd, kh, kw);
             io::store_float_value(diff_weights_d.data_type(), dw, diff_weights,
                     diff_weights_off);
         }
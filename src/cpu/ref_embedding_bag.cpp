@@ -0,0 +1,79 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "cpu/ref_embedding_bag.hpp"
+#include "cpu/ref_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t ref_embedding_bag_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto indices = CTX_IN_MEM(const int32_t *, DNNL_ARG_INDICES);
+    auto offsets = CTX_IN_MEM(const int32_t *, DNNL_ARG_OFFSETS);
+    auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+
+    DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
+    const int src_scales_mask = pd()->attr()->scales_.get(DNNL_ARG_SRC).mask_;
+
+    const memory_desc_wrapper src_d(pd()->src_md(0));
+    const memory_desc_wrapper indices_d(pd()->src_md(1));
+    const memory_desc_wrapper offsets_d(pd()->src_md(2));
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+
+    const auto src_dt = src_d.data_type();
+    const auto dst_dt = dst_d.data_type();
+
+    const dim_t num_bags = pd()->num_bags();
+    const dim_t num_indices = pd()->num_indices();
+    const dim_t dim = pd()->dim();
+    const bool is_mean = pd()->is_mean();
+
+    parallel_nd(num_bags, dim, [&](dim_t b, dim_t d) {
+        const dim_t beg = offsets[offsets_d.off(b)];
+        const dim_t end = b + 1 < num_bags ? offsets[offsets_d.off(b + 1)]
+                                           : num_indices;
+
+        assert(0 <= beg && end <= num_indices);
+
+        float acc = 0.f;
+        for (dim_t i = beg; i < end; ++i) {
+            const dim_t row = indices[indices_d.off(i)];
+            assert(0 <= row && row < pd()->rows());
+            const float scale = src_scales[src_scales_mask ? row : 0];
+            acc += scale
+                    * io::load_float_value(src_dt, src, src_d.off(row, d));
+        }
+        if (is_mean && end > beg) acc /= static_cast<float>(end - beg);
+
+        io::store_float_value(dst_dt, acc, dst, dst_d.off(b, d));
+    });
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2020-2023 Intel Corporation
+* Copyright 2020-2024 Intel Corporation
 * Copyright 2022 Arm Ltd. and affiliates
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
@@ -18,6 +18,10 @@
 #ifndef CPU_REF_FUSED_CONVOLUTION_HPP
 #define CPU_REF_FUSED_CONVOLUTION_HPP
 
+#include <atomic>
+#include <cstring>
+
+#include "common/dnnl_thread.hpp"
 #include "common/primitive.hpp"
 #include "common/primitive_desc_iterator.hpp"
 #include "common/reorder.hpp"
@@ -25,6 +29,7 @@
 
 #include "cpu/cpu_convolution_pd.hpp"
 #include "cpu/dw_convolution_utils.hpp"
+#include "cpu/platform.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -73,6 +78,23 @@ struct ref_fused_convolution_fwd_t : public primitive_t {
         std::vector<arg_info_t> info_;
     };
 
+    // Each band primitive is executed by a single thread, so it is created
+    // for a single thread in this scope. Otherwise its scratchpad, booked for
+    // all the threads, would be booked again per thread.
+    struct single_thread_scope_t {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        single_thread_scope_t() : nthr_(omp_get_max_threads()) {
+            omp_set_num_threads(1);
+        }
+        ~single_thread_scope_t() { omp_set_num_threads(nthr_); }
+
+    private:
+        int nthr_;
+#else
+        single_thread_scope_t() {}
+#endif
+    };
+
     struct pd_t : public cpu_convolution_fwd_pd_t {
         pd_t(const convolution_desc_t *adesc, const primitive_attr_t *attr,
                 const typename pd_t::base_class *hint_fwd_pd)
@@ -174,6 +196,55 @@ struct ref_fused_convolution_fwd_t : public primitive_t {
         std::vector<std::shared_ptr<primitive_desc_t>> op_pds_;
         std::vector<arg_cache_t> args_;
 
+        // Row-banded execution of a 1x1 convolution followed by a depthwise
+        // one. Output rows of the depthwise convolution are split into
+        // bands, and each thread computes the 1x1 rows a band needs into its
+        // own buffer sized to fit L2, so the intermediate tensor never goes
+        // to memory. Rows shared with the previous band of the same thread
+        // are carried over instead of being recomputed.
+        struct band_conf_t {
+            int nthr = 0;
+            // Depthwise output rows per band and the number of bands.
+            dim_t rows = 0;
+            dim_t nb_bands = 0;
+            // Intermediate rows of a full band and their count shared with
+            // the previous band.
+            dim_t in_rows = 0;
+            dim_t halo = 0;
+            size_t row_size = 0;
+            // Per-thread intermediate buffer and nested scratchpad sizes.
+            size_t buf_size = 0;
+            size_t scratchpad_size = 0;
+        } band_;
+        // 1x1 convolutions over a given number of intermediate rows.
+        std::vector<std::pair<dim_t, std::shared_ptr<primitive_desc_t>>>
+                band_pw_pds_;
+        // Depthwise convolutions for a full band and for the last one.
+        std::shared_ptr<primitive_desc_t> band_dw_pd_;
+        std::shared_ptr<primitive_desc_t> band_dw_tail_pd_;
+
+        bool with_bands() const { return band_.rows > 0; }
+
+        // Computes the range [r_start, r_start + r_count) of intermediate
+        // rows band `b` reads and the range [lo, hi) of them it has to
+        // compute, when `reused` leading rows come from the previous band.
+        void band_rows(dim_t b, dim_t reused, dim_t &r_start, dim_t &r_count,
+                dim_t &lo, dim_t &hi) const {
+            const auto *dw_pd = conv_pd(op_pds_.back());
+            const dim_t oh_start = b * band_.rows;
+            const dim_t oh_count
+                    = nstl::min(band_.rows, dw_pd->OH() - oh_start);
+            r_start = oh_start * dw_pd->KSH() - dw_pd->padT();
+            r_count = (oh_count - 1) * dw_pd->KSH() + dw_pd->KH();
+            lo = nstl::max(r_start + reused, dim_t(0));
+            hi = nstl::min(r_start + r_count, dw_pd->IH());
+        }
+
+        static const convolution_pd_t *conv_pd(
+                const std::shared_ptr<primitive_desc_t> &pd) {
+            return static_cast<const convolution_pd_t *>(pd.get());
+        }
+
     private:
         std::string name_;
         const unsigned int max_fusions_ = 1;
@@ -349,11 +420,162 @@ struct ref_fused_convolution_fwd_t : public primitive_t {
 
             assert(!op_pds_.empty());
 
+            CHECK(init_band_conf(engine));
+            if (with_bands()) {
+                user_scratchpad_size_ = band_.scratchpad_size * band_.nthr;
+                inout_sp_offset_end = band_.buf_size * band_.nthr;
+            }
+
             CHECK(init_scratchpad_memory(inout_sp_offset_end));
 
             return status::success;
         }
 
+        status_t init_band_conf(engine_t *engine) {
+            using namespace format_tag;
+            band_ = band_conf_t();
+            if (op_pds_.size() != 2) return status::success;
+
+            // Bands are sliced along the height of a single image, so every
+            // slice of a dense nhwc tensor is a dense nhwc tensor too.
+            const auto *pw_pd = conv_pd(op_pds_.front());
+            const auto *dw_pd = conv_pd(op_pds_.back());
+            const bool ok = pw_pd->ndims() == 4
+                    && dw_pd->kind() == primitive_kind::convolution
+                    && utils::everyone_is(1, pw_pd->KSH(), pw_pd->KSW())
+                    && utils::everyone_is(0, pw_pd->padT(), pw_pd->padB(),
+                            pw_pd->padL(), pw_pd->padR())
+                    && memory_desc_matches_tag(*pw_pd->src_md(), nhwc)
+                    && memory_desc_matches_tag(*pw_pd->dst_md(), nhwc)
+                    && memory_desc_matches_tag(*dw_pd->dst_md(), nhwc)
+                    && attr()->post_ops_.find(primitive_kind::binary) == -1;
+            if (!ok) return status::success;
+
+            const dim_t MB = dw_pd->MB();
+            const dim_t OH = dw_pd->OH();
+            const dim_t KH = dw_pd->KH();
+            const dim_t SH = dw_pd->KSH();
+            const size_t row_size = pw_pd->OW() * pw_pd->OC()
+                    * types::data_type_size(pw_pd->dst_md()->data_type);
+            const int nthr = dnnl_get_max_threads();
+
+            // Largest band whose intermediate rows fit in half of L2, but
+            // small enough for every thread to get a band.
+            const dim_t l2_rows = static_cast<dim_t>(
+                    platform::get_per_core_cache_size(2) / 2 / row_size);
+            dim_t rows = l2_rows > KH ? (l2_rows - KH) / SH + 1 : 1;
+            rows = nstl::min(rows, OH);
+            rows = nstl::min(rows,
+                    nstl::max(dim_t(1), OH / utils::div_up(nthr, MB)));
+
+            // Neighbouring bands share `halo` intermediate rows, which are
+            // recomputed whenever a thread starts a new run of bands. Skip
+            // banding when that would add too much 1x1 work.
+            const dim_t halo = nstl::max(KH - SH, dim_t(0));
+            if (rows < OH && rows * SH < 2 * halo) return status::success;
+
+            band_.nthr = nthr;
+            band_.rows = rows;
+            band_.nb_bands = utils::div_up(OH, rows);
+            band_.in_rows = (rows - 1) * SH + KH;
+            band_.halo = halo;
+            band_.row_size = row_size;
+            band_.buf_size = utils::rnd_up(band_.in_rows * row_size, 64);
+
+            auto create_pd = [&](std::shared_ptr<primitive_desc_t> &pd,
+                                     const convolution_desc_t &cd,
+                                     const primitive_attr_t *attr) {
+                single_thread_scope_t scope;
+                primitive_desc_iterator_t it(
+                        engine, (op_desc_t *)&cd, attr, nullptr);
+                if (!it.is_initialized()) return status::out_of_memory;
+                pd = *(++it);
+                return pd ? status::success : status::unimplemented;
+            };
+            auto init_band_md = [](memory_desc_t &md, const memory_desc_t &md_,
+                                        dim_t h) {
+                const dims_t dims = {1, md_.dims[1], h, md_.dims[3]};
+                return memory_desc_init_by_tag(
+                        md, 4, dims, md_.data_type, format_tag::nhwc);
+            };
+            auto same_weights = [](const std::shared_ptr<primitive_desc_t> &a,
+                                        const primitive_desc_t *b) {
+                return *a->weights_md(0) == *b->weights_md(0)
+                        && *a->weights_md(1) == *b->weights_md(1);
+            };
+            auto disable = [&]() {
+                band_ = band_conf_t();
+                band_pw_pds_.clear();
+                band_dw_pd_.reset();
+                band_dw_tail_pd_.reset();
+                return status::success;
+            };
+
+            // Depthwise convolution over the rows of one band. Top and bottom
+            // padding rows are zeroed in the intermediate buffer instead.
+            auto create_dw_pd = [&](std::shared_ptr<primitive_desc_t> &pd,
+                                        dim_t oh_count) {
+                convolution_desc_t cd = *dw_pd->desc();
+                CHECK(init_band_md(cd.src_desc, *dw_pd->src_md(),
+                        (oh_count - 1) * SH + KH));
+                CHECK(init_band_md(cd.dst_desc, *dw_pd->dst_md(), oh_count));
+                cd.weights_desc = *dw_pd->weights_md(0);
+                cd.bias_desc = *dw_pd->weights_md(1);
+                cd.padding[0][0] = 0;
+                cd.padding[1][0] = 0;
+                return create_pd(pd, cd, dw_pd->attr());
+            };
+            if (create_dw_pd(band_dw_pd_, rows) != status::success
+                    || !same_weights(band_dw_pd_, dw_pd))
+                return disable();
+            const dim_t tail = OH % rows;
+            if (tail > 0
+                    && (create_dw_pd(band_dw_tail_pd_, tail) != status::success
+                            || !same_weights(band_dw_tail_pd_, dw_pd)))
+                return disable();
+
+            // 1x1 convolutions for every number of rows a band may compute.
+            for_(dim_t b = 0; b < band_.nb_bands; b++)
+            for (dim_t reused : {dim_t(0), halo}) {
+                if (b == 0 && reused > 0) continue;
+                dim_t r_start {0}, r_count {0}, lo {0}, hi {0};
+                band_rows(b, reused, r_start, r_count, lo, hi);
+                if (hi <= lo || band_pw_pd(hi - lo)) continue;
+
+                convolution_desc_t cd = *pw_pd->desc();
+                CHECK(init_band_md(cd.src_desc, *pw_pd->src_md(), hi - lo));
+                CHECK(init_band_md(cd.dst_desc, *pw_pd->dst_md(), hi - lo));
+                cd.weights_desc = *pw_pd->weights_md(0);
+                cd.bias_desc = *pw_pd->weights_md(1);
+                std::shared_ptr<primitive_desc_t> pd;
+                if (create_pd(pd, cd, pw_pd->attr()) != status::success
+                        || !same_weights(pd, pw_pd))
+                    return disable();
+                band_pw_pds_.emplace_back(hi - lo, pd);
+            }
+
+            for (const auto &pd : band_pw_pds_)
+                band_.scratchpad_size = nstl::max<size_t>(band_.scratchpad_size,
+                        pd.second->scratchpad_size(attr()->scratchpad_mode_));
+            for (const auto &pd : {band_dw_pd_, band_dw_tail_pd_})
+                if (pd)
+                    band_.scratchpad_size
+                            = nstl::max<size_t>(band_.scratchpad_size,
+                                    pd->scratchpad_size(
+                                            attr()->scratchpad_mode_));
+            band_.scratchpad_size = utils::rnd_up(band_.scratchpad_size, 64);
+            return status::success;
+        }
+
+    public:
+        // Returns the 1x1 convolution over `rows` intermediate rows.
+        const primitive_desc_t *band_pw_pd(dim_t rows) const {
+            for (const auto &pd : band_pw_pds_)
+                if (pd.first == rows) return pd.second.get();
+            return nullptr;
+        }
+
+    private:
         status_t init_scratchpad_memory(size_t inout_buffer_size) {
 
             auto scratchpad = scratchpad_registry().registrar();
@@ -384,6 +606,18 @@ struct ref_fused_convolution_fwd_t : public primitive_t {
             op_pd->create_primitive(p, engine);
             primitives_.emplace_back(p);
         }
+
+        single_thread_scope_t scope;
+        for (const auto &op_pd : pd()->band_pw_pds_) {
+            std::shared_ptr<primitive_t> p;
+            CHECK(op_pd.second->create_primitive(p, engine));
+            band_pw_primitives_.emplace_back(op_pd.first, p);
+        }
+        if (pd()->band_dw_pd_)
+            CHECK(pd()->band_dw_pd_->create_primitive(band_dw_, engine));
+        if (pd()->band_dw_tail_pd_)
+            CHECK(pd()->band_dw_tail_pd_->create_primitive(
+                    band_dw_tail_, engine));
         return status::success;
     }
 
@@ -398,6 +632,8 @@ struct ref_fused_convolution_fwd_t : public primitive_t {
 #endif
 
     status_t execute(const exec_ctx_t &ctx) const override {
+        if (pd()->with_bands()) return execute_bands(ctx);
+
         engine_t *engine = ctx.stream()->engine();
         const auto scratchpad = ctx.get_scratchpad_grantor();
 
@@ -438,8 +674,136 @@ struct ref_fused_convolution_fwd_t : public primitive_t {
     }
 
 private:
+    status_t execute_bands(const exec_ctx_t &ctx) const {
+        using namespace memory_tracking::names;
+        engine_t *engine = ctx.stream()->engine();
+        const auto scratchpad = ctx.get_scratchpad_grantor();
+        const auto inout_buffer
+                = scratchpad.get_memory_storage(key_fusion_inout_buffer);
+        const auto nested_buffer
+                = scratchpad.get_memory_storage(key_fusion_forward_scratchpad);
+        const auto &ctx_args = ctx.args();
+        const auto &band = pd()->band_;
+
+        const auto *pw_pd = pd_t::conv_pd(pd()->op_pds_.front());
+        const auto *dw_pd = pd_t::conv_pd(pd()->op_pds_.back());
+        const memory_desc_wrapper src_d(pw_pd->src_md());
+        const memory_desc_wrapper dst_d(dw_pd->dst_md());
+        const auto &src_storage = CTX_IN_STORAGE(DNNL_ARG_SRC);
+        const auto &dst_storage = CTX_OUT_STORAGE(DNNL_ARG_DST);
+        const dim_t MB = dw_pd->MB();
+        const dim_t IH = dw_pd->IH();
+        const size_t row_size = band.row_size;
+
+        // Runs the op with cached arguments `args`, but with the given
+        // source and destination.
+        auto execute_op = [&](const std::shared_ptr<primitive_t> &op,
+                                  const arg_cache_t &args, memory_t *src,
+                                  memory_t *dst,
+                                  const memory_storage_t *sp_storage) {
+            exec_args_t exec_args;
+            for (const auto &arg_info : args.info()) {
+                if (arg_info.op_arg == DNNL_ARG_SRC)
+                    exec_args[DNNL_ARG_SRC] = {src, true};
+                else if (arg_info.op_arg == DNNL_ARG_DST)
+                    exec_args[DNNL_ARG_DST] = {dst, false};
+                else
+                    exec_args[arg_info.op_arg] = ctx_args.at(arg_info.ctx_arg);
+            }
+            exec_ctx_t op_ctx(ctx, std::move(exec_args));
+            const auto grantor
+                    = op->pd()->scratchpad_registry().grantor(sp_storage, ctx);
+            op_ctx.set_scratchpad_grantor(&grantor);
+            return op->execute(op_ctx);
+        };
+
+        std::atomic<status_t> st(status::success);
+        parallel(band.nthr, [&](const int ithr, const int nthr) {
+            dim_t start {0}, end {0};
+            balance211(MB * band.nb_bands, nthr, ithr, start, end);
+            if (start >= end) return;
+
+            auto buf_storage = inout_buffer->get_sub_storage(
+                    ithr * band.buf_size, band.buf_size);
+            char *buf = static_cast<char *>(buf_storage->data_handle());
+            std::unique_ptr<memory_storage_t> sp_storage;
+            if (band.scratchpad_size > 0)
+                sp_storage = nested_buffer->get_sub_storage(
+                        ithr * band.scratchpad_size, band.scratchpad_size);
+
+            dim_t n {0}, b {0};
+            utils::nd_iterator_init(start, n, MB, b, band.nb_bands);
+            dim_t prev_n = -1, prev_b = -1;
+            for (dim_t iwork = start; iwork < end; ++iwork) {
+                // Carry the rows shared with the previous band over.
+                dim_t reused = 0;
+                if (band.halo > 0 && prev_n == n && prev_b == b - 1) {
+                    reused = band.halo;
+                    std::memmove(buf, buf + (band.in_rows - reused) * row_size,
+                            reused * row_size);
+                }
+
+                dim_t r_start {0}, r_count {0}, lo {0}, hi {0};
+                pd()->band_rows(b, reused, r_start, r_count, lo, hi);
+                for (dim_t r = r_start + reused; r < r_start + r_count; ++r)
+                    if (r < 0 || r >= IH)
+                        std::memset(buf + (r - r_start) * row_size, 0,
+                                row_size);
+
+                if (hi > lo) {
+                    const auto *op_pd = pd()->band_pw_pd(hi - lo);
+                    std::shared_ptr<primitive_t> op;
+                    for (const auto &p : band_pw_primitives_)
+                        if (p.first == hi - lo) op = p.second;
+                    assert(op_pd && op);
+
+                    const memory_desc_wrapper op_src_d(op_pd->src_md());
+                    const memory_desc_wrapper op_dst_d(op_pd->dst_md());
+                    memory_t src(engine, op_pd->src_md(),
+                            src_storage.get_sub_storage(
+                                    src_d.blk_off(n, 0, lo, 0)
+                                            * src_d.data_type_size(),
+                                    op_src_d.size()));
+                    memory_t dst(engine, op_pd->dst_md(),
+                            buf_storage->get_sub_storage(
+                                    (lo - r_start) * row_size,
+                                    op_dst_d.size()));
+                    const status_t s = execute_op(op, pd()->args_.front(),
+                            &src, &dst, sp_storage.get());
+                    if (s != status::success) st = s;
+                }
+
+                const dim_t oh_start = b * band.rows;
+                const bool is_tail = oh_start + band.rows > dw_pd->OH();
+                const auto &op = is_tail ? band_dw_tail_ : band_dw_;
+                const memory_desc_wrapper op_src_d(op->pd()->src_md());
+                const memory_desc_wrapper op_dst_d(op->pd()->dst_md());
+                memory_t src(engine, op->pd()->src_md(),
+                        buf_storage->get_sub_storage(0, op_src_d.size()));
+                memory_t dst(engine, op->pd()->dst_md(),
+                        dst_storage.get_sub_storage(
+                                dst_d.blk_off(n, 0, oh_start, 0)
+                                        * dst_d.data_type_size(),
+                                op_dst_d.size()));
+                const status_t s = execute_op(op, pd()->args_.back(), &src,
+                        &dst, sp_storage.get());
+                if (s != status::success) st = s;
+
+                prev_n = n;
+                prev_b = b;
+                utils::nd_iterator_step(n, MB, b, band.nb_bands);
+            }
+        });
+
+        return st;
+    }
+
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
     std::vector<std::shared_ptr<primitive_t>> primitives_;
+    std::vector<std::pair<dim_t, std::shared_ptr<primitive_t>>>
+            band_pw_primitives_;
+    std::shared_ptr<primitive_t> band_dw_;
+    std::shared_ptr<primitive_t> band_dw_tail_;
 };
 
 } // namespace cpu
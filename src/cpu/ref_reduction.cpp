@@ -14,7 +14,10 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <math.h>
+#include <utility>
+#include <vector>
 
 #include "common/c_types_map.hpp"
 #include "common/dnnl_thread.hpp"
@@ -158,6 +161,65 @@ status_t ref_reduction_t<src_type, dst_type, acc_type>::execute_ref(
     return status::success;
 }
 
+template <data_type_t src_type, data_type_t dst_type, data_type_t acc_type>
+status_t ref_reduction_t<src_type, dst_type, acc_type>::execute_ref_index(
+        const exec_ctx_t &ctx) const {
+    status_t status = status::success;
+    auto src = CTX_IN_MEM(const src_t *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_CLEAN_MEM(dst_t *, DNNL_ARG_DST, status);
+    CHECK(status);
+    auto indices = CTX_OUT_CLEAN_MEM(int32_t *, DNNL_ARG_DST_1, status);
+    CHECK(status);
+
+    const memory_desc_wrapper src_mdw(pd()->src_md());
+    const memory_desc_wrapper dst_mdw(pd()->dst_md(0));
+    const memory_desc_wrapper indices_mdw(pd()->dst_md(1));
+
+    const int ndims = src_mdw.ndims();
+    const int axis = pd()->reduce_axis();
+    const dim_t n = src_mdw.dims()[axis];
+    const dim_t k = pd()->topk_k();
+    const bool is_min = pd()->desc()->alg_kind == alg_kind::reduction_argmin;
+
+    // Every position of dst with the reduced dimension dropped is a row.
+    dims_t row_dims;
+    utils::array_copy(row_dims, dst_mdw.dims(), ndims);
+    row_dims[axis] = 1;
+    const dim_t nrows = utils::array_product(row_dims, ndims);
+
+    using elem_t = std::pair<acc_t, dim_t>;
+    // Ties are resolved in favor of the smaller index.
+    const auto is_better = [&](const elem_t &a, const elem_t &b) {
+        if (a.first != b.first)
+            return is_min ? a.first < b.first : a.first > b.first;
+        return a.second < b.second;
+    };
+
+    parallel_nd(nrows, [&](dim_t row) {
+        dims_t pos;
+        utils::l_dims_by_l_offset(pos, row, row_dims, ndims);
+
+        std::vector<elem_t> elems(n);
+        for (dim_t i = 0; i < n; ++i) {
+            pos[axis] = i;
+            elems[i] = {static_cast<acc_t>(src[src_mdw.off_v(pos)]), i};
+        }
+        std::partial_sort(
+                elems.begin(), elems.begin() + k, elems.end(), is_better);
+
+        for (dim_t j = 0; j < k; ++j) {
+            pos[axis] = j;
+            const float val = static_cast<float>(elems[j].first);
+            dst[dst_mdw.off_v(pos)] = q10n::saturate_and_round<dst_t>(val);
+            if (indices)
+                indices[indices_mdw.off_v(pos)]
+                        = static_cast<int32_t>(elems[j].second);
+        }
+    });
+
+    return status::success;
+}
+
 using namespace data_type;
 template struct ref_reduction_t<f32, f32, f32>;
 template struct ref_reduction_t<bf16, bf16, f32>;
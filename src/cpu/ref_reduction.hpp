@@ -80,12 +80,14 @@ struct ref_reduction_t : public primitive_t {
     using dst_t = typename prec_traits<dst_type>::type;
 
     status_t execute(const exec_ctx_t &ctx) const override {
+        if (pd()->is_index_alg()) return execute_ref_index(ctx);
         return execute_ref(ctx);
     }
 
 private:
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
     status_t execute_ref(const exec_ctx_t &ctx) const;
+    status_t execute_ref_index(const exec_ctx_t &ctx) const;
     std::unique_ptr<ref_post_ops_t> ref_post_ops;
 
     void accumulate(
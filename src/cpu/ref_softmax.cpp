@@ -26,6 +26,7 @@
 
 #include "cpu/ref_io_helper.hpp"
 #include "cpu/ref_softmax.hpp"
+#include "cpu/topk_utils.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -42,6 +43,9 @@ status_t ref_softmax_fwd_t::execute_forward_dense(const exec_ctx_t &ctx) const {
 
     auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
     auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+    auto max = CTX_OUT_MEM(float *, DNNL_ARG_DST_1);
+    auto lse = CTX_OUT_MEM(float *, DNNL_ARG_DST_2);
+    auto candidates = CTX_OUT_MEM(int32_t *, DNNL_ARG_DST_3);
 
     DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
     DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
@@ -52,6 +56,7 @@ status_t ref_softmax_fwd_t::execute_forward_dense(const exec_ctx_t &ctx) const {
 
     const memory_desc_wrapper src_d(pd()->src_md());
     const memory_desc_wrapper dst_d(pd()->dst_md());
+    const dim_t k = pd()->num_candidates();
 
     const auto interim_dt = data_type::f32;
     const auto is_inplace = (src == dst);
@@ -154,6 +159,13 @@ status_t ref_softmax_fwd_t::execute_forward_dense(const exec_ctx_t &ctx) const {
             io::store_float_value(interim_dt, d, interim_ptr, i);
         }
 
+        // Rows are visited in the physical order of dst. Per-row outputs keep
+        // the dimension order of dst, so row `ou` lands at offset `ou`.
+        if (pd()->with_stats()) {
+            max[ou] = space_max;
+            lse[ou] = space_max + logf(space_denom);
+        }
+
         // scal
         if (pd()->is_softmax()) {
             space_denom = space_denom ? (1.f / space_denom) : 1.f;
@@ -187,6 +199,14 @@ status_t ref_softmax_fwd_t::execute_forward_dense(const exec_ctx_t &ctx) const {
                 io::store_float_value(
                         dst_d.data_type(), 0, dst_data, channels_ + i);
         }
+        if (pd()->with_candidates()) {
+            std::vector<topk_utils::candidate_t> heap;
+            heap.reserve(k);
+            topk_utils::select_topk(
+                    heap, dst_data, dst_d.data_type(), 0, channels_, 0, k);
+            for (dim_t j = 0; j < k; ++j)
+                candidates[ou * k + j] = static_cast<int32_t>(heap[j].idx);
+        }
     });
     return status::success;
 }
@@ -197,6 +217,9 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
 
     auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
     auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+    auto max = CTX_OUT_MEM(float *, DNNL_ARG_DST_1);
+    auto lse = CTX_OUT_MEM(float *, DNNL_ARG_DST_2);
+    auto candidates = CTX_OUT_MEM(int32_t *, DNNL_ARG_DST_3);
 
     DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
     DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
@@ -207,6 +230,9 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
 
     const memory_desc_wrapper src_d(pd()->src_md());
     const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper stat_d(pd()->dst_md(1));
+    const memory_desc_wrapper cand_d(pd()->dst_md(3));
+    const dim_t k = pd()->num_candidates();
 
     void *interim_ptr
             = pd()->need_intermediate_scratchpad() ? interim_scratchpad : dst;
@@ -274,6 +300,12 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
                 io::store_float_value(interim_dt, d, interim_ptr, interim_off);
             }
 
+            if (pd()->with_stats()) {
+                const auto stat_off = stat_d.off_l(ou * inner_size_ + in);
+                max[stat_off] = space_max[in];
+                lse[stat_off] = space_max[in] + logf(space_denom[in]);
+            }
+
             if (pd()->is_logsoftmax()) {
                 space_denom[in] = logf(space_denom[in]);
             }
@@ -303,6 +335,21 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
 
                 io::store_float_value(dst_d.data_type(), d, dst, dst_off);
             }
+
+            if (pd()->with_candidates()) {
+                // The row is strided in dst, gather it before the selection.
+                std::vector<float> row(channels_);
+                for (int c = 0; c < channels_; c++)
+                    row[c] = io::load_float_value(dst_d.data_type(), dst,
+                            dst_d.off_l(ou_in_offset + c * inner_size_));
+                std::vector<topk_utils::candidate_t> heap;
+                heap.reserve(k);
+                topk_utils::select_topk(heap, row.data(), data_type::f32, 0,
+                        channels_, 0, k);
+                for (dim_t j = 0; j < k; ++j)
+                    candidates[cand_d.off_l((ou * k + j) * inner_size_ + in)]
+                            = static_cast<int32_t>(heap[j].idx);
+            }
         }
     });
     return status::success;
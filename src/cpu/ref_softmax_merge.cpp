@@ -0,0 +1,139 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "cpu/ref_io_helper.hpp"
+#include "cpu/ref_softmax_merge.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t ref_softmax_merge_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
+    using namespace memory_tracking::names;
+    using namespace format_tag;
+
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto lse = CTX_IN_MEM(const float *, DNNL_ARG_SRC_1);
+    auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+    auto merged_lse = CTX_OUT_MEM(float *, DNNL_ARG_DST_2);
+
+    float *weights = ctx.get_scratchpad_grantor().template get<float>(
+            key_softmax_reduction);
+
+    const memory_desc_wrapper src_d(pd()->src_md(0));
+    const memory_desc_wrapper lse_d(pd()->src_md(1));
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper stat_d(pd()->dst_md(2));
+
+    const auto src_dt = src_d.data_type();
+    const auto dst_dt = dst_d.data_type();
+
+    const dim_t outer_size = pd()->outer_size();
+    const dim_t nchunks = pd()->nchunks();
+    const dim_t inner_size = pd()->inner_size();
+    const dim_t lse_inner_size = pd()->lse_inner_size();
+    // lse is broadcast along a trailing group of inner dimensions, so each lse
+    // value covers `bcast_size` consecutive inner elements.
+    const dim_t bcast_size = lse_inner_size ? inner_size / lse_inner_size : 0;
+    const bool is_sum = pd()->is_sum();
+
+    // Chunk `c` is rescaled by `exp(lse_c - L)` with `L = log(sum_c
+    // exp(lse_c))`. Weights are laid out as lse: [outer][chunk][inner].
+    parallel_nd(outer_size, lse_inner_size, [&](dim_t ou, dim_t in) {
+        float *w = weights + ou * nchunks * lse_inner_size + in;
+        const auto lse_val = [&](dim_t c) {
+            return lse[lse_d.off_l((ou * nchunks + c) * lse_inner_size + in)];
+        };
+
+        float max = -INFINITY;
+        for (dim_t c = 0; c < nchunks; ++c)
+            max = nstl::max(max, lse_val(c));
+
+        // Rows where all chunks are empty have no mass and get zero weights.
+        float sum = 0.f;
+        for (dim_t c = 0; c < nchunks; ++c) {
+            const float e = max == -INFINITY ? 0.f : expf(lse_val(c) - max);
+            w[c * lse_inner_size] = e;
+            sum += e;
+        }
+        const float rcp_sum = sum > 0.f ? 1.f / sum : 0.f;
+        for (dim_t c = 0; c < nchunks; ++c)
+            w[c * lse_inner_size] *= rcp_sum;
+
+        if (merged_lse) {
+            const float merged = sum > 0.f ? max + logf(sum) : -INFINITY;
+            merged_lse[stat_d.off_l(ou * lse_inner_size + in)] = merged;
+        }
+    });
+
+    const auto abx = utils::pick(
+            pd()->ndims() - 1, a, ab, abc, abcd, abcde, abcdef);
+    const bool src_plain = src_d.matches_tag(abx);
+    const bool dst_plain = dst_d.matches_tag(abx);
+    const dim_t dst_nchunks = is_sum ? 1 : nchunks;
+    const auto src_off = [&](dim_t ou, dim_t c, dim_t in) {
+        const dim_t l_off = (ou * nchunks + c) * inner_size + in;
+        return src_plain ? src_d.offset0() + l_off : src_d.off_l(l_off);
+    };
+    const auto dst_off = [&](dim_t ou, dim_t c, dim_t in) {
+        const dim_t l_off = (ou * dst_nchunks + c) * inner_size + in;
+        return dst_plain ? dst_d.offset0() + l_off : dst_d.off_l(l_off);
+    };
+
+    constexpr dim_t block = 256;
+    const dim_t nblocks = utils::div_up(inner_size, block);
+
+    parallel_nd(outer_size, nblocks, [&](dim_t ou, dim_t ib) {
+        const dim_t beg = ib * block;
+        const dim_t len = nstl::min(block, inner_size - beg);
+        float acc[block] = {0.f};
+
+        for (dim_t c = 0; c < nchunks; ++c) {
+            const float *w = weights + (ou * nchunks + c) * lse_inner_size;
+            for (dim_t i = 0; i < len; ++i) {
+                const dim_t in = beg + i;
+                const float val = w[in / bcast_size]
+                        * io::load_float_value(src_dt, src, src_off(ou, c, in));
+                if (is_sum)
+                    acc[i] += val;
+                else
+                    io::store_float_value(dst_dt, val, dst, dst_off(ou, c, in));
+            }
+        }
+
+        if (is_sum) {
+            for (dim_t i = 0; i < len; ++i)
+                io::store_float_value(
+                        dst_dt, acc[i], dst, dst_off(ou, 0, beg + i));
+        }
+    });
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
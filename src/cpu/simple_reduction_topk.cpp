@@ -0,0 +1,121 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+
+#include "cpu/ref_io_helper.hpp"
+#include "cpu/simple_reduction_topk.hpp"
+#include "cpu/topk_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t simple_reduction_topk_t::execute(const exec_ctx_t &ctx) const {
+    using namespace memory_tracking::names;
+    using namespace topk_utils;
+
+    status_t status = status::success;
+    const auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_CLEAN_MEM(void *, DNNL_ARG_DST, status);
+    CHECK(status);
+    auto indices = CTX_OUT_CLEAN_MEM(int32_t *, DNNL_ARG_DST_1, status);
+    CHECK(status);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const auto src_dt = src_d.data_type();
+    const auto dst_dt = dst_d.data_type();
+
+    const dim_t nrows = pd()->nrows();
+    const dim_t n = pd()->row_size();
+    const dim_t k = pd()->topk_k();
+    const dim_t nchunks = pd()->nchunks();
+    const dim_t chunk_size = pd()->chunk_size();
+    // argmin is computed as argmax over negated values.
+    const bool negate = pd()->desc()->alg_kind == alg_kind::reduction_argmin;
+
+    const auto write_row = [&](dim_t row, const candidate_t *cand) {
+        for (dim_t j = 0; j < k; ++j) {
+            const float val = negate ? -cand[j].val : cand[j].val;
+            const dim_t off = dst_d.off_l(row * k + j);
+            io::store_float_value(dst_dt, val, dst, off);
+            if (indices) indices[off] = static_cast<int32_t>(cand[j].idx);
+        }
+    };
+
+    if (nchunks == 1) {
+        parallel(0, [&](const int ithr, const int nthr) {
+            dim_t start {0}, end {0};
+            balance211(nrows, nthr, ithr, start, end);
+            std::vector<candidate_t> heap;
+            heap.reserve(k);
+            for (dim_t row = start; row < end; ++row) {
+                select_topk(heap, src, src_dt, 0, n,
+                        src_d.offset0() + row * n, k, negate);
+                write_row(row, heap.data());
+            }
+        });
+        return status::success;
+    }
+
+    // A few huge rows: every thread selects candidates from a chunk of a row
+    // and the per-chunk candidates are merged afterwards.
+    auto scratchpad = ctx.get_scratchpad_grantor();
+    auto cand_val = scratchpad.template get<float>(key_reduction);
+    auto cand_idx = scratchpad.template get<dim_t>(key_reduction_1);
+
+    parallel_nd(nrows, nchunks, [&](dim_t row, dim_t c) {
+        const dim_t beg = c * chunk_size;
+        const dim_t end = nstl::min(n, beg + chunk_size);
+        std::vector<candidate_t> heap;
+        heap.reserve(k);
+        select_topk(heap, src, src_dt, beg, end, src_d.offset0() + row * n,
+                k, negate);
+        // The last chunk may be shorter than k: pad it with candidates that
+        // lose to any element of the row.
+        const dim_t off = (row * nchunks + c) * k;
+        const dim_t nfilled = static_cast<dim_t>(heap.size());
+        for (dim_t j = 0; j < k; ++j) {
+            cand_val[off + j] = j < nfilled
+                    ? heap[j].val
+                    : -nstl::numeric_limits<float>::infinity();
+            cand_idx[off + j] = j < nfilled ? heap[j].idx : n;
+        }
+    });
+
+    parallel_nd(nrows, [&](dim_t row) {
+        std::vector<candidate_t> cand(nchunks * k);
+        const dim_t off = row * nchunks * k;
+        for (dim_t j = 0; j < nchunks * k; ++j)
+            cand[j] = {cand_val[off + j], cand_idx[off + j]};
+        std::partial_sort(
+                cand.begin(), cand.begin() + k, cand.end(), is_better);
+        write_row(row, cand.data());
+    });
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,136 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_SIMPLE_REDUCTION_TOPK_HPP
+#define CPU_SIMPLE_REDUCTION_TOPK_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_reduction_pd.hpp"
+#include "cpu/platform.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// Implements the index-producing reductions (argmax, argmin and top-k) over
+// the innermost dimension of plain tensors. Every row is scanned in blocks;
+// a block is skipped with a single vectorized max once the candidate set is
+// full and the block cannot improve on its worst element. Rows that are too
+// few to occupy all threads are split into chunks whose candidates are merged
+// afterwards.
+struct simple_reduction_topk_t : public primitive_t {
+    struct pd_t : public cpu_reduction_pd_t {
+        using cpu_reduction_pd_t::cpu_reduction_pd_t;
+
+        DECLARE_COMMON_PD_T("simple:any", simple_reduction_topk_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            using namespace format_tag;
+
+            const auto src_dt = src_md()->data_type;
+            const auto dst_dt = dst_md()->data_type;
+
+            VDISPATCH_REDUCTION(is_index_alg(), VERBOSE_BAD_ALGORITHM);
+            VDISPATCH_REDUCTION(utils::one_of(src_dt, f32, bf16, f16),
+                    VERBOSE_UNSUPPORTED_DT);
+            VDISPATCH_REDUCTION(utils::one_of(dst_dt, f32, bf16, f16),
+                    VERBOSE_UNSUPPORTED_DT);
+            VDISPATCH_REDUCTION(platform::has_data_type_support(src_dt)
+                            && platform::has_data_type_support(dst_dt),
+                    VERBOSE_UNSUPPORTED_DT);
+            VDISPATCH_REDUCTION(
+                    attr()->has_default_values(), VERBOSE_UNSUPPORTED_ATTR);
+            VDISPATCH_REDUCTION(!memory_desc_wrapper(src_md()).has_zero_dim(),
+                    VERBOSE_EMPTY_TENSOR, "");
+            VDISPATCH_REDUCTION(set_default_params() == status::success,
+                    VERBOSE_UNSUPPORTED_TAG);
+
+            const int ndims = src_md()->ndims;
+            const format_tag_t tag = memory_desc_matches_one_of_tag(
+                    *src_md(), a, ab, abc, abcd, abcde, abcdef);
+            VDISPATCH_REDUCTION(tag != format_tag::undef
+                            && memory_desc_matches_tag(*dst_md(), tag),
+                    VERBOSE_UNSUPPORTED_TAG);
+            VDISPATCH_REDUCTION(reduce_axis() == ndims - 1,
+                    "reduction is supported over the innermost dimension "
+                    "only");
+
+            init_scratchpad();
+
+            return status::success;
+        }
+
+        dim_t nrows() const {
+            return memory_desc_wrapper(dst_md()).nelems() / topk_k();
+        }
+        dim_t row_size() const { return src_md()->dims[reduce_axis()]; }
+        dim_t nchunks() const { return nchunks_; }
+        dim_t chunk_size() const { return chunk_size_; }
+
+    private:
+        dim_t nchunks_ = 1;
+        dim_t chunk_size_ = 0;
+
+        void init_scratchpad() {
+            using namespace memory_tracking::names;
+
+            // Split rows only when there are not enough of them to occupy
+            // the threads and each chunk is still large enough to amortize
+            // the merge of k candidates.
+            constexpr dim_t min_chunk_size = 4096;
+            const dim_t nthr = dnnl_get_max_threads();
+            const dim_t n = row_size();
+            const dim_t k = topk_k();
+            nchunks_ = 1;
+            if (nrows() < nthr) {
+                nchunks_ = nstl::min(utils::div_up(nthr, nrows()),
+                        n / nstl::max(min_chunk_size, 2 * k));
+                nchunks_ = nstl::max<dim_t>(nchunks_, 1);
+            }
+            chunk_size_ = utils::div_up(n, nchunks_);
+            nchunks_ = utils::div_up(n, chunk_size_);
+
+            if (nchunks_ == 1) return;
+
+            auto scratchpad = scratchpad_registry().registrar();
+            const dim_t ncand = nrows() * nchunks_ * k;
+            scratchpad.template book<float>(key_reduction, ncand);
+            scratchpad.template book<dim_t>(key_reduction_1, ncand);
+        }
+    };
+
+    simple_reduction_topk_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
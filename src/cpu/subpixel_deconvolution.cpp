@@ -0,0 +1,426 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive_desc_iterator.hpp"
+#include "common/reorder.hpp"
+#include "common/stream.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/ref_convolution.hpp"
+#include "cpu/ref_convolution_int8.hpp"
+#include "cpu/ref_fused_convolution.hpp"
+
+#include "cpu/subpixel_deconvolution.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+namespace {
+// A reference convolution has nothing to gain over the reference
+// deconvolution.
+bool is_ref_conv(const primitive_desc_t *pd) {
+    return dynamic_cast<const ref_convolution_fwd_t::pd_t *>(pd)
+            || dynamic_cast<const ref_convolution_int8_fwd_t::pd_t *>(pd)
+            || dynamic_cast<const ref_fused_convolution_fwd_t::pd_t *>(pd);
+}
+} // namespace
+
+void subpixel_deconvolution_fwd_t::pd_t::phase_coords(
+        int phase, dim_t coords[3]) const {
+    coords[2] = phase % strides_[2];
+    phase /= strides_[2];
+    coords[1] = phase % strides_[1];
+    coords[0] = phase / strides_[1];
+}
+
+dim_t subpixel_deconvolution_fwd_t::pd_t::phase_size(
+        int d, dim_t coord) const {
+    const dim_t os[3] = {OD(), OH(), OW()};
+    return utils::div_up(os[d] - coord, strides_[d]);
+}
+
+bool subpixel_deconvolution_fwd_t::pd_t::post_ops_ok() const {
+    // Post-ops are applied by the nested convolutions to the points of a
+    // phase, so they must not depend on the spatial position of a point.
+    const auto &po = attr()->post_ops_;
+    for (int i = 0; i < po.len(); ++i) {
+        const auto &e = po.entry_[i];
+        if (e.is_eltwise() || e.is_sum(false, false)) continue;
+        if (!e.is_binary()) return false;
+        const auto &src1 = e.binary.src1_desc;
+        for (int d = 2; d < src1.ndims; ++d)
+            if (src1.dims[d] != 1) return false;
+    }
+    return true;
+}
+
+status_t subpixel_deconvolution_fwd_t::pd_t::init_phase_conv(
+        engine_t *engine, int phase) {
+    using namespace format_tag;
+    const int nsp = ndims() - 2;
+    const dim_t is[3] = {ID(), IH(), IW()};
+    dim_t coords[3];
+    phase_coords(phase, coords);
+
+    // Output q of a phase with remainder r by some dimension is output
+    // o = q * stride + r of the deconvolution. With c = r + left padding it
+    // gathers source points q + c / stride - j for taps
+    // k = c % stride + j * stride, j = 0 .. phase_ks - 1, which is a
+    // convolution with the kernel flipped and the left padding below.
+    dims_t dst_dims, strides, dilates, pad_l, pad_r;
+    dst_dims[0] = MB();
+    dst_dims[1] = OC();
+    for (int i = 0; i < nsp; ++i) {
+        const int d = 3 - nsp + i;
+        const dim_t c = coords[d] + pads_[d];
+        const dim_t q = phase_size(d, coords[d]);
+        dst_dims[2 + i] = q;
+        strides[i] = 1;
+        dilates[i] = 0;
+        pad_l[i] = phase_ks_[d] - 1 - c / strides_[d];
+        pad_r[i] = q - 1 + phase_ks_[d] - is[d] - pad_l[i];
+        if (pad_l[i] < 0 || pad_r[i] < 0) return status::unimplemented;
+    }
+
+    const auto dat_tag = utils::pick(nsp - 1, nwc, nhwc, ndhwc);
+    memory_desc_t phase_dst_md;
+    CHECK(memory_desc_init_by_tag(
+            phase_dst_md, ndims(), dst_dims, dst_md_.data_type, dat_tag));
+    memory_desc_t conv_wei_md;
+    CHECK(memory_desc_init_by_tag(conv_wei_md, phase_wei_md_.ndims,
+            phase_wei_md_.dims, phase_wei_md_.data_type, any));
+
+    convolution_desc_t cd;
+    CHECK(conv_desc_init(&cd, desc()->prop_kind, alg_kind::convolution_direct,
+            &src_md_, &conv_wei_md, with_bias() ? &bias_md_ : nullptr,
+            &phase_dst_md, strides, dilates, pad_l, pad_r));
+
+    primitive_desc_iterator_t it(engine, (op_desc_t *)&cd, attr(), nullptr);
+    if (!it.is_initialized()) return status::out_of_memory;
+    std::shared_ptr<primitive_desc_t> conv_pd;
+    while (++it != it.end()) {
+        if (is_ref_conv((*it).get())) continue;
+        conv_pd = *it;
+        break;
+    }
+    if (!conv_pd) return status::unimplemented;
+    if (*conv_pd->src_md() != src_md_ || *conv_pd->dst_md() != phase_dst_md)
+        return status::unimplemented;
+
+    std::shared_ptr<primitive_desc_t> reorder_pd;
+    if (*conv_pd->weights_md() != phase_wei_md_)
+        CHECK(reorder_primitive_desc_create(
+                reorder_pd, engine, &phase_wei_md_, conv_pd->weights_md()));
+
+    conv_pds_.push_back(conv_pd);
+    reorder_pds_.push_back(reorder_pd);
+    return status::success;
+}
+
+status_t subpixel_deconvolution_fwd_t::pd_t::init(engine_t *engine) {
+    using namespace data_type;
+    using namespace format_tag;
+    using smask_t = primitive_attr_t::skip_mask_t;
+
+    const auto src_type = desc()->src_desc.data_type;
+    const auto dst_type = desc()->dst_desc.data_type;
+    const bool is_int8 = utils::one_of(src_type, s8, u8);
+    auto skip_mask = smask_t::post_ops | smask_t::sum_dt;
+    if (is_int8)
+        skip_mask |= smask_t::scales_runtime | smask_t::zero_points_runtime;
+
+    VDISPATCH_DECONVOLUTION(is_fwd(), VERBOSE_BAD_PROPKIND);
+    VDISPATCH_DECONVOLUTION(desc()->alg_kind == alg_kind::deconvolution_direct,
+            VERBOSE_BAD_ALGORITHM);
+    VDISPATCH_DECONVOLUTION(!has_zero_dim_memory(), VERBOSE_EMPTY_TENSOR, "");
+    VDISPATCH_DECONVOLUTION(attr()->has_default_values(skip_mask, dst_type),
+            VERBOSE_UNSUPPORTED_ATTR);
+    VDISPATCH_DECONVOLUTION(post_ops_ok(), VERBOSE_UNSUPPORTED_POSTOP);
+
+    const int nsp = ndims() - 2;
+    const dim_t ks[3] = {KD(), KH(), KW()};
+    const dim_t os[3] = {OD(), OH(), OW()};
+    bool is_strided = false;
+    nphases_ = 1;
+    for (int i = 0; i < nsp; ++i) {
+        const int d = 3 - nsp + i;
+        strides_[d] = desc()->strides[i];
+        pads_[d] = desc()->padding[0][i];
+        VDISPATCH_DECONVOLUTION(desc()->dilates[i] == 0,
+                VERBOSE_UNSUPPORTED_FEATURE, "dilation");
+        // All phases have the same number of taps and at least one output
+        // point when the kernel is a multiple of the stride.
+        VDISPATCH_DECONVOLUTION(
+                ks[d] % strides_[d] == 0 && os[d] >= strides_[d],
+                VERBOSE_IMPL_HEURISTIC_FAIL,
+                "kernel size is not a multiple of stride");
+        phase_ks_[d] = ks[d] / strides_[d];
+        nphases_ *= strides_[d];
+        is_strided = is_strided || strides_[d] > 1;
+    }
+    VDISPATCH_DECONVOLUTION(
+            is_strided, VERBOSE_IMPL_HEURISTIC_FAIL, "unit strides");
+
+    // Phases are scattered point by point, so channels must be innermost.
+    // Weights in other layouts are converted to the plain one the phases are
+    // extracted from.
+    const auto dat_tag = utils::pick(nsp - 1, nwc, nhwc, ndhwc);
+    const auto wei_tag = with_groups()
+            ? utils::pick(nsp - 1, goiw, goihw, goidhw)
+            : utils::pick(nsp - 1, oiw, oihw, oidhw);
+    if (src_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(src_md_, dat_tag));
+    if (dst_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(dst_md_, dat_tag));
+    if (weights_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(weights_md_, wei_tag));
+    if (with_bias() && bias_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(bias_md_, x));
+    VDISPATCH_DECONVOLUTION(memory_desc_wrapper(src_md_).matches_tag(dat_tag)
+                    && memory_desc_wrapper(dst_md_).matches_tag(dat_tag),
+            VERBOSE_UNSUPPORTED_TAG);
+    CHECK(attr_.set_default_formats(&dst_md_));
+
+    CHECK(memory_desc_init_by_tag(plain_wei_md_, weights_md_.ndims,
+            weights_md_.dims, weights_md_.data_type, wei_tag));
+    if (!memory_desc_wrapper(weights_md_).matches_tag(wei_tag))
+        CHECK(reorder_primitive_desc_create(
+                wei_reorder_pd_, engine, &weights_md_, &plain_wei_md_));
+
+    dims_t phase_wei_dims;
+    utils::array_copy(phase_wei_dims, weights_md_.dims, weights_md_.ndims);
+    for (int i = 0; i < nsp; ++i)
+        phase_wei_dims[weights_md_.ndims - nsp + i] = phase_ks_[3 - nsp + i];
+    CHECK(memory_desc_init_by_tag(phase_wei_md_, weights_md_.ndims,
+            phase_wei_dims, weights_md_.data_type, wei_tag));
+
+    for (int phase = 0; phase < nphases_; ++phase)
+        VDISPATCH_DECONVOLUTION(
+                init_phase_conv(engine, phase) == status::success,
+                VERBOSE_PRIMITIVE_CREATION_FAIL, "phase convolution");
+
+    init_scratchpad();
+    return status::success;
+}
+
+void subpixel_deconvolution_fwd_t::pd_t::init_scratchpad() {
+    using namespace memory_tracking::names;
+    auto scratchpad = scratchpad_registry().registrar();
+
+    size_t phase_dst_size = 0, blocked_wei_size = 0;
+    for (int phase = 0; phase < nphases_; ++phase) {
+        const auto &conv_pd = conv_pds_[phase];
+        phase_dst_size = nstl::max(phase_dst_size,
+                memory_desc_wrapper(conv_pd->dst_md()).size());
+        scratchpad.book(key_nested_multiple + 2 * phase,
+                conv_pd->scratchpad_registry());
+        if (!reorder_pds_[phase]) continue;
+        blocked_wei_size = nstl::max(blocked_wei_size,
+                memory_desc_wrapper(conv_pd->weights_md()).size());
+        scratchpad.book(key_nested_multiple + 2 * phase + 1,
+                reorder_pds_[phase]->scratchpad_registry());
+    }
+    scratchpad.book(key_deconv_subpixel_dst, phase_dst_size, 1);
+    scratchpad.book(key_deconv_subpixel_wei,
+            nphases_ * memory_desc_wrapper(phase_wei_md_).size(), 1);
+    if (blocked_wei_size > 0)
+        scratchpad.book(key_deconv_subpixel_wei_blocked, blocked_wei_size, 1);
+    if (wei_reorder_pd_) {
+        scratchpad.book(key_deconv_subpixel_wei_plain,
+                memory_desc_wrapper(plain_wei_md_).size(), 1);
+        scratchpad.book(key_nested_multiple + 2 * nphases_,
+                wei_reorder_pd_->scratchpad_registry());
+    }
+}
+
+status_t subpixel_deconvolution_fwd_t::init(engine_t *engine) {
+    const int nphases = pd()->nphases_;
+    convs_.resize(nphases);
+    reorders_.resize(nphases);
+    for (int phase = 0; phase < nphases; ++phase) {
+        CHECK(pd()->conv_pds_[phase]->create_primitive(convs_[phase], engine));
+        if (pd()->reorder_pds_[phase])
+            CHECK(pd()->reorder_pds_[phase]->create_primitive(
+                    reorders_[phase], engine));
+    }
+    if (pd()->wei_reorder_pd_)
+        CHECK(pd()->wei_reorder_pd_->create_primitive(wei_reorder_, engine));
+    return status::success;
+}
+
+void subpixel_deconvolution_fwd_t::extract_weights(
+        const char *wei, char *phase_wei) const {
+    const memory_desc_wrapper wei_d(&pd()->plain_wei_md_);
+    const size_t dt_size = wei_d.data_type_size();
+    const dim_t KH = pd()->KH(), KW = pd()->KW();
+    const dim_t ks = pd()->KD() * KH * KW;
+    const dim_t *pks = pd()->phase_ks_;
+    const dim_t *strides = pd()->strides_;
+    const dim_t phase_ks = pks[0] * pks[1] * pks[2];
+    const dim_t nchannels = pd()->OC() * pd()->IC() / pd()->G();
+
+    // Every channel is read once and its kernel is split between the
+    // phases, which together hold exactly the taps of the kernel.
+    const char *wei_base = wei + wei_d.offset0() * dt_size;
+    parallel_nd(pd()->nphases_, nchannels, [&](dim_t phase, dim_t i) {
+        // Tap j of the phase kernel is tap k_start - j * stride of the
+        // deconvolution kernel by each dimension.
+        dim_t coords[3], k_start[3];
+        pd()->phase_coords((int)phase, coords);
+        for (int d = 0; d < 3; ++d)
+            k_start[d] = (coords[d] + pd()->pads_[d]) % strides[d]
+                    + (pks[d] - 1) * strides[d];
+
+        const char *kernel = wei_base + i * ks * dt_size;
+        char *phase_kernel = phase_wei
+                + (phase * nchannels + i) * phase_ks * dt_size;
+        for_(dim_t jd = 0; jd < pks[0]; ++jd)
+        for_(dim_t jh = 0; jh < pks[1]; ++jh)
+        for (dim_t jw = 0; jw < pks[2]; ++jw) {
+            const dim_t kd = k_start[0] - jd * strides[0];
+            const dim_t kh = k_start[1] - jh * strides[1];
+            const dim_t kw = k_start[2] - jw * strides[2];
+            const dim_t phase_off = (jd * pks[1] + jh) * pks[2] + jw;
+            const dim_t off = (kd * KH + kh) * KW + kw;
+            std::memcpy(phase_kernel + phase_off * dt_size,
+                    kernel + off * dt_size, dt_size);
+        }
+    });
+}
+
+void subpixel_deconvolution_fwd_t::copy_phase(
+        char *dst, char *phase_dst, int phase, bool to_dst) const {
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const size_t point_size = pd()->OC() * dst_d.data_type_size();
+    const dim_t OD = pd()->OD(), OH = pd()->OH(), OW = pd()->OW();
+    const dim_t *strides = pd()->strides_;
+    dim_t coords[3];
+    pd()->phase_coords(phase, coords);
+    const dim_t QD = pd()->phase_size(0, coords[0]);
+    const dim_t QH = pd()->phase_size(1, coords[1]);
+    const dim_t QW = pd()->phase_size(2, coords[2]);
+
+    char *dst_base = dst + dst_d.offset0() * dst_d.data_type_size();
+    parallel_nd(pd()->MB(), QD, QH, [&](dim_t n, dim_t qd, dim_t qh) {
+        const dim_t od = qd * strides[0] + coords[0];
+        const dim_t oh = qh * strides[1] + coords[1];
+        char *dst_row = dst_base + ((n * OD + od) * OH + oh) * OW * point_size;
+        char *phase_row
+                = phase_dst + ((n * QD + qd) * QH + qh) * QW * point_size;
+        for (dim_t qw = 0; qw < QW; ++qw) {
+            char *dst_point
+                    = dst_row + (qw * strides[2] + coords[2]) * point_size;
+            char *phase_point = phase_row + qw * point_size;
+            if (to_dst)
+                std::memcpy(dst_point, phase_point, point_size);
+            else
+                std::memcpy(phase_point, dst_point, point_size);
+        }
+    });
+}
+
+status_t subpixel_deconvolution_fwd_t::execute(const exec_ctx_t &ctx) const {
+    using namespace memory_tracking::names;
+    engine_t *engine = ctx.stream()->engine();
+    const auto scratchpad = ctx.get_scratchpad_grantor();
+
+    auto wei = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+    char *phase_wei_ptr
+            = scratchpad.template get<char>(key_deconv_subpixel_wei);
+    char *phase_dst_ptr
+            = scratchpad.template get<char>(key_deconv_subpixel_dst);
+    const size_t phase_wei_size
+            = memory_desc_wrapper(pd()->phase_wei_md_).size();
+
+    if (wei_reorder_) {
+        memory_t plain_wei(engine, &pd()->plain_wei_md_,
+                scratchpad.get_memory_storage(key_deconv_subpixel_wei_plain));
+        exec_args_t r_args;
+        r_args[DNNL_ARG_SRC] = ctx.args().at(DNNL_ARG_WEIGHTS);
+        r_args[DNNL_ARG_DST] = {&plain_wei, false};
+        exec_ctx_t r_ctx(ctx, std::move(r_args));
+
+        nested_scratchpad_t ns(
+                ctx, key_nested_multiple + 2 * pd()->nphases_, wei_reorder_);
+        r_ctx.set_scratchpad_grantor(ns.grantor());
+        CHECK(wei_reorder_->execute(r_ctx));
+        wei = scratchpad.template get<const char>(
+                key_deconv_subpixel_wei_plain);
+    }
+    extract_weights(wei, phase_wei_ptr);
+    // A sum post-op reads the destination, so the phase buffer is filled
+    // with the points of the phase before the convolution.
+    const bool with_sum
+            = pd()->attr()->post_ops_.find(primitive_kind::sum) != -1;
+
+    for (int phase = 0; phase < pd()->nphases_; ++phase) {
+        const auto &conv_pd = pd()->conv_pds_[phase];
+        memory_t phase_wei(engine, &pd()->phase_wei_md_,
+                scratchpad.get_memory_storage(key_deconv_subpixel_wei)
+                        ->get_sub_storage(
+                                phase * phase_wei_size, phase_wei_size));
+        memory_t phase_dst(engine, conv_pd->dst_md(),
+                scratchpad.get_memory_storage(key_deconv_subpixel_dst));
+        memory_t *conv_wei = &phase_wei;
+
+        std::unique_ptr<memory_t> blocked_wei;
+        if (reorders_[phase]) {
+            blocked_wei.reset(new memory_t(engine, conv_pd->weights_md(),
+                    scratchpad.get_memory_storage(
+                            key_deconv_subpixel_wei_blocked)));
+            exec_args_t r_args;
+            r_args[DNNL_ARG_SRC] = {&phase_wei, true};
+            r_args[DNNL_ARG_DST] = {blocked_wei.get(), false};
+            exec_ctx_t r_ctx(ctx, std::move(r_args));
+
+            nested_scratchpad_t ns(
+                    ctx, key_nested_multiple + 2 * phase + 1, reorders_[phase]);
+            r_ctx.set_scratchpad_grantor(ns.grantor());
+            CHECK(reorders_[phase]->execute(r_ctx));
+            conv_wei = blocked_wei.get();
+        }
+
+        if (with_sum) copy_phase(dst, phase_dst_ptr, phase, false);
+
+        exec_args_t conv_args = ctx.args();
+        conv_args[DNNL_ARG_WEIGHTS] = {conv_wei, true};
+        conv_args[DNNL_ARG_DST] = {&phase_dst, false};
+        exec_ctx_t conv_ctx(ctx, std::move(conv_args));
+
+        nested_scratchpad_t ns(
+                ctx, key_nested_multiple + 2 * phase, convs_[phase]);
+        conv_ctx.set_scratchpad_grantor(ns.grantor());
+        CHECK(convs_[phase]->execute(conv_ctx));
+
+        copy_phase(dst, phase_dst_ptr, phase, true);
+    }
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,120 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_SUBPIXEL_DECONVOLUTION_HPP
+#define CPU_SUBPIXEL_DECONVOLUTION_HPP
+
+#include <memory>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_deconvolution_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// Strided forward deconvolution computed by sub-pixel decomposition. Output
+// points with the same remainders of their coordinates modulo the strides
+// form a phase, and each of them only meets every stride-th tap of the
+// kernel. So a phase is a dense unit-stride forward convolution of the
+// source with a strided and flipped slice of the weights, which skips the
+// zeros of the upsampled source entirely. The phases are computed one by
+// one by nested convolutions into a temporary buffer, then scattered into
+// the interleaved destination. The weights of all phases are extracted
+// in a single pass over the weights at every execution, as they may change
+// between executions.
+struct subpixel_deconvolution_fwd_t : public primitive_t {
+    struct pd_t : public cpu_deconvolution_fwd_pd_t {
+        using cpu_deconvolution_fwd_pd_t::cpu_deconvolution_fwd_pd_t;
+
+        pd_t(const pd_t &other)
+            : cpu_deconvolution_fwd_pd_t(other)
+            , wei_reorder_pd_(other.wei_reorder_pd_
+                              ? other.wei_reorder_pd_->clone()
+                              : nullptr)
+            , plain_wei_md_(other.plain_wei_md_)
+            , phase_wei_md_(other.phase_wei_md_)
+            , nphases_(other.nphases_) {
+            utils::array_copy(strides_, other.strides_, 3);
+            utils::array_copy(pads_, other.pads_, 3);
+            utils::array_copy(phase_ks_, other.phase_ks_, 3);
+            for (const auto &conv_pd : other.conv_pds_)
+                conv_pds_.emplace_back(conv_pd->clone());
+            for (const auto &reorder_pd : other.reorder_pds_)
+                reorder_pds_.emplace_back(
+                        reorder_pd ? reorder_pd->clone() : nullptr);
+        }
+
+        DECLARE_COMMON_PD_T("subpixel:any", subpixel_deconvolution_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        // Phase of index `phase` as remainders by depth, height and width.
+        void phase_coords(int phase, dim_t coords[3]) const;
+        // Number of phase outputs along dimension `d` starting at `coord`.
+        dim_t phase_size(int d, dim_t coord) const;
+
+        // Nested convolution and weights reorder of each phase. A reorder
+        // is null when the convolution takes plain weights.
+        std::vector<std::shared_ptr<primitive_desc_t>> conv_pds_;
+        std::vector<std::shared_ptr<primitive_desc_t>> reorder_pds_;
+        // Converts the user weights into the plain layout the phases are
+        // extracted from. Not created when the user weights are plain.
+        std::shared_ptr<primitive_desc_t> wei_reorder_pd_;
+        memory_desc_t plain_wei_md_;
+        // Plain weights of a phase, same for all phases.
+        memory_desc_t phase_wei_md_;
+        // Strides, left padding and kernel size of a phase by depth,
+        // height and width. Missing spatial dimensions are trivial.
+        dim_t strides_[3] = {1, 1, 1};
+        dim_t pads_[3] = {0, 0, 0};
+        dim_t phase_ks_[3] = {1, 1, 1};
+        int nphases_ = 1;
+
+    private:
+        bool post_ops_ok() const;
+        status_t init_phase_conv(engine_t *engine, int phase);
+        void init_scratchpad();
+    };
+
+    subpixel_deconvolution_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+    // Extracts the weights of all phases one after another.
+    void extract_weights(const char *wei, char *phase_wei) const;
+    // Copies a phase between the destination and the dense phase buffer.
+    void copy_phase(char *dst, char *phase_dst, int phase, bool to_dst) const;
+
+    std::vector<std::shared_ptr<primitive_t>> convs_;
+    std::vector<std::shared_ptr<primitive_t>> reorders_;
+    std::shared_ptr<primitive_t> wei_reorder_;
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_TOPK_UTILS_HPP
+#define CPU_TOPK_UTILS_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include "common/bfloat16.hpp"
+#include "common/c_types_map.hpp"
+#include "common/float16.hpp"
+#include "common/nstl.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/ref_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+namespace topk_utils {
+
+struct candidate_t {
+    float val;
+    dim_t idx;
+};
+
+// Orders candidates from the best to the worst: larger values first and, for
+// equal values, the one met first in the row.
+inline bool is_better(const candidate_t &a, const candidate_t &b) {
+    return a.val > b.val || (a.val == b.val && a.idx < b.idx);
+}
+
+inline void load_block(float *buf, const void *src, data_type_t dt, dim_t off,
+        dim_t len, bool negate) {
+    switch (dt) {
+        case data_type::f32:
+            utils::array_copy(buf, static_cast<const float *>(src) + off, len);
+            break;
+        case data_type::bf16:
+            cvt_bfloat16_to_float(
+                    buf, static_cast<const bfloat16_t *>(src) + off, len);
+            break;
+        case data_type::f16:
+            cvt_float16_to_float(
+                    buf, static_cast<const float16_t *>(src) + off, len);
+            break;
+        default:
+            for (dim_t i = 0; i < len; ++i)
+                buf[i] = io::load_float_value(dt, src, off + i);
+            break;
+    }
+    if (negate) {
+        PRAGMA_OMP_SIMD()
+        for (dim_t i = 0; i < len; ++i)
+            buf[i] = -buf[i];
+    }
+}
+
+// Selects the k best elements of `src[beg, end)` of a dense row starting at
+// `row_off` and returns them sorted from the best to the worst. Candidates are
+// kept in a heap whose top is the worst of them; once the heap is full, a
+// block is only scanned element-wise if its maximum beats the heap top.
+inline void select_topk(std::vector<candidate_t> &heap, const void *src,
+        data_type_t dt, dim_t beg, dim_t end, dim_t row_off, dim_t k,
+        bool negate = false) {
+    constexpr dim_t block = 64;
+    float buf[block];
+
+    heap.clear();
+    for (dim_t b = beg; b < end; b += block) {
+        const dim_t len = nstl::min(block, end - b);
+        load_block(buf, src, dt, row_off + b, len, negate);
+
+        if (static_cast<dim_t>(heap.size()) == k) {
+            float block_max = buf[0];
+            PRAGMA_OMP_SIMD(reduction(max : block_max))
+            for (dim_t i = 1; i < len; ++i)
+                block_max = nstl::max(block_max, buf[i]);
+            // Elements are visited in increasing index order, so an equal
+            // value can never replace a candidate.
+            if (!(block_max > heap.front().val)) continue;
+        }
+
+        for (dim_t i = 0; i < len; ++i) {
+            const candidate_t c {buf[i], b + i};
+            if (static_cast<dim_t>(heap.size()) < k) {
+                heap.push_back(c);
+                std::push_heap(heap.begin(), heap.end(), is_better);
+            } else if (c.val > heap.front().val) {
+                std::pop_heap(heap.begin(), heap.end(), is_better);
+                heap.back() = c;
+                std::push_heap(heap.begin(), heap.end(), is_better);
+            }
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), is_better);
+}
+
+} // namespace topk_utils
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -156,6 +156,7 @@ void brgemm_kernel_execute_postops(const brgemm_kernel_t *brg_kernel, int bs,
     brgemm_p.skip_accm = post_ops_data.skip_accumulation ? 1 : 0;
     brgemm_p.BS = bs;
     brgemm_p.zp_a_val = post_ops_data.zp_a_val;
+    brgemm_p.a_zp_values = post_ops_data.a_zp_values;
     brgemm_p.post_ops_binary_rhs_arg_vec = post_ops_data.binary_post_ops_rhs;
     brgemm_p.oc_logical_off = post_ops_data.oc_logical_off;
     brgemm_p.dst_row_logical_off = post_ops_data.dst_row_logical_off;
@@ -198,6 +199,7 @@ void brgemm_kernel_execute_postops(const brgemm_kernel_t *brg_kernel, int bs,
     brgemm_p.skip_accm = post_ops_data.skip_accumulation ? 1 : 0;
     brgemm_p.BS = bs;
     brgemm_p.zp_a_val = post_ops_data.zp_a_val;
+    brgemm_p.a_zp_values = post_ops_data.a_zp_values;
     brgemm_p.post_ops_binary_rhs_arg_vec = post_ops_data.binary_post_ops_rhs;
     brgemm_p.oc_logical_off = post_ops_data.oc_logical_off;
     brgemm_p.dst_row_logical_off = post_ops_data.dst_row_logical_off;
@@ -454,14 +456,20 @@ status_t brgemm_desc_set_postops(brgemm_desc_t *brg,
             = [&](brgemm_broadcast_t &zp_type, int mem_arg) -> status_t {
         auto zero_points = attr->zero_points_;
 
-        // common zero point type is supported for now
-        if (!zero_points.common(mem_arg)) return status::unimplemented;
+        // common zero point type is supported for now, and zero points per
+        // channel of A and C for the depthwise kernel, where channels are
+        // the N dimension
+        const bool is_per_n = brg->is_dgmm && mem_arg != DNNL_ARG_WEIGHTS
+                && zero_points.get(mem_arg) == (1 << 1);
+        if (!zero_points.common(mem_arg) && !is_per_n)
+            return status::unimplemented;
 
         const bool skip_zero_point
                 = mem_arg == DNNL_ARG_WEIGHTS && brg->skip_zp_b_compensation;
         zp_type = zero_points.has_default_values(mem_arg) || skip_zero_point
                 ? brgemm_broadcast_t::none
-                : brgemm_broadcast_t::per_tensor;
+                : is_per_n ? brgemm_broadcast_t::per_n
+                           : brgemm_broadcast_t::per_tensor;
         return status::success;
     };
 
@@ -467,6 +467,7 @@ struct brgemm_kernel_params_t {
     const void *c_zp_values = nullptr;
     size_t skip_accm = 0;
     int32_t zp_a_val = 1;
+    const void *a_zp_values = nullptr;
     const void *ptr_dst_scales = nullptr;
     dim_t dynamic_LDA = 0;
     dim_t dynamic_LDB = 0;
@@ -562,6 +563,8 @@ private:
 /// @param dst_scales - Vector of inverted scale factor values for matix C,
 ///     common scale vector type only is supported, it must be broadcasted to
 ///     vector of simd width length.
+/// @param a_zp_values - A matrix zero point values, used instead of zp_a_val
+///     when they are set per N dimension.
 ///
 struct brgemm_post_ops_data_t {
     brgemm_post_ops_data_t() = default;
@@ -606,6 +609,7 @@ struct brgemm_post_ops_data_t {
     const bool do_only_comp = false;
     const bool do_only_zp_a_val = false;
     const float *dst_scales = nullptr;
+    const void *a_zp_values = nullptr;
 };
 
 } // namespace x64
@@ -147,7 +147,10 @@ void jit_brdgmm_kernel_base_t<Wmm>::read_params() {
     }
 
     if (compute_src_zp_) {
-        mov(reg_tmp, ptr[param1 + GET_OFF(zp_a_val)]);
+        if (src_zp_per_n())
+            mov(reg_tmp, ptr[param1 + GET_OFF(a_zp_values)]);
+        else
+            mov(reg_tmp, ptr[param1 + GET_OFF(zp_a_val)]);
         mov(ptr[rsp + src_zp_value_], reg_tmp);
 
         mov(reg_tmp, ptr[param1 + GET_OFF(a_zp_compensations)]);
@@ -450,7 +453,27 @@ void jit_brdgmm_kernel_base_t<Wmm>::store_accumulators_apply_post_ops(
         }
     }
 
-    if (compute_dst_zp_) {
+    if (compute_dst_zp_ && dst_zp_per_n()) {
+        // the values are padded to the N blocks by the caller
+        auto vmm_dst_zp = vmm_tmp(0);
+        mov(reg_dst_zero_point, ptr[rsp + dst_zp_value_]);
+        lea(reg_dst_zero_point,
+                ptr[reg_dst_zero_point + reg_aux_N * sizeof(int32_t)]);
+
+        for_(int n = 0; n < n_blocks; n++)
+        for (int v_i = 0; v_i < v_substep; ++v_i) {
+            const int substep_simd = get_substep_simd(n, v_i, has_n_tail);
+            if (substep_simd <= 0) continue;
+            const size_t offset
+                    = sizeof(int32_t) * (n * n_block1() + v_i * simd_w_);
+            vcvtdq2ps(vmm_dst_zp,
+                    maybe_EVEX_compress_addr(reg_dst_zero_point, offset));
+            for (int m = 0; m < m_blocks; m++) {
+                const Vmm vmm = accm(m_blocks, n_blocks, m, n, v_i);
+                vaddps(vmm, vmm, vmm_dst_zp);
+            }
+        }
+    } else if (compute_dst_zp_) {
         auto vmm_dst_zp = vmm_tmp(0);
         mov(reg_dst_zero_point, ptr[rsp + dst_zp_value_]);
         if (is_superset(brg.isa_impl, avx512_core)) {
@@ -615,11 +638,11 @@ void jit_brdgmm_kernel_base_t<Wmm>::compute_int8_compensation(
         lea(reg_s8s8_comp, ptr[reg_s8s8_comp + reg_aux_N * sizeof(int32_t)]);
     }
     if (compute_src_zp_) {
-        lea(reg_src_zero_point, ptr[rsp + src_zp_value_]);
+        set_src_zero_point_ptr();
         mov(reg_zp_compensation, ptr[rsp + zp_compensation_]);
         lea(reg_zp_compensation,
                 ptr[reg_zp_compensation + reg_aux_N * sizeof(int32_t)]);
-        if (!is_superset(brg.isa_impl, avx512_core))
+        if (!is_superset(brg.isa_impl, avx512_core) && !src_zp_per_n())
             uni_vpbroadcastd(vmm_bcast(), ptr[reg_src_zero_point]);
     }
 
@@ -638,7 +661,10 @@ void jit_brdgmm_kernel_base_t<Wmm>::compute_int8_compensation(
             const Vmm vmm_zp = vmm_zp_comp();
             vmovups(vmm_zp,
                     maybe_EVEX_compress_addr(reg_zp_compensation, offset));
-            if (is_superset(brg.isa_impl, avx512_core)) {
+            if (src_zp_per_n()) {
+                vpmulld(vmm_zp, vmm_zp,
+                        maybe_EVEX_compress_addr(reg_src_zero_point, offset));
+            } else if (is_superset(brg.isa_impl, avx512_core)) {
                 const bool src_zp_is_common = true;
                 vpmulld(vmm_zp, vmm_zp,
                         maybe_EVEX_compress_addr(
@@ -788,9 +814,20 @@ void jit_brdgmm_kernel_base_t<Wmm>::load_b(
     }
 }
 
+template <typename Wmm>
+void jit_brdgmm_kernel_base_t<Wmm>::set_src_zero_point_ptr() {
+    if (src_zp_per_n()) {
+        mov(reg_src_zero_point, ptr[rsp + src_zp_value_]);
+        lea(reg_src_zero_point,
+                ptr[reg_src_zero_point + reg_aux_N * sizeof(int32_t)]);
+    } else {
+        lea(reg_src_zero_point, ptr[rsp + src_zp_value_]);
+    }
+}
+
 template <typename Wmm>
 void jit_brdgmm_kernel_base_t<Wmm>::comp_dot_product(
-        compute_pad_kernel_t kernel_type, Vmm vmm_acc, Vmm vmmb) {
+        compute_pad_kernel_t kernel_type, Vmm vmm_acc, Vmm vmmb, int n_i) {
     switch (kernel_type) {
         case compute_pad_kernel_t::s8s8_kernel:
             vpdpbusd(vmm_acc, vmm_shift(), vmmb,
@@ -799,7 +836,16 @@ void jit_brdgmm_kernel_base_t<Wmm>::comp_dot_product(
                             : Xbyak::VexEncoding);
             break;
         case compute_pad_kernel_t::zero_point_kernel:
-            if (is_superset(brg.isa_impl, avx512_core)) {
+            if (src_zp_per_n()) {
+                // the weights are in the order of the accumulators, so are
+                // the zero points
+                uni_vmovups(vmm_zp_comp(),
+                        maybe_EVEX_compress_addr(
+                                reg_src_zero_point, comp_offset(n_i)));
+                if (is_fast_vnni_int8())
+                    vpermd(vmm_zp_comp(), vmm_permute(), vmm_zp_comp());
+                vpmulld(vmm_zp_comp(), vmm_zp_comp(), vmmb);
+            } else if (is_superset(brg.isa_impl, avx512_core)) {
                 vpmulld(vmm_zp_comp(), vmmb,
                         maybe_EVEX_compress_addr(reg_src_zero_point, 0, true));
             } else {
@@ -848,8 +894,7 @@ void jit_brdgmm_kernel_base_t<Wmm>::pad_comp_kernel(
 
     for (int pad_i = max_m_unroll; pad_i > 0; --pad_i) {
         L(jmp_table_labels[pad_i]);
-        if (is_zero_point_kernel)
-            lea(reg_src_zero_point, ptr[rsp + src_zp_value_]);
+        if (is_zero_point_kernel) set_src_zero_point_ptr();
         if (pad_i > m_blocks) continue;
         const int m_i = get_mi(pad_i);
         int p_b_i = 0;
@@ -857,12 +902,12 @@ void jit_brdgmm_kernel_base_t<Wmm>::pad_comp_kernel(
             if (get_substep_simd(n_i, 0, has_tail) <= 0) continue;
             const Vmm vmm_acc = accm(m_blocks, n_blocks, m_i, n_i, 0);
             if (p_b_i < n_preload_b_vmms) {
-                comp_dot_product(kernel_type, vmm_acc, vmm_b(p_b_i));
+                comp_dot_product(kernel_type, vmm_acc, vmm_b(p_b_i), n_i);
             } else {
                 // preloaded vmm_b not available
                 const Vmm vmm_wei = vmm_b(max_bvmms - 1);
                 load_b(vmm_wei, n_i, 0, has_tail, load_broadcast_wei);
-                comp_dot_product(kernel_type, vmm_acc, vmm_wei);
+                comp_dot_product(kernel_type, vmm_acc, vmm_wei, n_i);
             }
         }
     }
@@ -880,8 +925,7 @@ void jit_brdgmm_kernel_base_t<Wmm>::batch_pad_kernel(
     auto kernel_body = [&](compute_pad_kernel_t kernel_type) {
         const bool is_zero_point_kernel
                 = kernel_type == compute_pad_kernel_t::zero_point_kernel;
-        if (is_zero_point_kernel)
-            lea(reg_src_zero_point, ptr[rsp + src_zp_value_]);
+        if (is_zero_point_kernel) set_src_zero_point_ptr();
         for (int nb_i = 0; nb_i < n_blocks; nb_i += max_bvmms) {
             const int n_e = nstl::min(nb_i + max_bvmms, n_blocks) - nb_i;
             for (int i = 0; i < n_e; ++i) {
@@ -895,7 +939,7 @@ void jit_brdgmm_kernel_base_t<Wmm>::batch_pad_kernel(
                 const int n_i = nb_i + i;
                 if (get_substep_simd(n_i, 0, has_tail) <= 0) continue;
                 const Vmm vmm_acc = accm(m_blocks, n_blocks, m_i, n_i, 0);
-                comp_dot_product(kernel_type, vmm_acc, vmm_b(i));
+                comp_dot_product(kernel_type, vmm_acc, vmm_b(i), n_i);
             }
         }
     };
@@ -245,6 +245,7 @@ private:
     constexpr static int abi_param1_offs_ = 40;
     constexpr static int reg_dst_scales_offs_ = 48;
     constexpr static int reg_s8s8_comp_offs_ = 56;
+    // hold the zero point values, or pointers to them when set per_n
     constexpr static int dst_zp_value_ = 64;
     constexpr static int src_zp_value_ = 72;
     constexpr static int zp_compensation_ = 80;
@@ -284,6 +285,13 @@ private:
         return brg.is_bf16 && mayiuse(avx512_core_amx);
     }
 
+    bool src_zp_per_n() const {
+        return brg.zp_type_a == brgemm_broadcast_t::per_n;
+    }
+    bool dst_zp_per_n() const {
+        return brg.zp_type_c == brgemm_broadcast_t::per_n;
+    }
+
     bool req_vmm_reload() { return brg.is_bf16_emu; }
     bool assign_data_vmm_once() { return !req_vmm_reload(); }
 
@@ -340,8 +348,9 @@ private:
     void load_a(Vmm vmma, int m_i, int n_i, int v_i, bool has_n_tail);
     void load_b(
             Vmm vmmb, int n_i, int v_i, bool has_n_tail, bool wei_zp = false);
+    void set_src_zero_point_ptr();
     void comp_dot_product(compute_pad_kernel_t kernel_type, Vmm vmm_acc,
-            Vmm vmmb); // int8 compensation dot_product (zp and s8s8)
+            Vmm vmmb, int n_i); // int8 compensation dot_product (zp and s8s8)
     void pad_comp_kernel(compute_pad_kernel_t kernel_type, int m_blocks,
             int n_blocks, int padding, const Xbyak::Reg64 reg_pad,
             const std::function<int(int)> &get_mi, bool has_tail = false);
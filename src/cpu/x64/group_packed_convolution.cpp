@@ -0,0 +1,241 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive_desc_iterator.hpp"
+#include "common/reorder.hpp"
+#include "common/stream.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/fft_convolution.hpp"
+#include "cpu/gemm_convolution.hpp"
+#include "cpu/gemm_x8s8s32x_convolution.hpp"
+#include "cpu/ref_convolution.hpp"
+#include "cpu/ref_convolution_int8.hpp"
+#include "cpu/ref_fused_convolution.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/gemm_bf16_convolution.hpp"
+
+#include "cpu/x64/group_packed_convolution.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+namespace {
+// Reference, gemm-based and FFT implementations do not pad the channels of a
+// group, so they would only do the extra work on the zeros of the packed
+// weights. Packing is also not applied twice.
+bool is_packing_nested_impl(const primitive_desc_t *pd) {
+    using namespace data_type;
+    return !(dynamic_cast<const ref_convolution_fwd_t::pd_t *>(pd)
+            || dynamic_cast<const ref_convolution_int8_fwd_t::pd_t *>(pd)
+            || dynamic_cast<const ref_fused_convolution_fwd_t::pd_t *>(pd)
+            || dynamic_cast<const gemm_convolution_fwd_t::pd_t *>(pd)
+            || dynamic_cast<const gemm_x8s8s32x_convolution_fwd_t::pd_t *>(pd)
+            || dynamic_cast<const gemm_bf16_convolution_fwd_t<f32>::pd_t *>(pd)
+            || dynamic_cast<const gemm_bf16_convolution_fwd_t<bf16>::pd_t *>(
+                    pd)
+            || dynamic_cast<const fft_convolution_fwd_t::pd_t *>(pd)
+            || dynamic_cast<const group_packed_convolution_fwd_t::pd_t *>(pd));
+}
+} // namespace
+
+status_t group_packed_convolution_fwd_t::pd_t::init_g_pack() {
+    // Merged groups should not have more channels than a vector register
+    // holds, otherwise the zeros of the packed weights cost more than the
+    // padding of the channels they remove.
+    const dim_t simd_w = mayiuse(avx512_core) ? 16 : 8;
+    const dim_t icg = IC() / G();
+    const dim_t ocg = OC() / G();
+    // Depthwise convolutions have dedicated implementations.
+    if (icg == 1 && ocg == 1) return status::unimplemented;
+
+    // Optimized kernels process channels of a group by whole vectors, so the
+    // work is estimated by the channels rounded up to the vector length.
+    // Packing pays off only when the rounded packed channels are fewer than
+    // the rounded channels of the groups merged into them.
+    const auto padded_work = [&](dim_t ngroups, dim_t ic, dim_t oc) {
+        return ngroups * utils::rnd_up(ic, simd_w) * utils::rnd_up(oc, simd_w);
+    };
+    const dim_t native_work = padded_work(G(), icg, ocg);
+    for (dim_t g_pack = simd_w / nstl::max(icg, ocg); g_pack > 1; --g_pack) {
+        if (G() % g_pack != 0) continue;
+        if (padded_work(G() / g_pack, g_pack * icg, g_pack * ocg)
+                >= native_work)
+            continue;
+        g_pack_ = g_pack;
+        return status::success;
+    }
+    return status::unimplemented;
+}
+
+status_t group_packed_convolution_fwd_t::pd_t::init(engine_t *engine) {
+    using namespace format_tag;
+
+    VDISPATCH_CONV(is_fwd(), VERBOSE_BAD_PROPKIND);
+    VDISPATCH_CONV(set_default_alg_kind(alg_kind::convolution_direct),
+            VERBOSE_BAD_ALGORITHM);
+    VDISPATCH_CONV(with_groups(), VERBOSE_UNSUPPORTED_FEATURE, "no groups");
+    VDISPATCH_CONV(mayiuse(avx2), VERBOSE_UNSUPPORTED_ISA);
+    VDISPATCH_CONV(!has_zero_dim_memory(), VERBOSE_EMPTY_TENSOR, "");
+    VDISPATCH_CONV(init_g_pack() == status::success,
+            VERBOSE_IMPL_HEURISTIC_FAIL, "packing groups is not profitable");
+
+    // Packing is done from plain weights, the nested convolution is free to
+    // pick its own layout.
+    const auto wei_tag = utils::pick(ndims() - 3, goiw, goihw, goidhw);
+    if (weights_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(weights_md_, wei_tag));
+    VDISPATCH_CONV(memory_desc_wrapper(weights_md_).matches_tag(wei_tag),
+            VERBOSE_UNSUPPORTED_TAG_S, "weights");
+
+    dims_t packed_dims;
+    utils::array_copy(packed_dims, weights_md_.dims, weights_md_.ndims);
+    packed_dims[0] /= g_pack_;
+    packed_dims[1] *= g_pack_;
+    packed_dims[2] *= g_pack_;
+    CHECK(memory_desc_init_by_tag(packed_wei_md_, weights_md_.ndims,
+            packed_dims, weights_md_.data_type, wei_tag));
+    memory_desc_t conv_wei_md;
+    CHECK(memory_desc_init_by_tag(conv_wei_md, weights_md_.ndims, packed_dims,
+            weights_md_.data_type, any));
+
+    convolution_desc_t cd;
+    CHECK(conv_desc_init(&cd, desc()->prop_kind, desc()->alg_kind, &src_md_,
+            &conv_wei_md, with_bias() ? &bias_md_ : nullptr, &dst_md_,
+            desc()->strides, desc()->dilates, desc()->padding[0],
+            desc()->padding[1]));
+
+    primitive_desc_iterator_t it(engine, (op_desc_t *)&cd, attr(), nullptr);
+    if (!it.is_initialized()) return status::out_of_memory;
+    while (++it != it.end()) {
+        if (!is_packing_nested_impl((*it).get())) continue;
+        conv_pd_ = *it;
+        break;
+    }
+    VDISPATCH_CONV(conv_pd_, VERBOSE_PRIMITIVE_CREATION_FAIL, "convolution");
+
+    src_md_ = *conv_pd_->src_md();
+    dst_md_ = *conv_pd_->dst_md();
+    if (with_bias()) bias_md_ = *conv_pd_->weights_md(1);
+    CHECK(attr_.set_default_formats(&dst_md_));
+
+    if (*conv_pd_->weights_md() != packed_wei_md_)
+        CHECK(reorder_primitive_desc_create(
+                reorder_pd_, engine, &packed_wei_md_, conv_pd_->weights_md()));
+
+    name_.append(conv_pd_->name());
+    init_scratchpad();
+    return status::success;
+}
+
+void group_packed_convolution_fwd_t::pd_t::init_scratchpad() {
+    using namespace memory_tracking::names;
+    auto scratchpad = scratchpad_registry().registrar();
+
+    const memory_desc_wrapper packed_wei_d(&packed_wei_md_);
+    scratchpad.book(key_conv_group_packed_wei, packed_wei_d.size(), 1,
+            packed_wei_d.data_type_size());
+    scratchpad.book(key_nested_multiple, conv_pd_->scratchpad_registry());
+    if (reorder_pd_) {
+        const memory_desc_wrapper conv_wei_d(conv_pd_->weights_md());
+        scratchpad.book(key_conv_group_packed_wei_blocked, conv_wei_d.size(),
+                1, conv_wei_d.data_type_size());
+        scratchpad.book(
+                key_nested_multiple + 1, reorder_pd_->scratchpad_registry());
+    }
+}
+
+status_t group_packed_convolution_fwd_t::init(engine_t *engine) {
+    CHECK(pd()->conv_pd_->create_primitive(conv_p_, engine));
+    if (pd()->reorder_pd_)
+        CHECK(pd()->reorder_pd_->create_primitive(reorder_p_, engine));
+    return status::success;
+}
+
+void group_packed_convolution_fwd_t::pack_weights(
+        const char *wei, char *packed_wei) const {
+    const dim_t G = pd()->G();
+    const dim_t g_pack = pd()->g_pack_;
+    const dim_t icg = pd()->IC() / G;
+    const dim_t ocg = pd()->OC() / G;
+    const dim_t ks = pd()->KD() * pd()->KH() * pd()->KW();
+    const memory_desc_wrapper wei_d(pd()->weights_md());
+    const size_t dt_size = wei_d.data_type_size();
+
+    // Both layouts keep the input channels and the kernel of an output
+    // channel contiguous, so a packed row is the row of the user weights
+    // surrounded by the zeros of the other groups in the pack.
+    const size_t row_size = icg * ks * dt_size;
+    const char *wei_base = wei + wei_d.offset0() * dt_size;
+    parallel_nd(G, ocg, [&](dim_t g, dim_t oc) {
+        const dim_t row = g * ocg + oc;
+        char *packed_row = packed_wei + row * g_pack * row_size;
+        std::memset(packed_row, 0, g_pack * row_size);
+        std::memcpy(packed_row + (g % g_pack) * row_size,
+                wei_base + row * row_size, row_size);
+    });
+}
+
+status_t group_packed_convolution_fwd_t::execute(const exec_ctx_t &ctx) const {
+    using namespace memory_tracking::names;
+    engine_t *engine = ctx.stream()->engine();
+    const auto scratchpad = ctx.get_scratchpad_grantor();
+
+    const auto wei = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS);
+    pack_weights(wei, scratchpad.template get<char>(key_conv_group_packed_wei));
+
+    memory_t packed_wei(engine, &pd()->packed_wei_md_,
+            scratchpad.get_memory_storage(key_conv_group_packed_wei));
+    memory_t *conv_wei = &packed_wei;
+
+    std::unique_ptr<memory_t> blocked_wei;
+    if (reorder_p_) {
+        blocked_wei.reset(new memory_t(engine, pd()->conv_pd_->weights_md(),
+                scratchpad.get_memory_storage(
+                        key_conv_group_packed_wei_blocked)));
+        exec_args_t r_args;
+        r_args[DNNL_ARG_SRC] = {&packed_wei, true};
+        r_args[DNNL_ARG_DST] = {blocked_wei.get(), false};
+        exec_ctx_t r_ctx(ctx, std::move(r_args));
+
+        nested_scratchpad_t ns(ctx, key_nested_multiple + 1, reorder_p_);
+        r_ctx.set_scratchpad_grantor(ns.grantor());
+        CHECK(reorder_p_->execute(r_ctx));
+        conv_wei = blocked_wei.get();
+    }
+
+    exec_args_t conv_args = ctx.args();
+    conv_args[DNNL_ARG_WEIGHTS] = {conv_wei, true};
+    exec_ctx_t conv_ctx(ctx, std::move(conv_args));
+
+    nested_scratchpad_t ns(ctx, key_nested_multiple, conv_p_);
+    conv_ctx.set_scratchpad_grantor(ns.grantor());
+    return conv_p_->execute(conv_ctx);
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,96 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_GROUP_PACKED_CONVOLUTION_HPP
+#define CPU_X64_GROUP_PACKED_CONVOLUTION_HPP
+
+#include <memory>
+#include <string>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_convolution_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Forward grouped convolution with few channels per group. Optimized
+// kernels block channels of each group by the vector length, so groups of
+// 4 or 8 channels leave most of the lanes padded with zeros. Here
+// g_pack consecutive groups are merged into one group of g_pack times more
+// input and output channels with block-diagonal weights, and the problem is
+// passed to a nested convolution. Channels keep their order, so source,
+// destination, bias and per-channel attributes are shared with the nested
+// primitive as is; only the weights are packed at execution.
+struct group_packed_convolution_fwd_t : public primitive_t {
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        using cpu_convolution_fwd_pd_t::cpu_convolution_fwd_pd_t;
+
+        pd_t(const pd_t &other)
+            : cpu_convolution_fwd_pd_t(other)
+            , conv_pd_(other.conv_pd_->clone())
+            , reorder_pd_(other.reorder_pd_ ? other.reorder_pd_->clone()
+                                            : nullptr)
+            , g_pack_(other.g_pack_)
+            , packed_wei_md_(other.packed_wei_md_)
+            , name_(other.name_) {}
+
+        DECLARE_COMMON_PD_T(name_.c_str(), group_packed_convolution_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        std::shared_ptr<primitive_desc_t> conv_pd_;
+        // Converts the packed weights into the layout of the nested
+        // convolution. Not created when the nested one takes plain weights.
+        std::shared_ptr<primitive_desc_t> reorder_pd_;
+        // Number of user groups merged into one group of the nested
+        // convolution.
+        dim_t g_pack_ = 1;
+        // Plain weights of the nested convolution.
+        memory_desc_t packed_wei_md_;
+
+    private:
+        std::string name_ = "group_packed:any+";
+
+        status_t init_g_pack();
+        void init_scratchpad();
+    };
+
+    group_packed_convolution_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+    void pack_weights(const char *wei, char *packed_wei) const;
+
+    std::shared_ptr<primitive_t> conv_p_;
+    std::shared_ptr<primitive_t> reorder_p_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
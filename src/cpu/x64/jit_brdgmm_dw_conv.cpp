@@ -250,14 +250,20 @@ status_t brdgmm_dw_convolution_fwd_t::pd_t::init(engine_t *engine) {
     jcp.src_zero_point = !zp_attr.has_default_values(DNNL_ARG_SRC);
     jcp.dst_zero_point = !zp_attr.has_default_values(DNNL_ARG_DST);
 
-    // Only common zero points for the whole output tensor is supported now
+    // Zero points are either common, or set per channel, which is the N
+    // dimension of the brdgmm kernel
+    const int per_ch_mask = 1 << 1;
+    jcp.src_zero_point_per_ch
+            = jcp.src_zero_point && zp_attr.get(DNNL_ARG_SRC) == per_ch_mask;
+    jcp.dst_zero_point_per_ch
+            = jcp.dst_zero_point && zp_attr.get(DNNL_ARG_DST) == per_ch_mask;
     const bool has_zero_points = jcp.src_zero_point || jcp.dst_zero_point;
     const bool params_ok
             = IMPLICATION(has_zero_points, utils::one_of(jcp.src_dt, u8, s8))
             && IMPLICATION(jcp.src_zero_point,
-                    attr()->zero_points_.common(DNNL_ARG_SRC))
+                    zp_attr.common(DNNL_ARG_SRC) || jcp.src_zero_point_per_ch)
             && IMPLICATION(jcp.dst_zero_point,
-                    attr()->zero_points_.common(DNNL_ARG_DST));
+                    zp_attr.common(DNNL_ARG_DST) || jcp.dst_zero_point_per_ch);
     VDISPATCH_CONV(params_ok, VERBOSE_UNSUPPORTED_ZP_CFG);
 
     VDISPATCH_CONV(!(jcp.src_zero_point
@@ -278,10 +284,15 @@ status_t brdgmm_dw_convolution_fwd_t::pd_t::init(engine_t *engine) {
     jcp.adjusted_batch_size
             = div_up(rnd_up(jcp.kd * jcp.kh * jcp.kw * sc_size, 4096), sc_size);
     CHECK(init_brdgmm_conf());
-    if (jcp.with_scale) {
-        auto scratchpad = scratchpad_registry().registrar();
+    auto scratchpad = scratchpad_registry().registrar();
+    if (jcp.with_scale)
         book_precomputed_scales(scratchpad, attr_.scales_, OC());
-    }
+    // the kernel reads zero points per channel by whole channel blocks
+    const size_t zp_size = rnd_up(jcp.ngroups, jcp.ch_block);
+    if (jcp.src_zero_point_per_ch)
+        scratchpad.book<int32_t>(key_conv_zero_points_src, zp_size);
+    if (jcp.dst_zero_point_per_ch)
+        scratchpad.book<int32_t>(key_conv_zero_points_dst, zp_size);
 
     init_batch_elements();
     return status::success;
@@ -583,9 +594,30 @@ status_t brdgmm_dw_convolution_fwd_t::execute(const exec_ctx_t &ctx) const {
     DEFINE_ARG_SCALES_BUFFER(wei_scales, DNNL_ARG_WEIGHTS);
     DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
 
-    DEFINE_ZERO_POINT_VALUE(src_zero_point, DNNL_ARG_SRC);
+    int32_t src_zero_point = 0;
+    if (!jcp.src_zero_point_per_ch) {
+        DEFINE_ZERO_POINT_VALUE(src_zp_value, DNNL_ARG_SRC);
+        src_zero_point = src_zp_value;
+    }
+    DEFINE_ZERO_POINTS_BUFFER(src_zero_points, DNNL_ARG_SRC);
     DEFINE_ZERO_POINTS_BUFFER(dst_zero_point, DNNL_ARG_DST);
 
+    // copies zero points per channel to a buffer padded to the channel blocks
+    const auto pad_zero_points = [&](const int32_t *zero_points,
+                                         memory_tracking::key_t key) {
+        auto *padded = ctx.get_scratchpad_grantor().get<int32_t>(key);
+        const int ch_padded = rnd_up(jcp.ngroups, jcp.ch_block);
+        for (int c = 0; c < ch_padded; ++c)
+            padded[c] = c < jcp.ngroups ? zero_points[c] : 0;
+        return static_cast<const int32_t *>(padded);
+    };
+    const int32_t *src_zp_per_ch = jcp.src_zero_point_per_ch
+            ? pad_zero_points(src_zero_points, key_conv_zero_points_src)
+            : nullptr;
+    const int32_t *dst_zp_per_ch = jcp.dst_zero_point_per_ch
+            ? pad_zero_points(dst_zero_point, key_conv_zero_points_dst)
+            : nullptr;
+
     const int wei_scale_mask
             = pd()->attr()->scales_.get(DNNL_ARG_WEIGHTS).mask_;
     const float *oscales = scale_utils::precompute_scales(
@@ -755,8 +787,12 @@ status_t brdgmm_dw_convolution_fwd_t::execute(const exec_ctx_t &ctx) const {
                 post_ops_data.dst_scales = dst_scales;
                 post_ops_data.zp_a_val
                         = jcp.src_zero_point ? src_zero_point : 1;
-                post_ops_data.c_zp_values
-                        = jcp.dst_zero_point ? dst_zero_point : nullptr;
+                post_ops_data.a_zp_values = jcp.src_zero_point_per_ch
+                        ? src_zp_per_ch + ch
+                        : nullptr;
+                post_ops_data.c_zp_values = jcp.dst_zero_point_per_ch
+                        ? dst_zp_per_ch + ch
+                        : jcp.dst_zero_point ? dst_zero_point : nullptr;
                 post_ops_data.a_zp_compensations
                         = jcp.src_zero_point ? zp_compensation + ch : nullptr;
 
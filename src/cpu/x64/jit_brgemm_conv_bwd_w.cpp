@@ -57,7 +57,16 @@ status_t brgemm_convolution_bwd_weights_t::pd_t::init(engine_t *engine) {
     VDISPATCH_CONV(set_default_alg_kind(alg_kind::convolution_direct),
             VERBOSE_BAD_ALGORITHM);
     VDISPATCH_CONV(!has_zero_dim_memory(), VERBOSE_EMPTY_TENSOR, "");
-    VDISPATCH_CONV(attr()->has_default_values(), VERBOSE_UNSUPPORTED_ATTR);
+    VDISPATCH_CONV(attr()->has_default_values(
+                           primitive_attr_t::skip_mask_t::post_ops),
+            VERBOSE_UNSUPPORTED_ATTR);
+    // Accumulation is done by the f32 buffers the kernels write to, so the
+    // sum post-op is limited to f32 diff weights and diff bias.
+    VDISPATCH_CONV(IMPLICATION(!attr()->post_ops_.has_default_values(),
+                           with_sum() && diff_wei_type == f32
+                                   && utils::one_of(diff_bia_type,
+                                           data_type::undef, f32)),
+            VERBOSE_UNSUPPORTED_POSTOP);
 
     auto scratchpad = scratchpad_registry().registrar();
 
@@ -65,6 +74,7 @@ status_t brgemm_convolution_bwd_weights_t::pd_t::init(engine_t *engine) {
             src_md_, diff_weights_md_, diff_bias_md_, diff_dst_md_, attr_,
             dnnl_get_max_threads());
     if (status != status::success) return status;
+    jcp_.with_sum = with_sum();
 
     status = brgemm_convolution_utils::init_scratchpad_bwd_w(
             scratchpad, jcp_, src_md_, diff_weights_md_, diff_dst_md_);
@@ -322,6 +332,11 @@ struct brgemm_convolution_bwd_weights_t::thread_info_t {
     int ithr_but_oc = 0;
     int ithr_but_ic = 0;
 
+    // With a sum post-op the first reduction layer accumulates straight into
+    // the user diff weights and diff bias, so these are never initialized.
+    bool accumulate_wei = false;
+    bool accumulate_bias = false;
+
     int img_start = 0, img_end = 0, img_work = 0;
     int g_start = 0, g_end = 0, g_work = 0;
     int oc_b_start = 0, oc_b_end = 0, oc_b_work = 0;
@@ -390,6 +405,9 @@ struct brgemm_convolution_bwd_weights_t::thread_info_t {
         ithr_but_ic
                 = (ithr_mb * jcp.nthr_g + ithr_g) * jcp.nthr_oc_b + ithr_oc_b;
 
+        accumulate_wei = jcp.with_sum && ithr_mb == 0;
+        accumulate_bias = accumulate_wei && jcp.oc % jcp.oc_block == 0;
+
         int work_amount = jcp.nthr_mb_work;
         /* reduction dimension */
         balance211(work_amount, jcp.nthr_mb, ithr_mb, img_start, img_end);
@@ -763,7 +781,7 @@ struct brgemm_convolution_bwd_weights_t::thread_info_t {
         if (start >= end) {
             // for rare case if thread has no work by spatial dimension then we
             // need to initialize the output at least
-            if (jcp.with_bias) {
+            if (jcp.with_bias && !accumulate_bias) {
                 for_(int g = g_start; g < g_end; ++g)
                 {
                     void *p_bias = diff_bias + g * rnd_up(jcp.oc, jcp.oc_block)
@@ -773,6 +791,7 @@ struct brgemm_convolution_bwd_weights_t::thread_info_t {
                 }
             }
 
+            if (accumulate_wei) return true;
             for_(int g = g_start; g < g_end; ++g)
             for (int oc_b = oc_b_start; oc_b < oc_b_end; oc_b++) {
                 auto wei_offs_ext = pd()->ndims() == 3
@@ -794,7 +813,7 @@ struct brgemm_convolution_bwd_weights_t::thread_info_t {
             }
             return true;
         }
-        if (jcp.M < jcp.ic_block * jcp.nb_ic_blocking) {
+        if (jcp.M < jcp.ic_block * jcp.nb_ic_blocking && !accumulate_wei) {
             // For small ic we may calculate only needed part of diff_weights.
             // So we have to initialize diff_weights
             // TODO: initialize only not calculated part of diff_weights
@@ -966,8 +985,8 @@ void brgemm_convolution_bwd_weights_t::compute_diff_weights_2d(
 
                         bp.bias = diff_bias + g * rnd_up(jcp.oc, jcp.oc_block)
                                 + oc_b * jcp.oc_block;
-                        bp.channel
-                                = (start == ti->img_start) && (ohb_s == oh_s);
+                        bp.channel = !ti->accumulate_bias
+                                && (start == ti->img_start) && (ohb_s == oh_s);
 
                         bp.os_index_begin = ohb_s;
                         bp.os_index_end = ohb_e;
@@ -986,7 +1005,8 @@ void brgemm_convolution_bwd_weights_t::compute_diff_weights_2d(
                             || ti->ic_b_start == ti->ic_b_end)
                         continue;
 
-                    const auto do_init = (start == ti->img_start);
+                    const auto do_init
+                            = !ti->accumulate_wei && (start == ti->img_start);
 
                     for (int kh = 0; kh < jcp.kh; kh++) {
                         const int bs_ih_s = _pd->get_start_ih(kh, ohb_s);
@@ -1165,7 +1185,8 @@ void brgemm_convolution_bwd_weights_t::compute_diff_weights_3d(
                                         ? 0
                                         : 1;
 
-                                bp.channel = (start == ti->img_start)
+                                bp.channel = !ti->accumulate_bias
+                                        && (start == ti->img_start)
                                         && (odb_s == od_s) && (iodb == odb_s)
                                         && (ohb_s == oh_s);
                                 const auto dst_idx
@@ -1182,8 +1203,8 @@ void brgemm_convolution_bwd_weights_t::compute_diff_weights_3d(
                                 || ti->ic_b_start == ti->ic_b_end)
                             continue;
 
-                        const auto do_init
-                                = (start == ti->img_start && ohb_s == oh_s);
+                        const auto do_init = !ti->accumulate_wei
+                                && (start == ti->img_start && ohb_s == oh_s);
 
                         for (int kd = 0; kd < jcp.kd; kd++) {
                             const int bs_id_s = _pd->get_start_id(kd, odb_s);
@@ -1553,8 +1574,13 @@ void brgemm_convolution_bwd_weights_t::execute_backward_weights(
         const int padded_stride = rnd_up(jcp.oc, jcp.oc_block);
         const int stride = jcp.oc;
         for (int g = 0; g < jcp.ngroups; ++g) {
-            utils::array_copy(diff_bias_in + g * stride,
-                    diff_bias + g * padded_stride, stride);
+            if (jcp.with_sum) {
+                for (int oc = 0; oc < stride; ++oc)
+                    diff_bias_in[g * stride + oc]
+                            += diff_bias[g * padded_stride + oc];
+            } else
+                utils::array_copy(diff_bias_in + g * stride,
+                        diff_bias + g * padded_stride, stride);
         }
     }
 }
@@ -1010,7 +1010,30 @@ void brg_blocking_t::iterate_ker_block(brg_blocking_t &best_brgb, int kd_block_,
                 + acc_dsz * 2 * amx_h * oc_block;
         const auto L2_available = nstl::min(static_cast<size_t>(div_up(L2, 2)),
                 other_size > L2 ? 0 : L2 - other_size);
-        if (idp * ihp * w_block_size > L2_available) {
+        if (od > 1 && idp * ihp * w_block_size > L2_available) {
+            // Depth-slab tiling: a block of od_block output slices reads
+            // (od_block - 1) * stride_d + ext_kd source slices, so the halo
+            // by depth is accounted in the slab size.
+            const auto src_slice_size
+                    = static_cast<size_t>(2) * src_dsz * ic_size * iwp * ihp;
+            const auto dst_slice_size
+                    = static_cast<size_t>(dst_dsz) * ow * oc_block * oh;
+            od_block = 1;
+            for (int odb = od; odb > 1; odb--) {
+                const auto slab_size = src_slice_size
+                                * get_inp_size(idp, odb, kd, stride_d, dilate_d)
+                        + dst_slice_size * odb;
+                if (slab_size <= L2_available) {
+                    od_block = odb;
+                    break;
+                }
+            }
+            if (od_block == 1)
+                oh_block = utils::saturate(
+                        1, oh, int(L2_available / (w_block_size)));
+            else
+                oh_block = oh;
+        } else if (idp * ihp * w_block_size > L2_available) {
             od_block = utils::saturate(
                     1, od, int(L2_available / (ihp * w_block_size)));
             if (od_block == 1)
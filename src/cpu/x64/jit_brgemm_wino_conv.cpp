@@ -0,0 +1,447 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/platform.hpp"
+
+#include "cpu/x64/jit_brgemm_wino_conv.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::data_type;
+using namespace dnnl::impl::format_tag;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+namespace {
+// F(m x m, r x r) with m = 4 and r = 3, see A. Lavin and S. Gray, "Fast
+// Algorithms for Convolutional Neural Networks".
+constexpr int wino_m = 4;
+constexpr int wino_r = 3;
+constexpr int wino_alpha = wino_m + wino_r - 1;
+constexpr int wino_pos = wino_alpha * wino_alpha;
+constexpr dim_t max_tile_block = 32;
+constexpr int simd_w = 16;
+
+// u = G * g, where g is a kernel column of wino_r elements.
+inline void wei_transform_1d(const float *g, dim_t gs, float *u, dim_t us) {
+    const float g0 = g[0], g1 = g[gs], g2 = g[2 * gs];
+    u[0] = g0 / 4.f;
+    u[us] = -(g0 + g1 + g2) / 6.f;
+    u[2 * us] = -(g0 - g1 + g2) / 6.f;
+    u[3 * us] = g0 / 24.f + g1 / 12.f + g2 / 6.f;
+    u[4 * us] = g0 / 24.f - g1 / 12.f + g2 / 6.f;
+    u[5 * us] = g2;
+}
+
+// r = B^T * x for simd_w independent columns.
+inline void src_transform_1d(const float *x, dim_t xs, float *r, dim_t rs) {
+    PRAGMA_OMP_SIMD()
+    for (int v = 0; v < simd_w; v++) {
+        const float x0 = x[v], x1 = x[xs + v], x2 = x[2 * xs + v];
+        const float x3 = x[3 * xs + v], x4 = x[4 * xs + v];
+        const float x5 = x[5 * xs + v];
+        r[v] = 4.f * x0 - 5.f * x2 + x4;
+        r[rs + v] = -4.f * (x1 + x2) + x3 + x4;
+        r[2 * rs + v] = 4.f * (x1 - x2) - x3 + x4;
+        r[3 * rs + v] = 2.f * (x3 - x1) - x2 + x4;
+        r[4 * rs + v] = 2.f * (x1 - x3) - x2 + x4;
+        r[5 * rs + v] = 4.f * x1 - 5.f * x3 + x5;
+    }
+}
+
+// r = A^T * x for simd_w independent columns.
+inline void dst_transform_1d(const float *x, dim_t xs, float *r, dim_t rs) {
+    PRAGMA_OMP_SIMD()
+    for (int v = 0; v < simd_w; v++) {
+        const float x0 = x[v], x1 = x[xs + v], x2 = x[2 * xs + v];
+        const float x3 = x[3 * xs + v], x4 = x[4 * xs + v];
+        const float x5 = x[5 * xs + v];
+        const float s12 = x1 + x2, d12 = x1 - x2;
+        const float s34 = x3 + x4, d34 = x3 - x4;
+        r[v] = x0 + s12 + s34;
+        r[rs + v] = d12 + 2.f * d34;
+        r[2 * rs + v] = s12 + 4.f * s34;
+        r[3 * rs + v] = d12 + 8.f * d34 + x5;
+    }
+}
+
+// Describes the weights of `md` after transform_weights().
+status_t init_wino_wei_md(memory_desc_t &wino_md, const memory_desc_t &md) {
+    CHECK(memory_desc_init_by_tag(
+            wino_md, md.ndims, md.dims, md.data_type, format_tag::any));
+    const dim_t OC = md.dims[0];
+    const dim_t IC = md.dims[1];
+    wino_md.format_kind = format_kind::wino;
+    wino_desc_t &wd = wino_md.format_desc.wino_desc;
+    wd.wino_format = wino_memory_format_t::wino_wei_aaIO;
+    wd.r = wino_r;
+    wd.alpha = wino_alpha;
+    wd.ic = static_cast<int>(IC);
+    wd.oc = static_cast<int>(OC);
+    wd.ic_block = wd.ic;
+    wd.oc_block = wd.oc;
+    wd.ic2_block = 1;
+    wd.oc2_block = 1;
+    wd.adj_scale = 1.f;
+    wd.size = sizeof(float) * wino_pos * IC * OC;
+    return status::success;
+}
+
+// U = G * g * G^T stored as [wino_pos][IC][OC], so that every transformed
+// position is a plain row-major B matrix for brgemm.
+void transform_weights(
+        const float *wei, const memory_desc_wrapper &wei_d, float *wino_wei) {
+    const dim_t OC = wei_d.dims()[0];
+    const dim_t IC = wei_d.dims()[1];
+
+    parallel_nd(IC, OC, [&](dim_t ic, dim_t oc) {
+        float g[wino_r][wino_r];
+        for_(int kh = 0; kh < wino_r; kh++)
+        for (int kw = 0; kw < wino_r; kw++)
+            g[kh][kw] = wei[wei_d.off(oc, ic, kh, kw)];
+
+        float tmp[wino_alpha][wino_r];
+        for (int kw = 0; kw < wino_r; kw++)
+            wei_transform_1d(&g[0][kw], wino_r, &tmp[0][kw], wino_r);
+
+        float u[wino_alpha][wino_alpha];
+        for (int i = 0; i < wino_alpha; i++)
+            wei_transform_1d(&tmp[i][0], 1, &u[i][0], 1);
+
+        float *wei_ptr = wino_wei + ic * OC + oc;
+        for_(int i = 0; i < wino_alpha; i++)
+        for (int j = 0; j < wino_alpha; j++)
+            wei_ptr[(i * wino_alpha + j) * IC * OC] = u[i][j];
+    });
+}
+} // namespace
+
+status_t brgemm_wino_convolution_fwd_t::pd_t::init(engine_t *engine) {
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    isa_ = mayiuse(avx512_core) ? avx512_core
+            : mayiuse(avx2)     ? avx2
+                                : isa_undef;
+
+    VDISPATCH_CONV(is_fwd(), VERBOSE_BAD_PROPKIND);
+    VDISPATCH_CONV(desc()->alg_kind == alg_kind::convolution_winograd,
+            VERBOSE_BAD_ALGORITHM);
+    VDISPATCH_CONV(
+            expect_data_types(f32, f32, f32, f32, f32), VERBOSE_UNSUPPORTED_DT);
+    VDISPATCH_CONV(isa_ != isa_undef, VERBOSE_UNSUPPORTED_ISA);
+    VDISPATCH_CONV(!has_zero_dim_memory(), VERBOSE_EMPTY_TENSOR, "");
+    VDISPATCH_CONV(ndims() == 4, VERBOSE_BAD_NDIMS, "src", ndims());
+    VDISPATCH_CONV(!with_groups(), VERBOSE_UNSUPPORTED_FEATURE, "groups");
+    VDISPATCH_CONV(everyone_is(wino_r, KH(), KW()),
+            VERBOSE_UNSUPPORTED_FEATURE, "kernel size other than 3x3");
+    VDISPATCH_CONV(everyone_is(1, KSH(), KSW()), VERBOSE_UNSUPPORTED_FEATURE,
+            "strides");
+    VDISPATCH_CONV(everyone_is(0, KDH(), KDW()), VERBOSE_UNSUPPORTED_FEATURE,
+            "dilations");
+    VDISPATCH_CONV(attr()->has_default_values(skip_mask_t::post_ops, f32),
+            VERBOSE_UNSUPPORTED_ATTR);
+    VDISPATCH_CONV(ref_post_ops_t::primitive_kind_ok(attr()->post_ops_)
+                    && attr()->post_ops_.check_sum_consistency(
+                            f32, /* is_int8 */ false),
+            VERBOSE_UNSUPPORTED_POSTOP);
+    memory_desc_t wino_wei_md;
+    CHECK(init_wino_wei_md(wino_wei_md, weights_md_));
+    if (weights_md_.format_kind == format_kind::any)
+        weights_md_ = wino_wei_md;
+    VDISPATCH_CONV(set_default_formats_common(nhwc, hwio, nhwc),
+            VERBOSE_UNSUPPORTED_TAG);
+    VDISPATCH_CONV(memory_desc_matches_tag(src_md_, nhwc)
+                    && memory_desc_matches_tag(dst_md_, nhwc)
+                    && (memory_desc_wrapper(weights_md_).is_blocking_desc()
+                            || weights_md_ == wino_wei_md),
+            VERBOSE_UNSUPPORTED_TAG);
+    CHECK(attr_.set_default_formats(dst_md(0)));
+
+    nthr_ = dnnl_get_max_threads();
+    tiles_h_ = div_up(OH(), wino_m);
+    tiles_w_ = div_up(OW(), wino_m);
+    nb_tiles_ = MB() * tiles_h_ * tiles_w_;
+
+    // Keep the transformed source and destination of a tile block within
+    // half of L2, and make sure every thread gets at least one block.
+    const dim_t L2 = platform::get_per_core_cache_size(2);
+    const dim_t tile_bytes = wino_pos * sizeof(float) * (IC() + OC());
+    tile_block_ = nstl::min(max_tile_block, L2 / 2 / tile_bytes);
+    tile_block_ = nstl::min(tile_block_, div_up(nb_tiles_, nthr_));
+    tile_block_ = nstl::max(tile_block_, dim_t(1));
+    tile_tail_ = nb_tiles_ % tile_block_;
+
+    CHECK(brgemm_desc_init(&brg_, isa_, brgemm_addr, f32, f32, false, false,
+            brgemm_row_major, 1.f, 0.f, IC(), OC(), OC(), tile_block_, OC(),
+            IC()));
+    if (tile_tail_ > 0)
+        CHECK(brgemm_desc_init(&brg_tail_, isa_, brgemm_addr, f32, f32, false,
+                false, brgemm_row_major, 1.f, 0.f, IC(), OC(), OC(),
+                tile_tail_, OC(), IC()));
+
+    init_scratchpad();
+    return status::success;
+}
+
+void brgemm_wino_convolution_fwd_t::pd_t::init_scratchpad() {
+    auto scratchpad = scratchpad_registry().registrar();
+    if (!memory_desc_wrapper(weights_md(0)).is_wino_desc())
+        scratchpad.template book<float>(key_wino_U, wino_pos * IC() * OC());
+    scratchpad.template book<float>(
+            key_wino_V, (size_t)nthr_ * wino_pos * tile_block_ * IC());
+    scratchpad.template book<float>(
+            key_wino_M, (size_t)nthr_ * wino_pos * tile_block_ * OC());
+}
+
+status_t brgemm_wino_convolution_fwd_t::init(engine_t *engine) {
+    brgemm_kernel_t *brg_kernel = nullptr;
+    CHECK(brgemm_kernel_create(&brg_kernel, pd()->brg_));
+    CHECK(safe_ptr_assign(brg_kernel_, brg_kernel));
+    if (pd()->tile_tail_ > 0) {
+        CHECK(brgemm_kernel_create(&brg_kernel, pd()->brg_tail_));
+        CHECK(safe_ptr_assign(brg_kernel_tail_, brg_kernel));
+    }
+
+    CHECK(safe_ptr_assign(
+            ref_post_ops_, new ref_post_ops_t(pd()->attr()->post_ops_)));
+    CHECK(ref_post_ops_->init(pd()->dst_md()));
+    return status::success;
+}
+
+status_t brgemm_wino_convolution_fwd_t::execute(const exec_ctx_t &ctx) const {
+    const auto src = CTX_IN_MEM(const float *, DNNL_ARG_SRC);
+    const auto wei = CTX_IN_MEM(const float *, DNNL_ARG_WEIGHTS);
+    const auto bias = CTX_IN_MEM(const float *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(float *, DNNL_ARG_DST);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper wei_d(pd()->weights_md(0));
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+
+    const auto scratchpad = ctx.get_scratchpad_grantor();
+    float *wino_src = scratchpad.template get<float>(key_wino_V);
+    float *wino_dst = scratchpad.template get<float>(key_wino_M);
+
+    // Weights in the wino format are already transformed by a reorder.
+    const float *wino_wei = wei;
+    if (!wei_d.is_wino_desc()) {
+        float *wino_wei_buf = scratchpad.template get<float>(key_wino_U);
+        transform_weights(wei, wei_d, wino_wei_buf);
+        wino_wei = wino_wei_buf;
+    }
+
+    const dim_t MB = pd()->MB();
+    const dim_t IC = pd()->IC();
+    const dim_t OC = pd()->OC();
+    const dim_t IH = pd()->IH();
+    const dim_t IW = pd()->IW();
+    const dim_t OH = pd()->OH();
+    const dim_t OW = pd()->OW();
+    const dim_t t_pad = pd()->padT();
+    const dim_t l_pad = pd()->padL();
+    const dim_t tiles_h = pd()->tiles_h_;
+    const dim_t tiles_w = pd()->tiles_w_;
+    const dim_t nb_tiles = pd()->nb_tiles_;
+    const dim_t tile_block = pd()->tile_block_;
+    const dim_t nb_tile_blocks = div_up(nb_tiles, tile_block);
+    const bool with_post_ops = pd()->attr()->post_ops_.len() > 0;
+
+    // Strides between transformed positions in the per-thread buffers.
+    const dim_t src_pos_stride = tile_block * IC;
+    const dim_t dst_pos_stride = tile_block * OC;
+
+    // V[pos][t][:] = (B^T * d * B)[pos] for the input tile of tile `t`.
+    auto transform_src_tile = [&](dim_t tile, float *wino_src_tile) {
+        dim_t n {0}, th {0}, tw {0};
+        nd_iterator_init(tile, n, MB, th, tiles_h, tw, tiles_w);
+        const dim_t ih0 = th * wino_m - t_pad;
+        const dim_t iw0 = tw * wino_m - l_pad;
+
+        for (dim_t ic = 0; ic < IC; ic += simd_w) {
+            const dim_t len = nstl::min<dim_t>(simd_w, IC - ic);
+            float in[wino_alpha][wino_alpha][simd_w];
+            float tmp[wino_alpha][wino_alpha][simd_w];
+            for_(int i = 0; i < wino_alpha; i++)
+            for (int j = 0; j < wino_alpha; j++) {
+                const dim_t ih = ih0 + i;
+                const dim_t iw = iw0 + j;
+                const bool is_inside = ih >= 0 && ih < IH && iw >= 0
+                        && iw < IW;
+                dim_t v = 0;
+                if (is_inside) {
+                    const float *s = src + src_d.blk_off(n, ic, ih, iw);
+                    for (; v < len; v++)
+                        in[i][j][v] = s[v];
+                }
+                for (; v < simd_w; v++)
+                    in[i][j][v] = 0.f;
+            }
+
+            const dim_t row_stride = wino_alpha * simd_w;
+            for (int j = 0; j < wino_alpha; j++)
+                src_transform_1d(
+                        &in[0][j][0], row_stride, &tmp[0][j][0], row_stride);
+            for (int i = 0; i < wino_alpha; i++)
+                src_transform_1d(&tmp[i][0][0], simd_w, &in[i][0][0], simd_w);
+
+            for_(int i = 0; i < wino_alpha; i++)
+            for (int j = 0; j < wino_alpha; j++) {
+                float *v_ptr = wino_src_tile
+                        + (i * wino_alpha + j) * src_pos_stride + ic;
+                for (dim_t v = 0; v < len; v++)
+                    v_ptr[v] = in[i][j][v];
+            }
+        }
+    };
+
+    // dst = A^T * M * A for tile `t`, followed by bias and post-ops.
+    auto transform_dst_tile = [&](dim_t tile, const float *wino_dst_tile) {
+        dim_t n {0}, th {0}, tw {0};
+        nd_iterator_init(tile, n, MB, th, tiles_h, tw, tiles_w);
+        const dim_t oh0 = th * wino_m;
+        const dim_t ow0 = tw * wino_m;
+
+        for (dim_t oc = 0; oc < OC; oc += simd_w) {
+            const dim_t len = nstl::min<dim_t>(simd_w, OC - oc);
+            float m[wino_alpha][wino_alpha][simd_w];
+            float tmp[wino_m][wino_alpha][simd_w];
+            float out[wino_m][wino_m][simd_w];
+            for_(int i = 0; i < wino_alpha; i++)
+            for (int j = 0; j < wino_alpha; j++) {
+                const float *m_ptr = wino_dst_tile
+                        + (i * wino_alpha + j) * dst_pos_stride + oc;
+                dim_t v = 0;
+                for (; v < len; v++)
+                    m[i][j][v] = m_ptr[v];
+                for (; v < simd_w; v++)
+                    m[i][j][v] = 0.f;
+            }
+
+            const dim_t row_stride = wino_alpha * simd_w;
+            for (int j = 0; j < wino_alpha; j++)
+                dst_transform_1d(
+                        &m[0][j][0], row_stride, &tmp[0][j][0], row_stride);
+            for (int i = 0; i < wino_m; i++)
+                dst_transform_1d(&tmp[i][0][0], simd_w, &out[i][0][0], simd_w);
+
+            for_(int i = 0; i < wino_m; i++)
+            for (int j = 0; j < wino_m; j++) {
+                const dim_t oh = oh0 + i;
+                const dim_t ow = ow0 + j;
+                if (oh >= OH || ow >= OW) continue;
+                float *d = dst + dst_d.blk_off(n, oc, oh, ow);
+                for (dim_t v = 0; v < len; v++) {
+                    float res = out[i][j][v];
+                    if (bias) res += bias[oc + v];
+                    if (with_post_ops) {
+                        ref_post_ops_t::args_t args;
+                        args.dst_val = d[v];
+                        args.ctx = &ctx;
+                        args.l_offset = ((n * OC + oc + v) * OH + oh) * OW + ow;
+                        args.dst_md = pd()->dst_md();
+                        ref_post_ops_->execute(res, args);
+                    }
+                    d[v] = res;
+                }
+            }
+        }
+    };
+
+    parallel(pd()->nthr_, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(nb_tile_blocks, nthr, ithr, start, end);
+        if (start >= end) return;
+
+        float *wino_src_thr = wino_src + ithr * wino_pos * src_pos_stride;
+        float *wino_dst_thr = wino_dst + ithr * wino_pos * dst_pos_stride;
+
+        for (dim_t blk = start; blk < end; blk++) {
+            const dim_t tile_start = blk * tile_block;
+            const dim_t nb_block_tiles
+                    = nstl::min(tile_block, nb_tiles - tile_start);
+            const brgemm_kernel_t *brg_kernel = nb_block_tiles < tile_block
+                    ? brg_kernel_tail_.get()
+                    : brg_kernel_.get();
+
+            for (dim_t t = 0; t < nb_block_tiles; t++)
+                transform_src_tile(tile_start + t, wino_src_thr + t * IC);
+
+            for (int pos = 0; pos < wino_pos; pos++) {
+                brgemm_batch_element_t batch;
+                batch.ptr.A = wino_src_thr + pos * src_pos_stride;
+                batch.ptr.B = wino_wei + pos * IC * OC;
+                brgemm_kernel_execute(brg_kernel, 1, &batch,
+                        (void *)(wino_dst_thr + pos * dst_pos_stride));
+            }
+
+            for (dim_t t = 0; t < nb_block_tiles; t++)
+                transform_dst_tile(tile_start + t, wino_dst_thr + t * OC);
+        }
+    });
+
+    return status::success;
+}
+
+status_t brgemm_wino_weights_reorder_t::pd_t::create(reorder_pd_t **reorder_pd,
+        engine_t *engine, const primitive_attr_t *attr, engine_t *src_engine,
+        const memory_desc_t *src_md, engine_t *dst_engine,
+        const memory_desc_t *dst_md) {
+    using namespace status;
+
+    const memory_desc_wrapper id(src_md), od(dst_md);
+    if (!od.is_wino_desc()) return invalid_arguments;
+
+    VDISPATCH_REORDER_IC(id.data_type() == f32 && id.ndims() == 4
+                    && id.is_blocking_desc()
+                    && !id.has_runtime_dims_or_strides(),
+            VERBOSE_UNSUPPORTED_TAG);
+    VDISPATCH_REORDER_IC(everyone_is(wino_r, id.dims()[2], id.dims()[3]),
+            VERBOSE_UNSUPPORTED_FEATURE, "kernel size other than 3x3");
+    VDISPATCH_REORDER_IC(
+            attr->has_default_values(), VERBOSE_UNSUPPORTED_ATTR);
+
+    memory_desc_t wino_wei_md;
+    CHECK(init_wino_wei_md(wino_wei_md, *src_md));
+    VDISPATCH_REORDER_IC(*dst_md == wino_wei_md, VERBOSE_UNSUPPORTED_TAG);
+
+    auto _pd = make_unique_pd<pd_t>(
+            attr, src_engine->kind(), src_md, dst_engine->kind(), dst_md);
+    if (_pd == nullptr) return out_of_memory;
+    CHECK(_pd->init(engine, src_engine, dst_engine));
+    CHECK(_pd->init_scratchpad_md());
+    return safe_ptr_assign<reorder_pd_t>(*reorder_pd, _pd.release());
+}
+
+status_t brgemm_wino_weights_reorder_t::execute(const exec_ctx_t &ctx) const {
+    const auto src = CTX_IN_MEM(const float *, DNNL_ARG_FROM);
+    auto dst = CTX_OUT_MEM(float *, DNNL_ARG_TO);
+    transform_weights(src, memory_desc_wrapper(pd()->src_md()), dst);
+    return status::success;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,112 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_BRGEMM_WINO_CONV_HPP
+#define CPU_X64_JIT_BRGEMM_WINO_CONV_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+
+#include "cpu/cpu_convolution_pd.hpp"
+#include "cpu/primitive_attr_postops.hpp"
+#include "cpu/reorder/cpu_reorder_pd.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Winograd F(4x4, 3x3) forward convolution. Input and output transforms are
+// done per block of tiles right before and after the brgemm calls, so the
+// transformed data never leaves the cache. Each of the 6x6 transformed
+// positions of the block is a single (tiles x IC) * (IC x OC) brgemm call.
+// With `any` weights the pd picks the wino_wei_aaIO format, so the weights
+// transform is done once by brgemm_wino_weights_reorder_t. Plain weights are
+// transformed on every execution.
+struct brgemm_wino_convolution_fwd_t : public primitive_t {
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        using cpu_convolution_fwd_pd_t::cpu_convolution_fwd_pd_t;
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("brgemm_wino:", isa_, ""),
+                brgemm_wino_convolution_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        cpu_isa_t isa_ = isa_undef;
+        int nthr_ = 0;
+        // Number of output tiles along height and width of a single image.
+        dim_t tiles_h_ = 0;
+        dim_t tiles_w_ = 0;
+        // Number of output tiles in the whole minibatch.
+        dim_t nb_tiles_ = 0;
+        // Number of tiles handled by one brgemm call and the last one.
+        dim_t tile_block_ = 0;
+        dim_t tile_tail_ = 0;
+        brgemm_desc_t brg_;
+        brgemm_desc_t brg_tail_;
+
+    private:
+        void init_scratchpad();
+    };
+
+    brgemm_wino_convolution_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    std::unique_ptr<brgemm_kernel_t> brg_kernel_;
+    std::unique_ptr<brgemm_kernel_t> brg_kernel_tail_;
+    std::unique_ptr<ref_post_ops_t> ref_post_ops_;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+};
+
+// Transforms plain weights into the wino_wei_aaIO format.
+struct brgemm_wino_weights_reorder_t : public primitive_t {
+    struct pd_t : public cpu_reorder_pd_t {
+        using cpu_reorder_pd_t::cpu_reorder_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                "brgemm_wino_weights_reorder", brgemm_wino_weights_reorder_t);
+
+    private:
+        static status_t create(reorder_pd_t **reorder_pd, engine_t *engine,
+                const primitive_attr_t *attr, engine_t *src_engine,
+                const memory_desc_t *src_md, engine_t *dst_engine,
+                const memory_desc_t *dst_md);
+
+        friend dnnl::impl::impl_list_item_t;
+    };
+
+    brgemm_wino_weights_reorder_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
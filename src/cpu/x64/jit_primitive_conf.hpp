@@ -654,6 +654,8 @@ struct jit_brdgmm_conv_conf_t {
     bool s8s8_compensation_required;
     bool src_zero_point;
     bool dst_zero_point;
+    bool src_zero_point_per_ch;
+    bool dst_zero_point_per_ch;
 
     cpu_isa_t isa;
 };
@@ -931,6 +933,35 @@ struct jit_reduction_call_s {
     const void *dst_orig = nullptr;
 };
 
+struct jit_embedding_bag_conf_t {
+    data_type_t src_type = data_type::undef;
+    data_type_t dst_type = data_type::undef;
+
+    std::size_t src_dt_size = 0;
+    std::size_t dst_dt_size = 0;
+
+    cpu_isa_t isa = isa_undef;
+
+    dim_t dim = 0;
+    // Number of embedding table elements processed per kernel block and the
+    // number of accumulator registers it occupies.
+    dim_t block = 0;
+    int nregs = 0;
+    // Distance (in bag elements) at which rows are prefetched ahead.
+    int prefetch_distance = 0;
+
+    bool with_per_row_scales = false;
+};
+
+struct jit_embedding_bag_call_s {
+    const void *src = nullptr;
+    const int32_t *indices = nullptr;
+    dim_t num_indices = 0;
+    const float *scales = nullptr;
+    void *dst = nullptr;
+    float bag_scale = 1.f;
+};
+
 } // namespace x64
 } // namespace cpu
 } // namespace impl
@@ -0,0 +1,193 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/dnnl_thread.hpp"
+#include "common/nstl.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "cpu/x64/jit_uni_embedding_bag.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+static cpu_isa_t get_supported_isa() {
+    if (mayiuse(avx512_core_fp16)) return avx512_core_fp16;
+    if (mayiuse(avx512_core_bf16)) return avx512_core_bf16;
+    if (mayiuse(avx512_core)) return avx512_core;
+    if (mayiuse(avx2_vnni_2)) return avx2_vnni_2;
+    if (mayiuse(avx2)) return avx2;
+
+    return isa_undef;
+}
+
+static bool impl_supports_datatype(data_type_t data_type) {
+    switch (data_type) {
+        case data_type::bf16:
+            return mayiuse(avx512_core) || mayiuse(avx2_vnni_2);
+        case data_type::f16:
+            return mayiuse(avx512_core_fp16) || mayiuse(avx2_vnni_2);
+        case data_type::f32:
+        case data_type::s8:
+        case data_type::u8: return true;
+        default: return false;
+    }
+}
+
+status_t jit_uni_embedding_bag_fwd_t::pd_t::init(engine_t *engine) {
+    using namespace data_type;
+    using namespace format_tag;
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    conf_.isa = get_supported_isa();
+    VDISPATCH_EMBEDDING_BAG(conf_.isa != isa_undef, VERBOSE_UNSUPPORTED_ISA);
+
+    conf_.src_type = src_md()->data_type;
+    conf_.dst_type = dst_md()->data_type;
+    conf_.src_dt_size = types::data_type_size(conf_.src_type);
+    conf_.dst_dt_size = types::data_type_size(conf_.dst_type);
+
+    VDISPATCH_EMBEDDING_BAG(
+            utils::one_of(conf_.src_type, f32, bf16, f16, s8, u8)
+                    && impl_supports_datatype(conf_.src_type),
+            VERBOSE_UNSUPPORTED_DT);
+    VDISPATCH_EMBEDDING_BAG(utils::one_of(conf_.dst_type, f32, bf16, f16)
+                    && impl_supports_datatype(conf_.dst_type),
+            VERBOSE_UNSUPPORTED_DT);
+    VDISPATCH_EMBEDDING_BAG(
+            attr()->has_default_values(skip_mask_t::scales_runtime),
+            VERBOSE_UNSUPPORTED_ATTR);
+    VDISPATCH_EMBEDDING_BAG(
+            set_default_formats() == status::success, VERBOSE_UNSUPPORTED_TAG);
+    VDISPATCH_EMBEDDING_BAG(
+            memory_desc_matches_tag(*src_md(0), ab)
+                    && memory_desc_matches_tag(*dst_md(), ab),
+            VERBOSE_UNSUPPORTED_TAG);
+    VDISPATCH_EMBEDDING_BAG(memory_desc_wrapper(src_md(1)).is_dense()
+                    && memory_desc_wrapper(src_md(2)).is_dense(),
+            VERBOSE_UNSUPPORTED_TAG);
+    VDISPATCH_EMBEDDING_BAG(!has_zero_dim_memory(), VERBOSE_EMPTY_TENSOR, "");
+
+    // Row addresses are computed with a 32-bit immediate row stride.
+    conf_.dim = dim();
+    VDISPATCH_EMBEDDING_BAG(
+            conf_.dim * static_cast<dim_t>(conf_.src_dt_size)
+                    <= nstl::numeric_limits<int32_t>::max(),
+            VERBOSE_SHAPE_RESTRICTION);
+
+    conf_.with_per_row_scales
+            = attr()->scales_.get(DNNL_ARG_SRC).mask_ != 0;
+
+    // Keep the whole output row in registers when it fits, otherwise split
+    // it into blocks of the maximal register count. Each extra block walks
+    // the bag's indices again, but those are hot in L1 after the first pass.
+    const int simd_w = is_superset(conf_.isa, avx512_core) ? 16 : 8;
+    conf_.nregs = static_cast<int>(nstl::min<dim_t>(
+            jit_uni_embedding_bag_kernel_base_t::max_nregs(conf_.isa),
+            utils::div_up(conf_.dim, simd_w)));
+    conf_.block = nstl::min<dim_t>(conf_.nregs * simd_w, conf_.dim);
+    // Gathered rows are far apart in memory; prefetch a few indices ahead to
+    // hide the latency of the table lookups.
+    conf_.prefetch_distance = 8;
+
+    return status::success;
+}
+
+status_t jit_uni_embedding_bag_fwd_t::init(engine_t *engine) {
+    CHECK(get_proper_kernel(pd()->get_conf()));
+    CHECK(kernel_->create_kernel());
+    return status::success;
+}
+
+status_t jit_uni_embedding_bag_fwd_t::execute(const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const uint8_t *, DNNL_ARG_SRC);
+    auto indices = CTX_IN_MEM(const int32_t *, DNNL_ARG_INDICES);
+    auto offsets = CTX_IN_MEM(const int32_t *, DNNL_ARG_OFFSETS);
+    auto dst = CTX_OUT_MEM(uint8_t *, DNNL_ARG_DST);
+
+    DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
+
+    const auto &conf = pd()->get_conf();
+    const memory_desc_wrapper src_d(pd()->src_md(0));
+    const memory_desc_wrapper indices_d(pd()->src_md(1));
+    const memory_desc_wrapper offsets_d(pd()->src_md(2));
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    src += src_d.offset0() * conf.src_dt_size;
+    dst += dst_d.offset0() * conf.dst_dt_size;
+    indices += indices_d.offset0();
+    offsets += offsets_d.offset0();
+
+    const dim_t num_bags = pd()->num_bags();
+    const dim_t num_indices = pd()->num_indices();
+    const bool is_mean = pd()->is_mean();
+    const float common_scale = conf.with_per_row_scales ? 1.f : src_scales[0];
+
+    parallel_nd(num_bags, [&](dim_t b) {
+        const dim_t beg = offsets[b];
+        const dim_t end = b + 1 < num_bags ? offsets[b + 1] : num_indices;
+        const dim_t count = nstl::max<dim_t>(end - beg, 0);
+        assert(0 <= beg && end <= num_indices);
+#ifndef NDEBUG
+        // The kernel gathers the rows without any check.
+        for (dim_t i = beg; i < beg + count; ++i)
+            assert(0 <= indices[i] && indices[i] < pd()->rows());
+#endif
+
+        jit_embedding_bag_call_s args = jit_embedding_bag_call_s();
+        args.src = src;
+        args.indices = indices + beg;
+        args.num_indices = count;
+        args.scales = src_scales;
+        args.dst = dst + b * conf.dim * conf.dst_dt_size;
+        args.bag_scale = (is_mean && count > 0 ? 1.f / count : 1.f)
+                * common_scale;
+
+        (*kernel_)(&args);
+    });
+
+    return status::success;
+}
+
+status_t jit_uni_embedding_bag_fwd_t::get_proper_kernel(
+        const jit_embedding_bag_conf_t &conf) {
+    switch (conf.isa) {
+        case avx512_core_fp16:
+            return safe_ptr_assign(kernel_,
+                    new jit_uni_embedding_bag_kernel_t<avx512_core_fp16>(conf));
+        case avx512_core_bf16:
+            return safe_ptr_assign(kernel_,
+                    new jit_uni_embedding_bag_kernel_t<avx512_core_bf16>(conf));
+        case avx512_core:
+            return safe_ptr_assign(kernel_,
+                    new jit_uni_embedding_bag_kernel_t<avx512_core>(conf));
+        case avx2_vnni_2:
+            return safe_ptr_assign(kernel_,
+                    new jit_uni_embedding_bag_kernel_t<avx2_vnni_2>(conf));
+        case avx2:
+            return safe_ptr_assign(
+                    kernel_, new jit_uni_embedding_bag_kernel_t<avx2>(conf));
+        default: return status::runtime_error;
+    }
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,178 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "cpu/platform.hpp"
+
+#include "cpu/x64/jit_uni_embedding_bag_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace Xbyak;
+#define GET_OFF(field) offsetof(jit_embedding_bag_call_s, field)
+
+template <cpu_isa_t isa, typename Vmm>
+jit_uni_embedding_bag_kernel_t<isa, Vmm>::jit_uni_embedding_bag_kernel_t(
+        const jit_embedding_bag_conf_t &conf)
+    : jit_uni_embedding_bag_kernel_base_t(conf)
+    , tail_size_(conf.dim % simd_w_)
+    , io_load_(this, isa, conf_.src_type, {false},
+              io::io_tail_conf_t {simd_w_, tail_size_, k_tail_mask_,
+                      vmm_tail_mask_.getIdx(), reg_tmp_},
+              io::io_emu_bf16_conf_t {vmm_bf16_emu_1_, vmm_bf16_emu_2_,
+                      vmm_bf16_emu_3_, reg_tmp_, vmm_bf16_emu_4_},
+              utils::nullopt)
+    , io_store_(this, isa, conf_.dst_type, {false},
+              io::io_tail_conf_t {simd_w_, tail_size_, k_tail_mask_,
+                      vmm_tail_mask_.getIdx(), reg_tmp_},
+              io::io_emu_bf16_conf_t {vmm_bf16_emu_1_, vmm_bf16_emu_2_,
+                      vmm_bf16_emu_3_, reg_tmp_, vmm_bf16_emu_4_},
+              utils::nullopt) {}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_embedding_bag_kernel_t<isa, Vmm>::load_params() {
+    mov(reg_src_, ptr[reg_param_ + GET_OFF(src)]);
+    mov(reg_indices_, ptr[reg_param_ + GET_OFF(indices)]);
+    mov(reg_num_indices_, ptr[reg_param_ + GET_OFF(num_indices)]);
+    if (conf_.with_per_row_scales)
+        mov(reg_scales_, ptr[reg_param_ + GET_OFF(scales)]);
+    mov(reg_dst_, ptr[reg_param_ + GET_OFF(dst)]);
+    uni_vbroadcastss(vmm_bag_scale_, ptr[reg_param_ + GET_OFF(bag_scale)]);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_embedding_bag_kernel_t<isa, Vmm>::prefetch_row(int nelems) {
+    if (conf_.prefetch_distance <= 0) return;
+
+    Label label_no_prefetch;
+    cmp(reg_work_, conf_.prefetch_distance);
+    jle(label_no_prefetch, T_NEAR);
+    {
+        const int pf_off = conf_.prefetch_distance * sizeof(int32_t);
+        movsxd(reg_pf_row_, dword[reg_idx_ptr_ + pf_off]);
+        imul(reg_pf_row_, reg_pf_row_,
+                static_cast<int>(conf_.dim * conf_.src_dt_size));
+        add(reg_pf_row_, reg_src_);
+        const int bytes = nelems * static_cast<int>(conf_.src_dt_size);
+        for (int off = 0; off < bytes; off += platform::get_cache_line_size())
+            prefetcht0(ptr[reg_pf_row_ + off]);
+    }
+    L(label_no_prefetch);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_embedding_bag_kernel_t<isa, Vmm>::compute_block(int nelems) {
+    const int nregs = utils::div_up(nelems, static_cast<int>(simd_w_));
+    const bool has_tail = nelems % simd_w_ != 0;
+    assert(IMPLICATION(has_tail, nelems % simd_w_ == tail_size_));
+
+    for (int r = 0; r < nregs; ++r)
+        uni_vpxor(vmm_acc(r), vmm_acc(r), vmm_acc(r));
+
+    Label label_idx_loop, label_idx_loop_end;
+    mov(reg_idx_ptr_, reg_indices_);
+    mov(reg_work_, reg_num_indices_);
+
+    L(label_idx_loop);
+    {
+        cmp(reg_work_, 0);
+        jle(label_idx_loop_end, T_NEAR);
+
+        prefetch_row(nelems);
+
+        movsxd(reg_row_, dword[reg_idx_ptr_]);
+        if (conf_.with_per_row_scales)
+            uni_vbroadcastss(vmm_row_scale_, ptr[reg_scales_ + reg_row_ * 4]);
+        imul(reg_row_, reg_row_,
+                static_cast<int>(conf_.dim * conf_.src_dt_size));
+        add(reg_row_, reg_src_);
+
+        for (int r = 0; r < nregs; ++r) {
+            const bool is_tail = has_tail && r == nregs - 1;
+            io_load_.load(ptr[reg_row_ + r * simd_w_ * conf_.src_dt_size],
+                    vmm_tmp_, is_tail);
+            if (conf_.with_per_row_scales)
+                uni_vfmadd231ps(vmm_acc(r), vmm_tmp_, vmm_row_scale_);
+            else
+                uni_vaddps(vmm_acc(r), vmm_acc(r), vmm_tmp_);
+        }
+
+        add(reg_idx_ptr_, sizeof(int32_t));
+        dec(reg_work_);
+        jmp(label_idx_loop, T_NEAR);
+    }
+    L(label_idx_loop_end);
+
+    for (int r = 0; r < nregs; ++r) {
+        const bool is_tail = has_tail && r == nregs - 1;
+        uni_vmulps(vmm_acc(r), vmm_acc(r), vmm_bag_scale_);
+        io_store_.store(vmm_acc(r),
+                ptr[reg_dst_ + r * simd_w_ * conf_.dst_dt_size], is_tail);
+    }
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_embedding_bag_kernel_t<isa, Vmm>::generate() {
+    preamble();
+
+    io_store_.init_bf16();
+    if (tail_size_ > 0) {
+        io_load_.prepare_tail_mask();
+        io_store_.prepare_tail_mask();
+    }
+
+    load_params();
+
+    const dim_t nblocks = conf_.dim / conf_.block;
+    const int block_tail = static_cast<int>(conf_.dim % conf_.block);
+
+    if (nblocks > 0) {
+        Label label_block_loop, label_block_loop_end;
+        mov(reg_blocks_, nblocks);
+        L(label_block_loop);
+        {
+            cmp(reg_blocks_, 0);
+            je(label_block_loop_end, T_NEAR);
+
+            compute_block(static_cast<int>(conf_.block));
+
+            add(reg_src_, conf_.block * conf_.src_dt_size);
+            add(reg_dst_, conf_.block * conf_.dst_dt_size);
+            dec(reg_blocks_);
+            jmp(label_block_loop, T_NEAR);
+        }
+        L(label_block_loop_end);
+    }
+
+    if (block_tail > 0) compute_block(block_tail);
+
+    postamble();
+}
+
+template struct jit_uni_embedding_bag_kernel_t<avx512_core_fp16>;
+template struct jit_uni_embedding_bag_kernel_t<avx512_core_bf16>;
+template struct jit_uni_embedding_bag_kernel_t<avx512_core>;
+template struct jit_uni_embedding_bag_kernel_t<avx2_vnni_2>;
+template struct jit_uni_embedding_bag_kernel_t<avx2>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
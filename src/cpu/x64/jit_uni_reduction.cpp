@@ -55,6 +55,8 @@ status_t jit_uni_reduction_t::pd_t::init(engine_t *engine) {
     using namespace format_tag;
     using sm = primitive_attr_t::skip_mask_t;
 
+    VDISPATCH_REDUCTION(!is_index_alg(), VERBOSE_BAD_ALGORITHM);
+
     conf_.isa = get_supported_isa();
 
     conf_.src_type = src_md()->data_type;
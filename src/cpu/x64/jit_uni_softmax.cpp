@@ -25,6 +25,7 @@
 #include "common/utils.hpp"
 
 #include "cpu/cpu_primitive.hpp"
+#include "cpu/topk_utils.hpp"
 
 #include "cpu/x64/jit_generator.hpp"
 
@@ -116,6 +117,7 @@ struct jit_softmax_dense_kernel_t : jit_softmax_kernel_base_t,
     bool with_eltwise_ = false;
     bool with_src_scales_ = false;
     bool with_dst_scales_ = false;
+    bool with_stats_ = pd_->with_stats();
     bool use_ext_aux_vmms_ = false;
 
     size_t unroll_regs_ = 4;
@@ -878,10 +880,20 @@ struct jit_softmax_dense_kernel_t : jit_softmax_kernel_base_t,
 
     void forward() {
         accumulate_vmax();
+        // `vmax` serves as a temporary register once the sum is accumulated.
+        if (with_stats_) store_stat(vmax, 0);
         accumulate_vsum();
+        if (with_stats_) store_stat(vsum, 1);
         compute_dst();
     }
 
+    // Saves the row maximum or the transformed denominator, the caller turns
+    // them into log-sum-exp.
+    void store_stat(const Vmm &vstat, int idx) {
+        mov(reg_tmp, ptr[reg_param + PARAM_OFF(stats)]);
+        uni_vmovss(ptr[reg_tmp + idx * sizeof(float)], Xmm(vstat.getIdx()));
+    }
+
     void backward() {
         accumulate_vsbr();
         compute_diff_src();
@@ -1593,6 +1605,9 @@ status_t jit_uni_softmax_fwd_t::init(engine_t *engine) {
 status_t jit_uni_softmax_fwd_t::execute(const exec_ctx_t &ctx) const {
     const auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
     auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+    auto max = CTX_OUT_MEM(float *, DNNL_ARG_DST_1);
+    auto lse = CTX_OUT_MEM(float *, DNNL_ARG_DST_2);
+    auto candidates = CTX_OUT_MEM(int32_t *, DNNL_ARG_DST_3);
     auto scratchpad_ptr = ctx.get_scratchpad_grantor().template get<char>(
             memory_tracking::names::key_softmax_interim_store);
 
@@ -1651,6 +1666,12 @@ status_t jit_uni_softmax_fwd_t::execute(const exec_ctx_t &ctx) const {
     const int nthr = pd()->nthr_;
     const char *dst_orig_ptr = dst;
 
+    // Per-row outputs are supported for a plain innermost axis only, so the
+    // row `ou` is also the row of the statistics and candidates.
+    const dim_t k = pd()->num_candidates();
+    std::vector<std::vector<topk_utils::candidate_t>> heaps(
+            pd()->with_candidates() ? nthr : 0);
+
     VDEBUGINFO(1, primitive, softmax,
             "%s,src=%p dst=%p outer_size=%" PRId64 " outer_stride=%" PRId64
             " inner_size=%" PRId64 " inner_stride=%" PRId64
@@ -1686,7 +1707,26 @@ status_t jit_uni_softmax_fwd_t::execute(const exec_ctx_t &ctx) const {
                 p.dst_orig = dst_orig_ptr;
                 p.post_ops_binary_rhs_arg_vec
                         = post_ops_binary_rhs_arg_vec.data();
+                float stats[2];
+                p.stats = stats;
                 (*ker_)(&p);
+
+                if (pd()->with_stats()) {
+                    // The kernel returns `1 / sum` for softmax and `log(sum)`
+                    // for logsoftmax.
+                    max[ou] = stats[0];
+                    lse[ou] = stats[0]
+                            + (pd()->is_softmax() ? -logf(stats[1])
+                                                  : stats[1]);
+                }
+                if (pd()->with_candidates()) {
+                    auto &heap = heaps[ithr];
+                    topk_utils::select_topk(heap, dst_ptr, dst_d.data_type(),
+                            0, pd()->axis_size(), 0, k);
+                    for (dim_t j = 0; j < k; ++j)
+                        candidates[ou * k + j]
+                                = static_cast<int32_t>(heap[j].idx);
+                }
             });
 
     return status::success;
@@ -51,6 +51,7 @@ struct jit_softmax_kernel_base_t {
         const void *interim; // scratch memory for intermediate storage
         const void *src_scales; // src_scales defined for all data type cases
         const void *dst_scales; // dst_scales defined for all data type cases
+        const void *stats; // row max and denominator, used by forward only
         size_t process_n_elems;
 
         // post ops
@@ -158,6 +159,10 @@ struct jit_uni_softmax_fwd_t : public primitive_t {
 
             const memory_desc_wrapper dst_d(dst_md());
             axis_is_plain_and_strided_ = dst_d.is_plain() && axis_stride() > 1;
+            VDISPATCH_SOFTMAX(IMPLICATION(with_stats() || with_candidates(),
+                                      dst_d.is_plain() && axis_stride() == 1),
+                    VERBOSE_UNSUPPORTED_FEATURE,
+                    "softmax per-row outputs for a non-innermost axis");
             nthr_ = dnnl_get_max_threads();
             init_scratchpad();
 
@@ -400,6 +400,7 @@ struct miopen_convolution_bwd_weights_t : public gpu::primitive_t {
 
             bool ok = desc()->prop_kind == prop_kind::backward_weights;
             ok = ok && this->set_default_formats();
+            ok = ok && attr()->post_ops_.has_default_values();
             ok = ok
                     && (utils::everyone_is(f32, src_md_.data_type,
                                 diff_weights_md_.data_type,
@@ -39,7 +39,8 @@ struct ref_sycl_softmax_fwd_t : public gpu::generic::sycl::primitive_t {
         status_t init(impl::engine_t *engine) {
             using sm = primitive_attr_t::skip_mask_t;
 
-            bool ok = is_fwd() && check_data_types(src_md()->data_type)
+            bool ok = is_fwd() && !with_stats() && !with_candidates()
+                    && check_data_types(src_md()->data_type)
                     && check_data_types(dst_md()->data_type)
                     && (src_md(0)->format_desc.blocking.inner_nblks == 0)
                     && attr()->has_default_values(
@@ -56,6 +56,8 @@ struct gen9_softmax_fwd_t : public gpu_primitive_t {
                     != format_tag::undef);
 
             VDISPATCH_SOFTMAX(is_fwd(), VERBOSE_BAD_PROPKIND);
+            VDISPATCH_SOFTMAX(!with_stats() && !with_candidates(),
+                    VERBOSE_UNSUPPORTED_FEATURE, "softmax per-row outputs");
             VDISPATCH_SOFTMAX(
                     IMPLICATION(is_blocked, axis_size() % buffer_size == 0),
                     VERBOSE_BAD_AXIS);
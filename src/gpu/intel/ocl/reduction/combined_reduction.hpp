@@ -54,6 +54,7 @@ struct combined_reduction_t : public gpu_primitive_t {
         status_t init(impl::engine_t *engine) {
             using smask_t = primitive_attr_t::skip_mask_t;
             const auto attr_skip_mask = smask_t::post_ops | smask_t::gpu_attr;
+            VDISPATCH_REDUCTION(!is_index_alg(), VERBOSE_BAD_ALGORITHM);
             VDISPATCH_REDUCTION_SC(
                     set_default_params(), VERBOSE_UNSUPPORTED_TAG);
             VDISPATCH_REDUCTION(attr()->has_default_values(attr_skip_mask),
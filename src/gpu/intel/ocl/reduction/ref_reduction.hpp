@@ -41,6 +41,7 @@ struct ref_reduction_t : public gpu_primitive_t {
             using sm = primitive_attr_t::skip_mask_t;
             const auto attr_skip_mask = sm::post_ops | sm::gpu_attr;
 
+            VDISPATCH_REDUCTION(!is_index_alg(), VERBOSE_BAD_ALGORITHM);
             VDISPATCH_REDUCTION_SC(
                     set_default_params(), VERBOSE_UNSUPPORTED_TAG);
             VDISPATCH_REDUCTION(!memory_desc_ndims_ok(src_md(), dst_md()),
@@ -104,6 +104,8 @@ struct reusable_softmax_fwd_t : public gpu_primitive_t {
 
             using namespace data_type;
             VDISPATCH_SOFTMAX(is_fwd(), VERBOSE_BAD_PROPKIND);
+            VDISPATCH_SOFTMAX(!with_stats() && !with_candidates(),
+                    VERBOSE_UNSUPPORTED_FEATURE, "softmax per-row outputs");
 
             // reusable implementation still too slow for half-precision
             VDISPATCH_SOFTMAX(utils::one_of(src_dt, f64, f32, u8, s8),
@@ -54,6 +54,8 @@ struct simple_softmax_fwd_t : public gpu_primitive_t {
             using namespace data_type;
             using skip_mask_t = primitive_attr_t::skip_mask_t;
             VDISPATCH_SOFTMAX(is_fwd(), VERBOSE_BAD_PROPKIND);
+            VDISPATCH_SOFTMAX(!with_stats() && !with_candidates(),
+                    VERBOSE_UNSUPPORTED_FEATURE, "softmax per-row outputs");
             VDISPATCH_SOFTMAX(
                     utils::one_of(src_dt, f64, f32, f16, bf16, u8, s8),
                     VERBOSE_UNSUPPORTED_DT);
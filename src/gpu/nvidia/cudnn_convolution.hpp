@@ -311,6 +311,7 @@ struct cudnn_convolution_bwd_weights_t : public gpu::primitive_t {
                     = utils::downcast<const xpu::sycl::engine_impl_t *>(
                             engine->impl());
             ok = ok && this->set_default_formats();
+            ok = ok && attr()->post_ops_.has_default_values();
             ok = ok
                     && (utils::everyone_is(f32, src_md_.data_type,
                                 diff_weights_md_.data_type,
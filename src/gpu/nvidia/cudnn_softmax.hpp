@@ -46,7 +46,7 @@ struct cudnn_softmax_fwd_t : public gpu::primitive_t {
             auto sycl_dev
                     = utils::downcast<nvidia::engine_t *>(engine)->device();
 
-            bool ok = is_fwd()
+            bool ok = is_fwd() && !with_stats() && !with_candidates()
                     && utils::one_of(src_d.data_type(), data_type::f32,
                             data_type::f16, data_type::bf16, data_type::s8)
                     && IMPLICATION(src_md()->data_type == data_type::bf16,
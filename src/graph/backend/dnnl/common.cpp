@@ -657,6 +657,18 @@ size_t generate_constant_cache_key(
     return key;
 }
 
+namespace {
+thread_local std::vector<dnnl::primitive> *primitive_recorder = nullptr;
+} // namespace
+
+void set_primitive_recorder(std::vector<dnnl::primitive> *prims) {
+    primitive_recorder = prims;
+}
+
+void record_primitive(const dnnl::primitive &prim) {
+    if (primitive_recorder) primitive_recorder->emplace_back(prim);
+}
+
 } // namespace dnnl_impl
 } // namespace graph
 } // namespace impl
@@ -144,6 +144,21 @@ dnnl::memory::format_tag get_format_tag(const dnnl::memory::desc &md);
 size_t generate_constant_cache_key(
         size_t part_id, const std::vector<dnnl::memory::desc> &const_mds);
 
+// Record the primitives created by make_dnnl_primitive in the current thread
+// into the given vector. Recording stops when it's set to nullptr.
+void set_primitive_recorder(std::vector<dnnl::primitive> *prims);
+
+void record_primitive(const dnnl::primitive &prim);
+
+// Create a primitive from the primitive descriptor and record it, so that the
+// implementations of the primitives can be reported by the profiling.
+template <typename prim_t, typename pd_t>
+prim_t make_dnnl_primitive(const pd_t &pd) {
+    prim_t prim(pd);
+    record_primitive(prim);
+    return prim;
+}
+
 #ifndef NDEBUG
 #define BACKEND_DNNL_ENFORCE(condition, message) \
     do { \
@@ -54,6 +54,7 @@ pass::pass_registry_t dnnl_backend_t::register_passes() {
     DNNL_BACKEND_REGISTER_PATTERN_CALL(convtranspose_fusion, pass_registry);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(matmul_post_ops, pass_registry);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(sdp, pass_registry);
+    DNNL_BACKEND_REGISTER_PATTERN_CALL(mlp, pass_registry);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(single_op_pass, pass_registry);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(pool_post_ops, pass_registry);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(eltwise_fusion, pass_registry);
@@ -0,0 +1,223 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "common/utils.hpp"
+
+#include "graph/interface/logical_tensor.hpp"
+
+#include "graph/backend/dnnl/dnnl_constant_tensor_cache.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+namespace {
+// The directory of the shared constant tensor cache. Empty if the shared cache
+// is disabled.
+const std::string &shared_constant_cache_path() {
+    static const std::string path = impl::getenv_string_user(
+            "GRAPH_CONSTANT_TENSOR_CACHE_SHARED_PATH");
+    return path;
+}
+
+// The file name contains the library version and the cpu isa as the layouts of
+// the constant tensors depend on them.
+std::string shared_constant_file_path(
+        graph::constant_tensor_cache_t::key_t key, size_t size) {
+    const unsigned isa = static_cast<unsigned>(dnnl_get_effective_cpu_isa());
+    char name[128];
+    snprintf(name, sizeof(name), "/onednn_graph_%s_%x_%016zx_%zu.bin",
+            dnnl_version()->hash, isa, key, size);
+    return shared_constant_cache_path() + name;
+}
+
+// The header at the beginning of a shared file. The constant tensors follow at
+// the next page, so that they are aligned as the ones of the engine allocator.
+struct shared_file_header_t {
+    char magic[16];
+    uint64_t size;
+};
+
+constexpr const char shared_file_magic[16] = "onednn_graph_sc";
+constexpr size_t shared_file_header_size = 4096;
+} // namespace
+
+dnnl_shared_constant_buffer_t::~dnnl_shared_constant_buffer_t() {
+#if !defined(_WIN32)
+    if (mapping_) munmap(mapping_, shared_file_header_size + size_);
+    // the constant tensors were not computed, drop the file
+    if (!tmp_path_.empty()) unlink(tmp_path_.c_str());
+#endif
+}
+
+bool dnnl_shared_constant_buffer_t::map(const std::string &path, bool &ready) {
+#if !defined(_WIN32)
+    path_ = path;
+    const size_t file_size = shared_file_header_size + size_;
+    // Symbolic links and files of other users are never followed, as another
+    // user could otherwise make the process use forged constant tensors.
+    int fd = open(path_.c_str(), O_RDONLY | O_NOFOLLOW);
+    if (fd >= 0) {
+        struct stat st;
+        shared_file_header_t header;
+        const bool valid = fstat(fd, &st) == 0 && S_ISREG(st.st_mode)
+                && st.st_uid == geteuid()
+                && static_cast<size_t>(st.st_size) == file_size
+                && pread(fd, &header, sizeof(header), 0)
+                        == static_cast<ssize_t>(sizeof(header))
+                && std::memcmp(header.magic, shared_file_magic,
+                           sizeof(header.magic))
+                        == 0
+                && header.size == size_;
+        if (valid) {
+            void *ptr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (ptr != MAP_FAILED) mapping_ = ptr;
+        }
+        close(fd);
+        ready = mapping_ != nullptr;
+        if (ready)
+            data_ = static_cast<char *>(mapping_) + shared_file_header_size;
+        return ready;
+    }
+
+    // Each process computes into its own file, so that other processes never
+    // see a partially computed file.
+    tmp_path_ = path_ + "." + std::to_string(getpid()) + "."
+            + std::to_string(reinterpret_cast<size_t>(this));
+    fd = open(tmp_path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+    if (fd < 0) {
+        tmp_path_.clear();
+        return false;
+    }
+    shared_file_header_t header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, shared_file_magic, sizeof(header.magic));
+    header.size = size_;
+    if (ftruncate(fd, static_cast<off_t>(file_size)) == 0
+            && pwrite(fd, &header, sizeof(header), 0)
+                    == static_cast<ssize_t>(sizeof(header))) {
+        void *ptr = mmap(nullptr, file_size, PROT_READ | PROT_WRITE,
+                MAP_SHARED, fd, 0);
+        if (ptr != MAP_FAILED) mapping_ = ptr;
+    }
+    close(fd);
+    ready = false;
+    if (!mapping_) {
+        unlink(tmp_path_.c_str());
+        tmp_path_.clear();
+        return false;
+    }
+    data_ = static_cast<char *>(mapping_) + shared_file_header_size;
+    return true;
+#else
+    UNUSED(path);
+    UNUSED(ready);
+    return false;
+#endif
+}
+
+void dnnl_shared_constant_buffer_t::publish() {
+#if !defined(_WIN32)
+    if (tmp_path_.empty()) return;
+    // rename is atomic, a process racing for the same file replaces it with
+    // identical content
+    rename(tmp_path_.c_str(), path_.c_str());
+    tmp_path_.clear();
+#endif
+}
+
+size_t dnnl_constant_inputs_hash(const std::vector<tensor_t> &inputs) {
+    size_t seed = 0;
+    for (const auto &in : inputs) {
+        const logical_tensor_t &lt = in.get_logical_tensor();
+        if (lt.property != property_type::constant) continue;
+        const auto *data
+                = static_cast<const unsigned char *>(in.get_data_handle());
+        if (!data) continue;
+        const size_t size = logical_tensor_wrapper_t(lt).size();
+        seed = hash_combine(seed, size);
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            seed = hash_combine(seed, word);
+        }
+        for (; i < size; i++)
+            seed = hash_combine(seed, data[i]);
+    }
+    return seed;
+}
+
+graph::constant_tensor_cache_t::cached_t dnnl_constant_buffer_create(
+        size_t size, dnnl::engine &eng, graph::allocator_t *alc,
+        graph::constant_tensor_cache_t::key_t key,
+        const std::vector<tensor_t> &inputs, bool &ready) {
+    ready = false;
+    if (size == 0 || eng.get_kind() != dnnl::engine::kind::cpu)
+        return std::make_shared<dnnl_constant_buffer_t>(size, eng, alc);
+
+    const size_t fingerprint = dnnl_constant_inputs_hash(inputs);
+    auto cache = graph::get_constant_tensor_cache(
+            eng.get()->kind(), eng.get()->index());
+    graph::constant_tensor_cache_t::cached_t buffer = cache
+            ? cache->take_loaded(dnnl_backend_t::get_singleton().get_id(), key,
+                    size, fingerprint)
+            : nullptr;
+    if (buffer) {
+        ready = true;
+        return buffer;
+    }
+
+    if (!shared_constant_cache_path().empty()) {
+        auto shared = std::make_shared<dnnl_shared_constant_buffer_t>(
+                size, eng, alc);
+        const size_t shared_key = hash_combine(key, fingerprint);
+        if (shared->map(shared_constant_file_path(shared_key, size), ready))
+            buffer = shared;
+    }
+    if (!buffer)
+        buffer = std::make_shared<dnnl_constant_buffer_t>(size, eng, alc);
+    buffer->set_fingerprint(fingerprint);
+    return buffer;
+}
+
+void dnnl_constant_buffer_publish(
+        const graph::constant_tensor_cache_t::cached_t &buffer,
+        dnnl::stream &strm) {
+    auto shared = std::dynamic_pointer_cast<dnnl_shared_constant_buffer_t>(
+            buffer);
+    if (!shared) return;
+    strm.wait();
+    shared->publish();
+}
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
@@ -16,7 +16,11 @@
 #ifndef GRAPH_BACKEND_DNNL_DNNL_CONSTANT_TENSOR_CACHE_HPP
 #define GRAPH_BACKEND_DNNL_DNNL_CONSTANT_TENSOR_CACHE_HPP
 
+#include <string>
+#include <vector>
+
 #include "graph/interface/constant_tensor_cache.hpp"
+#include "graph/interface/tensor.hpp"
 
 #include "graph/backend/dnnl/common.hpp"
 #include "graph/backend/dnnl/dnnl_backend.hpp"
@@ -62,6 +66,66 @@ struct dnnl_constant_buffer_t : public graph::constant_buffer_t {
     }
 };
 
+// The buffer of a constant cache entry placed in a memory-mapped file, so that
+// the processes of a user on a host can share the constant tensors of a
+// partition. The file is created under a temporary name, only accessible to
+// the user, and is renamed to its final name once the constant tensors are
+// computed. Other processes then map it read-only.
+struct dnnl_shared_constant_buffer_t : public graph::constant_buffer_t {
+    dnnl_shared_constant_buffer_t(
+            size_t size, dnnl::engine &engine, graph::allocator_t *alc)
+        : graph::constant_buffer_t(
+                size, engine.get(), alc, malloc_func, free_func) {}
+
+    ~dnnl_shared_constant_buffer_t() override;
+
+    // Map the file of the given path. If the file exists, it's mapped
+    // read-only and `ready` is set to true. Otherwise, a new file is created
+    // for the caller to compute the constant tensors into and publish them.
+    // Returns false if the file can't be mapped, or if the existing file is
+    // not a regular file owned by the user with a valid header.
+    bool map(const std::string &path, bool &ready);
+
+    // Make the computed constant tensors visible to other processes
+    void publish();
+
+    // The memory is mapped by the buffer itself
+    static void *malloc_func(size_t, impl::engine_t *, graph::allocator_t *) {
+        return nullptr;
+    }
+    static void free_func(void *, impl::engine_t *, graph::allocator_t *) {}
+
+private:
+    void *mapping_ = nullptr;
+    std::string path_;
+    std::string tmp_path_;
+};
+
+// Hash the contents of the constant input tensors. The tensors must be
+// accessible from host.
+size_t dnnl_constant_inputs_hash(const std::vector<tensor_t> &inputs);
+
+// Create the buffer of a constant cache entry. On a cpu engine, the buffer of
+// the entry imported from a file is returned as `ready` if it was computed from
+// the same contents of the constant `inputs`. When the shared constant tensor
+// cache is enabled through ONEDNN_GRAPH_CONSTANT_TENSOR_CACHE_SHARED_PATH, the
+// buffer of a cpu engine is placed in a file under that directory, keyed by
+// the constant cache key and by the contents of the constant `inputs`, as the
+// partition id in the key doesn't identify the weights of another process. In
+// that case, the constant tensors may already be computed by another process,
+// which is indicated by `ready`. The buffer falls back to the engine allocator
+// if the file can't be mapped.
+graph::constant_tensor_cache_t::cached_t dnnl_constant_buffer_create(
+        size_t size, dnnl::engine &eng, graph::allocator_t *alc,
+        graph::constant_tensor_cache_t::key_t key,
+        const std::vector<tensor_t> &inputs, bool &ready);
+
+// Publish the constant tensors computed into a buffer created by
+// dnnl_constant_buffer_create, once the stream has finished computing them.
+void dnnl_constant_buffer_publish(
+        const graph::constant_tensor_cache_t::cached_t &buffer,
+        dnnl::stream &strm);
+
 inline graph::constant_tensor_cache_t::value_t dnnl_constant_cache_get_or_add(
         const dnnl::engine &eng, graph::constant_tensor_cache_t::key_t key,
         size_t size, const graph::constant_tensor_cache_t::value_t &value) {
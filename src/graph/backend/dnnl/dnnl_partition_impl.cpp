@@ -132,7 +132,7 @@ status_t dnnl_partition_impl_t::compile(
     const std::vector<std::shared_ptr<op_t>> &fused_op = part->get_ops();
     auto agraph = graph_t(fused_op, get_engine_kind(), get_fpmath_mode());
     agraph.set_user_inputs_outputs(inputs, outputs);
-    agraph.infer_shape();
+    const status_t infer_ret = agraph.infer_shape();
     for (const auto &val : agraph.get_output_values()) {
         if (logical_tensor_wrapper_t(val->get_logical_tensor())
                         .has_zero_dim()) {
@@ -141,6 +141,34 @@ status_t dnnl_partition_impl_t::compile(
         }
     }
 
+    // The partition compiled with unknown input dims binds the concrete shapes
+    // at the execution, which is only supported for a single MatMul op on CPU.
+    // The outputs take the dims inferred from the known ones, and their
+    // strides are given at the execution.
+    std::vector<logical_tensor_t> dynamic_outputs;
+    const bool is_dynamic = std::any_of(
+            inputs.begin(), inputs.end(), [](const logical_tensor_t &lt) {
+                return lt.ndims > 0
+                        && logical_tensor_wrapper_t(lt).is_shape_unknown();
+            });
+    if (is_dynamic) {
+        if (get_engine_kind() != engine_kind::cpu || fused_op.size() != 1
+                || fused_op[0]->get_kind() != graph::op_kind::MatMul)
+            return status::unimplemented;
+        if (infer_ret != status::success) return infer_ret;
+        kernel_creator = dynamic_matmul_kernel_creator;
+
+        for (const auto &val : agraph.get_output_values()) {
+            logical_tensor_t lt = val->get_logical_tensor();
+            lt.layout_type = layout_type::strided;
+            for (int d = 0; d < lt.ndims; ++d)
+                lt.layout.strides[d] = DNNL_GRAPH_UNKNOWN_DIM;
+            dynamic_outputs.push_back(lt);
+        }
+    }
+    const std::vector<logical_tensor_t> &compile_outputs
+            = is_dynamic ? dynamic_outputs : outputs;
+
     kernel_ptr kernel = kernel_creator();
     if (!kernel) return status::unimplemented;
 
@@ -149,7 +177,7 @@ status_t dnnl_partition_impl_t::compile(
     // compile kernel.
     // FIXME(qun) will modify the outputs inside the compile, which
     // break the constant semantics
-    ret = kernel->compile(part.get(), g_engine, inputs, outputs);
+    ret = kernel->compile(part.get(), g_engine, inputs, compile_outputs);
     if (ret != status::success) return ret;
 
     std::vector<logical_tensor_t> ordered_inputs;
@@ -157,7 +185,8 @@ status_t dnnl_partition_impl_t::compile(
     ret = get_ordered_inputs_outputs(inputs_, inputs, ordered_inputs);
     if (status::success != ret) return ret;
 
-    ret = get_ordered_inputs_outputs(outputs_, outputs, ordered_outputs);
+    ret = get_ordered_inputs_outputs(
+            outputs_, compile_outputs, ordered_outputs);
     if (status::success != ret) return ret;
 
     // wrapper kernel to dnnl_compiled_partition_impl_t
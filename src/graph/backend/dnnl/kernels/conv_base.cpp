@@ -63,39 +63,8 @@ status_t conv_base_t::execute_impl(const stream_t *g_stream,
 
     constant_cache_t::cached_t c_buffer;
     if (enabled_constant_cache()) {
-        std::promise<constant_cache_t::cached_t> c_promise;
-        constant_cache_t::value_t cached_value
-                = dnnl_constant_cache_get_or_add(p_engine_, constant_key_,
-                        memory_planner_.total_internal_persistent_size(),
-                        c_promise.get_future());
-        bool is_from_cache = cached_value.valid();
-        if (is_from_cache) {
-            c_buffer = cached_value.get();
-            grantor_t c_grantor = memory_planner_.internal_persistent_grantor(
-                    c_buffer->data<char>());
-            for (auto &mem_offkey : res->get_mems_use_internal_persistent()) {
-                mem_offkey.first.set_data_handle(
-                        c_grantor.get(mem_offkey.second));
-            }
-        } else {
-            c_buffer = std::make_shared<dnnl_constant_buffer_t>(
-                    memory_planner_.total_internal_persistent_size(), p_engine_,
-                    g_alloc_);
-            grantor_t c_grantor = memory_planner_.internal_persistent_grantor(
-                    c_buffer->data<char>());
-            for (auto &mem_offkey : res->get_mems_use_internal_persistent()) {
-                mem_offkey.first.set_data_handle(
-                        c_grantor.get(mem_offkey.second));
-            }
-
-            for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
-                if (!subgraph_->is_constant_[i]) continue;
-                subgraph_->execs_[i]->execute(
-                        p_stream, res->get_exec_args()[i]);
-            }
-
-            c_promise.set_value(c_buffer);
-        }
+        c_buffer = prepare_constant_buffer(p_stream, constant_key_,
+                memory_planner_, *subgraph_, res, g_alloc_, inputs);
     }
 
     for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
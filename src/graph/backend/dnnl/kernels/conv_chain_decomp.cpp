@@ -0,0 +1,481 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <string>
+
+#include "common/dnnl_thread.hpp"
+#include "common/utils.hpp"
+
+#include "graph/backend/dnnl/kernels/conv_chain_decomp.hpp"
+
+#include "graph/backend/dnnl/common.hpp"
+#include "graph/backend/dnnl/passes/utils.hpp"
+#include "graph/backend/dnnl/scratchpad.hpp"
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include "cpu/platform.hpp"
+#endif
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include "cpu/cpu_stream.hpp"
+#include "oneapi/dnnl/dnnl_threadpool.h"
+#endif
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+namespace {
+
+bool is_dense(const logical_tensor_t &lt) {
+    const logical_tensor_wrapper_t ltw(lt);
+    return ltw.is_strided() && !ltw.is_shape_unknown()
+            && ltw.vstrides() == get_dense_strides(ltw.vdims());
+}
+
+size_t align_size(size_t size) {
+    return impl::utils::rnd_up(size, 64);
+}
+
+template <typename T>
+T get_attr_or(const op_t *op, op_attr_t attr, const T &default_value) {
+    return op->has_attr(attr) ? op->get_attr<T>(attr) : default_value;
+}
+
+} // namespace
+
+status_t conv_chain_decomp_kernel_t::init_config(
+        const std::vector<logical_tensor_t> &inputs,
+        const std::vector<logical_tensor_t> &outputs) {
+    const auto find_input = [&](const op_t *op, size_t offset, size_t &idx) {
+        const size_t id = op->get_input_value(offset)->get_logical_tensor().id;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (inputs[i].id != id) continue;
+            idx = i;
+            return is_dense(inputs[i]);
+        }
+        return false;
+    };
+
+    // the chain starts from the only convolution reading a partition input
+    const op_t *first = nullptr;
+    for (const auto &cur_op : subgraph_->get_ops()) {
+        if (cur_op->get_kind() != graph::op_kind::Convolution
+                || cur_op->get_input_value(0)->has_producer())
+            continue;
+        if (first) return status::unimplemented;
+        first = cur_op.get();
+    }
+    if (!first || !find_input(first, 0, src_idx_))
+        return status::unimplemented;
+
+    const data_type_t dt = inputs[src_idx_].data_type;
+    if (!impl::utils::one_of(dt, data_type::f32, data_type::bf16))
+        return status::unimplemented;
+    dt_ = static_cast<memory::data_type>(dt);
+
+    // src is [N, H, W, C]
+    const auto src_dims = logical_tensor_wrapper_t(inputs[src_idx_]).vdims();
+    if (src_dims.size() != 4) return status::unimplemented;
+    MB_ = src_dims[0];
+    dim_t IC = src_dims[3], IH = src_dims[1], IW = src_dims[2];
+
+    size_t nb_ops = 0;
+    const op_t *conv = first;
+    while (conv) {
+        if (conv->get_kind() != graph::op_kind::Convolution)
+            return status::unimplemented;
+        ++nb_ops;
+
+        // stride 1 convolutions on plain nxc activations only
+        const std::vector<int64_t> ones {1, 1};
+        const std::vector<int64_t> zeros {0, 0};
+        if (get_attr_or(conv, op_attr::strides, ones) != ones
+                || get_attr_or(conv, op_attr::dilations, ones) != ones
+                || get_attr_or<int64_t>(conv, op_attr::groups, 1) > 1
+                || get_attr_or<std::string>(conv, op_attr::data_format, "NXC")
+                        != "NXC"
+                || get_attr_or<std::string>(conv, op_attr::auto_pad, "None")
+                        != "None")
+            return status::unimplemented;
+        const auto wei_format = get_attr_or<std::string>(
+                conv, op_attr::weights_format, "XIO");
+        const auto pads_begin = get_attr_or(conv, op_attr::pads_begin, zeros);
+        const auto pads_end = get_attr_or(conv, op_attr::pads_end, zeros);
+        if (pads_begin.size() != 2 || pads_end.size() != 2)
+            return status::unimplemented;
+
+        layer_t layer;
+        layer.with_bias = conv->num_inputs() == 3;
+        if (!find_input(conv, 1, layer.wei_idx)
+                || (layer.with_bias && !find_input(conv, 2, layer.bia_idx)))
+            return status::unimplemented;
+
+        const auto &wei_lt = inputs[layer.wei_idx];
+        const auto wei_dims = logical_tensor_wrapper_t(wei_lt).vdims();
+        if (wei_lt.data_type != dt || wei_dims.size() != 4)
+            return status::unimplemented;
+        memory::format_tag wei_tag = memory::format_tag::undef;
+        if (wei_format == "OIX") {
+            layer.OC = wei_dims[0];
+            layer.KH = wei_dims[2];
+            layer.KW = wei_dims[3];
+            wei_tag = memory::format_tag::oihw;
+            if (wei_dims[1] != IC) return status::unimplemented;
+        } else if (wei_format == "XIO") {
+            layer.OC = wei_dims[3];
+            layer.KH = wei_dims[0];
+            layer.KW = wei_dims[1];
+            wei_tag = memory::format_tag::hwio;
+            if (wei_dims[2] != IC) return status::unimplemented;
+        } else {
+            return status::unimplemented;
+        }
+        layer.IC = IC;
+        layer.IH = IH;
+        layer.IW = IW;
+        layer.pad_t = pads_begin[0];
+        layer.pad_l = pads_begin[1];
+        layer.pad_r = pads_end[1];
+        layer.OH = IH + pads_begin[0] + pads_end[0] - layer.KH + 1;
+        layer.OW = IW + pads_begin[1] + pads_end[1] - layer.KW + 1;
+        if (layer.OH <= 0 || layer.OW <= 0) return status::unimplemented;
+        layer.user_wei_md = memory::desc(
+                {layer.OC, layer.IC, layer.KH, layer.KW}, dt_, wei_tag);
+
+        if (layer.with_bias) {
+            const auto &bia_lt = inputs[layer.bia_idx];
+            if (!impl::utils::one_of(bia_lt.data_type, dt, data_type::f32)
+                    || logical_tensor_wrapper_t(bia_lt).vdims()
+                            != std::vector<dim_t> {layer.OC})
+                return status::unimplemented;
+            layer.bia_md = make_dnnl_memory_desc(bia_lt);
+        }
+
+        // a ReLU may follow, and the output feeds the next convolution only
+        const op_t *out_op = conv;
+        const op_t *next = nullptr;
+        for (int i = 0; i < 2; ++i) {
+            const auto &csm = out_op->get_output_value(0)->get_consumers();
+            if (csm.size() > 1) return status::unimplemented;
+            if (csm.empty()) break;
+            next = &csm[0].get_op();
+            if (i == 0 && next->get_kind() == graph::op_kind::ReLU) {
+                layer.with_relu = true;
+                out_op = next;
+                next = nullptr;
+                ++nb_ops;
+                continue;
+            }
+            if (csm[0].get_offset() != 0) return status::unimplemented;
+            break;
+        }
+
+        layers_.emplace_back(layer);
+        IC = layer.OC;
+        IH = layer.OH;
+        IW = layer.OW;
+        conv = next;
+    }
+    if (layers_.size() < 2 || nb_ops != subgraph_->get_ops().size())
+        return status::unimplemented;
+
+    if (outputs.size() != 1 || outputs[0].data_type != dt)
+        return status::unimplemented;
+    const logical_tensor_wrapper_t out_ltw(outputs[0]);
+    if (!out_ltw.is_any() && !(out_ltw.is_strided() && is_dense(outputs[0])))
+        return status::unimplemented;
+
+    return status::success;
+}
+
+status_t conv_chain_decomp_kernel_t::init_bands() {
+    const size_t nb_layers = layers_.size();
+    const auto &last = layers_.back();
+    const size_t dt_size = memory::data_type_size(dt_);
+    const auto row_size = [&](const layer_t &l) {
+        return static_cast<size_t>(l.OW * l.OC) * dt_size;
+    };
+
+    // Every intermediate layer computes the rows of a band plus the halo
+    // rows the following convolutions read. Bands are sized so that these
+    // rows fit into half of the L2 cache, and so that every thread gets a
+    // band.
+    size_t l2_size = 1024 * 1024;
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    l2_size = cpu::platform::get_per_core_cache_size(2);
+#endif
+    size_t rows_size = 0, halo_size = 0;
+    dim_t halo = 0;
+    for (size_t l = nb_layers - 1; l-- > 0;) {
+        halo += layers_[l + 1].KH - 1;
+        rows_size += row_size(layers_[l]);
+        halo_size += halo * row_size(layers_[l]);
+    }
+    const size_t budget = l2_size / 2;
+    dim_t rows = budget > halo_size
+            ? static_cast<dim_t>((budget - halo_size) / rows_size)
+            : 1;
+    rows = std::max<dim_t>(1, std::min(rows, last.OH));
+    rows = std::min(rows,
+            std::max<dim_t>(1,
+                    last.OH
+                            / impl::utils::div_up(
+                                    static_cast<dim_t>(nthr_), MB_)));
+
+    // the halo is recomputed for every band, which must not more than
+    // double the work of the first convolution
+    if (rows < last.OH && rows < halo) return status::unimplemented;
+    band_rows_ = rows;
+
+    const dim_t nb_bands = impl::utils::div_up(last.OH, rows);
+    bands_.assign(nb_bands, std::vector<band_rows_t>(nb_layers));
+    band_prims_.assign(nb_layers, {});
+    std::vector<size_t> buf_rows(nb_layers, 0);
+    for (dim_t b = 0; b < nb_bands; ++b) {
+        dim_t out_start = b * rows;
+        dim_t out_end = std::min(last.OH, out_start + rows);
+        for (size_t l = nb_layers; l-- > 0;) {
+            const auto &layer = layers_[l];
+            auto &br = bands_[b][l];
+            const dim_t in_start = out_start - layer.pad_t;
+            const dim_t in_end = out_end - 1 - layer.pad_t + layer.KH;
+            br.out_start = out_start;
+            br.out_end = out_end;
+            br.in_start = std::max<dim_t>(in_start, 0);
+            br.in_end = std::min(in_end, layer.IH);
+            buf_rows[l] = std::max<size_t>(
+                    buf_rows[l], static_cast<size_t>(out_end - out_start));
+
+            const band_key_t key {br.in_end - br.in_start,
+                    br.in_start - in_start, in_end - br.in_end};
+            if (band_prims_[l].count(key) == 0)
+                CHECK(create_band_prim(l, key));
+            br.prim = &band_prims_[l].at(key);
+
+            out_start = br.in_start;
+            out_end = br.in_end;
+        }
+    }
+
+    per_thread_size_ = 0;
+    for (size_t l = 0; l + 1 < nb_layers; ++l) {
+        layers_[l].buf_offset = per_thread_size_;
+        per_thread_size_ += align_size(buf_rows[l] * row_size(layers_[l]));
+    }
+    scratchpad_size_ = align_size(scratchpad_size_);
+    per_thread_size_ += scratchpad_size_;
+    return status::success;
+}
+
+status_t conv_chain_decomp_kernel_t::create_band_prim(
+        size_t l, const band_key_t &key) {
+    using tag = memory::format_tag;
+    auto &layer = layers_[l];
+    const dim_t in_rows = std::get<0>(key);
+    const dim_t pad_t = std::get<1>(key);
+    const dim_t pad_b = std::get<2>(key);
+    const dim_t out_rows = in_rows + pad_t + pad_b - layer.KH + 1;
+
+    band_prim_t band_prim;
+    band_prim.src_md = memory::desc(
+            {1, layer.IC, in_rows, layer.IW}, dt_, tag::nhwc);
+    band_prim.dst_md = memory::desc(
+            {1, layer.OC, out_rows, layer.OW}, dt_, tag::nhwc);
+
+    // the weights layout is chosen by the first primitive of the layer, and
+    // reused by the others
+    const bool init_wei = layer.wei_md.is_zero();
+    const memory::desc wei_md = init_wei
+            ? memory::desc({layer.OC, layer.IC, layer.KH, layer.KW}, dt_,
+                    tag::any)
+            : layer.wei_md;
+
+    // must use user mode to support concurrent execution
+    primitive_attr attr;
+    attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+    if (layer.with_relu) {
+        post_ops pops;
+        pops.append_eltwise(algorithm::eltwise_relu, 0.f, 0.f);
+        attr.set_post_ops(pops);
+    }
+
+    convolution_forward::primitive_desc pd;
+    try {
+        pd = convolution_forward::primitive_desc(p_engine_,
+                prop_kind::forward_inference, algorithm::convolution_direct,
+                band_prim.src_md, wei_md, layer.bia_md, band_prim.dst_md,
+                {1, 1}, {pad_t, layer.pad_l}, {pad_b, layer.pad_r}, attr);
+    } catch (const dnnl::error &) { return status::unimplemented; }
+
+    if (init_wei) {
+        layer.wei_md = pd.weights_desc();
+        layer.need_reorder = layer.wei_md != layer.user_wei_md;
+        if (layer.need_reorder) {
+            auto reorder_pd = dnnl::reorder::primitive_desc(
+                    p_engine_, layer.user_wei_md, p_engine_, layer.wei_md);
+            layer.wei_reorder = make_dnnl_primitive<dnnl::reorder>(reorder_pd);
+            layer.wei_offset = shared_size_;
+            shared_size_ += align_size(layer.wei_md.get_size());
+        }
+    } else if (pd.weights_desc() != layer.wei_md) {
+        return status::unimplemented;
+    }
+
+    band_prim.prim = make_dnnl_primitive<dnnl::convolution_forward>(pd);
+    scratchpad_size_
+            = std::max(scratchpad_size_, pd.scratchpad_desc().get_size());
+    band_prims_[l].emplace(key, band_prim);
+    return status::success;
+}
+
+status_t conv_chain_decomp_kernel_t::compile_impl(
+        const dnnl_partition_impl_t *part, const engine_t *g_engine,
+        const std::vector<logical_tensor_t> &inputs,
+        const std::vector<logical_tensor_t> &outputs) {
+    p_engine_ = make_dnnl_engine(*g_engine);
+    g_alloc_
+            = reinterpret_cast<graph::allocator_t *>(g_engine->get_allocator());
+
+    // get subgraph from the deep copied partition
+    subgraph_ = std::make_shared<subgraph_t>(part->get_ops(), p_engine_,
+            part->get_fpmath_mode(), part->get_use_blocked_layout(), true);
+    BACKEND_DNNL_CHECK(set_given_inputs_outputs(subgraph_, inputs, outputs));
+
+    CHECK(init_config(inputs, outputs));
+    nthr_ = dnnl_get_current_num_threads();
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP
+    // the primitives are executed by a single thread in the parallel region,
+    // so create them for a single thread as well
+    const int omp_nthr = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    const status_t status = init_bands();
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP
+    omp_set_num_threads(omp_nthr);
+#endif
+    CHECK(status);
+
+    // the output is always plain nxc
+    const auto &last = layers_.back();
+    const std::vector<dim_t> out_dims {MB_, last.OH, last.OW, last.OC};
+    const auto out_strides = get_dense_strides(out_dims);
+    auto &out = const_cast<logical_tensor_t &>(outputs[0]);
+    out.ndims = static_cast<int32_t>(out_dims.size());
+    out.layout_type = layout_type::strided;
+    for (size_t i = 0; i < out_dims.size(); ++i) {
+        out.dims[i] = out_dims[i];
+        out.layout.strides[i] = out_strides[i];
+    }
+
+    return status::success;
+}
+
+status_t conv_chain_decomp_kernel_t::execute_impl(const stream_t *g_stream,
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs) {
+    dnnl::stream strm = make_dnnl_stream(p_engine_, *g_stream);
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    auto *tp_stream
+            = dnnl::impl::utils::downcast<dnnl::impl::cpu::cpu_stream_t *>(
+                    const_cast<stream_t *>(g_stream));
+    tp_stream->before_exec_hook();
+    int thread_num = 1;
+    dnnl_threadpool_interop_get_max_concurrency(&thread_num);
+    nthr_ = thread_num;
+#endif
+
+    temporary_scratchpad_t scratchpad(
+            shared_size_ + per_thread_size_ * nthr_, p_engine_, *g_alloc_);
+    char *buffer = scratchpad.get_buffer();
+
+    const size_t nb_layers = layers_.size();
+    std::vector<memory> weights(nb_layers), bias(nb_layers);
+    for (size_t l = 0; l < nb_layers; ++l) {
+        const auto &layer = layers_[l];
+        void *user = inputs[layer.wei_idx].get_data_handle();
+        if (layer.need_reorder) {
+            memory from(layer.user_wei_md, p_engine_, user);
+            weights[l] = memory(
+                    layer.wei_md, p_engine_, buffer + layer.wei_offset);
+            layer.wei_reorder.execute(strm, from, weights[l]);
+        } else {
+            weights[l] = memory(layer.wei_md, p_engine_, user);
+        }
+        if (layer.with_bias) {
+            bias[l] = memory(layer.bia_md, p_engine_,
+                    inputs[layer.bia_idx].get_data_handle());
+        }
+    }
+
+    char *src = static_cast<char *>(inputs[src_idx_].get_data_handle());
+    char *dst = static_cast<char *>(outputs[0].get_data_handle());
+    const size_t dt_size = memory::data_type_size(dt_);
+    const memory::desc scratchpad_md(
+            {static_cast<dim_t>(scratchpad_size_)}, memory::data_type::u8,
+            memory::format_tag::a);
+    const auto &first = layers_.front();
+    const auto &last = layers_.back();
+    const dim_t nb_bands = static_cast<dim_t>(bands_.size());
+
+    const auto loop = [&](int ithr, int nthr, dim_t i) {
+        const dim_t n = i / nb_bands;
+        const auto &band = bands_[i % nb_bands];
+        char *thr_buffer = buffer + shared_size_ + ithr * per_thread_size_;
+        memory sub_scratchpad(scratchpad_md, p_engine_,
+                thr_buffer + per_thread_size_ - scratchpad_size_);
+
+        // in parallel region - these primitives should use single thread.
+        for (size_t l = 0; l < nb_layers; ++l) {
+            const auto &layer = layers_[l];
+            const auto &br = band[l];
+            char *src_ptr = l == 0 ? src
+                            + ((n * first.IH + br.in_start) * first.IW
+                                      * first.IC)
+                                    * dt_size
+                                   : thr_buffer + layers_[l - 1].buf_offset;
+            char *dst_ptr = l + 1 == nb_layers
+                    ? dst
+                            + ((n * last.OH + br.out_start) * last.OW * last.OC)
+                                    * dt_size
+                    : thr_buffer + layer.buf_offset;
+            memory sub_src(br.prim->src_md, p_engine_, src_ptr);
+            memory sub_dst(br.prim->dst_md, p_engine_, dst_ptr);
+            std::unordered_map<int, memory> args {{DNNL_ARG_SRC, sub_src},
+                    {DNNL_ARG_WEIGHTS, weights[l]}, {DNNL_ARG_DST, sub_dst},
+                    {DNNL_ARG_SCRATCHPAD, sub_scratchpad}};
+            if (layer.with_bias) args.insert({DNNL_ARG_BIAS, bias[l]});
+            br.prim->prim.execute(strm, args);
+        }
+    };
+    parallel_nd_ext(nthr_, MB_ * nb_bands, loop);
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    tp_stream->after_exec_hook();
+#endif
+    return status::success;
+}
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,154 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_CONV_CHAIN_DECOMP_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_CONV_CHAIN_DECOMP_HPP
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "graph/backend/dnnl/kernels/kernel_base.hpp"
+
+#include "graph/backend/dnnl/dnnl_partition_impl.hpp"
+#include "graph/backend/dnnl/subgraph.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+// The kernel runs a chain of stride-1 convolutions (each optionally followed
+// by ReLU) band by band. The output rows of the last convolution are split
+// into bands, and each thread computes every convolution of the chain on the
+// rows a band needs, including the halo rows required by the following
+// convolutions. The intermediate rows of a band stay in the L2 cache of the
+// core instead of going through memory between the convolutions.
+struct conv_chain_decomp_kernel_t : public kernel_base_t {
+private:
+    allocator_t *g_alloc_ = nullptr;
+    std::shared_ptr<subgraph_t> subgraph_;
+
+    // a convolution of the chain
+    struct layer_t {
+        // offsets of the weights and the bias in the partition inputs
+        size_t wei_idx = 0;
+        size_t bia_idx = 0;
+        bool with_bias = false;
+        bool with_relu = false;
+        dim_t IC = 0, OC = 0, KH = 0, KW = 0;
+        dim_t IH = 0, IW = 0, OH = 0, OW = 0;
+        dim_t pad_t = 0, pad_l = 0, pad_r = 0;
+
+        // the weights are reordered once per execution if the layout chosen
+        // by the primitives differs from the user layout
+        memory::desc user_wei_md, wei_md, bia_md;
+        dnnl::reorder wei_reorder;
+        bool need_reorder = false;
+        size_t wei_offset = 0;
+
+        // per-thread buffer for the output rows of the layer
+        size_t buf_offset = 0;
+    };
+
+    // a convolution over a band of rows: (input rows, top padding, bottom
+    // padding)
+    using band_key_t = std::tuple<dim_t, dim_t, dim_t>;
+    struct band_prim_t {
+        dnnl::convolution_forward prim;
+        memory::desc src_md, dst_md;
+    };
+
+    // the rows a layer reads and writes for a band
+    struct band_rows_t {
+        dim_t in_start = 0, in_end = 0;
+        dim_t out_start = 0, out_end = 0;
+        const band_prim_t *prim = nullptr;
+    };
+
+    std::vector<layer_t> layers_;
+    std::vector<std::map<band_key_t, band_prim_t>> band_prims_;
+    // [band][layer]
+    std::vector<std::vector<band_rows_t>> bands_;
+
+    dim_t MB_ = 0;
+    dim_t band_rows_ = 0;
+    int nthr_ = 1;
+    memory::data_type dt_ = memory::data_type::undef;
+    size_t src_idx_ = 0;
+
+    // the size of the buffer shared by all threads, and of the buffers and
+    // scratchpad owned by each thread
+    size_t shared_size_ = 0, scratchpad_size_ = 0, per_thread_size_ = 0;
+
+    status_t init_config(const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs);
+
+    status_t init_bands();
+
+    status_t create_band_prim(size_t l, const band_key_t &key);
+
+public:
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override;
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override;
+
+#ifdef DNNL_WITH_SYCL
+    status_t sycl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override {
+        UNUSED(g_stream);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        UNUSED(sycl_deps);
+        UNUSED(sycl_event);
+        return status::unimplemented;
+    }
+#endif
+
+#if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
+    status_t ocl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<cl_event> &cl_deps,
+            cl_event *ret_event) override {
+        UNUSED(g_stream);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        UNUSED(cl_deps);
+        UNUSED(ret_event);
+        return status::unimplemented;
+    }
+#endif
+
+    DEF_KERNEL_METHOD_STR(conv_chain_decomp_kernel_t)
+};
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
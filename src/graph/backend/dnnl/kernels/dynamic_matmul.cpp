@@ -0,0 +1,278 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "graph/interface/logical_tensor.hpp"
+#include "graph/interface/op.hpp"
+
+#include "graph/backend/dnnl/common.hpp"
+#include "graph/backend/dnnl/kernels/dynamic_matmul.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+namespace {
+
+// Executes a matmul primitive created with runtime dims
+struct runtime_matmul_executable_t : public op_executable_t {
+    runtime_matmul_executable_t(const dnnl::matmul &prim) : prim_(prim) {}
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override {
+        prim_.execute(stream, args);
+    }
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        auto e = dnnl::sycl_interop::execute(prim_, stream, args, deps);
+        if (stream.get_engine().get_kind() == engine::kind::cpu) e.wait();
+        return e;
+    }
+#endif
+
+#if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
+    cl_event execute_ocl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<cl_event> &deps = {}) const override {
+        return dnnl::ocl_interop::execute(prim_, stream, args, deps);
+    }
+#endif
+
+private:
+    dnnl::matmul prim_;
+};
+
+// Get the dims and strides of a logical tensor used as a matmul argument with
+// `ndims` dims, i.e. with the leading dims padded with ones and the last two
+// dims swapped if transposed. The dims and strides which are not known are
+// runtime dims, except the stride of the innermost dim which must be one.
+void get_dims_strides(const logical_tensor_t &lt, int ndims, bool transposed,
+        dims &adims, dims &astrides) {
+    const logical_tensor_wrapper_t ltw(lt);
+    const bool known = ltw.is_strided() && !ltw.is_shape_unknown()
+            && !ltw.is_stride_unknown();
+    const int off = ndims - lt.ndims;
+
+    adims.assign(ndims, 1);
+    astrides.assign(ndims, DNNL_RUNTIME_DIM_VAL);
+    for (int d = 0; d < lt.ndims; ++d) {
+        adims[off + d] = lt.dims[d] == DNNL_GRAPH_UNKNOWN_DIM
+                ? DNNL_RUNTIME_DIM_VAL
+                : lt.dims[d];
+        if (known) astrides[off + d] = lt.layout.strides[d];
+    }
+    if (known) {
+        for (int d = off - 1; d >= 0; --d)
+            astrides[d] = adims[d + 1] * astrides[d + 1];
+    } else {
+        astrides[ndims - 1] = 1;
+    }
+
+    if (transposed) {
+        std::swap(adims[ndims - 1], adims[ndims - 2]);
+        std::swap(astrides[ndims - 1], astrides[ndims - 2]);
+    }
+}
+
+const logical_tensor_t *find_lt(
+        size_t id, const std::vector<logical_tensor_t> &lts) {
+    for (const auto &lt : lts) {
+        if (lt.id == id) return &lt;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+status_t dynamic_matmul_t::compile_impl(const dnnl_partition_impl_t *part,
+        const engine_t *g_engine, const std::vector<logical_tensor_t> &inputs,
+        const std::vector<logical_tensor_t> &outputs) {
+    p_engine_ = make_dnnl_engine(*g_engine);
+    if (p_engine_.get_kind() != dnnl::engine::kind::cpu)
+        return status::unimplemented;
+
+    const auto &ops = part->get_ops();
+    if (ops.size() != 1 || ops[0]->get_kind() != graph::op_kind::MatMul)
+        return status::unimplemented;
+    const auto &op = ops[0];
+
+    const bool with_bias = op->num_inputs() > 2;
+    const logical_tensor_t *src
+            = find_lt(op->get_input_value(0)->get_logical_tensor().id, inputs);
+    const logical_tensor_t *wei
+            = find_lt(op->get_input_value(1)->get_logical_tensor().id, inputs);
+    const logical_tensor_t *bias = with_bias
+            ? find_lt(op->get_input_value(2)->get_logical_tensor().id, inputs)
+            : nullptr;
+    const logical_tensor_t *dst = find_lt(
+            op->get_output_value(0)->get_logical_tensor().id, outputs);
+    if (!src || !wei || (with_bias && !bias) || !dst)
+        return status::invalid_arguments;
+
+    // The batch dims of the weights are not broadcast, and the shape of the
+    // bias is known.
+    const int ndims = src->ndims;
+    if (ndims < 2 || wei->ndims < 2 || wei->ndims > ndims)
+        return status::unimplemented;
+    for (int d = 0; d < wei->ndims - 2; ++d) {
+        if (wei->dims[d] != 1) return status::unimplemented;
+    }
+    if (bias
+            && (bias->ndims > ndims
+                    || logical_tensor_wrapper_t(*bias).is_shape_unknown()))
+        return status::unimplemented;
+
+    const bool transpose_a = op->has_attr(op_attr::transpose_a)
+            && op->get_attr<bool>(op_attr::transpose_a);
+    const bool transpose_b = op->has_attr(op_attr::transpose_b)
+            && op->get_attr<bool>(op_attr::transpose_b);
+
+    using md_t = dnnl::memory::desc;
+    const auto add_arg = [&](const logical_tensor_t &lt, int dnnl_arg,
+                                 bool transposed) -> md_t {
+        dims adims, astrides;
+        get_dims_strides(lt, ndims, transposed, adims, astrides);
+        const auto dt = static_cast<dnnl::memory::data_type>(lt.data_type);
+        args_.push_back({lt.id, dnnl_arg, transposed, {adims, dt, astrides}});
+        return args_.back().md;
+    };
+
+    args_.clear();
+    const md_t src_md = add_arg(*src, DNNL_ARG_SRC, transpose_a);
+    const md_t wei_md = add_arg(*wei, DNNL_ARG_WEIGHTS, transpose_b);
+    const md_t bias_md = bias ? add_arg(*bias, DNNL_ARG_BIAS, false) : md_t();
+
+    // The output dims are inferred from the known dims of the inputs, and its
+    // strides are given at the execution.
+    if (dst->ndims != ndims) return status::unimplemented;
+    const md_t dst_md = add_arg(*dst, DNNL_ARG_DST, false);
+
+    dnnl::primitive_attr attr;
+    attr.set_fpmath_mode(
+            static_cast<dnnl::fpmath_mode>(part->get_fpmath_mode()));
+    dnnl::matmul::primitive_desc pd;
+    try {
+        pd = dnnl::matmul::primitive_desc(
+                p_engine_, src_md, wei_md, bias_md, dst_md, attr);
+    } catch (dnnl::error &) { return status::unimplemented; }
+
+    const dnnl::matmul prim = make_dnnl_primitive<dnnl::matmul>(pd);
+    exec_ = std::make_shared<profiled_executable_t>(
+            std::make_shared<runtime_matmul_executable_t>(prim),
+            op_t::kind2str(op->get_kind()) + "_"
+                    + std::to_string(op->get_id()),
+            std::vector<dnnl::primitive> {prim});
+
+    return status::success;
+}
+
+status_t dynamic_matmul_t::bind_args(const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs,
+        std::unordered_map<int, memory> &args) const {
+    const auto find_tensor = [&](size_t id) -> const tensor_t * {
+        for (const auto *ts : {&inputs, &outputs}) {
+            for (const auto &t : *ts) {
+                if (t.get_logical_tensor().id == id) return &t;
+            }
+        }
+        return nullptr;
+    };
+
+    // Bind the concrete shapes to the memory descriptors of the primitive. The
+    // tensors which don't agree with the dims and strides known at the
+    // compilation can't be bound.
+    for (const auto &arg : args_) {
+        const tensor_t *t = find_tensor(arg.id);
+        if (!t) return status::invalid_arguments;
+
+        const int ndims = arg.md.get_ndims();
+        const logical_tensor_t &lt = t->get_logical_tensor();
+        const logical_tensor_wrapper_t ltw(lt);
+        if (lt.ndims > ndims || !ltw.is_strided() || ltw.is_shape_unknown()
+                || ltw.is_stride_unknown())
+            return status::invalid_arguments;
+
+        dims adims, astrides;
+        get_dims_strides(lt, ndims, arg.transposed, adims, astrides);
+        const dims &md_dims = arg.md.get_dims();
+        const dims &md_strides = arg.md.get_strides();
+        for (int d = 0; d < ndims; ++d) {
+            if ((md_dims[d] != DNNL_RUNTIME_DIM_VAL && md_dims[d] != adims[d])
+                    || (md_strides[d] != DNNL_RUNTIME_DIM_VAL
+                            && md_strides[d] != astrides[d]))
+                return status::unimplemented;
+        }
+
+        args.insert({arg.dnnl_arg,
+                make_dnnl_memory({adims, arg.md.get_data_type(), astrides},
+                        p_engine_, t->get_data_handle())});
+    }
+    return status::success;
+}
+
+status_t dynamic_matmul_t::execute_impl(const stream_t *g_stream,
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs) {
+    std::unordered_map<int, memory> args;
+    CHECK(bind_args(inputs, outputs, args));
+
+    dnnl::stream p_stream = make_dnnl_stream(p_engine_, *g_stream);
+    exec_->execute(p_stream, args);
+    return status::success;
+}
+
+#ifdef DNNL_WITH_SYCL
+status_t dynamic_matmul_t::sycl_execute_impl(const stream_t *g_stream,
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs,
+        const std::vector<::sycl::event> &sycl_deps,
+        ::sycl::event *sycl_event) {
+    std::unordered_map<int, memory> args;
+    CHECK(bind_args(inputs, outputs, args));
+
+    dnnl::stream p_stream = make_dnnl_stream(p_engine_, *g_stream);
+    auto e = exec_->execute_sycl(p_stream, args, sycl_deps);
+    if (sycl_event) *sycl_event = e;
+    return status::success;
+}
+#endif
+
+#if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
+status_t dynamic_matmul_t::ocl_execute_impl(const stream_t *g_stream,
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs,
+        const std::vector<cl_event> &cl_deps, cl_event *ret_event) {
+    // The kernel is only compiled for CPU engines
+    return status::unimplemented;
+}
+#endif
+
+kernel_ptr dynamic_matmul_kernel_creator() {
+    return std::make_shared<dynamic_matmul_t>();
+}
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
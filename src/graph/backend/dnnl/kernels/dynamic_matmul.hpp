@@ -0,0 +1,96 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_DYNAMIC_MATMUL_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_DYNAMIC_MATMUL_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graph/backend/dnnl/kernels/kernel_base.hpp"
+
+#include "graph/backend/dnnl/dnnl_partition_impl.hpp"
+#include "graph/backend/dnnl/op_executable.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+// The kernel of a single MatMul partition compiled with unknown input dims. The
+// unknown dims are compiled as runtime dims of the matmul primitive, so the
+// compiled partition binds the concrete shapes given at each execution without
+// lowering the partition again. The execution returns unimplemented for the
+// tensors which can't be bound to the primitive, so that the caller can fall
+// back to lowering the partition for their shapes.
+struct dynamic_matmul_t : public kernel_base_t {
+private:
+    struct arg_t {
+        size_t id;
+        int dnnl_arg;
+        bool transposed;
+        dnnl::memory::desc md;
+    };
+
+    std::vector<arg_t> args_;
+    std::shared_ptr<op_executable_t> exec_;
+
+    status_t bind_args(const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            std::unordered_map<int, memory> &args) const;
+
+public:
+    dynamic_matmul_t() = default;
+
+    ~dynamic_matmul_t() override = default;
+
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override;
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override;
+
+#ifdef DNNL_WITH_SYCL
+    status_t sycl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override;
+#endif
+
+#if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
+    status_t ocl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<cl_event> &cl_deps, cl_event *ret_event) override;
+#endif
+
+    DEF_KERNEL_METHOD_STR(dynamic_matmul_t)
+};
+
+kernel_ptr dynamic_matmul_kernel_creator();
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
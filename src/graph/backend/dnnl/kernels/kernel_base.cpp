@@ -14,8 +14,13 @@
  * limitations under the License.
  *******************************************************************************/
 
+#include <future>
+
 #include "graph/backend/dnnl/kernels/kernel_base.hpp"
 #include "graph/backend/dnnl/dnnl_constant_tensor_cache.hpp"
+#include "graph/backend/dnnl/op_executable.hpp"
+#include "graph/backend/dnnl/passes/memory_planning.hpp"
+#include "graph/backend/dnnl/subgraph.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -47,6 +52,41 @@ const std::vector<inplace_pair_t> &kernel_base_t::get_inplace_pairs() const {
     return inplace_pairs_;
 };
 
+constant_cache_t::cached_t kernel_base_t::prepare_constant_buffer(
+        dnnl::stream &strm, constant_cache_t::key_t key,
+        const memory_planner_t &planner, const subgraph_t &sg,
+        execution_args_set_t *res, graph::allocator_t *alc,
+        const std::vector<tensor_t> &inputs) {
+    std::promise<constant_cache_t::cached_t> c_promise;
+    constant_cache_t::value_t cached_value = dnnl_constant_cache_get_or_add(
+            p_engine_, key, planner.total_internal_persistent_size(),
+            c_promise.get_future());
+    const bool is_from_cache = cached_value.valid();
+
+    bool c_ready = is_from_cache;
+    constant_cache_t::cached_t c_buffer = is_from_cache
+            ? cached_value.get()
+            : dnnl_constant_buffer_create(
+                    planner.total_internal_persistent_size(), p_engine_, alc,
+                    key, inputs, c_ready);
+    grantor_t c_grantor
+            = planner.internal_persistent_grantor(c_buffer->data<char>());
+    for (auto &mem_offkey : res->get_mems_use_internal_persistent()) {
+        mem_offkey.first.set_data_handle(c_grantor.get(mem_offkey.second));
+    }
+    if (is_from_cache) return c_buffer;
+
+    if (!c_ready) {
+        for (size_t i = 0; i < sg.execs_.size(); i++) {
+            if (!sg.is_constant_[i]) continue;
+            sg.execs_[i]->execute(strm, res->get_exec_args()[i]);
+        }
+        dnnl_constant_buffer_publish(c_buffer, strm);
+    }
+    c_promise.set_value(c_buffer);
+    return c_buffer;
+}
+
 } // namespace dnnl_impl
 } // namespace graph
 } // namespace impl
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "graph/interface/c_types_map.hpp"
+#include "graph/interface/constant_tensor_cache.hpp"
 #include "graph/interface/logical_tensor.hpp"
 
 // required for dnnl::engine
@@ -38,6 +39,9 @@ namespace graph {
 namespace dnnl_impl {
 
 class dnnl_partition_impl_t;
+class execution_args_set_t;
+class memory_planner_t;
+class subgraph_t;
 
 struct kernel_base_t {
     virtual ~kernel_base_t() = default;
@@ -107,6 +111,16 @@ struct kernel_base_t {
     const std::vector<inplace_pair_t> &get_inplace_pairs() const;
 
 protected:
+    // Bind the internal persistent memories of `res` to the constant cache
+    // entry of `key`. On a cache miss, the constant executables of `sg` are
+    // run on `strm` to compute the entry. The returned buffer must be held
+    // until the execution finishes.
+    graph::constant_tensor_cache_t::cached_t prepare_constant_buffer(
+            dnnl::stream &strm, graph::constant_tensor_cache_t::key_t key,
+            const memory_planner_t &planner, const subgraph_t &sg,
+            execution_args_set_t *res, graph::allocator_t *alc,
+            const std::vector<tensor_t> &inputs);
+
     std::vector<inplace_pair_t> inplace_pairs_;
     dnnl::engine p_engine_;
 };
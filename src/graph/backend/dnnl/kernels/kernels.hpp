@@ -21,14 +21,17 @@
 #include "graph/backend/dnnl/kernels/binary.hpp"
 #include "graph/backend/dnnl/kernels/concat.hpp"
 #include "graph/backend/dnnl/kernels/conv.hpp"
+#include "graph/backend/dnnl/kernels/conv_chain.hpp"
 #include "graph/backend/dnnl/kernels/conv_transpose.hpp"
 #include "graph/backend/dnnl/kernels/dummy.hpp"
+#include "graph/backend/dnnl/kernels/dynamic_matmul.hpp"
 #include "graph/backend/dnnl/kernels/eltwise.hpp"
 #include "graph/backend/dnnl/kernels/group_norm.hpp"
 #include "graph/backend/dnnl/kernels/large_partition.hpp"
 #include "graph/backend/dnnl/kernels/layer_norm.hpp"
 #include "graph/backend/dnnl/kernels/log_softmax.hpp"
 #include "graph/backend/dnnl/kernels/matmul.hpp"
+#include "graph/backend/dnnl/kernels/mlp.hpp"
 #include "graph/backend/dnnl/kernels/mqa.hpp"
 #include "graph/backend/dnnl/kernels/pool.hpp"
 #include "graph/backend/dnnl/kernels/prelu.hpp"
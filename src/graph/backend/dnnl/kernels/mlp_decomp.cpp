@@ -0,0 +1,477 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <future>
+
+#include "common/dnnl_thread.hpp"
+#include "common/utils.hpp"
+
+#include "graph/backend/dnnl/kernels/mlp_decomp.hpp"
+
+#include "graph/backend/dnnl/common.hpp"
+#include "graph/backend/dnnl/dnnl_constant_tensor_cache.hpp"
+#include "graph/backend/dnnl/passes/utils.hpp"
+#include "graph/backend/dnnl/scratchpad.hpp"
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include "cpu/platform.hpp"
+#endif
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include "cpu/cpu_stream.hpp"
+#include "oneapi/dnnl/dnnl_threadpool.h"
+#endif
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+namespace {
+
+// Returns the activation applied on the output of the given matmul and sets
+// act_out to the op producing the activated tensor.
+algorithm get_activation(const op_t *matmul, const op_t *&act_out) {
+    const auto &consumers = matmul->get_output_value(0)->get_consumers();
+    if (consumers.size() == 1) {
+        act_out = &consumers[0].get_op();
+        switch (act_out->get_kind()) {
+            case graph::op_kind::GELU: return algorithm::eltwise_gelu_erf;
+            case graph::op_kind::ReLU: return algorithm::eltwise_relu;
+            default: return algorithm::undef;
+        }
+    }
+
+    // swish: x * sigmoid(x)
+    if (consumers.size() != 2) return algorithm::undef;
+    const op_t *sigmoid = nullptr, *mul = nullptr;
+    for (const auto &csm : consumers) {
+        const op_t &csm_op = csm.get_op();
+        if (csm_op.get_kind() == graph::op_kind::Sigmoid) sigmoid = &csm_op;
+        if (csm_op.get_kind() == graph::op_kind::Multiply) mul = &csm_op;
+    }
+    if (!sigmoid || !mul) return algorithm::undef;
+    const auto &sigmoid_csm = sigmoid->get_output_value(0)->get_consumers();
+    if (sigmoid_csm.size() != 1 || &sigmoid_csm[0].get_op() != mul)
+        return algorithm::undef;
+    act_out = mul;
+    return algorithm::eltwise_swish;
+}
+
+bool is_dense(const logical_tensor_t &lt) {
+    const logical_tensor_wrapper_t ltw(lt);
+    return ltw.is_strided() && !ltw.is_shape_unknown()
+            && ltw.vstrides() == get_dense_strides(ltw.vdims());
+}
+
+size_t align_size(size_t size) {
+    return impl::utils::rnd_up(size, 64);
+}
+
+} // namespace
+
+status_t mlp_decomp_kernel_t::init_config(
+        const std::vector<logical_tensor_t> &inputs,
+        const std::vector<logical_tensor_t> &outputs) {
+    std::vector<const op_t *> matmuls;
+    for (const auto &cur_op : subgraph_->get_ops()) {
+        if (cur_op->get_kind() == graph::op_kind::MatMul)
+            matmuls.emplace_back(cur_op.get());
+    }
+    if (matmuls.size() != 2 && matmuls.size() != 3)
+        return status::unimplemented;
+    gated_ = matmuls.size() == 3;
+
+    // the down projection produces the output of the partition
+    const op_t *down = nullptr;
+    for (const op_t *mm : matmuls) {
+        if (mm->get_output_value(0)->get_consumers().empty()) down = mm;
+    }
+    if (!down || !down->get_input_value(0)->has_producer())
+        return status::unimplemented;
+    const op_t *down_in = &down->get_input_value(0)->get_producer();
+
+    const op_t *up = nullptr, *gate = nullptr, *act_out = nullptr;
+    if (!gated_) {
+        up = matmuls[0] == down ? matmuls[1] : matmuls[0];
+        act_alg_ = get_activation(up, act_out);
+        if (act_alg_ == algorithm::undef || act_out != down_in)
+            return status::unimplemented;
+    } else {
+        // the activated gate projection multiplies the up projection
+        if (down_in->get_kind() != graph::op_kind::Multiply)
+            return status::unimplemented;
+        const op_t *gate_out = nullptr;
+        for (size_t i = 0; i < 2; ++i) {
+            auto in_val = down_in->get_input_value(i);
+            if (!in_val->has_producer()) return status::unimplemented;
+            const op_t *producer = &in_val->get_producer();
+            if (producer->get_kind() == graph::op_kind::MatMul)
+                up = producer;
+            else
+                gate_out = producer;
+        }
+        if (!up || !gate_out
+                || up->get_output_value(0)->get_consumers().size() != 1)
+            return status::unimplemented;
+        for (const op_t *mm : matmuls) {
+            if (mm != up && mm != down) gate = mm;
+        }
+        act_alg_ = get_activation(gate, act_out);
+        if (act_alg_ == algorithm::undef || act_out != gate_out)
+            return status::unimplemented;
+        if (gate->get_input_value(0)->get_logical_tensor().id
+                != up->get_input_value(0)->get_logical_tensor().id)
+            return status::unimplemented;
+    }
+
+    // no bias and no transposition is supported
+    for (const op_t *mm : {up, gate, down}) {
+        if (!mm) continue;
+        if (mm->num_inputs() != 2) return status::unimplemented;
+        for (auto attr : {op_attr::transpose_a, op_attr::transpose_b}) {
+            if (mm->has_attr(attr) && mm->get_attr<bool>(attr))
+                return status::unimplemented;
+        }
+    }
+
+    const auto find_input = [&](const op_t *op, size_t offset, size_t &idx) {
+        const size_t id = op->get_input_value(offset)->get_logical_tensor().id;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (inputs[i].id != id) continue;
+            idx = i;
+            return is_dense(inputs[i]);
+        }
+        return false;
+    };
+    if (!find_input(up, 0, src_idx_) || !find_input(up, 1, wei_up_idx_)
+            || !find_input(down, 1, wei_down_idx_)
+            || (gated_ && !find_input(gate, 1, wei_gate_idx_)))
+        return status::unimplemented;
+
+    const auto src_dims = logical_tensor_wrapper_t(inputs[src_idx_]).vdims();
+    const auto up_dims = logical_tensor_wrapper_t(inputs[wei_up_idx_]).vdims();
+    const auto down_dims
+            = logical_tensor_wrapper_t(inputs[wei_down_idx_]).vdims();
+    if (src_dims.size() < 2 || up_dims.size() != 2 || down_dims.size() != 2)
+        return status::unimplemented;
+    K_ = src_dims.back();
+    H_ = up_dims[1];
+    N_ = down_dims[1];
+    M_ = 1;
+    for (size_t i = 0; i + 1 < src_dims.size(); ++i)
+        M_ *= src_dims[i];
+    if (up_dims[0] != K_ || down_dims[0] != H_) return status::unimplemented;
+    if (gated_
+            && logical_tensor_wrapper_t(inputs[wei_gate_idx_]).vdims()
+                    != up_dims)
+        return status::unimplemented;
+
+    const data_type_t dt = inputs[src_idx_].data_type;
+    if (!impl::utils::one_of(dt, data_type::f32, data_type::bf16))
+        return status::unimplemented;
+    for (size_t idx : {wei_up_idx_, wei_down_idx_}) {
+        if (inputs[idx].data_type != dt) return status::unimplemented;
+    }
+    if (gated_ && inputs[wei_gate_idx_].data_type != dt)
+        return status::unimplemented;
+    dt_ = static_cast<memory::data_type>(dt);
+
+    if (outputs.size() != 1 || outputs[0].data_type != dt)
+        return status::unimplemented;
+    const logical_tensor_wrapper_t out_ltw(outputs[0]);
+    if (!out_ltw.is_any() && !(out_ltw.is_strided() && is_dense(outputs[0])))
+        return status::unimplemented;
+
+    // Each block of rows of the source is computed by one thread. Blocks are
+    // sized so that the source, intermediate and output rows of a block fit
+    // into half of the L2 cache. With too few rows per thread, the regular
+    // kernel which also parallelizes over the channels is preferred.
+    const dim_t min_rows_per_thread = 8;
+    nthr_ = dnnl_get_current_num_threads();
+    if (M_ < nthr_ * min_rows_per_thread) return status::unimplemented;
+
+    const size_t row_size = memory::data_type_size(dt_)
+            * static_cast<size_t>(K_ + H_ * (gated_ ? 2 : 1) + N_);
+    size_t l2_size = 1024 * 1024;
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    l2_size = cpu::platform::get_per_core_cache_size(2);
+#endif
+    dim_t rows = std::max<dim_t>(1, l2_size / 2 / row_size);
+    rows = std::min(rows, impl::utils::div_up(M_, static_cast<dim_t>(nthr_)));
+    if (rows > 16) rows = rows / 16 * 16;
+    block_m_ = rows;
+
+    return status::success;
+}
+
+status_t mlp_decomp_kernel_t::init_weights(weights_t &wei,
+        const logical_tensor_t &user_lt, const memory::desc &md) {
+    wei.user_md = make_dnnl_memory_desc(user_lt);
+    wei.md = md;
+    wei.need_reorder = wei.user_md != md;
+    if (!wei.need_reorder) return status::success;
+
+    auto pd = dnnl::reorder::primitive_desc(
+            p_engine_, wei.user_md, p_engine_, wei.md);
+    wei.reorder = dnnl::reorder(pd);
+    wei.constant = logical_tensor_wrapper_t(user_lt).is_constant()
+            && enabled_constant_cache();
+    size_t &size = wei.constant ? constant_size_ : shared_size_;
+    wei.offset = size;
+    size += align_size(md.get_size());
+    return status::success;
+}
+
+status_t mlp_decomp_kernel_t::create_block_prims(
+        dim_t rows, block_prims_t &prims) {
+    using tag = memory::format_tag;
+    prims.rows = rows;
+    prims.src_md = memory::desc({rows, K_}, dt_, tag::ab);
+    prims.inter_md = memory::desc({rows, H_}, dt_, tag::ab);
+    prims.dst_md = memory::desc({rows, N_}, dt_, tag::ab);
+
+    // the weights layout is chosen when creating the primitives for the full
+    // block, and reused by the primitives for the tail block
+    const bool init_wei = wei_up_.md.is_zero();
+    const auto get_wei_md = [&](const weights_t &wei, dim_t ic, dim_t oc) {
+        return init_wei ? memory::desc({ic, oc}, dt_, tag::any) : wei.md;
+    };
+
+    // must use user mode to support concurrent execution
+    primitive_attr act_attr;
+    act_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+    post_ops act_pops;
+    act_pops.append_eltwise(
+            act_alg_, act_alg_ == algorithm::eltwise_swish ? 1.f : 0.f, 0.f);
+    act_attr.set_post_ops(act_pops);
+
+    primitive_attr down_attr;
+    down_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+
+    matmul::primitive_desc up_pd, gate_pd, down_pd;
+    try {
+        if (gated_) {
+            gate_pd = matmul::primitive_desc(p_engine_, prims.src_md,
+                    get_wei_md(wei_gate_, K_, H_), prims.inter_md, act_attr);
+
+            primitive_attr mul_attr;
+            mul_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+            post_ops mul_pops;
+            mul_pops.append_binary(algorithm::binary_mul, prims.inter_md);
+            mul_attr.set_post_ops(mul_pops);
+            up_pd = matmul::primitive_desc(p_engine_, prims.src_md,
+                    get_wei_md(wei_up_, K_, H_), prims.inter_md, mul_attr);
+        } else {
+            up_pd = matmul::primitive_desc(p_engine_, prims.src_md,
+                    get_wei_md(wei_up_, K_, H_), prims.inter_md, act_attr);
+        }
+        down_pd = matmul::primitive_desc(p_engine_, prims.inter_md,
+                get_wei_md(wei_down_, H_, N_), prims.dst_md, down_attr);
+    } catch (const dnnl::error &) { return status::unimplemented; }
+
+    prims.up = dnnl::matmul(up_pd);
+    prims.down = dnnl::matmul(down_pd);
+    if (gated_) prims.gate = dnnl::matmul(gate_pd);
+
+    if (init_wei) {
+        const auto &ins = subgraph_->ins_;
+        CHECK(init_weights(wei_up_, ins[wei_up_idx_], up_pd.weights_desc()));
+        CHECK(init_weights(
+                wei_down_, ins[wei_down_idx_], down_pd.weights_desc()));
+        if (gated_) {
+            CHECK(init_weights(
+                    wei_gate_, ins[wei_gate_idx_], gate_pd.weights_desc()));
+        }
+    }
+
+    for (const auto &pd : {up_pd, gate_pd, down_pd}) {
+        if (!pd) continue;
+        scratchpad_size_
+                = std::max(scratchpad_size_, pd.scratchpad_desc().get_size());
+    }
+    return status::success;
+}
+
+status_t mlp_decomp_kernel_t::compile_impl(const dnnl_partition_impl_t *part,
+        const engine_t *g_engine, const std::vector<logical_tensor_t> &inputs,
+        const std::vector<logical_tensor_t> &outputs) {
+    p_engine_ = make_dnnl_engine(*g_engine);
+    g_alloc_
+            = reinterpret_cast<graph::allocator_t *>(g_engine->get_allocator());
+
+    // get subgraph from the deep copied partition
+    subgraph_ = std::make_shared<subgraph_t>(part->get_ops(), p_engine_,
+            part->get_fpmath_mode(), part->get_use_blocked_layout(), true);
+    BACKEND_DNNL_CHECK(set_given_inputs_outputs(subgraph_, inputs, outputs));
+
+    CHECK(init_config(inputs, outputs));
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP
+    // the primitives are executed by a single thread in the parallel region,
+    // so create them for a single thread as well
+    const int omp_nthr = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    status_t status = create_block_prims(block_m_, full_block_);
+    const dim_t tail = M_ % block_m_;
+    if (status == status::success && tail != 0)
+        status = create_block_prims(tail, tail_block_);
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP
+    omp_set_num_threads(omp_nthr);
+#endif
+    CHECK(status);
+
+    std::vector<memory::desc> constant_mds;
+    for (const weights_t *wei : {&wei_up_, &wei_gate_, &wei_down_}) {
+        if (wei->constant) constant_mds.push_back(wei->md);
+    }
+    constant_key_ = generate_constant_cache_key(part->id(), constant_mds);
+
+    const size_t dt_size = memory::data_type_size(dt_);
+    inter_size_ = align_size(block_m_ * H_ * dt_size);
+    scratchpad_size_ = align_size(scratchpad_size_);
+    per_thread_size_ = inter_size_ * (gated_ ? 2 : 1) + scratchpad_size_;
+
+    // the output is always plain
+    auto &out = const_cast<logical_tensor_t &>(outputs[0]);
+    auto out_dims = logical_tensor_wrapper_t(inputs[src_idx_]).vdims();
+    out_dims.back() = N_;
+    const auto out_strides = get_dense_strides(out_dims);
+    out.ndims = static_cast<int32_t>(out_dims.size());
+    out.layout_type = layout_type::strided;
+    for (size_t i = 0; i < out_dims.size(); ++i) {
+        out.dims[i] = out_dims[i];
+        out.layout.strides[i] = out_strides[i];
+    }
+
+    return status::success;
+}
+
+status_t mlp_decomp_kernel_t::execute_impl(const stream_t *g_stream,
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs) {
+    dnnl::stream strm = make_dnnl_stream(p_engine_, *g_stream);
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    auto *tp_stream
+            = dnnl::impl::utils::downcast<dnnl::impl::cpu::cpu_stream_t *>(
+                    const_cast<stream_t *>(g_stream));
+    tp_stream->before_exec_hook();
+    int thread_num = 1;
+    dnnl_threadpool_interop_get_max_concurrency(&thread_num);
+    nthr_ = thread_num;
+#endif
+
+    temporary_scratchpad_t scratchpad(
+            shared_size_ + per_thread_size_ * nthr_, p_engine_, *g_alloc_);
+    char *buffer = scratchpad.get_buffer();
+
+    // the constant weights are reordered only if the cache entry is not
+    // computed yet
+    constant_cache_t::cached_t c_buffer;
+    char *c_data = nullptr;
+    bool is_from_cache = true, c_ready = true;
+    std::promise<constant_cache_t::cached_t> c_promise;
+    if (constant_size_ > 0) {
+        constant_cache_t::value_t cached_value
+                = dnnl_constant_cache_get_or_add(p_engine_, constant_key_,
+                        constant_size_, c_promise.get_future());
+        is_from_cache = cached_value.valid();
+        c_ready = is_from_cache;
+        c_buffer = is_from_cache ? cached_value.get()
+                                 : dnnl_constant_buffer_create(constant_size_,
+                                         p_engine_, g_alloc_, constant_key_,
+                                         inputs, c_ready);
+        c_data = c_buffer->data<char>();
+    }
+
+    const auto prepare_weights = [&](const weights_t &wei, size_t idx) {
+        char *user = static_cast<char *>(inputs[idx].get_data_handle());
+        if (!wei.need_reorder) return user;
+        char *data = (wei.constant ? c_data : buffer) + wei.offset;
+        if (wei.constant && c_ready) return data;
+        memory from(wei.user_md, p_engine_, user);
+        memory to(wei.md, p_engine_, data);
+        wei.reorder.execute(strm, from, to);
+        return data;
+    };
+    memory wei_up(wei_up_.md, p_engine_, prepare_weights(wei_up_, wei_up_idx_));
+    memory wei_down(
+            wei_down_.md, p_engine_, prepare_weights(wei_down_, wei_down_idx_));
+    memory wei_gate;
+    if (gated_) {
+        wei_gate = memory(wei_gate_.md, p_engine_,
+                prepare_weights(wei_gate_, wei_gate_idx_));
+    }
+    if (!is_from_cache) {
+        if (!c_ready) dnnl_constant_buffer_publish(c_buffer, strm);
+        c_promise.set_value(c_buffer);
+    }
+
+    char *src = static_cast<char *>(inputs[src_idx_].get_data_handle());
+    char *dst = static_cast<char *>(outputs[0].get_data_handle());
+    const size_t dt_size = memory::data_type_size(dt_);
+    const memory::desc scratchpad_md(
+            {static_cast<dim_t>(scratchpad_size_)}, memory::data_type::u8,
+            memory::format_tag::a);
+
+    const auto loop = [&](int ithr, int nthr, dim_t ib) {
+        const dim_t m = ib * block_m_;
+        const block_prims_t &prims
+                = m + block_m_ > M_ ? tail_block_ : full_block_;
+        char *thr_buffer = buffer + shared_size_ + ithr * per_thread_size_;
+
+        memory sub_src(prims.src_md, p_engine_, src + m * K_ * dt_size);
+        memory sub_dst(prims.dst_md, p_engine_, dst + m * N_ * dt_size);
+        memory inter(prims.inter_md, p_engine_, thr_buffer);
+        memory sub_scratchpad(scratchpad_md, p_engine_,
+                thr_buffer + per_thread_size_ - scratchpad_size_);
+
+        // in parallel region - these primitives should use single thread.
+        std::unordered_map<int, memory> up_args {{DNNL_ARG_SRC, sub_src},
+                {DNNL_ARG_WEIGHTS, wei_up}, {DNNL_ARG_DST, inter},
+                {DNNL_ARG_SCRATCHPAD, sub_scratchpad}};
+        if (gated_) {
+            memory gate(prims.inter_md, p_engine_, thr_buffer + inter_size_);
+            prims.gate.execute(strm,
+                    {{DNNL_ARG_SRC, sub_src}, {DNNL_ARG_WEIGHTS, wei_gate},
+                            {DNNL_ARG_DST, gate},
+                            {DNNL_ARG_SCRATCHPAD, sub_scratchpad}});
+            up_args.insert(
+                    {DNNL_ARG_ATTR_MULTIPLE_POST_OP(0) | DNNL_ARG_SRC_1, gate});
+        }
+        prims.up.execute(strm, up_args);
+        prims.down.execute(strm,
+                {{DNNL_ARG_SRC, inter}, {DNNL_ARG_WEIGHTS, wei_down},
+                        {DNNL_ARG_DST, sub_dst},
+                        {DNNL_ARG_SCRATCHPAD, sub_scratchpad}});
+    };
+    parallel_nd_ext(nthr_, impl::utils::div_up(M_, block_m_), loop);
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    tp_stream->after_exec_hook();
+#endif
+    return status::success;
+}
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
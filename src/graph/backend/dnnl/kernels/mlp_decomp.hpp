@@ -0,0 +1,142 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_MLP_DECOMP_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_MLP_DECOMP_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graph/backend/dnnl/kernels/kernel_base.hpp"
+
+#include "graph/backend/dnnl/dnnl_partition_impl.hpp"
+#include "graph/backend/dnnl/subgraph.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+// The kernel decomposes a MLP block (matmul -> activation -> matmul, or the
+// gated variant where the activated gate projection multiplies the up
+// projection) into blocks of rows of the source. Each thread runs all the
+// matmuls of the block in turn, so the wide intermediate of a block stays in
+// the L2 cache of the core instead of being written to memory.
+struct mlp_decomp_kernel_t : public kernel_base_t {
+private:
+    allocator_t *g_alloc_ = nullptr;
+    std::shared_ptr<subgraph_t> subgraph_;
+
+    // the primitives computing one block of rows
+    struct block_prims_t {
+        dim_t rows = 0;
+        dnnl::matmul up, gate, down;
+        memory::desc src_md, inter_md, dst_md;
+    };
+
+    // M: rows of the source, K: input channels, H: hidden channels, N: output
+    // channels
+    dim_t M_ = 0, K_ = 0, H_ = 0, N_ = 0;
+    dim_t block_m_ = 0;
+    int nthr_ = 1;
+    bool gated_ = false;
+    algorithm act_alg_ = algorithm::undef;
+    memory::data_type dt_ = memory::data_type::undef;
+
+    // offsets of the source and the weights in the partition inputs
+    size_t src_idx_ = 0, wei_up_idx_ = 0, wei_gate_idx_ = 0, wei_down_idx_ = 0;
+
+    block_prims_t full_block_, tail_block_;
+
+    // the weights are reordered if the layout chosen by the matmul primitives
+    // differs from the user layout. Constant weights are reordered into the
+    // constant tensor cache on the first execution, and the other ones into
+    // the shared buffer on each execution.
+    struct weights_t {
+        memory::desc user_md, md;
+        dnnl::reorder reorder;
+        bool need_reorder = false;
+        bool constant = false;
+        size_t offset = 0;
+    };
+    weights_t wei_up_, wei_gate_, wei_down_;
+
+    // the size of the constant cache entry and of the buffer shared by all
+    // threads, and of the intermediate buffers and scratchpad owned by each
+    // thread
+    size_t constant_size_ = 0, shared_size_ = 0;
+    size_t inter_size_ = 0, scratchpad_size_ = 0;
+    size_t per_thread_size_ = 0;
+    graph::constant_tensor_cache_t::key_t constant_key_ = 0;
+
+    status_t init_config(const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs);
+
+    status_t create_block_prims(dim_t rows, block_prims_t &prims);
+
+    status_t init_weights(weights_t &wei, const logical_tensor_t &user_lt,
+            const memory::desc &md);
+
+public:
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override;
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override;
+
+#ifdef DNNL_WITH_SYCL
+    status_t sycl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override {
+        UNUSED(g_stream);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        UNUSED(sycl_deps);
+        UNUSED(sycl_event);
+        return status::unimplemented;
+    }
+#endif
+
+#if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
+    status_t ocl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<cl_event> &cl_deps,
+            cl_event *ret_event) override {
+        UNUSED(g_stream);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        UNUSED(cl_deps);
+        UNUSED(ret_event);
+        return status::unimplemented;
+    }
+#endif
+
+    DEF_KERNEL_METHOD_STR(mlp_decomp_kernel_t)
+};
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
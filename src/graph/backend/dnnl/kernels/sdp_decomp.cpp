@@ -229,7 +229,10 @@ status_t sdp_decomp_kernel_t<quantized, dt>::execute_impl(
     sdp_args_set_t *res = res_cache.get_or_add(
             reinterpret_cast<size_t>(this), resource_ctor_);
 
-    int MBO = sdp_cfg_.batch_size, MBI = sdp_cfg_.num_head_q;
+    // Each task handles a stack of query heads sharing one K/V head.
+    int MBO = sdp_cfg_.batch_size,
+        MBI = sdp_cfg_.num_head_q / sdp_cfg_.stacked_head;
+    const dim_t group_head = sdp_cfg_.num_head_q / sdp_cfg_.num_head_kv;
 
     char *src1_user_pointer = static_cast<char *>(
             inputs[sdp_cfg_.graph_inport[0]].get_data_handle());
@@ -267,6 +270,17 @@ status_t sdp_decomp_kernel_t<quantized, dt>::execute_impl(
         // prepare execution args and allocate real memory
         prepare_sub_args(var_grantor, tid, block_size, res->mem_map);
 
+        // first query head of the stack and the K/V head it shares
+        const dim_t q_head = bi * sdp_cfg_.stacked_head;
+        const dim_t kv_head = q_head / group_head;
+        // offset of the slice read for (bo, q_head) from a post-op source,
+        // which may be broadcast along the batch or the head dimension
+        const auto post_src_offset
+                = [&](const memory::dims &dims, const memory::dims &strides) {
+                      return (dims[0] > 1 ? bo * strides[0] : 0)
+                              + (dims[1] > 1 ? q_head * strides[1] : 0);
+                  };
+
         // reorder0
         auto &sub_src1_tid = res->mem_map[sdp_cfg_.sub_src1.get()][tid];
         // reorder1:
@@ -288,10 +302,10 @@ status_t sdp_decomp_kernel_t<quantized, dt>::execute_impl(
                     = res->mem_map[sdp_cfg_.sub_mm1_post_mem[start_index++]
                                            .get()][tid];
             auto mask_input = inputs[sdp_cfg_.graph_inport[3]];
-            auto mask_strides = ltw(mask_input.get_logical_tensor()).vstrides();
+            const ltw mask_ltw(mask_input.get_logical_tensor());
             sub_mm1_post_add_tid.set_data_handle(
                     static_cast<char *>(mask_input.get_data_handle())
-                    + bo * mask_strides[1]
+                    + post_src_offset(mask_ltw.vdims(), mask_ltw.vstrides())
                             * get_mem_dt_size(sub_mm1_post_add_tid));
         }
         if (sdp_cfg_.has_select) {
@@ -304,10 +318,11 @@ status_t sdp_decomp_kernel_t<quantized, dt>::execute_impl(
                 auto out_mem
                         = select_res_args[sdp_cfg_.select_outop_index[i - 1]]
                                   .at(DNNL_ARG_DST);
-                auto out_strides = out_mem.get_desc().get_strides();
+                const auto &out_md = out_mem.get_desc();
                 sub_mm1_post_tid.set_data_handle(
                         static_cast<char *>(out_mem.get_data_handle())
-                        + bo * out_strides[0]
+                        + post_src_offset(
+                                  out_md.get_dims(), out_md.get_strides())
                                 * get_mem_dt_size(sub_mm1_post_tid));
             }
         }
@@ -321,21 +336,21 @@ status_t sdp_decomp_kernel_t<quantized, dt>::execute_impl(
         // matmul2
         auto &sub_mm2_dst_tid = res->mem_map[sdp_cfg_.sub_mm2_dst.get()][tid];
 
-        const size_t sub_src1_offset = (bo * sdp_cfg_.src1_strides[0]
-                                               + bi * sdp_cfg_.src1_strides[1])
+        const size_t sub_src1_offset
+                = (bo * sdp_cfg_.src1_strides[0]
+                          + q_head * sdp_cfg_.src1_strides[1])
                 * get_mem_dt_size(sub_src1_tid);
-        const size_t group_head = sdp_cfg_.num_head_q / sdp_cfg_.num_head_kv;
-        size_t wei_head_offset = bi / group_head;
         const size_t sub_wei1_offset
                 = (bo * sdp_cfg_.wei1_strides[0]
-                          + wei_head_offset * sdp_cfg_.wei1_strides[1])
+                          + kv_head * sdp_cfg_.wei1_strides[1])
                 * get_mem_dt_size(sub_wei1_user_tid);
         const size_t sub_wei2_offset
                 = (bo * sdp_cfg_.wei2_strides[0]
-                          + wei_head_offset * sdp_cfg_.wei2_strides[1])
+                          + kv_head * sdp_cfg_.wei2_strides[1])
                 * get_mem_dt_size(sub_wei2_user_tid);
         const size_t sub_dst_user_offset
-                = (bo * sdp_cfg_.dst_strides[0] + bi * sdp_cfg_.dst_strides[1])
+                = (bo * sdp_cfg_.dst_strides[0]
+                          + q_head * sdp_cfg_.dst_strides[1])
                 * get_mem_dt_size(sub_dst_user_tid);
 
         sub_wei1_user_tid.set_data_handle(wei1_user_pointer + sub_wei1_offset);
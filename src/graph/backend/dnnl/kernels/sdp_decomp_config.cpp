@@ -73,6 +73,19 @@ impl::status_t sdp_decomp_config_t::construct_params(
     num_head_kv = ltw_wei.vdims()[1];
     seq_len_kv = ltw_wei.vdims()[3];
 
+    // With GQA/MQA several query heads share one K/V head. Stack the whole
+    // group unless it leaves too few tasks to keep all the threads busy.
+    const memory::dim group_head = num_head_q / num_head_kv;
+    stacked_head = group_head;
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP
+    while (stacked_head > 1
+            && batch_size * num_head_q / stacked_head <= RATIO * nthr) {
+        do {
+            stacked_head--;
+        } while (group_head % stacked_head != 0);
+    }
+#endif
+
     // Acquire the data type from input param for later primitive creation.
     // The src and wei dt of both quantized sdp and float sdp are the same.
     memory::data_type dt_src_user = static_cast<memory::data_type>(
@@ -102,10 +115,10 @@ impl::status_t sdp_decomp_config_t::construct_params(
     sub_reorder0_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
 
     // per-head: reorder src1 to dense, for first matmul
-    memory::dims sub_src1_dims = {1, 1, seq_len_q, size_per_head};
+    memory::dims sub_src1_dims = {1, stacked_head, seq_len_q, size_per_head};
     src1_strides = ltw(inputs[graph_inport[0]]).vstrides();
     sub_src1_md = memory::desc(sub_src1_dims, dt_src_user,
-            {1, 1, src1_strides[2], src1_strides[3]});
+            {1, src1_strides[1], src1_strides[2], src1_strides[3]});
     auto sub_src1_d_md = memory::desc(sub_src1_dims, dt_src_user, tag::abcd);
     auto sub_reorder0_pd = reorder::primitive_desc(
             p_engine, sub_src1_md, p_engine, sub_src1_d_md, sub_reorder0_attr);
@@ -132,9 +145,12 @@ impl::status_t sdp_decomp_config_t::construct_params(
     // first matmul
     // create first matmul primitive attr
     dnnl::primitive_attr sub_matmul1_attr = make_primitive_attr(sdp_op[1], mgr);
-    memory::dims sub_mm1_src_dims = {1, 1, seq_len_q, size_per_head};
+    // The stacked query heads are a batch dimension broadcast across the
+    // weights, which matmul merges into M.
+    memory::dims sub_mm1_src_dims
+            = {1, stacked_head, seq_len_q, size_per_head};
     memory::dims sub_mm1_wei_dims = {1, 1, size_per_head, seq_len_kv};
-    memory::dims sub_mm1_dst_dims = {1, 1, seq_len_q, seq_len_kv};
+    memory::dims sub_mm1_dst_dims = {1, stacked_head, seq_len_q, seq_len_kv};
 
     sub_mm1_src_md = memory::desc(sub_mm1_src_dims, dt_src_user, tag::abcd);
     sub_mm1_wei_md = memory::desc(sub_mm1_wei_dims, dt_wei, tag::abdc);
@@ -151,7 +167,9 @@ impl::status_t sdp_decomp_config_t::construct_params(
         auto post_dt = static_cast<memory::data_type>(ori_desc.data_type);
         memory::dims post_stride_dims
                 = memory::dims(post_stride, post_stride + ori_desc.ndims);
-        auto new_sub_md = memory::desc({1, 1, post_shape[2], post_shape[3]},
+        auto new_sub_md = memory::desc(
+                {1, post_shape[1] == 1 ? 1 : stacked_head, post_shape[2],
+                        post_shape[3]},
                 post_dt, post_stride_dims);
         sub_mm1_post_md.emplace_back(new_sub_md);
         dnnl_pops.append_binary(alg, new_sub_md);
@@ -188,9 +206,10 @@ impl::status_t sdp_decomp_config_t::construct_params(
     // second matmul
     // create second matmul primitive attr
     dnnl::primitive_attr sub_matmul2_attr = make_primitive_attr(sdp_op[4], mgr);
-    memory::dims sub_mm2_src_dims = {1, 1, seq_len_q, seq_len_kv};
+    memory::dims sub_mm2_src_dims = {1, stacked_head, seq_len_q, seq_len_kv};
     memory::dims sub_mm2_wei_dims = {1, 1, seq_len_kv, size_per_head};
-    memory::dims sub_mm2_dst_dims = {1, 1, seq_len_q, size_per_head};
+    memory::dims sub_mm2_dst_dims
+            = {1, stacked_head, seq_len_q, size_per_head};
     auto sub_mm2_src_md
             = memory::desc(sub_mm2_src_dims, dt_src_user, tag::abcd);
     sub_mm2_wei_md = memory::desc(sub_mm2_wei_dims, dt_wei, tag::abcd);
@@ -202,12 +221,12 @@ impl::status_t sdp_decomp_config_t::construct_params(
     // per-head: reorder dst2 from dense to strided
     primitive_attr sub_reorder3_attr;
     sub_reorder3_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
-    memory::dims sub_dst_dims = {1, 1, seq_len_q, size_per_head};
+    memory::dims sub_dst_dims = {1, stacked_head, seq_len_q, size_per_head};
     auto out_lt = sdp_op[4]->get_output_value(0)->get_logical_tensor();
     dst_strides = ltw(out_lt).vstrides();
     sub_dst_md = memory::desc(sub_dst_dims, dt_src_user, tag::abcd);
-    sub_dst_user_md = memory::desc(
-            sub_dst_dims, dt_src_user, {1, 1, dst_strides[2], dst_strides[3]});
+    sub_dst_user_md = memory::desc(sub_dst_dims, dt_src_user,
+            {1, dst_strides[1], dst_strides[2], dst_strides[3]});
     auto sub_reorder3_pd = reorder::primitive_desc(
             p_engine, sub_dst_md, p_engine, sub_dst_user_md, sub_reorder3_attr);
     sub_reorder3.init(sub_reorder3_pd);
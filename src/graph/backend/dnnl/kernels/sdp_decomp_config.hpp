@@ -76,6 +76,11 @@ public:
     // SDP input dimension
     memory::dim batch_size, num_head_q, num_head_kv, seq_len_q, size_per_head;
 
+    // Number of query heads processed together by one thread. These heads
+    // share the same K/V head and are stacked into the M dimension of both
+    // matmuls, so K/V are loaded and reordered once per stack.
+    memory::dim stacked_head = 1;
+
     // SDP input and output strides
     memory::dims src1_strides, wei1_strides, wei2_strides, dst_strides,
             post_add_strides;
@@ -23,8 +23,12 @@
 
 #include "oneapi/dnnl/dnnl.hpp"
 
+#include "common/verbose.hpp"
+
 #include <graph/utils/utils.hpp>
 
+#include "graph/interface/partition_impl.hpp"
+
 #include "graph/backend/dnnl/common.hpp"
 #include "graph/backend/dnnl/dnnl_constant_tensor_cache.hpp"
 #include "graph/backend/dnnl/fusion_info.hpp"
@@ -39,6 +43,47 @@ namespace dnnl_impl {
 const indices_t::type_t input = indices_t::type_t::input;
 const indices_t::type_t output = indices_t::type_t::output;
 
+profiled_executable_t::profiled_executable_t(
+        const std::shared_ptr<op_executable_t> &exec, const std::string &name,
+        const std::vector<dnnl::primitive> &prims)
+    : exec_(exec), name_(name) {
+    for (const auto &prim : prims) {
+        const char *info = nullptr;
+        if (dnnl_primitive_desc_query(prim.get_primitive_desc(),
+                    dnnl_query_impl_info_str, 0, &info)
+                        != dnnl_success
+                || !info)
+            continue;
+        if (!impl_info_.empty()) impl_info_ += "+";
+        impl_info_ += info;
+    }
+}
+
+void profiled_executable_t::execute(const stream &stream,
+        const std::unordered_map<int, memory> &args) const {
+    std::vector<profiling_record_t> *records
+            = get_execution_profiling_records();
+    if (!records) {
+        exec_->execute(stream, args);
+        return;
+    }
+
+    size_t bytes = 0;
+    for (const auto &arg : args) {
+        if (arg.first == DNNL_ARG_SCRATCHPAD) continue;
+        bytes += arg.second.get_desc().get_size();
+    }
+
+    // the stream handle is shared, waiting on the copy waits on the stream
+    dnnl::stream strm = stream;
+    strm.wait();
+    const double start_ms = get_msec();
+    exec_->execute(stream, args);
+    strm.wait();
+    records->push_back(
+            {name_, impl_info_, start_ms, get_msec() - start_ms, bytes});
+}
+
 conv_fwd_executable_t::desc_t conv_fwd_executable_t::create_desc(
         std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
         fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
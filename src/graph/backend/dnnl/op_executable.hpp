@@ -105,6 +105,39 @@ struct op_executable_t {
 #endif
 };
 
+// Wraps an executable to record its wall time, the size of its arguments and
+// the implementation of its primitives when the execution in the current
+// thread is profiled. The executions on GPU are not profiled.
+struct profiled_executable_t : public op_executable_t {
+    profiled_executable_t(const std::shared_ptr<op_executable_t> &exec,
+            const std::string &name,
+            const std::vector<dnnl::primitive> &prims);
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override;
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        return exec_->execute_sycl(stream, args, deps);
+    }
+#endif
+
+#if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
+    cl_event execute_ocl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<cl_event> &deps = {}) const override {
+        return exec_->execute_ocl(stream, args, deps);
+    }
+#endif
+
+private:
+    std::shared_ptr<op_executable_t> exec_;
+    std::string name_;
+    std::string impl_info_;
+};
+
 using executable_creator_func = std::function<std::shared_ptr<op_executable_t>(
         std::shared_ptr<op_t> &, const dnnl::engine &, fusion_info_mgr_t &,
         pd_cache_t &)>;
@@ -392,7 +425,7 @@ struct conv_fwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::convolution_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::convolution_forward>(desc);
         if (op->has_attr(op_attr::with_sum))
             with_sum_ = op->get_attr<bool>(op_attr::with_sum);
     }
@@ -570,7 +603,7 @@ struct deconv_fwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::deconvolution_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::deconvolution_forward>(desc);
         if (op->has_attr(op_attr::with_sum))
             with_sum_ = op->get_attr<bool>(op_attr::with_sum);
     }
@@ -649,7 +682,7 @@ struct deconv_bwd_data_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::deconvolution_backward_data(desc);
+        prim_ = make_dnnl_primitive<dnnl::deconvolution_backward_data>(desc);
     }
 
     void execute(const stream &stream,
@@ -689,7 +722,7 @@ struct deconv_bwd_weights_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::deconvolution_backward_weights(desc);
+        prim_ = make_dnnl_primitive<dnnl::deconvolution_backward_weights>(desc);
     }
 
     void execute(const stream &stream,
@@ -737,7 +770,7 @@ struct matmul_executable_t : public op_executable_t {
         }
 
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::matmul(desc);
+        prim_ = make_dnnl_primitive<dnnl::matmul>(desc);
 
         // The scratchpad size of pd created by using any format tag may be
         // different from the scratchpad size of pd created by using queried
@@ -861,7 +894,7 @@ struct eltwise_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::eltwise_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::eltwise_forward>(desc);
     }
 
     void execute(const stream &stream,
@@ -900,7 +933,7 @@ struct eltwise_bwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::eltwise_backward(desc);
+        prim_ = make_dnnl_primitive<dnnl::eltwise_backward>(desc);
     }
 
     void execute(const stream &stream,
@@ -948,7 +981,7 @@ struct binary_executable_t : public op_executable_t {
         }
 
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::binary(desc);
+        prim_ = make_dnnl_primitive<dnnl::binary>(desc);
 
         if (op->has_attr(op_attr::with_sum))
             with_sum_ = op->get_attr<bool>(op_attr::with_sum);
@@ -1060,7 +1093,7 @@ struct concat_executable_t : public op_executable_t {
     concat_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
             fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::concat(desc);
+        prim_ = make_dnnl_primitive<dnnl::concat>(desc);
     }
 
     void execute(const stream &stream,
@@ -1099,7 +1132,7 @@ struct shuffle_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::shuffle_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::shuffle_forward>(desc);
     }
 
     void execute(const stream &stream,
@@ -1137,7 +1170,7 @@ struct pool_executable_t : public op_executable_t {
     pool_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
             fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::pooling_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::pooling_forward>(desc);
     }
 
     void execute(const stream &stream,
@@ -1176,7 +1209,7 @@ struct pool_bwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::pooling_backward(desc);
+        prim_ = make_dnnl_primitive<dnnl::pooling_backward>(desc);
     }
 
     void execute(const stream &stream,
@@ -1214,7 +1247,7 @@ struct prelu_executable_t : public op_executable_t {
     prelu_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
             fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::prelu_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::prelu_forward>(desc);
     }
 
     void execute(const stream &stream,
@@ -1253,7 +1286,7 @@ struct prelu_bwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::prelu_backward(desc);
+        prim_ = make_dnnl_primitive<dnnl::prelu_backward>(desc);
     }
 
     void execute(const stream &stream,
@@ -1292,7 +1325,7 @@ struct reorder_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::reorder(desc);
+        prim_ = make_dnnl_primitive<dnnl::reorder>(desc);
         if (op->has_attr(op_attr::with_sum))
             with_sum_ = op->get_attr<bool>(op_attr::with_sum);
     }
@@ -1416,9 +1449,9 @@ struct bn_folding_t : public op_executable_t {
     bn_folding_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
             fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
         desc_ = create_desc(op, p_engine, mgr, pd_cache);
-        add_prim_ = dnnl::binary(desc_.add_pd_);
-        mul_prim_ = dnnl::binary(desc_.mul_pd_);
-        sub_prim_ = dnnl::binary(desc_.sub_pd_);
+        add_prim_ = make_dnnl_primitive<dnnl::binary>(desc_.add_pd_);
+        mul_prim_ = make_dnnl_primitive<dnnl::binary>(desc_.mul_pd_);
+        sub_prim_ = make_dnnl_primitive<dnnl::binary>(desc_.sub_pd_);
     }
 
     void execute(const stream &stream,
@@ -1729,7 +1762,7 @@ struct conv_bwd_data_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::convolution_backward_data(desc);
+        prim_ = make_dnnl_primitive<dnnl::convolution_backward_data>(desc);
     }
 
     void execute(const stream &stream,
@@ -1769,7 +1802,7 @@ struct conv_bwd_weights_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::convolution_backward_weights(desc);
+        prim_ = make_dnnl_primitive<dnnl::convolution_backward_weights>(desc);
     }
 
     void execute(const stream &stream,
@@ -1814,7 +1847,7 @@ struct batchnorm_executable_t : public op_executable_t {
             momentum = op->get_attr<float>(op_attr::momentum);
         scales_ = {momentum, 1 - momentum};
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::batch_normalization_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::batch_normalization_forward>(desc);
     }
 
     void execute(const stream &stream,
@@ -1986,7 +2019,7 @@ struct batchnorm_bwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::batch_normalization_backward(desc);
+        prim_ = make_dnnl_primitive<dnnl::batch_normalization_backward>(desc);
     }
 
     void execute(const stream &stream,
@@ -2025,7 +2058,7 @@ struct resampling_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::resampling_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::resampling_forward>(desc);
         if (op->has_attr(op_attr::with_sum))
             with_sum_ = op->get_attr<bool>(op_attr::with_sum);
     }
@@ -2109,7 +2142,7 @@ struct resampling_bwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::resampling_backward(desc);
+        prim_ = make_dnnl_primitive<dnnl::resampling_backward>(desc);
     }
 
     void execute(const stream &stream,
@@ -2149,7 +2182,7 @@ struct layernorm_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::layer_normalization_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::layer_normalization_forward>(desc);
     }
 
     void execute(const stream &stream,
@@ -2189,7 +2222,7 @@ struct layernorm_bwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::layer_normalization_backward(desc);
+        prim_ = make_dnnl_primitive<dnnl::layer_normalization_backward>(desc);
     }
 
     void execute(const stream &stream,
@@ -2227,7 +2260,7 @@ struct sum_executable_t : public op_executable_t {
     sum_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
             fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::sum(desc);
+        prim_ = make_dnnl_primitive<dnnl::sum>(desc);
     }
 
     void execute(const stream &stream,
@@ -2266,7 +2299,7 @@ struct softmax_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::softmax_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::softmax_forward>(desc);
     }
 
     void execute(const stream &stream,
@@ -2305,7 +2338,7 @@ struct softmax_bwd_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::softmax_backward(desc);
+        prim_ = make_dnnl_primitive<dnnl::softmax_backward>(desc);
     }
 
     void execute(const stream &stream,
@@ -2344,7 +2377,7 @@ struct reduction_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::reduction(desc);
+        prim_ = make_dnnl_primitive<dnnl::reduction>(desc);
 
         if (op->has_attr(op_attr::with_sum))
             with_sum_ = op->get_attr<bool>(op_attr::with_sum);
@@ -2426,7 +2459,7 @@ struct groupnorm_executable_t : public op_executable_t {
             const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
             pd_cache_t &pd_cache) {
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
-        prim_ = dnnl::group_normalization_forward(desc);
+        prim_ = make_dnnl_primitive<dnnl::group_normalization_forward>(desc);
     }
 
     void execute(const stream &stream,
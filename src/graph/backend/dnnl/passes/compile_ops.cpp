@@ -15,6 +15,7 @@
  *******************************************************************************/
 
 #include <memory>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -58,15 +59,26 @@ status_t compile_ops(std::shared_ptr<subgraph_t> &sg) {
         auto cur_op = op->shared_from_this();
         auto creator = opm->get_additional_item<executable_creator_func>(
                 "executable_creator");
+
+        // collect the primitives of the executable for profiling
+        std::vector<dnnl::primitive> prims;
+        set_primitive_recorder(&prims);
         std::shared_ptr<op_executable_t> exec
                 = creator(cur_op, p_engine, mgr, pd_cache);
+        set_primitive_recorder(nullptr);
 
         if (!exec) {
             assertm(false, "unimplemented op, can't compile it");
             return status::unimplemented;
         }
 
-        sg->execs_.emplace_back(exec);
+        // name the op as in the subgraph dump, with its ID or address when ID
+        // is not available
+        const size_t op_id = op->get_id() != op_t::DEFAULT_ID
+                ? op->get_id()
+                : reinterpret_cast<size_t>(op);
+        sg->execs_.emplace_back(std::make_shared<profiled_executable_t>(exec,
+                kind2str(op->get_kind()) + "_" + std::to_string(op_id), prims));
         sg->is_constant_.push_back(op->has_attr(op_attr::is_constant)
                 && op->get_attr<bool>(op_attr::is_constant));
         return status::success;
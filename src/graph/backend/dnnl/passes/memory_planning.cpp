@@ -15,12 +15,15 @@
  *******************************************************************************/
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <set>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 
+#include "common/verbose.hpp"
+
 #include "graph/interface/c_types_map.hpp"
 #include "graph/interface/value.hpp"
 
@@ -484,16 +487,31 @@ status_t memory_planner_t::assign_internal_persistent_buffer(
 // - Inplace:  if the op support inplace computation, the output results can be
 //   written into input buffer
 // - Standard Memory Sharing: if a edge's all consumers have been computed, then
-//   the buffer of this edge can be reused by other edge.
+//   the memory of this edge can be reused by other edge. This is done when
+//   placing the buffers in the arena according to the live ranges recorded
+//   here, see plan_internal_temporary_buffer.
 // TODO(qun) Consider more situations (for example, a tensor can also be reused
 // even if its consumer is not computed, as long as it consumer only need the
 // tensor's metadata instead of content)
 status_t memory_planner_t::assign_internal_temporary_buffer(
         std::shared_ptr<subgraph_t> &sg,
         const std::unordered_map<value_t *, size_t> &edge_ref_count,
-        fusion_info_mgr_t &mgr, bool enable_standard_sharing) {
+        fusion_info_mgr_t &mgr) {
     std::unordered_map<size_t, size_t> temporary_buffer_ref_count;
 
+    size_t time_point = 0;
+    const auto record = [&](const assign_info_t &info) {
+        if (info.kind_ != internal_temporary
+                || info.index_ == static_cast<size_t>(-1))
+            return;
+        auto pos = temporary_live_ranges_.find(info.index_);
+        if (pos == temporary_live_ranges_.end())
+            temporary_live_ranges_.insert(
+                    {info.index_, {time_point, time_point}});
+        else
+            pos->second.end_ = std::max(pos->second.end_, time_point);
+    };
+
     auto func = [&](op_t *op) {
         // Handle alias first
         auto inputs = op->get_input_values();
@@ -548,12 +566,8 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
             assign_info_t info = buffer_assignments_.at(in.get());
             if (info.kind_ != internal_temporary) continue;
 
+            record(info);
             --temporary_buffer_ref_count[info.index_];
-            // if we decrease it to zero, we are ready to release
-            if (enable_standard_sharing
-                    && temporary_buffer_ref_count[info.index_] == 0) {
-                temporary_buffer_assigner_.release(info.index_);
-            }
         }
 
         // Free outputs that have no consumer (such as scratchpad)
@@ -561,21 +575,107 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
             assign_info_t info = buffer_assignments_.at(out.get());
             if (info.kind_ != internal_temporary) continue;
 
+            record(info);
             auto consumers = out->get_consumers();
             if (consumers.empty()) {
                 --temporary_buffer_ref_count[info.index_];
-                if (enable_standard_sharing) {
-                    temporary_buffer_assigner_.release(info.index_);
-                }
             }
         }
 
+        time_point++;
         return status::success;
     };
 
     return topo_order_visit(sg->get_output_ops(), func);
 }
 
+// Place the internal temporary buffers in the arena with best-fit decreasing:
+// the buffers are visited from the largest to the smallest, and each of them
+// is put into the smallest gap between the already placed buffers whose live
+// ranges overlap with its own. If there is no such gap, the buffer is put
+// right after the last of them.
+status_t memory_planner_t::plan_internal_temporary_buffer() {
+    const size_t alignment = 64;
+    const auto aligned_size = [&](size_t idx) {
+        const size_t size = temporary_buffer_assigner_.query_size(idx);
+        return (size + alignment - 1) / alignment * alignment;
+    };
+
+    std::vector<size_t> order;
+    order.reserve(temporary_live_ranges_.size());
+    for (const auto &range : temporary_live_ranges_)
+        order.emplace_back(range.first);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const size_t size_a = aligned_size(a), size_b = aligned_size(b);
+        return size_a != size_b ? size_a > size_b : a < b;
+    });
+
+    using block_t = std::pair<size_t, size_t>; // [begin, end) in the arena
+    size_t planned_size = 0;
+    std::vector<block_t> blocks;
+    for (size_t i = 0; i < order.size(); i++) {
+        const size_t size = aligned_size(order[i]);
+        const time_bound_t &range = temporary_live_ranges_.at(order[i]);
+
+        blocks.clear();
+        for (size_t j = 0; j < i; j++) {
+            const time_bound_t &other = temporary_live_ranges_.at(order[j]);
+            if (range.end_ < other.start_ || other.end_ < range.start_)
+                continue;
+            const size_t offset = temporary_offsets_.at(order[j]);
+            blocks.emplace_back(offset, offset + aligned_size(order[j]));
+        }
+        std::sort(blocks.begin(), blocks.end());
+
+        size_t best_offset = std::numeric_limits<size_t>::max();
+        size_t best_gap = std::numeric_limits<size_t>::max();
+        size_t end = 0;
+        for (const auto &block : blocks) {
+            if (block.first > end) {
+                const size_t gap = block.first - end;
+                if (gap >= size && gap < best_gap) {
+                    best_offset = end;
+                    best_gap = gap;
+                }
+            }
+            end = std::max(end, block.second);
+        }
+        if (best_gap == std::numeric_limits<size_t>::max()) best_offset = end;
+
+        temporary_offsets_[order[i]] = best_offset;
+        planned_size = std::max(planned_size, best_offset + size);
+    }
+
+    if (get_verbose(verbose_t::create_profile, component_t::graph)) {
+        // The lower bound is the peak of the total size of the live buffers
+        std::vector<std::pair<size_t, bool>> events; // time point, is end
+        std::unordered_map<size_t, size_t> start_size, end_size;
+        for (const auto &range : temporary_live_ranges_) {
+            start_size[range.second.start_] += aligned_size(range.first);
+            end_size[range.second.end_] += aligned_size(range.first);
+        }
+        for (const auto &e : start_size)
+            events.emplace_back(e.first, false);
+        for (const auto &e : end_size)
+            events.emplace_back(e.first, true);
+        std::sort(events.begin(), events.end());
+
+        size_t live_size = 0, lower_bound = 0;
+        for (const auto &e : events) {
+            if (e.second) {
+                live_size -= end_size.at(e.first);
+            } else {
+                live_size += start_size.at(e.first);
+                lower_bound = std::max(lower_bound, live_size);
+            }
+        }
+        verbose_printf("graph,info,memory_planning,temporary,buffers:%zu,"
+                       "planned:%zu,lower_bound:%zu\n",
+                temporary_live_ranges_.size(), planned_size, lower_bound);
+    }
+    return status::success;
+}
+
 status_t memory_planner_t::prepare_subgraph_inplace_pairs(
         std::shared_ptr<subgraph_t> &sg, bool enable_standard_sharing) {
     size_t time_point = 0;
@@ -709,10 +809,13 @@ status_t memory_planner_t::book_buffers(std::shared_ptr<subgraph_t> &sg) {
             case external_input:
             case external_output: break;
             // book buffers for internal temporary and persistent
-            case internal_temporary:
-                temporary_registrar.book(info.index_,
+            case internal_temporary: {
+                auto pos = temporary_offsets_.find(info.index_);
+                temporary_registrar.book_at(info.index_,
+                        pos == temporary_offsets_.end() ? 0 : pos->second,
                         temporary_buffer_assigner_.query_size(info.index_));
                 break;
+            }
             case internal_persistent:
                 persistent_registrar.book(info.index_,
                         persistent_buffer_assigner_.query_size(info.index_));
@@ -871,7 +974,7 @@ status_t memory_planner_t::run(std::shared_ptr<subgraph_t> &sg) {
     if (ret != status::success) return ret;
 
     // Assign internal temporary buffer for all other edges
-    ret = assign_internal_temporary_buffer(sg, edge_ref_count, mgr, false);
+    ret = assign_internal_temporary_buffer(sg, edge_ref_count, mgr);
     if (ret != status::success) return ret;
 
     // Replace some internal temporary buffers to user given external output
@@ -885,6 +988,7 @@ status_t memory_planner_t::run(std::shared_ptr<subgraph_t> &sg) {
 
     // Reset the unreplaced internal temporary buffer
     temporary_buffer_assigner_.clear();
+    temporary_live_ranges_.clear();
     for (auto it = buffer_assignments_.begin();
             it != buffer_assignments_.end();) {
         if (it->second.kind_ == internal_temporary) {
@@ -894,9 +998,17 @@ status_t memory_planner_t::run(std::shared_ptr<subgraph_t> &sg) {
         }
     }
 
-    // Re-assign internal temporary buffer for reset ones (will re-do memory
-    // sharing between temporary buffers)
-    ret = assign_internal_temporary_buffer(sg, edge_ref_count, mgr, true);
+    // Re-assign internal temporary buffer for reset ones
+    ret = assign_internal_temporary_buffer(sg, edge_ref_count, mgr);
+    if (ret != status::success) return ret;
+
+    // Place the temporary buffers in the arena. Buffers with disjoint live
+    // ranges may share memory, unless memory sharing is disabled.
+    if (!enable_memory_sharing) {
+        for (auto &range : temporary_live_ranges_)
+            range.second = {0, std::numeric_limits<size_t>::max()};
+    }
+    ret = plan_internal_temporary_buffer();
     if (ret != status::success) return ret;
 
     // Check which input/output pair of the subgraph can be inplaced
@@ -288,10 +288,18 @@ private:
 // The supported memory sharing policy:
 // - Inplace sharing. Use same buffer for input and output values of ops that
 //   support inplace computation.
-// - Standard sharing. Use same buffer for values that have disjoint live range.
+// - Standard sharing. Use same memory for values that have disjoint live range.
 //   Take this subgraph 't1 -> op1 -> t2 -> op2 -> t3 -> op3 -> t4-> op4 -> t5'
 //   as an example: when writing data to t4, t2 is not used any more, so they
-//   have disjoint live range and we can make them share same buffer.
+//   have disjoint live range and we can make them share same memory.
+//
+// Internal temporary buffers are placed in a single arena. The placement is
+// planned offline from the live ranges of all the buffers: buffers are placed
+// from the largest to the smallest, each one into the smallest gap left by the
+// already placed buffers whose live range overlaps with its own (best-fit
+// decreasing). The arena can't be smaller than the peak of the total size of
+// the buffers that are live at the same time. Both sizes are reported with
+// ONEDNN_VERBOSE=profile_create.
 //
 // The following internal env vars can be used to control the memory planning:
 // - _ONEDNN_GRAPH_ENABLE_MEM_REUSE
@@ -396,6 +404,8 @@ private:
         temporary_registry_.clear();
         external_inputs_live_range_.clear();
         inplace_pairs_.clear();
+        temporary_live_ranges_.clear();
+        temporary_offsets_.clear();
     }
 
     status_t assign_external_inputs_buffer(std::shared_ptr<subgraph_t> &sg,
@@ -410,7 +420,9 @@ private:
 
     status_t assign_internal_temporary_buffer(std::shared_ptr<subgraph_t> &sg,
             const std::unordered_map<value_t *, size_t> &edge_ref_count,
-            fusion_info_mgr_t &mgr, bool enable_standard_sharing);
+            fusion_info_mgr_t &mgr);
+
+    status_t plan_internal_temporary_buffer();
 
     status_t prepare_subgraph_inplace_pairs(
             std::shared_ptr<subgraph_t> &sg, bool enable_standard_sharing);
@@ -433,6 +445,11 @@ private:
     std::unordered_map<const assign_info_t *, time_bound_t>
             external_inputs_live_range_;
     std::vector<inplace_pair_t> inplace_pairs_;
+
+    // The live range of each internal temporary buffer, in planning steps
+    std::unordered_map<size_t, time_bound_t> temporary_live_ranges_;
+    // The offset of each internal temporary buffer in the arena
+    std::unordered_map<size_t, size_t> temporary_offsets_;
 };
 
 } // namespace dnnl_impl
@@ -1803,6 +1803,131 @@ status_t fuse_mul_sigmoid_to_swish(std::shared_ptr<subgraph_t> &sg) {
     return status::success;
 }
 
+status_t dynamically_quantize_matmul(std::shared_ptr<subgraph_t> &sg) {
+    if (sg->get_engine_kind() != graph::engine_kind::cpu)
+        return status::success;
+
+    std::vector<op_t *> matmuls;
+    for (const auto &cur_op : sg->get_ops()) {
+        if (cur_op->get_kind() != op_kind::dnnl_matmul) continue;
+        const auto &src_lt = cur_op->get_input_value(0)->get_logical_tensor();
+        const auto &wei_lt = cur_op->get_input_value(1)->get_logical_tensor();
+        if (src_lt.data_type != wei_lt.data_type
+                || !impl::utils::one_of(src_lt.data_type, graph::data_type::f32,
+                        graph::data_type::bf16))
+            continue;
+        if (src_lt.ndims < 2 || wei_lt.ndims != 2) continue;
+        // the weight scales and the quantized weight are expected to be
+        // computed once by constant propagation and cached.
+        if (wei_lt.property != property_type::constant) continue;
+        matmuls.emplace_back(cur_op.get());
+    }
+
+    if (matmuls.empty()) return status::success;
+
+    auto &mgr = sg->fusion_info_mgr_;
+    subgraph_rewriter_t rewriter(sg);
+
+    auto new_output = [&rewriter](op_ptr op, data_type_t dtype) {
+        logical_tensor_t lt = empty_logical_tensor_with_default_id();
+        auto val = std::make_shared<value_t>(*op, 0, lt, true);
+        val->set_data_type(dtype);
+        op->add_output(val);
+        insert_empty_scratchpad(op);
+        rewriter.to_insert(op);
+        return val;
+    };
+
+    for (auto &matmul : matmuls) {
+        int64_t key = -1;
+        if (matmul->has_attr(op_attr::fusion_info_key)
+                && matmul->get_attr<int64_t>(op_attr::fusion_info_key) != -1) {
+            key = matmul->get_attr<int64_t>(op_attr::fusion_info_key);
+        } else {
+            key = mgr.init_info();
+            matmul->set_attr<int64_t>(op_attr::fusion_info_key, key);
+        }
+        fusion_info_t &fusion_info = mgr.get_mutable_info(key);
+
+        // src scales must be connected before wei scales
+        for (size_t offset = 0; offset < 2; ++offset) {
+            auto in_val = matmul->get_input_value(offset);
+            const auto &in_lt = in_val->get_logical_tensor();
+            const int64_t ndims = in_lt.ndims;
+
+            // the weight is quantized along the output channel, which is the
+            // last dimension unless the weight is transposed.
+            std::string qtype = "per_tensor";
+            int64_t axis = 0;
+            if (offset == 1) {
+                const bool trans = matmul->has_attr(op_attr::transpose_b)
+                        && matmul->get_attr<bool>(op_attr::transpose_b);
+                qtype = "per_channel";
+                axis = trans ? ndims - 2 : ndims - 1;
+            }
+            std::vector<int64_t> axes;
+            for (int64_t i = 0; i < ndims; ++i) {
+                if (qtype == "per_tensor" || i != axis) axes.push_back(i);
+            }
+
+            // scale = max(|x|) / 127
+            auto abs_op = std::make_shared<op_t>(op_kind::dnnl_eltwise);
+            abs_op->set_attr<int64_t>(op_attr::alg_kind,
+                    static_cast<int64_t>(dnnl::algorithm::eltwise_abs));
+            abs_op->connect_input(0, in_val);
+            auto abs_val = new_output(abs_op, in_lt.data_type);
+
+            auto max_op = std::make_shared<op_t>(op_kind::dnnl_reduction);
+            max_op->set_attr<int64_t>(op_attr::alg_kind,
+                    static_cast<int64_t>(dnnl::algorithm::reduction_max));
+            max_op->set_attr<std::vector<int64_t>>(op_attr::axes, axes);
+            max_op->set_attr<bool>(op_attr::keep_dims, true);
+            max_op->connect_input(0, abs_val);
+            auto max_val = new_output(max_op, graph::data_type::f32);
+
+            // a tiny beta keeps the scale non-zero for all-zero inputs
+            auto div_op = std::make_shared<op_t>(op_kind::dnnl_eltwise);
+            div_op->set_attr<int64_t>(op_attr::alg_kind,
+                    static_cast<int64_t>(dnnl::algorithm::eltwise_linear));
+            div_op->set_attr<float>(op_attr::alpha, 1.f / 127.f);
+            div_op->set_attr<float>(op_attr::beta, 1e-30f);
+            div_op->connect_input(0, max_val);
+            auto scale_val = new_output(div_op, graph::data_type::f32);
+
+            // int8 = x * (1 / scale)
+            auto inv_op = std::make_shared<op_t>(op_kind::dnnl_eltwise);
+            inv_op->set_attr<int64_t>(op_attr::alg_kind,
+                    static_cast<int64_t>(dnnl::algorithm::eltwise_pow));
+            inv_op->set_attr<float>(op_attr::alpha, 1.f);
+            inv_op->set_attr<float>(op_attr::beta, -1.f);
+            inv_op->connect_input(0, scale_val);
+            auto inv_val = new_output(inv_op, graph::data_type::f32);
+
+            auto quant_op = std::make_shared<op_t>(op_kind::dnnl_reorder);
+            quant_op->set_attr<bool>(op_attr::change_layout, false);
+            quant_op->set_attr<int64_t>(op_attr::axis, axis);
+            quant_op->set_attr<std::string>(op_attr::qtype, qtype);
+            quant_op->set_attr<bool>(op_attr::with_runtime_scales, true);
+            rewriter.insert_op_before(quant_op, matmul->shared_from_this(),
+                    offset, 0, 0);
+            quant_op->connect_input(1, inv_val);
+            quant_op->get_output_value(0)->set_data_type(graph::data_type::s8);
+            insert_empty_scratchpad(quant_op);
+
+            // dequantize the matmul result with the runtime scales
+            auto scales_op = std::make_shared<op_t>(op_kind::dnnl_mul_scales);
+            scales_op->set_attr<int64_t>(op_attr::axis, axis);
+            scales_op->set_attr<std::string>(op_attr::qtype, qtype);
+            scales_op->set_attr<bool>(op_attr::with_runtime_scales, true);
+            fusion_info.set_runtime_scales(scales_op, true, offset);
+            matmul->connect_input(matmul->num_inputs(), scale_val);
+        }
+    }
+
+    rewriter.run();
+    return infer_shape(sg);
+}
+
 status_t fuse_typecast_to_matmul_or_conv(std::shared_ptr<subgraph_t> &sg) {
     std::vector<std::vector<op_t *>> fusion_groups;
     for (const auto &cur_op : sg->get_ops()) {
@@ -66,6 +66,17 @@ status_t pool_bwd_canonicalization(std::shared_ptr<subgraph_t> &sg);
 
 status_t fuse_mul_sigmoid_to_swish(std::shared_ptr<subgraph_t> &sg);
 
+/// rewrite f32/bf16 matmul with constant weight to run in int8. The scales are
+/// computed at runtime from the absolute maximum of the activation (per-tensor)
+/// and the weight (per output channel), so no calibration data is needed.
+///
+///    (f32) \     / (f32, constant)              reorder   reorder
+///           \   /                      -->   (s8) \     / (s8)
+///           matmul                                matmul (with runtime
+///              |                                    |     src/wei scales)
+///
+status_t dynamically_quantize_matmul(std::shared_ptr<subgraph_t> &sg);
+
 /// translate mixed int8/bf16 matmul/convolution subgraph to x8x8bf16 subgraph
 ///
 ///     | (u8/s8)  | (u8/s8)               | (u8/s8)  | (u8/s8)
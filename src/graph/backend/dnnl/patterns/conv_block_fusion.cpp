@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include "graph/backend/dnnl/kernels/conv_chain.hpp"
 #include "graph/backend/dnnl/kernels/large_partition.hpp"
 #include "graph/backend/dnnl/patterns/fusions.hpp"
 #include "graph/backend/dnnl/patterns/pattern_matcher_pass.hpp"
@@ -348,6 +349,30 @@ pm::pb_op_t *identical_bottleneck_resblock(
     return dst2;
 };
 
+// Convolutions of a chain are f32 or bf16, keep the spatial size of plain
+// activations, and work on images large enough to be split into bands of rows.
+bool check_conv_chain(op_t *op) {
+    if (!check_input_dtype<graph::data_type::f32>(op)
+            && !check_input_dtype<graph::data_type::bf16>(op))
+        return false;
+
+    const auto attr_is = [&](op_attr_t attr, const std::vector<int64_t> &v) {
+        return !op->has_attr(attr)
+                || op->get_attr<std::vector<int64_t>>(attr) == v;
+    };
+    if (!check_grouped<false>(op) || !attr_is(op_attr::strides, {1, 1})
+            || !attr_is(op_attr::dilations, {1, 1})
+            || (op->has_attr(op_attr::data_format)
+                    && op->get_attr<std::string>(op_attr::data_format)
+                            != "NXC"))
+        return false;
+
+    const auto src = op->get_input_value(0)->get_logical_tensor();
+    if (src.ndims != 4) return false;
+    const dim_t IH = src.dims[1], IW = src.dims[2];
+    return IH > 0 && IW > 0 && IH * IW >= 4096;
+}
+
 } // namespace
 
 /*!
@@ -706,6 +731,47 @@ DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(
             return std::make_shared<larger_partition_kernel_t>();
         });
 
+/*
+Chain of convolutions on large images:
+                [src]
+                  |
+           Convolution (+ReLU)
+                  |
+           Convolution (+ReLU)  x [1, 3]
+                  |
+                [dst]
+The chains are matched after the quantized convolution patterns, and before
+the floating-point convolution post-op patterns which would split them.
+*/
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, float_conv_chain_fusion)
+        .set_priority(10.2f)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::conv_chain)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    auto layer = std::make_shared<pb_graph_t>();
+                    pm::pb_op_t *conv
+                            = layer->append_op(graph::op_kind::Convolution);
+                    conv->append_decision_function(check_conv_chain);
+                    auto popt_graph = std::make_shared<pb_graph_t>();
+                    pm::pb_op_t *relu
+                            = popt_graph->append_op(graph::op_kind::ReLU);
+                    popt_graph->create_input_port(0, relu, 0);
+                    popt_graph->create_output_port(0, relu, 0);
+                    auto popt = layer->append_optional(
+                            popt_graph, in_edges_t {in_edge(0, conv, 0)});
+                    layer->create_input_port(0, conv, 0);
+                    layer->create_output_port(0, popt, 0);
+
+                    pgraph->append_repetition(
+                            layer, {0, 0}, 2, MAX_REPETITION);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<conv_chain_base_t>();
+        });
+#endif
+
 DNNL_BACKEND_REGISTER_PATTERN_DEF_END
 
 } // namespace pattern
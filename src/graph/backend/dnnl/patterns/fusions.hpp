@@ -31,6 +31,7 @@ DNNL_BACKEND_REGISTER_PATTERN_DECLARE(conv_block_fusion)
 DNNL_BACKEND_REGISTER_PATTERN_DECLARE(conv_post_ops)
 DNNL_BACKEND_REGISTER_PATTERN_DECLARE(matmul_post_ops)
 DNNL_BACKEND_REGISTER_PATTERN_DECLARE(sdp)
+DNNL_BACKEND_REGISTER_PATTERN_DECLARE(mlp)
 DNNL_BACKEND_REGISTER_PATTERN_DECLARE(binary_fusion)
 DNNL_BACKEND_REGISTER_PATTERN_DECLARE(bn_fusion)
 DNNL_BACKEND_REGISTER_PATTERN_DECLARE(convtranspose_fusion)
@@ -0,0 +1,164 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "graph/backend/dnnl/kernels/mlp.hpp"
+
+#include "graph/backend/dnnl/patterns/fusions.hpp"
+#include "graph/backend/dnnl/patterns/pattern_matcher_pass.hpp"
+#include "graph/backend/dnnl/patterns/utils.hpp"
+
+#include "graph/utils/pm/pbuilder.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+namespace pattern {
+
+namespace pm = graph::utils::pm;
+using in_edges_t = pm::in_edges_t;
+using pb_graph_t = pm::pb_graph_t;
+using FCreatePattern = graph::pass::FCreatePattern;
+
+namespace {
+
+// The MLP kernel computes floating-point matmuls, with the same f32 or bf16
+// data type for all the inputs.
+bool check_float_matmul(op_t *op) {
+    return check_input_dtype<graph::data_type::f32>(op)
+            || check_input_dtype<graph::data_type::bf16>(op);
+}
+
+pm::pb_op_t *append_float_matmul(const std::shared_ptr<pb_graph_t> &pgraph,
+        const in_edges_t &edges = {}) {
+    auto matmul = pgraph->append_op(graph::op_kind::MatMul, edges);
+    matmul->append_decision_function(check_float_matmul);
+    return matmul;
+}
+
+// Appends x * sigmoid(x) on the output of the given node and returns the
+// Multiply node.
+pm::pb_node_t *append_swish(
+        const std::shared_ptr<pb_graph_t> &pgraph, pm::pb_node_t *input) {
+    auto sigmoid = pgraph->append_op(
+            graph::op_kind::Sigmoid, {in_edge(0, input, 0)});
+    return pgraph->append_op(graph::op_kind::Multiply,
+            {in_edge(0, input, 0), in_edge(1, sigmoid, 0)});
+}
+
+// Appends the down projection of a gated MLP, where the activated gate
+// projection multiplies the up projection.
+void append_gated_down(
+        const std::shared_ptr<pb_graph_t> &pgraph, pm::pb_node_t *act) {
+    auto matmul_up = append_float_matmul(pgraph);
+    auto mul = pgraph->append_op(graph::op_kind::Multiply,
+            {in_edge(0, act, 0), in_edge(1, matmul_up, 0)});
+    append_float_matmul(pgraph, {in_edge(0, mul, 0)});
+}
+
+} // namespace
+
+// The MLP patterns are matched after the quantized matmul patterns, and before
+// the floating-point matmul post-op patterns which would split them.
+
+/*
+      [src]  [wei_up]
+          \   /
+          MatMul
+            |
+       GELU / ReLU    [wei_down]
+               \      /
+                MatMul
+                  |
+               [output]
+*/
+DNNL_BACKEND_REGISTER_PATTERN_DEF_BEGIN(mlp)
+
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, float_mlp_fusion)
+        .set_priority(9.5f)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    auto matmul_up = append_float_matmul(pgraph);
+                    auto act = pgraph->append_alternation(
+                            {graph::op_kind::GELU, graph::op_kind::ReLU},
+                            {in_edge(0, matmul_up, 0)});
+                    append_float_matmul(pgraph, {in_edge(0, act, 0)});
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<mlp_base_t>();
+        });
+
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, float_swish_mlp_fusion)
+        .set_priority(9.5f)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    auto matmul_up = append_float_matmul(pgraph);
+                    auto act = append_swish(pgraph, matmul_up);
+                    append_float_matmul(pgraph, {in_edge(0, act, 0)});
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<mlp_base_t>();
+        });
+
+/*
+  [src]  [wei_gate]
+     \   /
+     MatMul    [src]  [wei_up]
+       |          \   /
+  GELU / Swish    MatMul
+            \     /
+            Multiply   [wei_down]
+                  \    /
+                  MatMul
+                    |
+                 [output]
+*/
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, float_gated_mlp_fusion)
+        .set_priority(9.6f)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    auto matmul_gate = append_float_matmul(pgraph);
+                    auto act = pgraph->append_op(
+                            graph::op_kind::GELU, {in_edge(0, matmul_gate, 0)});
+                    append_gated_down(pgraph, act);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<mlp_base_t>();
+        });
+
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, float_swish_gated_mlp_fusion)
+        .set_priority(9.6f)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    auto matmul_gate = append_float_matmul(pgraph);
+                    auto act = append_swish(pgraph, matmul_gate);
+                    append_gated_down(pgraph, act);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<mlp_base_t>();
+        });
+
+DNNL_BACKEND_REGISTER_PATTERN_DEF_END
+
+} // namespace pattern
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
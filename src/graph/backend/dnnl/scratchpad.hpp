@@ -16,6 +16,7 @@
 #ifndef GRAPH_BACKEND_DNNL_SCRATCHPAD_HPP
 #define GRAPH_BACKEND_DNNL_SCRATCHPAD_HPP
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <unordered_map>
@@ -162,6 +163,20 @@ public:
         lcm_alignment_ = graph::utils::lcm(lcm_alignment_, alignment);
     }
 
+    // book a piece of memory at a given offset, which must be a multiple of
+    // the alignment. The caller is responsible for the placement, pieces
+    // booked in this way may overlap with each other.
+    void book_at(const key_t &key, offset_t offset, size_t size,
+            size_t alignment) {
+        // If the piece is booked, skip it
+        if (offset_map_.count(key)) return;
+        assertm(offset % alignment == 0, "unaligned offset");
+
+        offset_map_.insert({key, offset});
+        size_ = std::max(size_, offset + size);
+        lcm_alignment_ = graph::utils::lcm(lcm_alignment_, alignment);
+    }
+
     // get the offset of a booked piece of memory
     offset_t get(const key_t &key) const {
         if (size_ == 0 || offset_map_.count(key) != 1) return 0;
@@ -203,6 +218,11 @@ public:
         registry_.book(key, size, alignment);
     }
 
+    void book_at(const registry_t::key_t &key, registry_t::offset_t offset,
+            size_t size, size_t alignment = 64) {
+        registry_.book_at(key, offset, size, alignment);
+    }
+
 private:
     registry_t &registry_;
 };
@@ -49,6 +49,9 @@ namespace dnnl_impl {
 struct op_executable_t;
 class subgraph_rewriter_t;
 
+// Returns the name of a graph op kind or of a dnnl backend internal op kind
+std::string kind2str(op_kind_t kind);
+
 // The subgraph_t class is a subclass of graph_t, which is used as the only
 // parameter of transformation passes. Each transformation pass will process the
 // subgraph_t object, and after that, the content of subgraph_t object will be
@@ -99,7 +99,8 @@ enum class partition_kind_t {
     quantized_residual_conv_blocks = 23,
     concat_fusion_memory_optim = 24,
     sdp = 25,
-    quantized_sdp = 26
+    quantized_sdp = 26,
+    conv_chain = 27
 };
 
 using engine_kind_t = dnnl_engine_kind_t;
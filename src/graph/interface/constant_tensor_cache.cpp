@@ -15,11 +15,22 @@
  *******************************************************************************/
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "common/engine.hpp"
 #include "common/utils.hpp"
 
@@ -39,6 +50,8 @@
 #include "graph/interface/constant_tensor_cache.hpp"
 #include "graph/utils/utils.hpp"
 
+#include "oneapi/dnnl/dnnl.h"
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -65,6 +78,59 @@ static size_t get_timestamp() {
     return std::chrono::steady_clock::now().time_since_epoch().count();
 }
 
+namespace {
+// The layout of a file saved by constant_tensor_cache_t::save(): the header,
+// followed by the entries, followed by the data of each entry at an offset
+// aligned to the page size, so that the data can be used in place once the
+// file is mapped.
+struct cache_file_header_t {
+    char magic[16];
+    // The library hash and the cpu isa identify the layouts of the tensors
+    char hash[64];
+    uint64_t isa;
+    uint64_t num_entries;
+};
+
+// The fingerprint of the constant inputs identifies an entry across processes,
+// while the key holds process-local partition ids.
+struct cache_file_entry_t {
+    uint64_t key;
+    uint64_t fingerprint;
+    uint64_t size;
+    uint64_t offset;
+};
+
+constexpr const char cache_file_magic[16] = "onednn_graph_cc";
+constexpr size_t cache_file_alignment = 4096;
+
+void init_cache_file_header(cache_file_header_t &header) {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, cache_file_magic, sizeof(header.magic));
+    const char *hash = dnnl_version()->hash;
+    std::strncpy(header.hash, hash ? hash : "", sizeof(header.hash) - 1);
+    header.isa = static_cast<uint64_t>(dnnl_get_effective_cpu_isa());
+}
+
+// The buffer of a constant tensor loaded from a mapped file
+struct mapped_constant_buffer_t : public constant_buffer_t {
+    mapped_constant_buffer_t(void *data, size_t size, impl::engine_t *eng,
+            const std::shared_ptr<void> &mapping)
+        : constant_buffer_t(size, eng, nullptr, malloc_func, free_func)
+        , mapping_(mapping) {
+        data_ = data;
+    }
+
+    // The memory is owned by the mapping
+    static void *malloc_func(size_t, impl::engine_t *, allocator_t *) {
+        return nullptr;
+    }
+    static void free_func(void *, impl::engine_t *, allocator_t *) {}
+
+private:
+    std::shared_ptr<void> mapping_;
+};
+} // namespace
+
 constant_tensor_cache_t::constant_tensor_cache_t(
         size_t capacity_in_bytes, const std::string &name)
     : name_(name), capacity_in_bytes_(capacity_in_bytes), counter_(1) {
@@ -171,7 +237,7 @@ c_value_t constant_tensor_cache_t::get_or_add(c_key_t backend_id,
     }
     // Check if the requested entry is present in the cache (likely cache_hit)
     auto e = get(key);
-    if (e.valid()) {
+    if (e.valid() && !is_stale(e, size)) {
         unlock_read();
         return e;
     }
@@ -193,6 +259,10 @@ c_value_t constant_tensor_cache_t::get_or_add(c_key_t backend_id,
     // Double check if the requested entry is present in the cache (unlikely
     // cache_hit).
     e = get(key);
+    if (e.valid() && is_stale(e, size)) {
+        constant_map().erase(key);
+        e = c_value_t();
+    }
     if (!e.valid()) {
         // If the entry is missing in the cache then add it (cache_miss)
         add(key, size, value);
@@ -229,6 +299,157 @@ size_t constant_tensor_cache_t::get_size() const {
     return total_size;
 }
 
+status_t constant_tensor_cache_t::save(const std::string &path) {
+    std::vector<std::pair<c_key_t, cached_t>> entries;
+    lock_read();
+    for (const auto &pair : constant_map()) {
+        const c_value_t &value = pair.second.value_;
+        if (value.wait_for(std::chrono::seconds(0))
+                != std::future_status::ready)
+            continue;
+        entries.emplace_back(pair.first, value.get());
+    }
+    unlock_read();
+    // save the entries in a certain order
+    std::sort(entries.begin(), entries.end(),
+            [](const std::pair<c_key_t, cached_t> &a,
+                    const std::pair<c_key_t, cached_t> &b) {
+                return a.first < b.first;
+            });
+
+    cache_file_header_t header;
+    init_cache_file_header(header);
+    header.num_entries = entries.size();
+
+    std::vector<cache_file_entry_t> file_entries(entries.size());
+    size_t offset
+            = sizeof(header) + sizeof(cache_file_entry_t) * entries.size();
+    for (size_t i = 0; i < entries.size(); i++) {
+        offset = impl::utils::rnd_up(offset, cache_file_alignment);
+        const cached_t &buffer = entries[i].second;
+        file_entries[i]
+                = {entries[i].first, buffer->fingerprint(), buffer->size(),
+                        offset};
+        offset += buffer->size();
+    }
+
+    // The file is written under a temporary name and renamed once complete,
+    // so that a reader never maps a partially written file.
+#ifdef _WIN32
+    const std::string tmp_path
+            = path + ".tmp" + std::to_string(GetCurrentProcessId());
+#else
+    const std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+#endif
+    std::ofstream ofs(tmp_path, std::ios::out | std::ios::binary);
+    if (!ofs.is_open()) return status::invalid_arguments;
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char *>(file_entries.data()),
+            sizeof(cache_file_entry_t) * file_entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        const size_t pos = static_cast<size_t>(ofs.tellp());
+        const std::vector<char> padding(file_entries[i].offset - pos, 0);
+        ofs.write(padding.data(), padding.size());
+        ofs.write(entries[i].second->data<char>(), file_entries[i].size);
+    }
+    ofs.close();
+    bool ok = !ofs.fail();
+#ifdef _WIN32
+    // rename doesn't replace an existing file on Windows
+    if (ok) std::remove(path.c_str());
+#endif
+    ok = ok && std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    if (!ok) std::remove(tmp_path.c_str());
+    return ok ? status::success : status::runtime_error;
+}
+
+status_t constant_tensor_cache_t::load(
+        const std::string &path, impl::engine_t *eng, size_t &num_skipped) {
+    num_skipped = 0;
+#if !defined(_WIN32)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return status::invalid_arguments;
+    struct stat st;
+    if (fstat(fd, &st) != 0
+            || static_cast<size_t>(st.st_size) < sizeof(cache_file_header_t)) {
+        close(fd);
+        return status::invalid_arguments;
+    }
+    const size_t file_size = static_cast<size_t>(st.st_size);
+    void *base = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return status::runtime_error;
+    std::shared_ptr<void> mapping(
+            base, [file_size](void *ptr) { munmap(ptr, file_size); });
+
+    cache_file_header_t expected;
+    init_cache_file_header(expected);
+    const auto *header = static_cast<const cache_file_header_t *>(base);
+    if (std::memcmp(header->magic, expected.magic, sizeof(expected.magic))
+            || std::memcmp(header->hash, expected.hash, sizeof(expected.hash))
+            || header->isa != expected.isa)
+        return status::invalid_arguments;
+
+    const size_t num_entries = header->num_entries;
+    if (num_entries
+            > (file_size - sizeof(cache_file_header_t))
+                    / sizeof(cache_file_entry_t))
+        return status::invalid_arguments;
+    const auto *file_entries = reinterpret_cast<const cache_file_entry_t *>(
+            static_cast<const char *>(base) + sizeof(cache_file_header_t));
+    for (size_t i = 0; i < num_entries; i++) {
+        const cache_file_entry_t &entry = file_entries[i];
+        if (entry.offset > file_size || entry.size > file_size - entry.offset)
+            return status::invalid_arguments;
+    }
+
+    lock_write();
+    size_t total_size = get_size();
+    for (const auto &pair : loaded_map_)
+        total_size += pair.second->size();
+    for (size_t i = 0; i < num_entries; i++) {
+        const cache_file_entry_t &entry = file_entries[i];
+        if (entry.size == 0 || constant_map().count(entry.key)
+                || loaded_map_.count(entry.key))
+            continue;
+        if (total_size + entry.size > capacity_in_bytes_) {
+            num_skipped++;
+            continue;
+        }
+
+        auto buffer = std::make_shared<mapped_constant_buffer_t>(
+                static_cast<char *>(base) + entry.offset, entry.size, eng,
+                mapping);
+        buffer->set_fingerprint(entry.fingerprint);
+        loaded_map_.emplace(entry.key, buffer);
+        total_size += entry.size;
+    }
+    unlock_write();
+    return status::success;
+#else
+    UNUSED(path);
+    UNUSED(eng);
+    return status::unimplemented;
+#endif
+}
+
+constant_tensor_cache_t::cached_t constant_tensor_cache_t::take_loaded(
+        c_key_t backend_id, c_key_t backend_specific_key, size_t size,
+        size_t fingerprint) {
+    const c_key_t key = combine_key(backend_id, backend_specific_key);
+    lock_write();
+    cached_t buffer;
+    auto it = loaded_map_.find(key);
+    if (it != loaded_map_.end()) {
+        if (it->second->size() == size
+                && it->second->fingerprint() == fingerprint)
+            buffer = it->second;
+        loaded_map_.erase(it);
+    }
+    unlock_write();
+    return buffer;
+}
+
 void constant_tensor_cache_t::add(
         const c_key_t &key, size_t size, const c_value_t &constant) {
     size_t current_size = get_size();
@@ -257,6 +478,13 @@ c_value_t constant_tensor_cache_t::get(const c_key_t &key) {
     return it->second.value_;
 }
 
+// An entry computed for a different size can't be used, which may happen with
+// entries loaded from a file
+bool constant_tensor_cache_t::is_stale(const c_value_t &value, size_t size) {
+    return value.wait_for(std::chrono::seconds(0)) == std::future_status::ready
+            && value.get()->size() != size;
+}
+
 // Evict n size of cached buffers
 void constant_tensor_cache_t::evict(size_t n) {
     using v_t = std::unordered_map<c_key_t, timed_entry_t>::value_type;
@@ -519,3 +747,31 @@ dnnl::impl::graph::status_t dnnl_graph_get_constant_tensor_cache_capacity(
 
     return dnnl::impl::graph::status::success;
 }
+
+dnnl::impl::graph::status_t dnnl_graph_export_constant_tensor_cache(
+        dnnl_engine_t engine, const char *path) {
+    using namespace dnnl::impl::graph;
+    if (dnnl::impl::utils::any_null(engine, path))
+        return status::invalid_arguments;
+    // only the constant tensors in host memory can be saved
+    if (engine->kind() != dnnl::impl::engine_kind::cpu)
+        return status::unimplemented;
+    auto cache = get_constant_tensor_cache(engine->kind(), engine->index());
+    if (!cache) return status::invalid_arguments;
+    return cache->save(path);
+}
+
+dnnl::impl::graph::status_t dnnl_graph_import_constant_tensor_cache(
+        dnnl_engine_t engine, const char *path, size_t *num_skipped) {
+    using namespace dnnl::impl::graph;
+    if (dnnl::impl::utils::any_null(engine, path))
+        return status::invalid_arguments;
+    if (engine->kind() != dnnl::impl::engine_kind::cpu)
+        return status::unimplemented;
+    auto cache = get_constant_tensor_cache(engine->kind(), engine->index());
+    if (!cache) return status::invalid_arguments;
+    size_t skipped = 0;
+    const status_t ret = cache->load(path, engine, skipped);
+    if (num_skipped) *num_skipped = skipped;
+    return ret;
+}
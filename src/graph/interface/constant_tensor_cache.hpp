@@ -21,6 +21,7 @@
 #include <future>
 #include <limits>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 
@@ -70,6 +71,12 @@ public:
 
     size_t size() const { return size_; }
 
+    // The fingerprint of the contents of the constant inputs the buffer is
+    // computed from. Unlike the cache key, it identifies the buffer across
+    // processes.
+    size_t fingerprint() const { return fingerprint_; }
+    void set_fingerprint(size_t fingerprint) { fingerprint_ = fingerprint; }
+
     // used to notify backend the buffer has been evict. backend can use this
     // api to avoid query constant cache frequently to reduce overhead.
     virtual void notify_evict() {}
@@ -83,6 +90,7 @@ protected:
 private:
     malloc_func_t malloc_func_;
     free_func_t free_func_;
+    size_t fingerprint_ = 0;
 };
 
 struct constant_tensor_cache_t {
@@ -114,6 +122,26 @@ struct constant_tensor_cache_t {
 
     size_t get_size() const;
 
+    // Save the cached constant tensors into a file. The entries whose constant
+    // tensors are still being computed are skipped. The buffers must be
+    // accessible from host.
+    status_t save(const std::string &path);
+
+    // Load the constant tensors saved by save(). The file is mapped read-only
+    // and the loaded buffers point into it. The loaded entries are only moved
+    // into the cache by take_loaded(), once the fingerprint of the constant
+    // inputs is checked. Entries exceeding the remaining capacity are not
+    // loaded and are counted in `num_skipped`. Fails if the file was saved by
+    // another library version or for another cpu isa, as the layouts of the
+    // constant tensors depend on them.
+    status_t load(
+            const std::string &path, impl::engine_t *eng, size_t &num_skipped);
+
+    // Take the loaded entry of the given key, if its size and fingerprint
+    // match. The entry is dropped from the loaded entries in any case.
+    cached_t take_loaded(key_t backend_id, key_t backend_specific_key,
+            size_t size, size_t fingerprint);
+
     // The key_t is composed of two parts: backend id and backend specific key.
     // The backend id occupies 4 bits, and the backend specific key occupies the
     // remained 60 bits. So backends should ensure not encode any information in
@@ -126,6 +154,7 @@ private:
     void evict(size_t n);
     value_t get(const key_t &key);
     void add(const key_t &key, size_t size, const value_t &constant);
+    static bool is_stale(const value_t &value, size_t size);
 
     void lock_read() { rw_mutex_.lock_read(); }
     void lock_write() { rw_mutex_.lock_write(); }
@@ -159,6 +188,8 @@ private:
     // an element*, since it invokes the copy constructor of std::atomic, which
     // is deleted.
     std::unique_ptr<std::unordered_map<key_t, timed_entry_t>> constant_map_;
+    // The entries loaded from a file, not checked against their inputs yet
+    std::unordered_map<key_t, cached_t> loaded_map_;
     impl::utils::rw_mutex_t rw_mutex_;
     std::string name_;
     std::atomic<size_t> capacity_in_bytes_;
@@ -0,0 +1,383 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/cache_hit_types.hpp"
+#include "common/stream.hpp"
+#include "common/utils.hpp"
+
+#include "graph/interface/dynamic_compiled_partition.hpp"
+#include "graph/interface/logical_tensor.hpp"
+#include "graph/interface/tensor.hpp"
+
+#include "graph/utils/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+
+namespace {
+
+const logical_tensor_t *find_by_id(
+        size_t id, const std::vector<logical_tensor_t> &lts) {
+    for (const auto &lt : lts) {
+        if (lt.id == id) return &lt;
+    }
+    return nullptr;
+}
+
+// Check if each op of the partition computes the rows of its outputs, i.e. the
+// slices along their leading dim, from the same rows of its inputs. The
+// contraction of a MatMul op must only involve known dims, so its inputs other
+// than the source must be inputs of the partition with known dims.
+bool is_row_wise(
+        const partition_t &part, const std::vector<logical_tensor_t> &inputs) {
+    using namespace op_kind;
+    static const std::vector<op_kind_t> elementwise_kinds {Abs, Add, BiasAdd,
+            Clamp, Divide, Elu, Exp, GELU, HardSigmoid, HardSwish, LeakyReLU,
+            Log, Maximum, Minimum, Mish, Multiply, Pow, Reciprocal, ReLU, Round,
+            Select, Sigmoid, SoftPlus, Sqrt, Square, SquaredDifference,
+            Subtract, Tanh, TypeCast};
+    for (const auto &op : part.get_ops()) {
+        if (std::find(elementwise_kinds.begin(), elementwise_kinds.end(),
+                    op->get_kind())
+                != elementwise_kinds.end())
+            continue;
+        if (op->get_kind() != MatMul) return false;
+        for (size_t i = 1; i < op->num_inputs(); ++i) {
+            const logical_tensor_t *lt = find_by_id(
+                    op->get_input_value(i)->get_logical_tensor().id, inputs);
+            if (!lt || logical_tensor_wrapper_t(lt).is_shape_unknown())
+                return false;
+        }
+    }
+    return true;
+}
+
+// Check if the rows of a strided tensor are disjoint, i.e. the stride of the
+// leading dim spans all the other dims.
+bool has_disjoint_rows(const logical_tensor_t &lt) {
+    if (lt.ndims < 1) return false;
+    dim_t row_extent = 1;
+    for (int d = 1; d < lt.ndims; ++d) {
+        if (lt.layout.strides[d] < 1) return false;
+        row_extent += (lt.dims[d] - 1) * lt.layout.strides[d];
+    }
+    return lt.layout.strides[0] >= row_extent;
+}
+
+void append_shape_class(std::vector<dim_t> &shape_class,
+        const std::vector<logical_tensor_t> &lts) {
+    for (const auto &lt : lts) {
+        shape_class.push_back(lt.ndims);
+        shape_class.insert(shape_class.end(), lt.dims, lt.dims + lt.ndims);
+        shape_class.insert(shape_class.end(), lt.layout.strides,
+                lt.layout.strides + lt.ndims);
+    }
+}
+
+} // namespace
+
+bool has_dynamic_dims(const std::vector<logical_tensor_t> &lts) {
+    return std::any_of(lts.begin(), lts.end(), [](const logical_tensor_t &lt) {
+        return lt.ndims > 0 && logical_tensor_wrapper_t(lt).is_shape_unknown();
+    });
+}
+
+dynamic_compiled_partition_impl_t::dynamic_compiled_partition_impl_t(
+        const partition_t &src_partition, const engine_t &engine,
+        const std::vector<logical_tensor_t> &inputs,
+        const std::vector<logical_tensor_t> &outputs)
+    : compiled_partition_impl_t(engine, inputs, outputs, {})
+    , src_partition_(src_partition)
+    , row_wise_(is_row_wise(src_partition, inputs))
+    , capacity_(static_cast<size_t>(std::max(1,
+              graph::utils::getenv_int_internal(
+                      "GRAPH_DYNAMIC_SHAPE_CLASSES", 16)))) {
+    // The layout of the outputs can't be decided before the shapes are known,
+    // so the outputs are always in plain layout.
+    for (auto &lt : outputs_) {
+        if (lt.layout_type == layout_type::any)
+            lt.layout_type = layout_type::strided;
+    }
+
+    // The backend compilation modifies the given logical tensors, and the ones
+    // of this compiled partition are kept as they are.
+    std::vector<logical_tensor_t> ins = inputs_, outs = outputs_;
+    auto cp = std::make_shared<compiled_partition_t>(src_partition_);
+    if (src_partition_.is_supported()
+            && src_partition_.get_pimpl()->compile(cp.get(), ins, outs, &engine)
+                    == status::success)
+        generic_ = cp;
+}
+
+status_t dynamic_compiled_partition_impl_t::get_lowered(
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs, bool allow_padding,
+        std::shared_ptr<compiled_partition_t> &lowered,
+        std::vector<logical_tensor_t> &ins, std::vector<logical_tensor_t> &outs,
+        dim_t &rows) {
+    // The dims of the given tensors must agree with the known dims at the
+    // compilation.
+    const auto collect = [](const std::vector<tensor_t> &tensors,
+                                 const std::vector<logical_tensor_t> &compiled,
+                                 std::vector<logical_tensor_t> &concrete) {
+        if (tensors.size() != compiled.size()) return false;
+        concrete.clear();
+        for (const auto &t : tensors) {
+            const logical_tensor_t &lt = t.get_logical_tensor();
+            const logical_tensor_wrapper_t ltw(lt);
+            const logical_tensor_t *pos = find_by_id(lt.id, compiled);
+            if (!pos || pos->ndims != lt.ndims || !ltw.is_strided()
+                    || ltw.is_shape_unknown() || ltw.is_stride_unknown())
+                return false;
+
+            for (int d = 0; d < lt.ndims; ++d) {
+                if (pos->dims[d] != DNNL_GRAPH_UNKNOWN_DIM
+                        && pos->dims[d] != lt.dims[d])
+                    return false;
+            }
+            concrete.push_back(lt);
+        }
+        return true;
+    };
+
+    if (!collect(inputs, inputs_, ins) || !collect(outputs, outputs_, outs))
+        return status::invalid_arguments;
+    rows = 0;
+
+    // The row count of the inputs whose unknown dims are only the leading one.
+    // The outputs with the same row count are padded as well.
+    dim_t nrows = 0;
+    bool can_pad = allow_padding && row_wise_;
+    for (const auto &lt : ins) {
+        if (!can_pad) break;
+        const logical_tensor_t *pos = find_by_id(lt.id, inputs_);
+        if (!logical_tensor_wrapper_t(pos).is_shape_unknown()) continue;
+        for (int d = 1; d < pos->ndims; ++d) {
+            if (pos->dims[d] == DNNL_GRAPH_UNKNOWN_DIM) can_pad = false;
+        }
+        can_pad = can_pad && pos->dims[0] == DNNL_GRAPH_UNKNOWN_DIM
+                && (nrows == 0 || nrows == lt.dims[0])
+                && has_disjoint_rows(lt);
+        nrows = lt.dims[0];
+    }
+    for (const auto &lt : outs) {
+        if (!can_pad) break;
+        if (lt.ndims > 0 && lt.dims[0] == nrows)
+            can_pad = has_disjoint_rows(lt);
+    }
+
+    const dim_t padded_rows = nrows > 0 ? utils::rnd_up_pow2(nrows) : 0;
+    if (can_pad && padded_rows != nrows) {
+        std::vector<logical_tensor_t> padded_ins = ins, padded_outs = outs;
+        for (auto &lt : padded_ins) {
+            const logical_tensor_t *pos = find_by_id(lt.id, inputs_);
+            if (logical_tensor_wrapper_t(pos).is_shape_unknown())
+                lt.dims[0] = padded_rows;
+        }
+        for (auto &lt : padded_outs) {
+            if (lt.ndims > 0 && lt.dims[0] == nrows) lt.dims[0] = padded_rows;
+        }
+
+        // The partition may still not be lowered for the padded shapes, e.g.
+        // when an output is not computed from the padded rows. The exact
+        // shapes are lowered then.
+        CHECK(lower(padded_ins, padded_outs, true, lowered));
+        if (lowered) {
+            ins = std::move(padded_ins);
+            outs = std::move(padded_outs);
+            rows = padded_rows;
+            return status::success;
+        }
+    }
+
+    return lower(ins, outs, false, lowered);
+}
+
+status_t dynamic_compiled_partition_impl_t::lower(
+        const std::vector<logical_tensor_t> &ins,
+        const std::vector<logical_tensor_t> &outs, bool keep_failure,
+        std::shared_ptr<compiled_partition_t> &lowered) {
+    shape_class_t shape_class;
+    append_shape_class(shape_class, ins);
+    append_shape_class(shape_class, outs);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = shape_classes_.find(shape_class);
+        if (it != shape_classes_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+            lowered = it->second.lowered;
+            return status::success;
+        }
+    }
+
+    std::vector<const logical_tensor_t *> in_ptrs, out_ptrs;
+    for (const auto &lt : ins)
+        in_ptrs.push_back(&lt);
+    for (const auto &lt : outs)
+        out_ptrs.push_back(&lt);
+
+    auto cp = std::make_shared<compiled_partition_t>(src_partition_);
+    std::pair<compiled_partition_t *, cache_state_t> cp_state {
+            cp.get(), cache_state_t::compiled_partition_hit};
+    const status_t ret
+            = src_partition_.compile(cp_state, in_ptrs, out_ptrs, engine_);
+    if (ret != status::success) {
+        if (!keep_failure) return ret;
+        cp = nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Another thread may have lowered the same shape class meanwhile
+    auto it = shape_classes_.find(shape_class);
+    if (it != shape_classes_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+        lowered = it->second.lowered;
+        return status::success;
+    }
+
+    lru_.push_front(shape_class);
+    shape_classes_.emplace(std::move(shape_class),
+            shape_class_entry_t {cp, lru_.begin()});
+    if (lru_.size() > capacity_) {
+        shape_classes_.erase(lru_.back());
+        lru_.pop_back();
+    }
+    lowered = cp;
+    return status::success;
+}
+
+status_t dynamic_compiled_partition_impl_t::execute_padded(
+        const compiled_partition_t &lowered, const stream_t *astream,
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs,
+        const std::vector<logical_tensor_t> &ins,
+        const std::vector<logical_tensor_t> &outs) {
+    const auto *alloc
+            = static_cast<const allocator_t *>(engine_->get_allocator());
+    std::vector<void *> buffers;
+    const auto pad = [&](const std::vector<tensor_t> &tensors,
+                             const std::vector<logical_tensor_t> &lts,
+                             bool copy_in, std::vector<tensor_t> &padded) {
+        for (size_t i = 0; i < tensors.size(); ++i) {
+            const logical_tensor_t &lt = tensors[i].get_logical_tensor();
+            const logical_tensor_t &padded_lt = lts[i];
+            if (lt.ndims == 0 || lt.dims[0] == padded_lt.dims[0]) {
+                padded.push_back(tensors[i]);
+                continue;
+            }
+
+            // The padded rows are zeroed so that they hold finite values
+            const size_t size = logical_tensor_wrapper_t(lt).size();
+            const size_t padded_size
+                    = logical_tensor_wrapper_t(padded_lt).size();
+            auto *buf = static_cast<char *>(alloc->allocate(padded_size,
+                    {allocator_t::mem_type_t::temp, alignof(max_align_t)}));
+            if (!buf) return false;
+            buffers.push_back(buf);
+            if (copy_in)
+                std::memcpy(buf, tensors[i].get_data_handle(), size);
+            std::memset(buf + (copy_in ? size : 0), 0,
+                    padded_size - (copy_in ? size : 0));
+            padded.emplace_back(padded_lt, engine_, buf);
+        }
+        return true;
+    };
+
+    std::vector<tensor_t> padded_inputs, padded_outputs;
+    status_t ret = status::out_of_memory;
+    if (pad(inputs, ins, true, padded_inputs)
+            && pad(outputs, outs, false, padded_outputs)) {
+        ret = lowered.execute(astream, padded_inputs, padded_outputs);
+        if (ret == status::success)
+            ret = const_cast<stream_t *>(astream)->wait();
+        for (size_t i = 0; ret == status::success && i < outputs.size(); ++i) {
+            const void *buf = padded_outputs[i].get_data_handle();
+            if (buf == outputs[i].get_data_handle()) continue;
+            std::memcpy(outputs[i].get_data_handle(), buf,
+                    logical_tensor_wrapper_t(outputs[i].get_logical_tensor())
+                            .size());
+        }
+    }
+
+    for (void *buf : buffers)
+        alloc->deallocate(buf);
+    return ret;
+}
+
+status_t dynamic_compiled_partition_impl_t::execute(const stream_t *astream,
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs) {
+    if (generic_) {
+        const status_t ret = generic_->execute(astream, inputs, outputs);
+        if (ret != status::unimplemented) return ret;
+    }
+    // The tensors are only padded on the host
+    std::shared_ptr<compiled_partition_t> lowered;
+    std::vector<logical_tensor_t> ins, outs;
+    dim_t rows = 0;
+    CHECK(get_lowered(inputs, outputs, engine_->kind() == engine_kind::cpu,
+            lowered, ins, outs, rows));
+    if (rows > 0)
+        return execute_padded(*lowered, astream, inputs, outputs, ins, outs);
+    return lowered->execute(astream, inputs, outputs);
+}
+
+#ifdef DNNL_WITH_SYCL
+status_t dynamic_compiled_partition_impl_t::execute_sycl(
+        const stream_t *astream, const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs,
+        const std::vector<::sycl::event> &sycl_deps,
+        ::sycl::event *sycl_event) {
+    if (generic_) {
+        const status_t ret = generic_->execute_sycl(
+                astream, inputs, outputs, sycl_deps, sycl_event);
+        if (ret != status::unimplemented) return ret;
+    }
+    std::shared_ptr<compiled_partition_t> lowered;
+    std::vector<logical_tensor_t> ins, outs;
+    dim_t rows = 0;
+    CHECK(get_lowered(inputs, outputs, false, lowered, ins, outs, rows));
+    return lowered->execute_sycl(
+            astream, inputs, outputs, sycl_deps, sycl_event);
+}
+#endif
+
+#if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
+status_t dynamic_compiled_partition_impl_t::execute_ocl(
+        const stream_t *astream, const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs,
+        const std::vector<cl_event> &ocl_deps, cl_event *ocl_event) {
+    if (generic_) {
+        const status_t ret = generic_->execute_ocl(
+                astream, inputs, outputs, ocl_deps, ocl_event);
+        if (ret != status::unimplemented) return ret;
+    }
+    std::shared_ptr<compiled_partition_t> lowered;
+    std::vector<logical_tensor_t> ins, outs;
+    dim_t rows = 0;
+    CHECK(get_lowered(inputs, outputs, false, lowered, ins, outs, rows));
+    return lowered->execute_ocl(astream, inputs, outputs, ocl_deps, ocl_event);
+}
+#endif
+
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,143 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_INTERFACE_DYNAMIC_COMPILED_PARTITION_HPP
+#define GRAPH_INTERFACE_DYNAMIC_COMPILED_PARTITION_HPP
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "graph/interface/c_types_map.hpp"
+#include "graph/interface/partition.hpp"
+#include "graph/interface/partition_impl.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+
+/// Check if any of the given logical tensors has unknown dims while its ndims
+/// is known. A partition compiled with such inputs is dispatched to the
+/// dynamic_compiled_partition_impl_t.
+bool has_dynamic_dims(const std::vector<logical_tensor_t> &lts);
+
+/// A compiled partition for inputs with unknown dims. If the backend supports
+/// it, the partition is compiled once with the unknown dims, and the concrete
+/// shapes given at each execution are only bound to the compiled partition.
+/// Otherwise, or for the shapes the backend can't bind, the partition is
+/// lowered for each shape class given at execution. When the unknown dims are
+/// the leading dims of the inputs and the partition only has operations which
+/// compute each row of their outputs from the same rows of their inputs, a
+/// shape class covers all the row counts which round up to the same power of
+/// two: the partition is lowered for the rounded row count, and executed on
+/// copies of the tensors padded to it. Otherwise, a shape class is a set of
+/// concrete input and output shapes. The lowered compiled partitions of the
+/// recently used shape classes are kept, so that the execution for a known
+/// shape class only needs a lookup. The lowering goes through the global
+/// compiled partition cache, so the shape classes evicted from here are
+/// usually still cached there.
+class dynamic_compiled_partition_impl_t : public compiled_partition_impl_t {
+public:
+    dynamic_compiled_partition_impl_t(const partition_t &src_partition,
+            const engine_t &engine, const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs);
+
+    std::string str() const override { return "dynamic"; }
+
+    status_t execute(const stream_t *astream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override;
+
+#ifdef DNNL_WITH_SYCL
+    status_t execute_sycl(const stream_t *astream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override;
+#endif
+
+#if DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL
+    status_t execute_ocl(const stream_t *astream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<cl_event> &ocl_deps,
+            cl_event *ocl_event) override;
+#endif
+
+private:
+    using shape_class_t = std::vector<dim_t>;
+
+    /// Get the compiled partition lowered for the shapes of the given tensors,
+    /// and the logical tensors to execute it with. If they are padded, `rows`
+    /// is set to the padded row count, and to 0 otherwise. The partition is
+    /// lowered on the first use of a shape class.
+    status_t get_lowered(const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs, bool allow_padding,
+            std::shared_ptr<compiled_partition_t> &lowered,
+            std::vector<logical_tensor_t> &ins,
+            std::vector<logical_tensor_t> &outs, dim_t &rows);
+
+    /// Look up the compiled partition lowered for the given logical tensors,
+    /// or lower the partition for them. The partition is lowered without
+    /// holding the lock. If `keep_failure` is set, a failed lowering is kept
+    /// as a nullptr `lowered`, so that it's not tried again.
+    status_t lower(const std::vector<logical_tensor_t> &ins,
+            const std::vector<logical_tensor_t> &outs, bool keep_failure,
+            std::shared_ptr<compiled_partition_t> &lowered);
+
+    /// Execute the lowered partition on copies of the tensors padded to the
+    /// row count of the given logical tensors.
+    status_t execute_padded(const compiled_partition_t &lowered,
+            const stream_t *astream, const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<logical_tensor_t> &ins,
+            const std::vector<logical_tensor_t> &outs);
+
+    const partition_t src_partition_;
+
+    /// The partition compiled with the unknown dims, or nullptr if the backend
+    /// doesn't support it. Its execution returns unimplemented for the shapes
+    /// it can't bind.
+    std::shared_ptr<compiled_partition_t> generic_;
+
+    /// Whether the rows of the tensors can be padded, i.e. each operation of
+    /// the partition computes the rows of its outputs from the same rows of
+    /// its inputs
+    bool row_wise_;
+
+    /// The capacity of shape_classes_
+    const size_t capacity_;
+
+    struct shape_class_entry_t {
+        std::shared_ptr<compiled_partition_t> lowered;
+        std::list<shape_class_t>::iterator lru_pos;
+    };
+
+    /// The lowered compiled partitions of the recently used shape classes
+    std::map<shape_class_t, shape_class_entry_t> shape_classes_;
+    /// The recently used shape classes, with the most recent one in the front
+    std::list<shape_class_t> lru_;
+    std::mutex mutex_;
+};
+
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
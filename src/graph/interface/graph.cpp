@@ -18,6 +18,7 @@
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -275,6 +276,64 @@ status_t DNNL_API dnnl_graph_graph_create_with_fpmath_mode(
     return status::success;
 }
 
+status_t DNNL_API dnnl_graph_graph_create_from_partitions(graph_t **graph,
+        size_t num_partitions, const partition_t **partitions) {
+    if (utils::any_null(graph, partitions) || num_partitions == 0)
+        return status::invalid_arguments;
+
+    const auto *first = partitions[0];
+    if (first == nullptr || first->get_pimpl() == nullptr)
+        return status::invalid_arguments;
+    const engine_kind_t engine_kind = first->get_pimpl()->get_engine_kind();
+    const fpmath_mode_t fpmath_mode = first->get_pimpl()->get_fpmath_mode();
+
+    std::unordered_set<size_t> op_ids;
+    for (size_t i = 0; i < num_partitions; ++i) {
+        const auto *part = partitions[i];
+        if (part == nullptr || part->get_pimpl() == nullptr)
+            return status::invalid_arguments;
+        // partitions can only be merged into a graph that is partitioned with
+        // the same engine kind and math mode.
+        if (part->get_pimpl()->get_engine_kind() != engine_kind
+                || part->get_pimpl()->get_fpmath_mode() != fpmath_mode)
+            return status::invalid_arguments;
+        for (const auto &aop : part->get_ops()) {
+            // the same op cannot belong to two partitions
+            if (!op_ids.insert(aop->get_id()).second)
+                return status::invalid_graph_op;
+        }
+    }
+
+    // re-create the ops from their attributes and logical tensors so that the
+    // new graph does not share any value with the graph of the partitions. The
+    // ops are connected again by logical tensor ids when finalizing the graph.
+    std::unique_ptr<graph_t> agraph(new graph_t(engine_kind, fpmath_mode));
+    for (size_t i = 0; i < num_partitions; ++i) {
+        for (const auto &aop : partitions[i]->get_ops()) {
+            op_t new_op(aop->get_id(), aop->get_kind(), aop->get_name());
+            // only keep the attributes defined in the spec, the internal ones
+            // set by the partitioning (e.g. op depth) fail the verification.
+            const op_schema_t *opm
+                    = op_schema_registry_t::get_op_schema(aop->get_kind());
+            std::unordered_map<op_attr_t, op_t::attribute_value_t> attrs;
+            for (const auto &attr : aop->get_attributes()) {
+                if (opm == nullptr || opm->get_attrs().count(attr.first))
+                    attrs.insert(attr);
+            }
+            new_op.merge_attributes(attrs);
+            for (const auto &in_val : aop->get_input_values())
+                new_op.add_input(in_val->get_logical_tensor());
+            for (const auto &out_val : aop->get_output_values())
+                new_op.add_output(out_val->get_logical_tensor());
+            status_t ret = agraph->add_op(&new_op);
+            if (ret != status::success) return ret;
+        }
+    }
+
+    *graph = agraph.release();
+    return status::success;
+}
+
 status_t DNNL_API dnnl_graph_graph_destroy(graph_t *graph) {
     delete graph;
     return status::success;
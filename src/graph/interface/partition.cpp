@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <limits>
@@ -29,11 +30,13 @@
 
 #include "common/cache_hit_types.hpp"
 #include "common/stream.hpp"
+#include "common/utils.hpp"
 #include "common/verbose.hpp"
 
 #include "graph/interface/allocator.hpp"
 #include "graph/interface/backend.hpp"
 #include "graph/interface/c_types_map.hpp"
+#include "graph/interface/dynamic_compiled_partition.hpp"
 #include "graph/interface/graph.hpp"
 #include "graph/interface/logical_tensor.hpp"
 #include "graph/interface/op_schema.hpp"
@@ -52,6 +55,41 @@ using dnnl::impl::cache_state2str;
 using dnnl::impl::cache_state_t;
 using namespace dnnl::impl::graph;
 
+namespace dnnl {
+namespace impl {
+namespace graph {
+
+namespace {
+std::atomic<bool> &execution_profiling_flag() {
+    static std::atomic<bool> flag {
+            dnnl::impl::getenv_int_user("GRAPH_EXECUTION_PROFILING", 0) > 0};
+    return flag;
+}
+
+thread_local std::vector<profiling_record_t> *execution_profiling_records
+        = nullptr;
+} // namespace
+
+bool is_execution_profiling_enabled() {
+    return execution_profiling_flag().load();
+}
+
+void set_execution_profiling_enabled(bool enabled) {
+    execution_profiling_flag().store(enabled);
+}
+
+void set_execution_profiling_records(std::vector<profiling_record_t> *records) {
+    execution_profiling_records = records;
+}
+
+std::vector<profiling_record_t> *get_execution_profiling_records() {
+    return execution_profiling_records;
+}
+
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
 /// This allows to create a partition directly with an op and an engine kind. In
 /// order to not break backend API and change the existing graph and partition
 /// implementation, we internally construct a temporal graph object, add the
@@ -551,6 +589,102 @@ status_t DNNL_API dnnl_graph_compiled_partition_get_inplace_ports(
     return status::success;
 }
 
+void dnnl_graph_compiled_partition::set_profiling_records(
+        std::vector<profiling_record_t> &&records) const {
+    std::lock_guard<std::mutex> lock(profiling_mutex_);
+    profiling_records_ = std::move(records);
+    c_profiling_records_.clear();
+    c_profiling_records_.reserve(profiling_records_.size());
+    for (const auto &r : profiling_records_) {
+        c_profiling_records_.push_back({r.name.c_str(), r.impl_info.c_str(),
+                r.start_ms, r.duration_ms, r.bytes});
+    }
+}
+
+std::vector<profiling_record_t>
+dnnl_graph_compiled_partition::get_profiling_records() const {
+    std::lock_guard<std::mutex> lock(profiling_mutex_);
+    return profiling_records_;
+}
+
+void dnnl_graph_compiled_partition::get_c_profiling_records(size_t &num_records,
+        const dnnl_graph_profiling_record_t *&records) const {
+    std::lock_guard<std::mutex> lock(profiling_mutex_);
+    num_records = c_profiling_records_.size();
+    records = c_profiling_records_.data();
+}
+
+namespace {
+std::string json_escape(const std::string &str) {
+    std::string ret;
+    for (char c : str) {
+        if (c == '"' || c == '\\') ret.push_back('\\');
+        ret.push_back(c);
+    }
+    return ret;
+}
+
+// Write the records as complete events of the Chrome trace event format, with
+// the timestamps in microseconds
+std::string profiling_records2trace(
+        const std::vector<profiling_record_t> &records) {
+    std::ostringstream ss;
+    ss.precision(3);
+    ss << std::fixed << "{\"traceEvents\":[";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto &r = records[i];
+        if (i > 0) ss << ",";
+        ss << "{\"name\":\"" << json_escape(r.name)
+           << "\",\"cat\":\"graph\",\"ph\":\"X\",\"pid\":0,\"tid\":0"
+           << ",\"ts\":" << r.start_ms * 1e3
+           << ",\"dur\":" << r.duration_ms * 1e3
+           << ",\"args\":{\"impl\":\"" << json_escape(r.impl_info)
+           << "\",\"bytes\":" << r.bytes << "}}";
+    }
+    ss << "],\"displayTimeUnit\":\"ms\"}";
+    return ss.str();
+}
+} // namespace
+
+status_t DNNL_API dnnl_graph_set_execution_profiling(int flag) {
+    if (flag < 0) return status::invalid_arguments;
+    set_execution_profiling_enabled(flag > 0);
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_get_execution_profiling(int *flag) {
+    if (flag == nullptr) return status::invalid_arguments;
+    *flag = is_execution_profiling_enabled() ? 1 : 0;
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_compiled_partition_get_profiling_records(
+        const compiled_partition_t *compiled_partition, size_t *num_records,
+        const dnnl_graph_profiling_record_t **records) {
+    if (utils::any_null(compiled_partition, num_records, records))
+        return status::invalid_arguments;
+
+    compiled_partition->get_c_profiling_records(*num_records, *records);
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_compiled_partition_get_profiling_trace(
+        const compiled_partition_t *compiled_partition, size_t *size,
+        char *trace) {
+    if (utils::any_null(compiled_partition, size))
+        return status::invalid_arguments;
+
+    const std::string data = profiling_records2trace(
+            compiled_partition->get_profiling_records());
+    if (!trace) {
+        *size = data.size() + 1;
+        return status::success;
+    }
+    if (*size != data.size() + 1) return status::invalid_arguments;
+    std::memcpy(trace, data.c_str(), data.size() + 1);
+    return status::success;
+}
+
 status_t dnnl_graph_partition::infer_shape(
         std::vector<const logical_tensor_t *> &inputs,
         std::vector<logical_tensor_t *> &outputs) {
@@ -648,6 +782,18 @@ status_t dnnl_graph_partition::compile(compiled_partition_t *cp,
     ret = pre_process(tmp_outputs, outputs, backend);
     if (status::success != ret) return ret;
 
+    // The partition compiled with unknown input dims is lowered for the
+    // concrete shapes given at the execution.
+    if (has_dynamic_dims(tmp_inputs)) {
+        for (const auto &lt : tmp_inputs) {
+            if (!logical_tensor_wrapper_t(lt).is_strided())
+                return status::invalid_arguments;
+        }
+        cp->init(std::make_shared<dynamic_compiled_partition_impl_t>(
+                *this, *aengine, tmp_inputs, tmp_outputs));
+        return status::success;
+    }
+
     // Count how many registered backends support the engine kind
     const engine_kind_t kind = aengine->kind();
     size_t effective_backends = 0;
@@ -781,7 +927,20 @@ status_t dnnl_graph_compiled_partition::execute(const stream_t *astream,
         pre_process(processed_inputs, inputs, backend);
         pre_process(processed_outputs, outputs, backend);
 
-        return pimpl_->execute(astream, processed_inputs, processed_outputs);
+        // A nested execution, e.g. the one of a shape class of a dynamic
+        // compiled partition, is recorded in the records of the outer one.
+        if (!is_execution_profiling_enabled()
+                || get_execution_profiling_records())
+            return pimpl_->execute(
+                    astream, processed_inputs, processed_outputs);
+
+        std::vector<profiling_record_t> records;
+        set_execution_profiling_records(&records);
+        status_t ret = pimpl_->execute(
+                astream, processed_inputs, processed_outputs);
+        set_execution_profiling_records(nullptr);
+        if (ret == status::success) set_profiling_records(std::move(records));
+        return ret;
 #endif
     }
 }
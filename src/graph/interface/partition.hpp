@@ -20,6 +20,7 @@
 #include <cstring>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -227,6 +228,17 @@ public:
         return info_.c_str();
     }
 
+    // Keep the profiling records of the last profiled execution
+    void set_profiling_records(
+            std::vector<graph::profiling_record_t> &&records) const;
+
+    // A copy of the records, as a concurrent execution may replace them
+    std::vector<graph::profiling_record_t> get_profiling_records() const;
+
+    // The C API view of the records, valid until the records are replaced
+    void get_c_profiling_records(size_t &num_records,
+            const dnnl_graph_profiling_record_t *&records) const;
+
 private:
     std::shared_ptr<graph::compiled_partition_impl_t> pimpl_;
 
@@ -234,6 +246,12 @@ private:
 
     // Partition information
     mutable graph::utils::partition_info_t info_;
+
+    // Profiling records and their C API view, which refers to the strings of
+    // the records
+    mutable std::mutex profiling_mutex_;
+    mutable std::vector<graph::profiling_record_t> profiling_records_;
+    mutable std::vector<dnnl_graph_profiling_record_t> c_profiling_records_;
 };
 
 #endif
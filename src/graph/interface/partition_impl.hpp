@@ -252,6 +252,28 @@ private:
     DNNL_DISALLOW_COPY_AND_ASSIGN(partition_impl_t);
 };
 
+/// The profiling record of an internal operation of a compiled partition
+struct profiling_record_t {
+    std::string name;
+    std::string impl_info;
+    double start_ms;
+    double duration_ms;
+    size_t bytes;
+};
+
+/// Whether the execution profiling is enabled
+bool is_execution_profiling_enabled();
+
+void set_execution_profiling_enabled(bool enabled);
+
+/// Set the records receiving the profiling of the internal operations executed
+/// in the current thread. Backends stop recording when it's set to nullptr.
+void set_execution_profiling_records(std::vector<profiling_record_t> *records);
+
+/// Get the records receiving the profiling of the internal operations executed
+/// in the current thread, nullptr if the execution is not profiled.
+std::vector<profiling_record_t> *get_execution_profiling_records();
+
 class compiled_partition_impl_t {
 public:
     /// The base constructor of compiled_partition_impl_t. The subclass
@@ -105,6 +105,7 @@ std::string partition_kind2str(partition_kind_t v) {
         CASE(concat_fusion_memory_optim);
         CASE(sdp);
         CASE(quantized_sdp);
+        CASE(conv_chain);
         default: return "unknown_kind";
     }
 #undef CASE
@@ -141,6 +142,7 @@ partition_kind_t str2partition_kind(const std::string &str) {
     IF_HANDLE(concat_fusion_memory_optim);
     IF_HANDLE(sdp);
     IF_HANDLE(quantized_sdp);
+    IF_HANDLE(conv_chain);
 
     return partition_kind_t::undef;
 
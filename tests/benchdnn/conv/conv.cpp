@@ -227,6 +227,7 @@ dnnl_status_t init_pd(init_pd_args_t<prb_t> &init_pd_args) {
     dnnl_alg_kind_t alg = dnnl_convolution_direct;
     if (prb->alg == WINO) alg = dnnl_convolution_winograd;
     if (prb->alg == AUTO) alg = dnnl_convolution_auto;
+    if (prb->alg == FFT) alg = dnnl_convolution_fft;
 
     attr_args_t attr_args;
     attr_args.prepare_post_ops_mds(
@@ -392,10 +393,10 @@ void skip_unimplemented_prb(const prb_t *prb, res_t *res) {
         }
     }
 
-    // Winograd implementation has very limited scope and support. It doesn't
-    // make sense to list all of them, just convert all unimplemented Winograd
-    // problems into not supported.
-    if (prb->alg == WINO) {
+    // Winograd and FFT implementations have very limited scope and support.
+    // It doesn't make sense to list all of them, just convert all
+    // unimplemented Winograd and FFT problems into not supported.
+    if (prb->alg == WINO || prb->alg == FFT) {
         res->state = SKIPPED;
         res->reason = skip_reason::case_not_supported;
         return;
@@ -413,11 +414,14 @@ void skip_invalid_prb(const prb_t *prb, res_t *res) {}
 
 void setup_cmp(compare::compare_t &cmp, const prb_t *prb, data_kind_t kind,
         const args_t &ref_args) {
-    const bool compare_with_norm = (prb->alg & WINO);
+    const bool compare_with_norm = (prb->alg & WINO) || prb->alg == FFT;
     cmp.set_norm_validation_mode(compare_with_norm);
 
     float trh = 0.f;
-    if (prb->alg & WINO) {
+    if (prb->alg == FFT) {
+        // Transforms round each output to the magnitude of the whole tile.
+        trh = 1e-5f;
+    } else if (prb->alg & WINO) {
         trh = prb->dt[1] == dnnl_f16 ? 7e-3f : 2e-5f;
         if (prb->dir & FLAG_WEI) {
             // This is an empirical equation derived by observing growth error
@@ -513,6 +517,19 @@ int init_ref_memory_args(dnn_mem_map_t &ref_mem_map, dnn_mem_map_t &mem_map,
             case DNNL_ARG_DIFF_DST:
                 SAFE(fill_data(DST, prb, cfg, mem, ref_mem, res), WARN);
                 break;
+            case DNNL_ARG_DIFF_WEIGHTS:
+            case DNNL_ARG_DIFF_BIAS:
+                // Sum post-op accumulates gradients into existing values.
+                if (prb->attr.post_ops.find(attr_t::post_ops_t::kind_t::SUM)
+                        >= 0) {
+                    const auto kind
+                            = exec_arg == DNNL_ARG_DIFF_WEIGHTS ? WEI : BIA;
+                    SAFE(fill_data(kind, prb, cfg, mem, ref_mem, res), WARN);
+                    if (has_bench_mode_bit(mode_bit_t::bitwise)) {
+                        SAFE(mem_map.at(-exec_arg).reorder(ref_mem), WARN);
+                    }
+                }
+                break;
             default:
                 SAFE(init_ref_memory_args_default_case(
                              exec_arg, mem, ref_mem, prb->attr, res),
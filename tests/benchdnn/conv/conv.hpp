@@ -37,9 +37,11 @@ enum alg_t {
     DIRECT,
     WINO,
     AUTO,
+    FFT,
     convolution_direct = DIRECT,
     convolution_wino = WINO,
     convolution_auto = AUTO,
+    convolution_fft = FFT,
 };
 alg_t str2alg(const char *str);
 const char *alg2str(alg_t alg);
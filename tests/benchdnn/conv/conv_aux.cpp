@@ -32,6 +32,8 @@ alg_t str2alg(const char *str) {
     CASE(convolution_direct);
     CASE(WINO);
     CASE(convolution_wino);
+    CASE(FFT);
+    CASE(convolution_fft);
 #undef CASE
     assert(!"unknown algorithm");
     return UNDEF;
@@ -41,6 +43,7 @@ const char *alg2str(alg_t alg) {
     if (alg == AUTO) return "auto";
     if (alg == DIRECT) return "direct";
     if (alg == WINO) return "wino";
+    if (alg == FFT) return "fft";
     assert(!"unknown algorithm");
     return "undef";
 }
@@ -49,6 +52,7 @@ alg_t alg_kind2alg(dnnl_alg_kind_t alg) {
     if (alg == dnnl_convolution_auto) return AUTO;
     if (alg == dnnl_convolution_direct) return DIRECT;
     if (alg == dnnl_convolution_winograd) return WINO;
+    if (alg == dnnl_convolution_fft) return FFT;
     assert(!"unknown algorithm");
     return DIRECT;
 }
@@ -325,6 +325,8 @@ void compute_ref_direct_bwd_d(const prb_t *prb, const args_t &args) {
 }
 
 void compute_ref_bwd_weights(const prb_t *prb, const args_t &args) {
+    const bool with_sum
+            = prb->attr.post_ops.find(attr_t::post_ops_t::SUM) >= 0;
     const dnn_mem_t &src_m = args.find(DNNL_ARG_SRC);
     const dnn_mem_t &diff_wei_m = args.find(DNNL_ARG_DIFF_WEIGHTS);
     const dnn_mem_t &diff_dst_m = args.find(DNNL_ARG_DIFF_DST);
@@ -383,12 +385,14 @@ void compute_ref_bwd_weights(const prb_t *prb, const args_t &args) {
                     int64_t kw) {
                 size_t wei_off = wei_off_f(prb, g, oc, ic, kd, kh, kw);
                 float &dw = ((float *)diff_wei_m)[wei_off];
-                dw = 0;
+                if (!with_sum) dw = 0;
                 ker(dw, g, oc, ic, kd, kh, kw);
             });
 }
 
 void compute_ref_bwd_bias(const prb_t *prb, const args_t &args) {
+    const bool with_sum
+            = prb->attr.post_ops.find(attr_t::post_ops_t::SUM) >= 0;
     const dnn_mem_t &diff_bia_m = args.find(DNNL_ARG_DIFF_BIAS);
     const dnn_mem_t &diff_dst_m = args.find(DNNL_ARG_DIFF_DST);
     /* help compiler optimize the code */
@@ -398,7 +402,7 @@ void compute_ref_bwd_bias(const prb_t *prb, const args_t &args) {
 
     benchdnn_parallel_nd(G, OCG, [&](int64_t g, int64_t oc) {
         size_t bia_off = bia_off_f(prb, g, oc);
-        double sum = 0;
+        double sum = with_sum ? ((float *)diff_bia_m)[bia_off] : 0;
 
         for_(int64_t mb = 0; mb < MB; ++mb)
         for_(int64_t od = 0; od < OD; ++od)
@@ -249,10 +249,10 @@ struct scratchpad_t {
 int init_scratchpad(const prb_t *prb, scratchpad_t &sp) {
     if (sp.out_dim != 4 || sp.alpha != 6) return FAIL;
 
-    sp.h_tiles = prb->dir == FLAG_FWD ? div_up(prb->oh, sp.out_dim)
-                                      : div_up(prb->ih, sp.out_dim);
-    sp.w_tiles = prb->dir == FLAG_FWD ? div_up(prb->ow, sp.out_dim)
-                                      : div_up(prb->iw, sp.out_dim);
+    sp.h_tiles = (prb->dir & FLAG_FWD) ? div_up(prb->oh, sp.out_dim)
+                                       : div_up(prb->ih, sp.out_dim);
+    sp.w_tiles = (prb->dir & FLAG_FWD) ? div_up(prb->ow, sp.out_dim)
+                                       : div_up(prb->iw, sp.out_dim);
 
     sp._u_ptr = (float *)zmalloc(
             sizeof(float) * sp.alpha * sp.alpha * prb->oc * prb->ic, 64);
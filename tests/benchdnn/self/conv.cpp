@@ -35,6 +35,9 @@ static int check_simple_enums() {
     SELF_CHECK_CASE_STR_EQ(alg2str(alg_t::WINO), "wino");
     SELF_CHECK_CASE_STR_NE(alg2str(alg_t::WINO), "winox");
 
+    SELF_CHECK_CASE_STR_EQ(alg2str(alg_t::FFT), "fft");
+    SELF_CHECK_CASE_STR_NE(alg2str(alg_t::FFT), "fftx");
+
     SELF_CHECK_EQ(str2alg("auto"), alg_t::AUTO);
     SELF_CHECK_EQ(str2alg("AUTO"), alg_t::AUTO);
 
@@ -44,6 +47,9 @@ static int check_simple_enums() {
     SELF_CHECK_EQ(str2alg("wino"), alg_t::WINO);
     SELF_CHECK_EQ(str2alg("WINO"), alg_t::WINO);
 
+    SELF_CHECK_EQ(str2alg("fft"), alg_t::FFT);
+    SELF_CHECK_EQ(str2alg("FFT"), alg_t::FFT);
+
     return OK;
 }
 
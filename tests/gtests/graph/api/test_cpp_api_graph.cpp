@@ -74,6 +74,53 @@ TEST(APIGraph, GetPartitionsReentrant) {
     EXPECT_EQ(debug_partitions.size(), 2U);
 }
 
+TEST(APIGraph, CreateFromPartitions) {
+    using namespace dnnl::graph;
+    engine::kind engine_kind = engine::kind::cpu;
+
+    op matmul_op(0, op::kind::MatMul, "matmul");
+    op relu_op(1, op::kind::ReLU, "relu");
+    logical_tensor matmul_src {0, logical_tensor::data_type::f32,
+            logical_tensor::layout_type::strided};
+    logical_tensor matmul_wei {1, logical_tensor::data_type::f32,
+            logical_tensor::layout_type::strided};
+    logical_tensor matmul_dst {2, logical_tensor::data_type::f32,
+            logical_tensor::layout_type::strided};
+    logical_tensor relu_dst {3, logical_tensor::data_type::f32,
+            logical_tensor::layout_type::strided};
+
+    matmul_op.add_input(matmul_src);
+    matmul_op.add_input(matmul_wei);
+    matmul_op.add_output(matmul_dst);
+    relu_op.add_input(matmul_dst);
+    relu_op.add_output(relu_dst);
+
+    // the two ops are submitted in two different graphs
+    graph g0(engine_kind);
+    g0.add_op(matmul_op);
+    g0.finalize();
+    auto partitions0 = g0.get_partitions();
+    ASSERT_EQ(partitions0.size(), 1U);
+
+    graph g1(engine_kind);
+    g1.add_op(relu_op);
+    g1.finalize();
+    auto partitions1 = g1.get_partitions();
+    ASSERT_EQ(partitions1.size(), 1U);
+
+    // the merged graph can fuse across the partition boundary
+    graph merged({partitions0[0], partitions1[0]});
+    EXPECT_FALSE(merged.is_finalized());
+    merged.finalize();
+    auto partitions = merged.get_partitions();
+    ASSERT_EQ(partitions.size(), 1U);
+    EXPECT_EQ(partitions[0].get_ops_num(), 2U);
+    EXPECT_EQ(partitions[0].get_input_ports().size(), 2U);
+    EXPECT_EQ(partitions[0].get_output_ports().size(), 1U);
+
+    EXPECT_THROW(graph(std::vector<partition> {}), dnnl::error);
+}
+
 TEST(APIGraph, AddOp) {
     using namespace dnnl::graph;
     dnnl::engine::kind engine_kind = dnnl::engine::kind::cpu;
@@ -19,7 +19,10 @@
 #include "test_api_common.hpp"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cstdint>
+#include <string>
 
 TEST(APIPartition, PartitionTest) {
     using namespace dnnl::graph;
@@ -308,6 +311,199 @@ TEST(APIPartition, CompileWildcardPartition) {
     EXPECT_THROW(part.compile({lt1}, {lt2}, eng), dnnl::error);
 }
 
+TEST(APIPartition, ExecutionProfiling) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    SKIP_IF(engine_kind != dnnl::engine::kind::cpu,
+            "Skip the case as the profiling is only supported on CPU");
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+    dnnl::stream strm(eng);
+
+    std::vector<int64_t> dims {16, 64};
+    logical_tensor src {0, logical_tensor::data_type::f32, dims,
+            logical_tensor::layout_type::strided};
+    logical_tensor dst {1, logical_tensor::data_type::f32, dims,
+            logical_tensor::layout_type::strided};
+
+    op relu(0, op::kind::ReLU, "relu");
+    relu.add_input(src);
+    relu.add_output(dst);
+
+    partition part {relu, engine_kind};
+    ASSERT_TRUE(part.is_supported());
+    compiled_partition cp = part.compile({src}, {dst}, eng);
+
+    std::vector<float> src_data(16 * 64, -1.f), dst_data(16 * 64, 0.f);
+    tensor src_ts(src, eng, src_data.data());
+    tensor dst_ts(dst, eng, dst_data.data());
+
+    // Nothing is recorded while the profiling is disabled
+    const int flag = get_execution_profiling();
+    set_execution_profiling(0);
+    cp.execute(strm, {src_ts}, {dst_ts});
+    strm.wait();
+    ASSERT_TRUE(cp.get_profiling_records().empty());
+
+    set_execution_profiling(1);
+    ASSERT_EQ(get_execution_profiling(), 1);
+    cp.execute(strm, {src_ts}, {dst_ts});
+    strm.wait();
+    set_execution_profiling(flag);
+
+    const auto records = cp.get_profiling_records();
+    ASSERT_FALSE(records.empty());
+    const auto &last = records.back();
+    ASSERT_NE(last.name.find("eltwise"), std::string::npos);
+    // the name ends with the id of the op, as in the subgraph dump
+    ASSERT_TRUE(std::isdigit(static_cast<unsigned char>(last.name.back())));
+    ASSERT_FALSE(last.impl_info.empty());
+    ASSERT_GE(last.duration_ms, 0.0);
+    ASSERT_EQ(last.bytes, 2 * src_data.size() * sizeof(float));
+
+    const std::string trace = cp.get_profiling_trace();
+    ASSERT_EQ(trace.find("{\"traceEvents\":["), 0U);
+    ASSERT_NE(trace.find(last.impl_info), std::string::npos);
+
+    EXPECT_THROW(set_execution_profiling(-1), dnnl::error);
+}
+
+TEST(APIPartition, DynamicShapePartition) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    SKIP_IF(engine_kind != dnnl::engine::kind::cpu,
+            "Skip the case as the buffers are allocated on the host");
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    // The batch size is unknown at the compilation
+    std::vector<int64_t> dynamic_dims {DNNL_GRAPH_UNKNOWN_DIM, 16};
+    logical_tensor src {0, logical_tensor::data_type::f32, dynamic_dims,
+            logical_tensor::layout_type::strided};
+    logical_tensor dst {1, logical_tensor::data_type::f32, dynamic_dims,
+            logical_tensor::layout_type::strided};
+
+    op relu(0, op::kind::ReLU, "relu");
+    relu.add_input(src);
+    relu.add_output(dst);
+
+    partition part {relu, engine_kind};
+    ASSERT_TRUE(part.is_supported());
+    compiled_partition cp = part.compile({src}, {dst}, eng);
+    ASSERT_EQ(cp.query_logical_tensor(1).get_dims()[0], DNNL_GRAPH_UNKNOWN_DIM);
+
+    // The batch sizes 3 and 4, and 5 and 8, are in the same shape classes,
+    // with the tensors of batch sizes 3 and 5 padded
+    dnnl::stream strm(eng);
+    for (int64_t batch : {2, 5, 3, 8, 4, 2}) {
+        std::vector<int64_t> dims {batch, 16};
+        logical_tensor src_lt {0, logical_tensor::data_type::f32, dims,
+                logical_tensor::layout_type::strided};
+        logical_tensor dst_lt {1, logical_tensor::data_type::f32, dims,
+                logical_tensor::layout_type::strided};
+
+        std::vector<float> src_data(batch * 16), dst_data(batch * 16, 0.f);
+        for (size_t i = 0; i < src_data.size(); ++i)
+            src_data[i] = (i % 2) ? -1.f * i : 1.f * i;
+
+        tensor src_ts(src_lt, eng, src_data.data());
+        tensor dst_ts(dst_lt, eng, dst_data.data());
+        cp.execute(strm, {src_ts}, {dst_ts});
+        strm.wait();
+
+        for (size_t i = 0; i < dst_data.size(); ++i)
+            ASSERT_EQ(dst_data[i], std::max(src_data[i], 0.f));
+    }
+
+    // The known dims must agree with the ones given at the compilation
+    std::vector<int64_t> bad_dims {2, 8};
+    logical_tensor bad_lt {0, logical_tensor::data_type::f32, bad_dims,
+            logical_tensor::layout_type::strided};
+    logical_tensor bad_dst_lt {1, logical_tensor::data_type::f32, bad_dims,
+            logical_tensor::layout_type::strided};
+    std::vector<float> bad_src_data(16), bad_dst_data(16);
+    tensor bad_src_ts(bad_lt, eng, bad_src_data.data());
+    tensor bad_dst_ts(bad_dst_lt, eng, bad_dst_data.data());
+    EXPECT_THROW(cp.execute(strm, {bad_src_ts}, {bad_dst_ts}), dnnl::error);
+}
+
+TEST(APIPartition, DynamicShapeMatMulPartition) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    SKIP_IF(engine_kind != dnnl::engine::kind::cpu,
+            "Skip the case as the buffers are allocated on the host");
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    // The batch size is unknown at the compilation, and the weights are
+    // transposed
+    const int64_t K = 8, N = 4;
+    logical_tensor src {0, logical_tensor::data_type::f32,
+            {DNNL_GRAPH_UNKNOWN_DIM, K}, logical_tensor::layout_type::strided};
+    logical_tensor wei {1, logical_tensor::data_type::f32, {N, K},
+            logical_tensor::layout_type::strided};
+    logical_tensor dst {2, logical_tensor::data_type::f32,
+            {DNNL_GRAPH_UNKNOWN_DIM, N}, logical_tensor::layout_type::strided};
+
+    op matmul(0, op::kind::MatMul, "matmul");
+    matmul.set_attr<bool>(op::attr::transpose_b, true);
+    matmul.add_inputs({src, wei});
+    matmul.add_output(dst);
+
+    partition part {matmul, engine_kind};
+    ASSERT_TRUE(part.is_supported());
+    compiled_partition cp = part.compile({src, wei}, {dst}, eng);
+    ASSERT_EQ(cp.query_logical_tensor(2).get_dims()[0], DNNL_GRAPH_UNKNOWN_DIM);
+
+    std::vector<float> wei_data(N * K);
+    for (size_t i = 0; i < wei_data.size(); ++i)
+        wei_data[i] = static_cast<float>(i % 3) - 1.f;
+    tensor wei_ts(wei, eng, wei_data.data());
+
+    const int flag = get_execution_profiling();
+    set_execution_profiling(1);
+    dnnl::stream strm(eng);
+    // The last source is in column-major layout, which is not bound to the
+    // compiled partition but executed by lowering the partition for its shape.
+    for (int64_t batch : {3, 7, 3, -5}) {
+        const bool col_major = batch < 0;
+        const int64_t M = col_major ? -batch : batch;
+        logical_tensor src_lt {0, logical_tensor::data_type::f32, {M, K},
+                col_major ? std::vector<int64_t> {1, M}
+                          : std::vector<int64_t> {K, 1}};
+        logical_tensor dst_lt {2, logical_tensor::data_type::f32, {M, N},
+                logical_tensor::layout_type::strided};
+
+        std::vector<float> src_data(M * K), dst_data(M * N, 0.f);
+        for (size_t i = 0; i < src_data.size(); ++i)
+            src_data[i] = static_cast<float>(i % 5);
+
+        tensor src_ts(src_lt, eng, src_data.data());
+        tensor dst_ts(dst_lt, eng, dst_data.data());
+        cp.execute(strm, {src_ts, wei_ts}, {dst_ts});
+        strm.wait();
+
+        // The records of the lowered partition are kept as well
+        const auto records = cp.get_profiling_records();
+        if (col_major)
+            ASSERT_FALSE(records.empty());
+        else
+            ASSERT_EQ(records.size(), 1U);
+
+        for (int64_t m = 0; m < M; ++m) {
+            for (int64_t n = 0; n < N; ++n) {
+                float ref = 0.f;
+                for (int64_t k = 0; k < K; ++k) {
+                    const int64_t src_off = col_major ? k * M + m : m * K + k;
+                    ref += src_data[src_off] * wei_data[n * K + k];
+                }
+                ASSERT_FLOAT_EQ(dst_data[m * N + n], ref);
+            }
+        }
+    }
+    set_execution_profiling(flag);
+}
+
 TEST(APIPartitionCache, GetSetCapacity) {
     ASSERT_EQ(dnnl_graph_set_compiled_partition_cache_capacity(-1),
             dnnl_invalid_arguments);
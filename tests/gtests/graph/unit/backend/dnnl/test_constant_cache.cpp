@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2022-2023 Intel Corporation
+* Copyright 2022-2024 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -13,6 +13,14 @@
 * See the License for the specific language governing permissions and
 * limitations under the License.
 *******************************************************************************/
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
 #include "gtest/gtest.h"
 
 #include "interface/constant_tensor_cache.hpp"
@@ -26,6 +34,7 @@
 
 namespace graph = dnnl::impl::graph;
 namespace dnnl_impl = graph::dnnl_impl;
+namespace utils = dnnl::graph::tests::unit::utils;
 
 TEST(test_constant_cache_constant_cache, SetGetCapacity) {
     graph::constant_tensor_cache_t cache(0);
@@ -110,3 +119,164 @@ TEST(test_constant_cache_constant_cache, NoEvictWhenCacheFull) {
     // ignore since we use no_evict policy
     ASSERT_FALSE(cache.get_or_add(0, 3, 3, c_promise3_2.get_future()).valid());
 }
+
+#if !defined(_WIN32)
+TEST(test_constant_cache_constant_cache, SaveLoad) {
+    using cached_t = graph::constant_tensor_cache_t::cached_t;
+    graph::engine_t &engine = *get_engine();
+    if (engine.kind() != graph::engine_kind::cpu) {
+        GTEST_SKIP() << "Saving constant tensors is for cpu engine only";
+    }
+    auto p_engine_ = dnnl_impl::make_dnnl_engine(engine);
+    auto g_alloc_ = static_cast<graph::allocator_t *>(engine.get_allocator());
+    const std::string path = "./onednn_graph_constant_cache_test.bin";
+
+    // sizes are in bytes here
+    const std::vector<size_t> sizes = {100, 5000};
+    graph::constant_tensor_cache_t cache(1024 * 1024);
+    for (size_t i = 0; i < sizes.size(); i++) {
+        std::promise<cached_t> c_promise;
+        ASSERT_FALSE(cache.get_or_add(0, i, sizes[i], c_promise.get_future())
+                             .valid());
+        cached_t c_buffer = std::make_shared<dnnl_impl::dnnl_constant_buffer_t>(
+                sizes[i], p_engine_, g_alloc_);
+        for (size_t j = 0; j < sizes[i]; j++)
+            c_buffer->data<char>()[j] = static_cast<char>((i + j) % 127);
+        c_buffer->set_fingerprint(i + 10);
+        c_promise.set_value(c_buffer);
+    }
+    // entries being computed are not saved
+    std::promise<cached_t> pending;
+    ASSERT_FALSE(cache.get_or_add(0, 2, 64, pending.get_future()).valid());
+    ASSERT_EQ(cache.save(path), graph::status::success);
+
+    graph::constant_tensor_cache_t loaded(1024 * 1024);
+    size_t num_skipped = 1;
+    ASSERT_EQ(loaded.load(path, &engine, num_skipped), graph::status::success);
+    ASSERT_EQ(num_skipped, 0U);
+    // the loaded entries are not in the cache until their inputs are checked
+    ASSERT_EQ(loaded.get_size(), 0U);
+    for (size_t i = 0; i < sizes.size(); i++) {
+        cached_t c_buffer = loaded.take_loaded(0, i, sizes[i], i + 10);
+        ASSERT_NE(c_buffer, nullptr);
+        ASSERT_EQ(c_buffer->size(), sizes[i]);
+        ASSERT_EQ(c_buffer->fingerprint(), i + 10);
+        for (size_t j = 0; j < sizes[i]; j++)
+            ASSERT_EQ(c_buffer->data<char>()[j],
+                    static_cast<char>((i + j) % 127));
+        // an entry is taken only once
+        ASSERT_EQ(loaded.take_loaded(0, i, sizes[i], i + 10), nullptr);
+    }
+
+    // an entry of a different size or computed from other inputs is not used
+    ASSERT_EQ(loaded.load(path, &engine, num_skipped), graph::status::success);
+    ASSERT_EQ(loaded.take_loaded(0, 0, 200, 10), nullptr);
+    ASSERT_EQ(loaded.take_loaded(0, 1, sizes[1], 12), nullptr);
+    ASSERT_EQ(loaded.take_loaded(0, 1, sizes[1], 11), nullptr);
+
+    // the entries exceeding the capacity are reported as skipped
+    graph::constant_tensor_cache_t small(1024);
+    ASSERT_EQ(small.load(path, &engine, num_skipped), graph::status::success);
+    ASSERT_EQ(num_skipped, 1U);
+    ASSERT_NE(small.take_loaded(0, 0, sizes[0], 10), nullptr);
+    ASSERT_EQ(small.take_loaded(0, 1, sizes[1], 11), nullptr);
+
+    std::remove(path.c_str());
+}
+#endif
+
+#if !defined(_WIN32)
+TEST(test_constant_cache_constant_cache, SharedConstantBuffer) {
+    graph::engine_t &engine = *get_engine();
+    if (engine.kind() != graph::engine_kind::cpu) {
+        GTEST_SKIP() << "Shared constant buffer is for cpu engine only";
+    }
+    auto p_engine_ = dnnl_impl::make_dnnl_engine(engine);
+    auto g_alloc_ = static_cast<graph::allocator_t *>(engine.get_allocator());
+
+    const size_t size = 4096;
+    const std::string path = "./onednn_graph_shared_constant_buffer_test.bin";
+    std::remove(path.c_str());
+
+    // the first buffer creates the file and computes the constant tensors
+    bool ready = true;
+    auto buffer1 = std::make_shared<dnnl_impl::dnnl_shared_constant_buffer_t>(
+            size, p_engine_, g_alloc_);
+    ASSERT_TRUE(buffer1->map(path, ready));
+    ASSERT_FALSE(ready);
+    for (size_t i = 0; i < size; i++)
+        buffer1->data<char>()[i] = static_cast<char>(i % 127);
+
+    // not published yet, so the second buffer can't see the file
+    auto buffer2 = std::make_shared<dnnl_impl::dnnl_shared_constant_buffer_t>(
+            size, p_engine_, g_alloc_);
+    ASSERT_TRUE(buffer2->map(path, ready));
+    ASSERT_FALSE(ready);
+    buffer2.reset();
+
+    buffer1->publish();
+
+    // the published file is mapped read-only by the following buffers
+    auto buffer3 = std::make_shared<dnnl_impl::dnnl_shared_constant_buffer_t>(
+            size, p_engine_, g_alloc_);
+    ASSERT_TRUE(buffer3->map(path, ready));
+    ASSERT_TRUE(ready);
+    for (size_t i = 0; i < size; i++)
+        ASSERT_EQ(buffer3->data<char>()[i], static_cast<char>(i % 127));
+
+    // a file of different size is not reused
+    auto buffer4 = std::make_shared<dnnl_impl::dnnl_shared_constant_buffer_t>(
+            size * 2, p_engine_, g_alloc_);
+    ASSERT_FALSE(buffer4->map(path, ready));
+
+    // a symbolic link to the file is not followed
+    const std::string link_path = path + ".link";
+    std::remove(link_path.c_str());
+    ASSERT_EQ(symlink(path.c_str(), link_path.c_str()), 0);
+    auto buffer5 = std::make_shared<dnnl_impl::dnnl_shared_constant_buffer_t>(
+            size, p_engine_, g_alloc_);
+    ASSERT_FALSE(buffer5->map(link_path, ready));
+    std::remove(link_path.c_str());
+
+    buffer1.reset();
+    buffer3.reset();
+    std::remove(path.c_str());
+
+    // a file without the header is not used
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    const std::vector<char> zeros(4096 + size, 0);
+    ASSERT_EQ(std::fwrite(zeros.data(), 1, zeros.size(), file), zeros.size());
+    std::fclose(file);
+    auto buffer6 = std::make_shared<dnnl_impl::dnnl_shared_constant_buffer_t>(
+            size, p_engine_, g_alloc_);
+    ASSERT_FALSE(buffer6->map(path, ready));
+    std::remove(path.c_str());
+}
+#endif
+
+TEST(test_constant_cache_constant_cache, ConstantInputsHash) {
+    graph::engine_t &engine = *get_engine();
+    if (engine.kind() != graph::engine_kind::cpu) {
+        GTEST_SKIP() << "Hashing constant tensors is for cpu engine only";
+    }
+
+    graph::logical_tensor_t wei_lt = utils::logical_tensor_init(
+            0, {4, 3}, graph::data_type::f32);
+    wei_lt.property = graph::property_type::constant;
+    graph::logical_tensor_t src_lt = utils::logical_tensor_init(
+            1, {4, 3}, graph::data_type::f32);
+
+    std::vector<float> wei(12, 1.f), src(12, 2.f);
+    graph::tensor_t wei_ts(wei_lt, &engine, wei.data());
+    graph::tensor_t src_ts(src_lt, &engine, src.data());
+    const size_t hash = dnnl_impl::dnnl_constant_inputs_hash({wei_ts, src_ts});
+
+    // the variable inputs don't affect the hash
+    src[5] = 3.f;
+    ASSERT_EQ(dnnl_impl::dnnl_constant_inputs_hash({wei_ts, src_ts}), hash);
+
+    // a different content of the constant inputs leads to a different hash
+    wei[5] = 3.f;
+    ASSERT_NE(dnnl_impl::dnnl_constant_inputs_hash({wei_ts, src_ts}), hash);
+}
@@ -0,0 +1,174 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "oneapi/dnnl/dnnl_graph.hpp"
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+using dim_t = dnnl_dim_t;
+using dims_t = dnnl_dims_t;
+using dims = std::vector<dim_t>;
+
+static inline void custom_setenv(
+        const char *name, const char *value, int overwrite) {
+#ifdef _WIN32
+    SetEnvironmentVariable(name, value);
+#else
+    ::setenv(name, value, overwrite);
+#endif
+}
+
+namespace {
+
+struct conv_layer_t {
+    dim_t OC, K;
+    bool with_bias, with_relu;
+};
+
+// Builds a chain of stride 1 NXC convolutions on a [N, H, W, C] source. Each
+// convolution is padded to keep the spatial size.
+void construct_conv_chain(graph::graph_t *g, dim_t N, dim_t H, dim_t W,
+        dim_t C, const std::vector<conv_layer_t> &layers,
+        std::vector<graph::op_t> &ops) {
+    const auto dt = graph::data_type::f32;
+    size_t lt_id = 0, op_id = 0;
+    ops.reserve(2 * layers.size());
+    auto src = utils::logical_tensor_init(lt_id++, {N, H, W, C}, dt);
+    for (const auto &l : layers) {
+        auto wei = utils::logical_tensor_init(lt_id++, {l.K, l.K, C, l.OC}, dt);
+        auto dst = utils::logical_tensor_init(lt_id++, {N, H, W, l.OC}, dt);
+
+        ops.emplace_back(op_id++, graph::op_kind::Convolution, "conv");
+        auto &conv = ops.back();
+        conv.set_attr<dims>(graph::op_attr::strides, dims {1, 1});
+        conv.set_attr<dims>(graph::op_attr::dilations, dims {1, 1});
+        conv.set_attr<dims>(
+                graph::op_attr::pads_begin, dims {l.K / 2, l.K / 2});
+        conv.set_attr<dims>(graph::op_attr::pads_end, dims {l.K / 2, l.K / 2});
+        conv.set_attr<int64_t>(graph::op_attr::groups, 1);
+        conv.set_attr<std::string>(graph::op_attr::data_format, "NXC");
+        conv.set_attr<std::string>(graph::op_attr::weights_format, "XIO");
+        conv.add_input(src);
+        conv.add_input(wei);
+        if (l.with_bias)
+            conv.add_input(utils::logical_tensor_init(lt_id++, {l.OC}, dt));
+        conv.add_output(dst);
+
+        if (l.with_relu) {
+            auto relu_dst
+                    = utils::logical_tensor_init(lt_id++, {N, H, W, l.OC}, dt);
+            ops.emplace_back(op_id++, graph::op_kind::ReLU, "relu");
+            ops.back().add_input(dst);
+            ops.back().add_output(relu_dst);
+            dst = relu_dst;
+        }
+        src = dst;
+        C = l.OC;
+    }
+    for (auto &op : ops)
+        g->add_op(&op);
+}
+
+} // namespace
+
+TEST(test_conv_chain_decomp_execute, F32ConvChainDecomp_CPU) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "Skip for GPU - not supported yet.");
+
+    const std::vector<std::vector<conv_layer_t>> cases
+            = {{{32, 3, true, true}, {16, 1, false, true},
+                       {24, 3, true, false}},
+                    {{16, 3, false, false}, {16, 3, true, true}}};
+    for (const auto &c : cases) {
+        graph::graph_t g(eng->kind());
+        std::vector<graph::op_t> ops;
+        construct_conv_chain(&g, 2, 96, 80, 16, c, ops);
+        g.finalize();
+
+        graph::pass::pass_base_ptr apass = get_pass("float_conv_chain_fusion");
+        apass->run(g);
+        ASSERT_EQ(g.get_num_partitions(), 1U);
+        auto part = g.get_partitions()[0];
+        ASSERT_EQ(part->get_kind(), graph::partition_kind_t::conv_chain);
+
+        graph::partition_t p;
+        p.init(part);
+
+        auto partition_inputs = p.get_inputs();
+        auto partition_outputs = p.get_outputs();
+        std::vector<const graph::logical_tensor_t *> inputs, outputs;
+        for (auto &lt : partition_inputs) {
+            inputs.emplace_back(&lt);
+        }
+        for (auto &lt : partition_outputs) {
+            // set output to be strided
+            lt = utils::logical_tensor_init(
+                    lt.id, lt.data_type, graph::layout_type::strided);
+            outputs.emplace_back(&lt);
+        }
+
+        std::vector<test_tensor> inputs_ts;
+        for (auto &lt : inputs) {
+            inputs_ts.emplace_back(*lt, eng);
+            inputs_ts.back().fill<float>(0.f, 0.5f);
+        }
+
+        // run with the larger partition kernel and the decomposition kernel
+        std::vector<std::vector<test_tensor>> outputs_ts(2);
+        for (size_t i = 0; i < outputs_ts.size(); ++i) {
+            custom_setenv("_ONEDNN_ENABLE_CONV_CHAIN_DECOMP",
+                    i == 0 ? "0" : "1", 1);
+            graph::compiled_partition_t cp(p);
+            ASSERT_EQ(p.compile(&cp, inputs, outputs, eng),
+                    graph::status::success);
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+            ASSERT_EQ(cp.get_pimpl()->str(),
+                    i == 0 ? "larger_partition_kernel_t"
+                           : "conv_chain_decomp_kernel_t");
+#endif
+            for (auto &lt : outputs) {
+                graph::logical_tensor_t compiled_output;
+                cp.query_logical_tensor(lt->id, &compiled_output);
+                outputs_ts[i].emplace_back(compiled_output, eng);
+            }
+            ASSERT_EQ(cp.execute(strm, test_tensor::to_graph_tensor(inputs_ts),
+                              test_tensor::to_graph_tensor(outputs_ts[i])),
+                    graph::status::success);
+            strm->wait();
+        }
+
+        ASSERT_TRUE(allclose<float>(outputs_ts[0][0], outputs_ts[1][0],
+                /*rtol*/ 0.01f,
+                /*atol*/ 1e-4f));
+    }
+}
@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <functional>
 #include <random>
 
@@ -26,6 +27,9 @@
 #include "graph/unit/utils.hpp"
 
 #include "backend/dnnl/dnnl_constant_tensor_cache.hpp"
+#include "backend/dnnl/passes/lower.hpp"
+#include "backend/dnnl/passes/transform.hpp"
+#include "backend/dnnl/subgraph.hpp"
 
 namespace graph = dnnl::impl::graph;
 namespace utils = dnnl::graph::tests::unit::utils;
@@ -8021,3 +8025,120 @@ TEST(test_matmul_execute_subgraph_int8, ShareCachedWeight) {
         strm->wait();
     }
 }
+
+static inline void custom_setenv(
+        const char *name, const char *value, int overwrite) {
+#ifdef _WIN32
+    SetEnvironmentVariable(name, value);
+#else
+    ::setenv(name, value, overwrite);
+#endif
+}
+
+TEST(test_matmul_execute, MatmulBiasDynamicQuantization_CPU) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() != graph::engine_kind::cpu,
+            "dynamic quantization is only supported on cpu.");
+
+    const int64_t M = 4, K = 8, N = 16;
+    std::vector<float> src_data(M * K), weight_data(K * N), bias_data(N);
+    for (size_t i = 0; i < src_data.size(); ++i)
+        src_data[i] = static_cast<float>(i % 7) / 3.f - 1.f;
+    for (size_t i = 0; i < weight_data.size(); ++i)
+        weight_data[i] = static_cast<float>(i % 11) / 5.f - 1.f;
+    for (size_t i = 0; i < bias_data.size(); ++i)
+        bias_data[i] = static_cast<float>(i) / N;
+
+    graph::op_t matmul_op(graph::op_kind::MatMul);
+    graph::logical_tensor_t src
+            = utils::logical_tensor_init(0, {M, K}, graph::data_type::f32);
+    graph::logical_tensor_t weight
+            = utils::logical_tensor_init(1, {K, N}, graph::data_type::f32);
+    weight.property = graph::property_type::constant;
+    graph::logical_tensor_t bias
+            = utils::logical_tensor_init(2, {N}, graph::data_type::f32);
+    graph::logical_tensor_t dst
+            = utils::logical_tensor_init(3, {M, N}, graph::data_type::f32);
+
+    matmul_op.add_input(src);
+    matmul_op.add_input(weight);
+    matmul_op.add_input(bias);
+    matmul_op.add_output(dst);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&matmul_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("matmul_pass");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    std::vector<const graph::logical_tensor_t *> inputs {&src, &weight, &bias};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst};
+
+    test_tensor src_ts(src, eng, src_data);
+    test_tensor weight_ts(weight, eng, weight_data);
+    test_tensor bias_ts(bias, eng, bias_data);
+
+    auto run = [&](const char *dyn_quant) {
+        custom_setenv("_ONEDNN_GRAPH_DYNAMIC_QUANTIZATION", dyn_quant, 1);
+        graph::compiled_partition_t cp(p);
+        EXPECT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+        test_tensor dst_ts(dst, eng);
+        cp.execute(strm, {src_ts.get(), weight_ts.get(), bias_ts.get()},
+                {dst_ts.get()});
+        strm->wait();
+        return dst_ts.as_vec_type<float>();
+    };
+
+    auto ref_data = run("0");
+    auto dst_data = run("1");
+    custom_setenv("_ONEDNN_GRAPH_DYNAMIC_QUANTIZATION", "0", 1);
+
+    ASSERT_EQ(dst_data.size(), ref_data.size());
+    for (size_t i = 0; i < ref_data.size(); ++i) {
+        ASSERT_NEAR(dst_data[i], ref_data[i], 0.1f);
+    }
+
+    // the lowered matmul takes s8 inputs quantized by reorders with runtime
+    // scales, and dequantizes its result with the same scales.
+    namespace dnnl_impl = graph::dnnl_impl;
+    dnnl::engine p_engine = dnnl_impl::make_dnnl_engine(*eng);
+    auto subgraph = std::make_shared<dnnl_impl::subgraph_t>(
+            part->get_ops(), p_engine, graph::fpmath_mode::any, false, true);
+    ASSERT_EQ(dnnl_impl::lower_down(subgraph), graph::status::success);
+    ASSERT_EQ(dnnl_impl::dynamically_quantize_matmul(subgraph),
+            graph::status::success);
+
+    auto qmatmul = std::find_if(subgraph->get_ops().begin(),
+            subgraph->get_ops().end(),
+            [](const std::shared_ptr<graph::op_t> &op) {
+                return op->get_kind() == dnnl_impl::op_kind::dnnl_matmul;
+            });
+    ASSERT_NE(qmatmul, subgraph->get_ops().end());
+    for (size_t offset = 0; offset < 2; ++offset) {
+        auto in_val = (*qmatmul)->get_input_value(offset);
+        ASSERT_EQ(in_val->get_logical_tensor().data_type,
+                graph::data_type::s8);
+        ASSERT_TRUE(in_val->has_producer());
+        auto &quant = in_val->get_producer();
+        ASSERT_EQ(quant.get_kind(), dnnl_impl::op_kind::dnnl_reorder);
+        ASSERT_TRUE(quant.get_attr<bool>(
+                dnnl_impl::op_attr::with_runtime_scales));
+        ASSERT_EQ(quant.get_attr<std::string>(graph::op_attr::qtype),
+                offset == 0 ? "per_tensor" : "per_channel");
+    }
+    // src, weight, bias, then the src and weight scales
+    ASSERT_EQ((*qmatmul)->num_inputs(), 5U);
+    ASSERT_TRUE((*qmatmul)->has_attr(dnnl_impl::op_attr::fusion_info_key));
+    const auto &fusion_info = subgraph->fusion_info_mgr_.get_info(
+            (*qmatmul)->get_attr<int64_t>(
+                    dnnl_impl::op_attr::fusion_info_key));
+    ASSERT_TRUE(fusion_info.with_runtime_scales(true, 0));
+    ASSERT_TRUE(fusion_info.with_runtime_scales(true, 1));
+}
@@ -15,9 +15,16 @@
 *******************************************************************************/
 #include <memory>
 
+#include <string>
+#include <vector>
+
 #include "interface/c_types_map.hpp"
+#include "interface/graph.hpp"
 
+#include "backend/dnnl/common.hpp"
 #include "backend/dnnl/passes/memory_planning.hpp"
+#include "backend/dnnl/passes/utils.hpp"
+#include "backend/dnnl/subgraph.hpp"
 
 #include "gtest/gtest.h"
 
@@ -37,3 +44,80 @@ TEST(test_memory_planning_memory_planning, GetMemoryInfo) {
     graph::value_t val {op, 0, lt};
     ASSERT_NO_THROW(mp.get_memory_info(&val));
 }
+
+TEST(test_memory_planning_memory_planning, BestFitDecreasingOffsets) {
+    /*
+    in (f32) -> reorder -> t1 (s8) -> reorder -> t2 (f32) -> reorder
+    -> t3 (bf16) -> reorder -> out (f32)
+    */
+    graph::engine_t *g_eng = get_engine();
+    dnnl::engine p_eng = dnnl_impl::make_dnnl_engine(*g_eng);
+
+    // 1024 elements: 4096 bytes in f32, 2048 in bf16 and 1024 in s8, all
+    // multiples of the 64 bytes alignment of the arena.
+    const std::vector<int64_t> shape {16, 64};
+    graph::op_t op1(1, dnnl_impl::op_kind::dnnl_reorder, "op1");
+    graph::op_t op2(2, dnnl_impl::op_kind::dnnl_reorder, "op2");
+    graph::op_t op3(3, dnnl_impl::op_kind::dnnl_reorder, "op3");
+    graph::op_t op4(4, dnnl_impl::op_kind::dnnl_reorder, "op4");
+
+    auto in = utils::logical_tensor_init(0, shape, graph::data_type::f32);
+    auto t1 = utils::logical_tensor_init(1, shape, graph::data_type::s8);
+    auto t2 = utils::logical_tensor_init(2, shape, graph::data_type::f32);
+    auto t3 = utils::logical_tensor_init(3, shape, graph::data_type::bf16);
+    auto out = utils::logical_tensor_init(4, shape, graph::data_type::f32);
+
+    op1.add_input(in);
+    op1.add_output(t1);
+    op2.add_input(t1);
+    op2.add_output(t2);
+    op3.add_input(t2);
+    op3.add_output(t3);
+    op4.add_input(t3);
+    op4.add_output(out);
+
+    graph::graph_t g;
+    g.add_op(&op1);
+    g.add_op(&op2);
+    g.add_op(&op3);
+    g.add_op(&op4);
+    g.finalize();
+
+    auto subgraph = std::make_shared<dnnl_impl::subgraph_t>(g.get_ops(), p_eng,
+            graph::fpmath_mode::strict, false, /* reset_layout */ false);
+    std::vector<graph::logical_tensor_t> inputs = {in};
+    std::vector<graph::logical_tensor_t> outputs = {out};
+    dnnl_impl::set_given_inputs_outputs(subgraph, inputs, outputs);
+
+    dnnl_impl::memory_planner_t memory_planner;
+    ASSERT_EQ(memory_planner.run(subgraph), graph::status::success);
+
+    // The data types differ, so no reorder runs inplace and each temporary
+    // gets its own buffer. t2 is the largest one and is placed first at the
+    // start of the arena. t3 overlaps with t2 and goes right after it. t1 is
+    // not live together with t3, so it shares the memory of t3. The arena is
+    // then as large as the peak of the live sizes, t2 + t3.
+    const auto key_of = [&](size_t id) {
+        for (const auto &op : subgraph->get_ops()) {
+            if (op->get_id() != id) continue;
+            const std::string info = memory_planner.get_memory_info(
+                    op->get_output_value(0).get());
+            const std::string prefix = "temporary_";
+            EXPECT_EQ(info.compare(0, prefix.size(), prefix), 0);
+            return std::stoul(info.substr(prefix.size()));
+        }
+        ADD_FAILURE() << "no op " << id;
+        return 0UL;
+    };
+    const auto key1 = key_of(1), key2 = key_of(2), key3 = key_of(3);
+    ASSERT_NE(key1, key2);
+    ASSERT_NE(key1, key3);
+    ASSERT_NE(key2, key3);
+    ASSERT_EQ(memory_planner.total_internal_temporary_size(), 4096U + 2048U);
+
+    std::vector<char> arena(memory_planner.total_internal_temporary_size()
+            + 4096); // room for the alignment of the base pointer
+    auto grantor = memory_planner.internal_temporary_grantor(arena.data());
+    ASSERT_EQ(grantor.get(key3) - grantor.get(key2), 4096);
+    ASSERT_EQ(grantor.get(key1) - grantor.get(key2), 4096);
+}
@@ -0,0 +1,216 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "oneapi/dnnl/dnnl_graph.hpp"
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+using dim_t = dnnl_dim_t;
+using dims_t = dnnl_dims_t;
+using dims = std::vector<dim_t>;
+
+static inline void custom_setenv(
+        const char *name, const char *value, int overwrite) {
+#ifdef _WIN32
+    SetEnvironmentVariable(name, value);
+#else
+    ::setenv(name, value, overwrite);
+#endif
+}
+
+namespace {
+
+// Builds a MLP block of shape [batch, seq_len, K] -> [batch, seq_len, N]. The
+// plain block applies GELU on the up projection. The gated block multiplies
+// the up projection by the swish-activated gate projection.
+void construct_mlp(graph::graph_t *g, bool gated, bool constant_weights,
+        dim_t batch, dim_t seq_len, dim_t K, dim_t H, dim_t N) {
+    const auto dt = graph::data_type::f32;
+    const auto wei_property = constant_weights
+            ? graph::property_type::constant
+            : graph::property_type::undef;
+    size_t lt_id = 0;
+    auto src = utils::logical_tensor_init(lt_id++, {batch, seq_len, K}, dt);
+    auto wei_up = utils::logical_tensor_init(lt_id++, {K, H}, dt);
+    wei_up.property = wei_property;
+    auto up_out
+            = utils::logical_tensor_init(lt_id++, {batch, seq_len, H}, dt);
+    auto act_out
+            = utils::logical_tensor_init(lt_id++, {batch, seq_len, H}, dt);
+    auto wei_down = utils::logical_tensor_init(lt_id++, {H, N}, dt);
+    wei_down.property = wei_property;
+    auto dst = utils::logical_tensor_init(lt_id++, {batch, seq_len, N}, dt);
+
+    graph::op_t matmul_up(0, graph::op_kind::MatMul, "matmul_up");
+    matmul_up.add_input(src);
+    matmul_up.add_input(wei_up);
+    matmul_up.add_output(up_out);
+
+    graph::op_t matmul_down(1, graph::op_kind::MatMul, "matmul_down");
+    matmul_down.add_input(act_out);
+    matmul_down.add_input(wei_down);
+    matmul_down.add_output(dst);
+
+    if (!gated) {
+        graph::op_t gelu(2, graph::op_kind::GELU, "gelu");
+        gelu.add_input(up_out);
+        gelu.add_output(act_out);
+
+        g->add_op(&matmul_up);
+        g->add_op(&gelu);
+        g->add_op(&matmul_down);
+        return;
+    }
+
+    auto wei_gate = utils::logical_tensor_init(lt_id++, {K, H}, dt);
+    wei_gate.property = wei_property;
+    auto gate_out
+            = utils::logical_tensor_init(lt_id++, {batch, seq_len, H}, dt);
+    auto sigmoid_out
+            = utils::logical_tensor_init(lt_id++, {batch, seq_len, H}, dt);
+    auto swish_out
+            = utils::logical_tensor_init(lt_id++, {batch, seq_len, H}, dt);
+
+    graph::op_t matmul_gate(2, graph::op_kind::MatMul, "matmul_gate");
+    matmul_gate.add_input(src);
+    matmul_gate.add_input(wei_gate);
+    matmul_gate.add_output(gate_out);
+
+    graph::op_t sigmoid(3, graph::op_kind::Sigmoid, "sigmoid");
+    sigmoid.add_input(gate_out);
+    sigmoid.add_output(sigmoid_out);
+
+    graph::op_t swish(4, graph::op_kind::Multiply, "swish");
+    swish.add_input(gate_out);
+    swish.add_input(sigmoid_out);
+    swish.add_output(swish_out);
+
+    graph::op_t mul(5, graph::op_kind::Multiply, "mul");
+    mul.add_input(swish_out);
+    mul.add_input(up_out);
+    mul.add_output(act_out);
+
+    g->add_op(&matmul_gate);
+    g->add_op(&sigmoid);
+    g->add_op(&swish);
+    g->add_op(&matmul_up);
+    g->add_op(&mul);
+    g->add_op(&matmul_down);
+}
+
+} // namespace
+
+TEST(test_mlp_decomp_execute, F32MlpDecomp_CPU) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "Skip for GPU - not supported yet.");
+
+    // The decomposition needs at least 8 rows per thread, and the rows are
+    // not a multiple of the block size.
+    const dim_t batch = 2;
+    const dim_t seq_len
+            = std::max<dim_t>(150, 4 * dnnl_get_current_num_threads() + 7);
+
+    // gated, pass name, constant weights
+    const std::vector<std::tuple<bool, std::string, bool>> cases
+            = {{false, "float_mlp_fusion", false},
+                    {true, "float_swish_gated_mlp_fusion", false},
+                    {true, "float_swish_gated_mlp_fusion", true}};
+    for (const auto &c : cases) {
+        graph::graph_t g(eng->kind());
+        construct_mlp(&g, std::get<0>(c), std::get<2>(c), batch, seq_len, 64,
+                256, 96);
+        g.finalize();
+
+        graph::pass::pass_base_ptr apass = get_pass(std::get<1>(c));
+        apass->run(g);
+        ASSERT_EQ(g.get_num_partitions(), 1U);
+        auto part = g.get_partitions()[0];
+        ASSERT_EQ(part->get_kind(), graph::partition_kind_t::mlp);
+
+        graph::partition_t p;
+        p.init(part);
+
+        auto partition_inputs = p.get_inputs();
+        auto partition_outputs = p.get_outputs();
+        std::vector<const graph::logical_tensor_t *> inputs, outputs;
+        for (auto &lt : partition_inputs) {
+            inputs.emplace_back(&lt);
+        }
+        for (auto &lt : partition_outputs) {
+            // set output to be strided
+            lt = utils::logical_tensor_init(
+                    lt.id, lt.data_type, graph::layout_type::strided);
+            outputs.emplace_back(&lt);
+        }
+
+        std::vector<test_tensor> inputs_ts;
+        for (auto &lt : inputs) {
+            inputs_ts.emplace_back(*lt, eng);
+            inputs_ts.back().fill<float>(0.f, 0.5f);
+        }
+
+        // run with the larger partition kernel and the decomposition kernel
+        std::vector<std::vector<test_tensor>> outputs_ts(2);
+        for (size_t i = 0; i < outputs_ts.size(); ++i) {
+            custom_setenv(
+                    "_ONEDNN_ENABLE_MLP_DECOMP", i == 0 ? "0" : "1", 1);
+            graph::compiled_partition_t cp(p);
+            ASSERT_EQ(p.compile(&cp, inputs, outputs, eng),
+                    graph::status::success);
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+            ASSERT_EQ(cp.get_pimpl()->str(),
+                    i == 0 ? "larger_partition_kernel_t"
+                           : "mlp_decomp_kernel_t");
+#endif
+            for (auto &lt : outputs) {
+                graph::logical_tensor_t compiled_output;
+                cp.query_logical_tensor(lt->id, &compiled_output);
+                outputs_ts[i].emplace_back(compiled_output, eng);
+            }
+            // the second execution reuses the cached constant weights
+            for (int iter = 0; iter < 2; ++iter) {
+                ASSERT_EQ(cp.execute(strm,
+                                  test_tensor::to_graph_tensor(inputs_ts),
+                                  test_tensor::to_graph_tensor(outputs_ts[i])),
+                        graph::status::success);
+                strm->wait();
+            }
+        }
+
+        ASSERT_TRUE(allclose<float>(outputs_ts[0][0], outputs_ts[1][0],
+                /*rtol*/ 0.01f,
+                /*atol*/ 1e-5f));
+    }
+}
@@ -105,6 +105,43 @@ TEST(test_scratchpad_scratchpad, Registry) {
     ASSERT_TRUE(piece_end <= total_end); // make sure no overflow
 }
 
+TEST(test_scratchpad_scratchpad, RegistryBookAt) {
+    using dnnl::impl::graph::dnnl_impl::grantor_t;
+    using dnnl::impl::graph::dnnl_impl::registrar_t;
+    using dnnl::impl::graph::dnnl_impl::registry_t;
+
+    size_t alignment = 64;
+    std::vector<registry_t::key_t> keys = {0, 1, 2};
+    std::vector<registry_t::offset_t> offsets = {0, 0, 1024};
+    std::vector<size_t> sizes = {1024, 512, 100};
+
+    registry_t registry;
+    registrar_t registrar = registry.registrar();
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        registrar.book_at(keys[i], offsets[i], sizes[i], alignment);
+    }
+    // booked pieces are skipped
+    registrar.book_at(keys[2], 4096, sizes[2], alignment);
+
+    // the pieces are not appended, so the total size is the end of the last
+    // piece plus the space reserved for alignment
+    ASSERT_EQ(registry.size(), offsets[2] + sizes[2] + alignment);
+
+    char *unaligned_base_ptr = (char *)4631;
+    grantor_t grantor = registry.grantor(unaligned_base_ptr);
+    ASSERT_EQ(grantor.get(keys[0]), grantor.get(keys[1]));
+    for (size_t i = 0; i < keys.size(); i++) {
+        char *address = grantor.get(keys[i]);
+        ASSERT_EQ((size_t)address % alignment, 0U);
+        ASSERT_EQ((size_t)(address - grantor.get(keys[0])), offsets[i]);
+    }
+
+    char *piece_end = grantor.get(keys.back()) + sizes.back();
+    char *total_end = unaligned_base_ptr + registry.size();
+    ASSERT_TRUE(piece_end <= total_end); // make sure no overflow
+}
+
 TEST(test_scratchpad_scratchpad, RegistryMultithreading) {
     using dnnl::impl::graph::allocator_t;
     using dnnl::impl::graph::dnnl_impl::grantor_t;
@@ -661,6 +661,93 @@ TEST(test_sdp_decomp_execute, F32SdpCorr_CPU) {
     }
 }
 
+// Test correctness of multi-query attention, where all the query heads share
+// a single key and value head and are stacked into one matmul per group.
+TEST(test_sdp_decomp_execute, F32MqaSdpCorr_CPU) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "Skip for GPU - not supported yet.");
+
+    int batch_size = 56, seq_len = 128, num_head = 16, head_dim = 1024,
+        num_head_kv = 1;
+    std::vector<bool> transpose_b = {false, true};
+
+    for (size_t i = 0; i < transpose_b.size(); ++i) {
+        graph::graph_t g(eng->kind());
+        utils::construct_dnnl_float_MHA(&g, dnnl::impl::data_type::f32,
+                batch_size, seq_len, num_head, head_dim, transpose_b[i],
+                /* attention_mask */ true, num_head_kv);
+        g.finalize();
+
+        graph::pass::pass_base_ptr apass = get_pass("float_sdp_fusion");
+        apass->run(g);
+        ASSERT_EQ(g.get_num_partitions(), 1U);
+        auto part = g.get_partitions()[0];
+
+        // compile
+        graph::partition_t p;
+        p.init(part);
+
+        auto partition_inputs = p.get_inputs();
+        auto partition_outputs = p.get_outputs();
+
+        std::vector<const graph::logical_tensor_t *> inputs, outputs;
+        for (auto &lt : partition_inputs) {
+            inputs.emplace_back(&lt);
+        }
+        for (auto &lt : partition_outputs) {
+            // set output to be strided
+            lt = utils::logical_tensor_init(
+                    lt.id, lt.data_type, graph::layout_type::strided);
+            outputs.emplace_back(&lt);
+        }
+
+        std::vector<test_tensor> inputs_ts;
+        for (auto &lt : inputs) {
+            inputs_ts.emplace_back(*lt, eng);
+            inputs_ts.back().fill<float>();
+        }
+
+        // -------------------------case 1----------------------------------
+        custom_setenv("_ONEDNN_ENABLE_SDP_DECOMP", "0", 1);
+        graph::compiled_partition_t cp1(p);
+        ASSERT_EQ(p.compile(&cp1, inputs, outputs, eng),
+                graph::status::success);
+        std::vector<test_tensor> outputs1_ts;
+        for (auto &lt : outputs) {
+            graph::logical_tensor_t compiled_output;
+            cp1.query_logical_tensor(lt->id, &compiled_output);
+            outputs1_ts.emplace_back(compiled_output, eng);
+        }
+        ASSERT_EQ(cp1.execute(strm, test_tensor::to_graph_tensor(inputs_ts),
+                          test_tensor::to_graph_tensor(outputs1_ts)),
+                graph::status::success);
+        strm->wait();
+
+        // -------------------------case 2----------------------------------
+        custom_setenv("_ONEDNN_ENABLE_SDP_DECOMP", "1", 1);
+        graph::compiled_partition_t cp2(p);
+        ASSERT_EQ(p.compile(&cp2, inputs, outputs, eng),
+                graph::status::success);
+        std::vector<test_tensor> outputs2_ts;
+        for (auto &lt : outputs) {
+            graph::logical_tensor_t compiled_output;
+            cp2.query_logical_tensor(lt->id, &compiled_output);
+            outputs2_ts.emplace_back(compiled_output, eng);
+        }
+        ASSERT_EQ(cp2.execute(strm, test_tensor::to_graph_tensor(inputs_ts),
+                          test_tensor::to_graph_tensor(outputs2_ts)),
+                graph::status::success);
+        strm->wait();
+
+        ASSERT_TRUE(allclose<float>(outputs1_ts[0], outputs2_ts[0],
+                /*rtol*/ 0.01f,
+                /*atol*/ 1e-6f));
+    }
+}
+
 // Test correctness
 TEST(test_sdp_decomp_execute, F32DistilBertSdpCorr_CPU) {
     graph::engine_t *eng = get_engine();
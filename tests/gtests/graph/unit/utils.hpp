@@ -887,20 +887,27 @@ inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
 inline void construct_dnnl_float_MHA(dnnl::impl::graph::graph_t *agraph,
         impl::data_type_t dtype = impl::data_type::f32, int batch_size = 1,
         int seq_len = 384, int num_head = 16, int head_dim = 1024,
-        bool transpose = false, bool attention_mask = true) {
+        bool transpose = false, bool attention_mask = true,
+        int num_head_kv = 0) {
     using namespace dnnl::impl::graph;
     using namespace dnnl::graph::tests;
 
+    // num_head_kv == 1 shares key and value across all the query heads
+    if (num_head_kv == 0) num_head_kv = num_head;
     int size_per_head = head_dim / num_head;
     dims MIXED_LAYER_INPUT_SHAPE = {batch_size, seq_len, head_dim};
     dims EXTENDED_ATTENTION_MASK_SHAPE = {batch_size, 1, 1, seq_len};
     dims QKV_RESHAPED_SHAPE = {batch_size, seq_len, num_head, size_per_head};
     dims QKV_TRANSPOSED_SHAPE = {batch_size, num_head, seq_len, size_per_head};
+    dims VALUE_TRANSPOSED_SHAPE
+            = {batch_size, num_head_kv, seq_len, size_per_head};
     dims KEY_TRANSPOSED_SHAPE;
     if (!transpose)
-        KEY_TRANSPOSED_SHAPE = {batch_size, num_head, size_per_head, seq_len};
+        KEY_TRANSPOSED_SHAPE
+                = {batch_size, num_head_kv, size_per_head, seq_len};
     else
-        KEY_TRANSPOSED_SHAPE = {batch_size, num_head, seq_len, size_per_head};
+        KEY_TRANSPOSED_SHAPE
+                = {batch_size, num_head_kv, seq_len, size_per_head};
     dims MATMUL_QK_OUTPUT_SHAPE = {batch_size, num_head, seq_len, seq_len};
     dims MATMUL_V_OUTPUT_SHAPE = {batch_size, num_head, seq_len, size_per_head};
 
@@ -935,7 +942,7 @@ inline void construct_dnnl_float_MHA(dnnl::impl::graph::graph_t *agraph,
             lt_id++, MATMUL_QK_OUTPUT_SHAPE, dtype);
 
     auto value_input = unit::utils::logical_tensor_init(
-            lt_id++, QKV_TRANSPOSED_SHAPE, dtype);
+            lt_id++, VALUE_TRANSPOSED_SHAPE, dtype);
 
     auto matmul_v_out = unit::utils::logical_tensor_init(
             lt_id++, MATMUL_V_OUTPUT_SHAPE, dtype);
@@ -0,0 +1,233 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using tag = memory::format_tag;
+
+struct embedding_bag_test_params_t {
+    algorithm aalgorithm;
+    memory::dim rows;
+    memory::dim dim;
+    // Bag sizes; the offsets and the indices are derived from them.
+    std::vector<memory::dim> bag_sizes;
+    bool per_row_scales;
+    bool expect_to_fail;
+    dnnl_status_t expected_status;
+};
+
+template <typename src_data_t, typename dst_data_t = float>
+class embedding_bag_test_t
+    : public ::testing::TestWithParam<embedding_bag_test_params_t> {
+private:
+    embedding_bag_test_params_t p;
+    memory::data_type src_dt, dst_dt;
+
+protected:
+    void SetUp() override {
+        src_dt = data_traits<src_data_t>::data_type;
+        dst_dt = data_traits<dst_data_t>::data_type;
+
+        p = ::testing::TestWithParam<embedding_bag_test_params_t>::GetParam();
+
+        SKIP_IF_CUDA(true, "Embedding bag primitive not supported by CUDA");
+        SKIP_IF_HIP(true, "Embedding bag primitive not supported by HIP");
+        SKIP_IF(unsupported_data_type(src_dt, dst_dt),
+                "Engine does not support this data type.");
+        SKIP_IF(get_test_engine().get_kind() != engine::kind::cpu,
+                "Engine does not support this primitive.");
+
+        catch_expected_failures(
+                [&]() { Test(); }, p.expect_to_fail, p.expected_status);
+    }
+
+    void Test() {
+        using pd_t = embedding_bag_forward::primitive_desc;
+        allows_attr_t allowed_attributes {false}; // doesn't support anything
+        allowed_attributes.scales = true;
+
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        const memory::dim num_bags = p.bag_sizes.size();
+        memory::dim num_indices = 0;
+        for (auto sz : p.bag_sizes)
+            num_indices += sz;
+
+        auto desc_src = memory::desc({p.rows, p.dim}, src_dt, tag::ab);
+        auto desc_idx = memory::desc(
+                {num_indices}, memory::data_type::s32, tag::a);
+        auto desc_off
+                = memory::desc({num_bags}, memory::data_type::s32, tag::a);
+        auto desc_dst = memory::desc({num_bags, p.dim}, dst_dt, tag::any);
+
+        primitive_attr attr;
+        if (p.per_row_scales) attr.set_scales_mask(DNNL_ARG_SRC, 1);
+
+        // default pd ctor
+        auto pd = pd_t();
+        // regular pd ctor
+        pd = pd_t(eng, prop_kind::forward_inference, p.aalgorithm, desc_src,
+                desc_idx, desc_off, desc_dst, attr);
+        // test all pd ctors
+        test_fwd_pd_constructors<pd_t>(pd, allowed_attributes,
+                prop_kind::forward_inference, p.aalgorithm, desc_src, desc_idx,
+                desc_off, desc_dst);
+
+        EXPECT_ANY_THROW(embedding_bag_forward(pd, {}));
+        // default primitive ctor
+        auto prim = embedding_bag_forward();
+        // regular primitive ctor
+        prim = embedding_bag_forward(pd);
+
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_SRC)
+                == pd.src_desc());
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_INDICES)
+                == pd.indices_desc());
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_OFFSETS)
+                == pd.offsets_desc());
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST)
+                == pd.dst_desc());
+        ASSERT_EQ(pd.get_algorithm(), p.aalgorithm);
+        ASSERT_EQ(pd.get_prop_kind(), prop_kind::forward_inference);
+
+        const auto test_engine = pd.get_engine();
+        auto mem_src = memory(pd.src_desc(), test_engine);
+        auto mem_idx = memory(pd.indices_desc(), test_engine);
+        auto mem_off = memory(pd.offsets_desc(), test_engine);
+        auto mem_dst = memory(pd.dst_desc(), test_engine);
+        auto mem_scales = memory(
+                memory::desc({p.rows}, memory::data_type::f32, tag::a),
+                test_engine);
+
+        fill_data<src_data_t>(p.rows * p.dim, mem_src);
+        {
+            auto idx = map_memory<int32_t>(mem_idx);
+            auto off = map_memory<int32_t>(mem_off);
+            auto scales = map_memory<float>(mem_scales);
+            memory::dim pos = 0;
+            for (memory::dim b = 0; b < num_bags; ++b) {
+                off[b] = static_cast<int32_t>(pos);
+                for (memory::dim i = 0; i < p.bag_sizes[b]; ++i, ++pos)
+                    idx[pos] = static_cast<int32_t>((pos * 7 + b) % p.rows);
+            }
+            for (memory::dim r = 0; r < p.rows; ++r)
+                scales[r] = 0.25f * (r % 4 + 1);
+        }
+
+        std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, mem_src},
+                {DNNL_ARG_INDICES, mem_idx}, {DNNL_ARG_OFFSETS, mem_off},
+                {DNNL_ARG_DST, mem_dst}};
+        if (p.per_row_scales)
+            args.insert({DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC, mem_scales});
+        prim.execute(strm, args);
+        strm.wait();
+
+        check_result(mem_src, mem_idx, mem_off, mem_scales, mem_dst);
+    }
+
+    void check_result(const memory &mem_src, const memory &mem_idx,
+            const memory &mem_off, const memory &mem_scales,
+            const memory &mem_dst) {
+        auto src = map_memory<src_data_t>(mem_src);
+        auto idx = map_memory<int32_t>(mem_idx);
+        auto off = map_memory<int32_t>(mem_off);
+        auto scales = map_memory<float>(mem_scales);
+        auto dst = map_memory<dst_data_t>(mem_dst);
+
+        const memory::dim num_bags = p.bag_sizes.size();
+        const float eps = dst_dt == memory::data_type::f32 ? 1e-5f : 1e-2f;
+        for (memory::dim b = 0; b < num_bags; ++b) {
+            for (memory::dim d = 0; d < p.dim; ++d) {
+                float ref = 0.f;
+                const memory::dim beg = off[b];
+                const memory::dim end = beg + p.bag_sizes[b];
+                for (memory::dim i = beg; i < end; ++i) {
+                    const memory::dim row = idx[i];
+                    const float s = p.per_row_scales ? scales[row] : 1.f;
+                    ref += s * static_cast<float>(src[row * p.dim + d]);
+                }
+                if (p.aalgorithm == algorithm::embedding_bag_mean
+                        && end > beg)
+                    ref /= static_cast<float>(end - beg);
+
+                const float got = static_cast<float>(dst[b * p.dim + d]);
+                const float diff = std::fabs(got - ref);
+                const float rel = diff / std::max(std::fabs(ref), 1.f);
+                ASSERT_LE(rel, eps) << "bag " << b << ", element " << d;
+            }
+        }
+    }
+};
+
+static auto expected_failures = []() {
+    return ::testing::Values(
+            // not supported alg_kind
+            embedding_bag_test_params_t {algorithm::eltwise_relu, 4, 4, {2},
+                    false, true, dnnl_invalid_arguments},
+            // negative dim
+            embedding_bag_test_params_t {algorithm::embedding_bag_sum, 4, -1,
+                    {2}, false, true, dnnl_invalid_arguments});
+};
+
+static auto simple_cases = []() {
+    return ::testing::Values(
+            embedding_bag_test_params_t {
+                    algorithm::embedding_bag_sum, 16, 8, {1, 2, 3}, false},
+            embedding_bag_test_params_t {
+                    algorithm::embedding_bag_mean, 16, 8, {4, 0, 3}, false},
+            // dimension with a vector tail
+            embedding_bag_test_params_t {
+                    algorithm::embedding_bag_sum, 32, 37, {5, 1, 10}, false},
+            // dimension split into several register blocks
+            embedding_bag_test_params_t {algorithm::embedding_bag_mean, 64,
+                    300, {3, 12, 0, 7}, false},
+            // bags longer than the prefetch distance
+            embedding_bag_test_params_t {
+                    algorithm::embedding_bag_sum, 128, 64, {40, 17}, false},
+            // per-row dequantization scales
+            embedding_bag_test_params_t {
+                    algorithm::embedding_bag_sum, 32, 19, {6, 9}, true},
+            embedding_bag_test_params_t {
+                    algorithm::embedding_bag_mean, 32, 64, {6, 9}, true});
+};
+
+#define INST_TEST_CASE(test) \
+    TEST_P(test, TestsEmbeddingBag) {} \
+    INSTANTIATE_TEST_SUITE_P(TestEmbeddingBagEF, test, expected_failures()); \
+    INSTANTIATE_TEST_SUITE_P(TestEmbeddingBagSimple, test, simple_cases());
+
+using embedding_bag_test_f32 = embedding_bag_test_t<float>;
+using embedding_bag_test_bf16 = embedding_bag_test_t<bfloat16_t>;
+using embedding_bag_test_f16 = embedding_bag_test_t<float16_t>;
+using embedding_bag_test_s8 = embedding_bag_test_t<int8_t>;
+using embedding_bag_test_u8 = embedding_bag_test_t<uint8_t>;
+using embedding_bag_test_bf16bf16
+        = embedding_bag_test_t<bfloat16_t, bfloat16_t>;
+
+INST_TEST_CASE(embedding_bag_test_f32)
+INST_TEST_CASE(embedding_bag_test_bf16)
+INST_TEST_CASE(embedding_bag_test_f16)
+INST_TEST_CASE(embedding_bag_test_s8)
+INST_TEST_CASE(embedding_bag_test_u8)
+INST_TEST_CASE(embedding_bag_test_bf16bf16)
+
+} // namespace dnnl
@@ -53,6 +53,11 @@ protected:
         const bool is_gpu = get_test_engine_kind() == engine::kind::gpu;
         input_f32.wino_supported = is_gpu;
         input_f16.wino_supported = is_gpu;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+        // x64 CPU supports f32 forward Winograd since AVX2.
+        input_f32.wino_supported
+                = input_f32.wino_supported || mayiuse(cpu_isa::avx2);
+#endif
 #elif DNNL_AARCH64 && DNNL_AARCH64_USE_ACL
 #if DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
         const bool is_cpu = get_test_engine_kind() == engine::kind::cpu;
@@ -108,7 +113,7 @@ TEST_F(wino_conv_test_t, TestLargePadding) {
         memory::desc dst_md {{1, 32, 9, 9}, input.dat_dt, tag::any};
 
         bool large_pad_is_supported
-                = (get_test_engine_kind() == engine::kind::gpu);
+                = (get_test_engine_kind() == engine::kind::gpu) || DNNL_X64;
         if (input.wino_supported && large_pad_is_supported) {
             EXPECT_NO_THROW(convolution_forward::primitive_desc(eng,
                     prop_kind::forward, algorithm::convolution_winograd, src_md,
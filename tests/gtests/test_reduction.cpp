@@ -191,6 +191,184 @@ static auto f32_cases = []() {
     INSTANTIATE_TEST_SUITE_P(TestReductionSimple, test, simple_cases()); \
     INSTANTIATE_TEST_SUITE_P(TestReductionNorm, test, f32_cases());
 
+struct reduction_index_test_params_t {
+    memory::format_tag tag;
+    algorithm aalgorithm;
+    memory::dims src_dims;
+    memory::dims dst_dims;
+};
+
+// Checks the values and the indices produced by argmax, argmin and top-k.
+template <typename data_t>
+class reduction_index_test_t
+    : public ::testing::TestWithParam<reduction_index_test_params_t> {
+private:
+    reduction_index_test_params_t p;
+    memory::data_type dt;
+
+protected:
+    void SetUp() override {
+        dt = data_traits<data_t>::data_type;
+        p = ::testing::TestWithParam<reduction_index_test_params_t>::GetParam();
+
+        SKIP_IF(unsupported_data_type(dt),
+                "Engine does not support this data type.");
+        SKIP_IF(get_test_engine().get_kind() != engine::kind::cpu,
+                "Engine does not support this algorithm.");
+
+        Test();
+    }
+
+    void Test() {
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        auto desc_src = memory::desc(p.src_dims, dt, p.tag);
+        auto desc_dst = memory::desc(p.dst_dims, dt, memory::format_tag::any);
+        auto pd = reduction::primitive_desc(
+                eng, p.aalgorithm, desc_src, desc_dst, 0.f, 0.f);
+        auto prim = reduction(pd);
+
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST_1)
+                == pd.indices_desc());
+        ASSERT_EQ(pd.indices_desc().get_data_type(), memory::data_type::s32);
+        ASSERT_EQ(pd.indices_desc().get_dims(), p.dst_dims);
+
+        auto mem_src = memory(pd.src_desc(), eng);
+        auto mem_dst = memory(pd.dst_desc(), eng);
+        auto mem_idx = memory(pd.indices_desc(), eng);
+
+        // A narrow value range produces ties, which are resolved in favor of
+        // the smaller index.
+        const memory::dim nelems = pd.src_desc().get_size() / sizeof(data_t);
+        {
+            auto src = map_memory<data_t>(mem_src);
+            for (memory::dim i = 0; i < nelems; ++i)
+                src[i] = data_t(float((i * 37 + 11) % 61) - 30.f);
+        }
+
+        prim.execute(strm,
+                {{DNNL_ARG_SRC, mem_src}, {DNNL_ARG_DST, mem_dst},
+                        {DNNL_ARG_DST_1, mem_idx}});
+        strm.wait();
+
+        check_result(mem_src, mem_dst, mem_idx);
+    }
+
+    void check_result(const memory &mem_src, const memory &mem_dst,
+            const memory &mem_idx) {
+        const memory::desc src_d = mem_src.get_desc();
+        const memory::desc dst_d = mem_dst.get_desc();
+        auto src = map_memory<data_t>(mem_src);
+        auto dst = map_memory<data_t>(mem_dst);
+        auto idx = map_memory<int32_t>(mem_idx);
+
+        const int ndims = static_cast<int>(p.src_dims.size());
+        int axis = 0;
+        while (p.src_dims[axis] == p.dst_dims[axis])
+            axis++;
+        const memory::dim n = p.src_dims[axis];
+        const memory::dim k = p.dst_dims[axis];
+        const bool is_min = p.aalgorithm == algorithm::reduction_argmin;
+
+        memory::dims row_dims = p.dst_dims;
+        row_dims[axis] = 1;
+        memory::dim nrows = 1;
+        for (auto d : row_dims)
+            nrows *= d;
+
+        const dnnl::impl::memory_desc_wrapper src_mdw(src_d.get());
+        const dnnl::impl::memory_desc_wrapper dst_mdw(dst_d.get());
+
+        for (memory::dim row = 0; row < nrows; ++row) {
+            memory::dims pos(ndims);
+            memory::dim rem = row;
+            for (int d = ndims - 1; d >= 0; --d) {
+                pos[d] = rem % row_dims[d];
+                rem /= row_dims[d];
+            }
+
+            std::vector<std::pair<float, memory::dim>> ref(n);
+            for (memory::dim i = 0; i < n; ++i) {
+                pos[axis] = i;
+                ref[i] = {float(src[src_mdw.off_v(pos.data())]), i};
+            }
+            std::stable_sort(ref.begin(), ref.end(),
+                    [&](const std::pair<float, memory::dim> &a,
+                            const std::pair<float, memory::dim> &b) {
+                        return is_min ? a.first < b.first : a.first > b.first;
+                    });
+
+            for (memory::dim j = 0; j < k; ++j) {
+                pos[axis] = j;
+                const memory::dim off = dst_mdw.off_v(pos.data());
+                ASSERT_EQ(float(dst[off]), ref[j].first)
+                        << "row " << row << ", element " << j;
+                ASSERT_EQ(idx[off], ref[j].second)
+                        << "row " << row << ", element " << j;
+            }
+        }
+    }
+};
+
+static auto index_cases = []() {
+    using alg = algorithm;
+    return ::testing::Values(
+            reduction_index_test_params_t {
+                    tag::ab, alg::reduction_argmax, {3, 37}, {3, 1}},
+            reduction_index_test_params_t {
+                    tag::ab, alg::reduction_argmin, {3, 200}, {3, 1}},
+            reduction_index_test_params_t {
+                    tag::ab, alg::reduction_topk, {4, 1000}, {4, 7}},
+            reduction_index_test_params_t {
+                    tag::ab, alg::reduction_topk, {1, 100000}, {1, 16}},
+            // reduction over an outer dimension
+            reduction_index_test_params_t {
+                    tag::abc, alg::reduction_argmax, {2, 20, 5}, {2, 1, 5}},
+            reduction_index_test_params_t {
+                    tag::abc, alg::reduction_topk, {2, 20, 5}, {2, 3, 5}},
+            reduction_index_test_params_t {tag::nChw16c,
+                    alg::reduction_topk, {2, 32, 3, 3}, {2, 4, 3, 3}});
+};
+
+static auto index_expected_failures = []() {
+    return ::testing::Values(
+            // more than one reduced dimension
+            reduction_index_test_params_t {tag::abc,
+                    algorithm::reduction_argmax, {2, 3, 4}, {2, 1, 1}},
+            // k exceeds the size of the reduced dimension
+            reduction_index_test_params_t {
+                    tag::ab, algorithm::reduction_topk, {2, 4}, {2, 5}},
+            // k only applies to top-k
+            reduction_index_test_params_t {
+                    tag::ab, algorithm::reduction_argmin, {2, 4}, {2, 2}});
+};
+
+using reduction_index_test_f32 = reduction_index_test_t<float>;
+using reduction_index_test_bf16 = reduction_index_test_t<bfloat16_t>;
+
+TEST_P(reduction_index_test_f32, TestsReductionIndex) {}
+INSTANTIATE_TEST_SUITE_P(
+        TestReductionIndex, reduction_index_test_f32, index_cases());
+TEST_P(reduction_index_test_bf16, TestsReductionIndex) {}
+INSTANTIATE_TEST_SUITE_P(
+        TestReductionIndex, reduction_index_test_bf16, index_cases());
+
+class reduction_index_test_failures_t
+    : public ::testing::TestWithParam<reduction_index_test_params_t> {};
+
+TEST_P(reduction_index_test_failures_t, TestsReductionIndexEF) {
+    const auto p = GetParam();
+    auto eng = get_test_engine();
+    auto desc_src = memory::desc(p.src_dims, memory::data_type::f32, p.tag);
+    auto desc_dst = memory::desc(
+            p.dst_dims, memory::data_type::f32, memory::format_tag::any);
+    EXPECT_ANY_THROW(reduction::primitive_desc(
+            eng, p.aalgorithm, desc_src, desc_dst, 0.f, 0.f));
+}
+INSTANTIATE_TEST_SUITE_P(TestReductionIndexEF, reduction_index_test_failures_t,
+        index_expected_failures());
+
 using reduction_test_f32 = reduction_test_t<float>;
 using reduction_test_bf16 = reduction_test_t<bfloat16_t>;
 using reduction_test_f16 = reduction_test_t<float16_t>;
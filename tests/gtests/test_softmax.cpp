@@ -548,4 +548,245 @@ INSTANTIATE_TEST_SUITE_P(Test_Softmax_Forward_S8, softmax_test_t,
                         tag::nhwc, tag::nhwc, tag::undef, {2, 1011, 32, 1},
                         2}));
 
+struct softmax_stats_test_params_t {
+    algorithm aalgorithm;
+    tag data_tag;
+    memory::dims dims;
+    int axis;
+    softmax_flags flags;
+    memory::dim num_candidates;
+};
+
+// Checks the statistics and the candidates produced on forward propagation
+// against the source and the destination values.
+template <typename data_t>
+class softmax_stats_test_t
+    : public ::testing::TestWithParam<softmax_stats_test_params_t> {
+private:
+    softmax_stats_test_params_t p;
+    dt data_dt;
+
+protected:
+    void SetUp() override {
+        data_dt = data_traits<data_t>::data_type;
+        p = ::testing::TestWithParam<softmax_stats_test_params_t>::GetParam();
+
+        SKIP_IF(unsupported_data_type(data_dt),
+                "Engine does not support this data type.");
+        SKIP_IF(get_test_engine().get_kind() != engine::kind::cpu,
+                "Engine does not support this feature.");
+
+        Test();
+    }
+
+    void Test() {
+        using pd_t = softmax_forward::primitive_desc;
+
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        const bool with_stats
+                = static_cast<bool>(p.flags & softmax_flags::output_stats);
+        const bool with_candidates = static_cast<bool>(
+                p.flags & softmax_flags::output_candidates);
+
+        auto data_md = memory::desc(p.dims, data_dt, p.data_tag);
+        auto pd = pd_t(eng, prop_kind::forward_inference, p.aalgorithm,
+                data_md, data_md, p.axis, p.flags, p.num_candidates);
+        auto softmax = softmax_forward(pd);
+
+        ASSERT_EQ(pd.get_flags(), p.flags);
+
+        memory::dims stat_dims = p.dims;
+        stat_dims[p.axis] = 1;
+        memory::dims candidates_dims = p.dims;
+        candidates_dims[p.axis] = p.num_candidates;
+
+        const auto max_desc = pd.max_desc();
+        const auto lse_desc = pd.lse_desc();
+        const auto candidates_desc = pd.candidates_desc();
+        if (with_stats) {
+            ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST_1)
+                    == max_desc);
+            ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST_2)
+                    == lse_desc);
+            ASSERT_EQ(max_desc.get_dims(), stat_dims);
+            ASSERT_EQ(max_desc.get_data_type(), dt::f32);
+            ASSERT_TRUE(max_desc == lse_desc);
+        } else {
+            ASSERT_TRUE(max_desc.is_zero());
+            ASSERT_TRUE(lse_desc.is_zero());
+        }
+        if (with_candidates) {
+            ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST_3)
+                    == candidates_desc);
+            ASSERT_EQ(candidates_desc.get_dims(), candidates_dims);
+            ASSERT_EQ(candidates_desc.get_data_type(), dt::s32);
+        } else {
+            ASSERT_TRUE(candidates_desc.is_zero());
+        }
+
+        auto src = test::make_memory(pd.src_desc(), eng);
+        auto dst = test::make_memory(pd.dst_desc(), eng);
+        auto max = test::make_memory(max_desc, eng);
+        auto lse = test::make_memory(lse_desc, eng);
+        auto candidates = test::make_memory(candidates_desc, eng);
+
+        // A narrow value range produces ties among the candidates.
+        {
+            const memory::dim nelems
+                    = pd.src_desc().get_size() / sizeof(data_t);
+            auto src_ptr = map_memory<data_t>(src);
+            for (memory::dim i = 0; i < nelems; ++i)
+                src_ptr[i] = data_t(float((i * 37 + 11) % 61) / 4.f - 7.f);
+        }
+
+        softmax.execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst},
+                        {DNNL_ARG_DST_1, max}, {DNNL_ARG_DST_2, lse},
+                        {DNNL_ARG_DST_3, candidates}});
+        strm.wait();
+
+        check_result(src, dst, max, lse, candidates);
+    }
+
+    void check_result(const memory &src, const memory &dst, const memory &max,
+            const memory &lse, const memory &candidates) {
+        const memory::desc src_d = src.get_desc();
+        const memory::desc dst_d = dst.get_desc();
+        const memory::desc max_d = max.get_desc();
+        const memory::desc cand_d = candidates.get_desc();
+        const dnnl::impl::memory_desc_wrapper src_mdw(src_d.get());
+        const dnnl::impl::memory_desc_wrapper dst_mdw(dst_d.get());
+        const dnnl::impl::memory_desc_wrapper max_mdw(max_d.get());
+        const dnnl::impl::memory_desc_wrapper cand_mdw(cand_d.get());
+
+        auto src_ptr = map_memory<data_t>(src);
+        auto dst_ptr = map_memory<data_t>(dst);
+        auto max_ptr = map_memory<float>(max);
+        auto lse_ptr = map_memory<float>(lse);
+        auto cand_ptr = map_memory<int32_t>(candidates);
+
+        const int ndims = static_cast<int>(p.dims.size());
+        const memory::dim n = p.dims[p.axis];
+        const memory::dim k = p.num_candidates;
+
+        memory::dims row_dims = p.dims;
+        row_dims[p.axis] = 1;
+        memory::dim nrows = 1;
+        for (auto d : row_dims)
+            nrows *= d;
+
+        for (memory::dim row = 0; row < nrows; ++row) {
+            memory::dims pos(ndims);
+            memory::dim rem = row;
+            for (int d = ndims - 1; d >= 0; --d) {
+                pos[d] = rem % row_dims[d];
+                rem /= row_dims[d];
+            }
+
+            if (max_ptr) {
+                pos[p.axis] = 0;
+                const memory::dim stat_off = max_mdw.off_v(pos.data());
+                float ref_max = -FLT_MAX;
+                for (memory::dim i = 0; i < n; ++i) {
+                    pos[p.axis] = i;
+                    ref_max = std::max(
+                            ref_max, float(src_ptr[src_mdw.off_v(pos.data())]));
+                }
+                double ref_sum = 0;
+                for (memory::dim i = 0; i < n; ++i) {
+                    pos[p.axis] = i;
+                    ref_sum += std::exp(
+                            double(src_ptr[src_mdw.off_v(pos.data())])
+                            - ref_max);
+                }
+                const double ref_lse = ref_max + std::log(ref_sum);
+                ASSERT_EQ(max_ptr[stat_off], ref_max) << "row " << row;
+                ASSERT_NEAR(lse_ptr[stat_off], ref_lse,
+                        1e-5 * std::max(1.0, std::fabs(ref_lse)))
+                        << "row " << row;
+            }
+
+            if (!cand_ptr) continue;
+
+            const auto dst_val = [&](memory::dim i) {
+                pos[p.axis] = i;
+                return float(dst_ptr[dst_mdw.off_v(pos.data())]);
+            };
+            std::vector<bool> selected(n, false);
+            memory::dim prev_idx = -1;
+            float prev_val = 0.f;
+            for (memory::dim j = 0; j < k; ++j) {
+                pos[p.axis] = j;
+                const memory::dim idx = cand_ptr[cand_mdw.off_v(pos.data())];
+                ASSERT_TRUE(0 <= idx && idx < n) << "row " << row;
+                ASSERT_FALSE(selected[idx]) << "row " << row;
+                selected[idx] = true;
+
+                const float val = dst_val(idx);
+                if (j > 0) {
+                    ASSERT_TRUE(val < prev_val
+                            || (val == prev_val && idx > prev_idx))
+                            << "row " << row << ", candidate " << j;
+                }
+                prev_idx = idx;
+                prev_val = val;
+            }
+            // No element left out of the candidates may beat the last one.
+            for (memory::dim i = 0; i < n; ++i) {
+                if (selected[i]) continue;
+                const float val = dst_val(i);
+                ASSERT_TRUE(val < prev_val || (val == prev_val && i > prev_idx))
+                        << "row " << row << ", element " << i;
+            }
+        }
+    }
+};
+
+static auto stats_cases = []() {
+    using sp = softmax_stats_test_params_t;
+    const auto stats = softmax_flags::output_stats;
+    const auto candidates = softmax_flags::output_candidates;
+    return ::testing::Values(
+            // axis is the innermost dimension
+            sp {alg_softmax, tag::ab, {3, 1000}, 1, stats, 0},
+            sp {alg_softmax, tag::ab, {3, 1000}, 1, candidates, 10},
+            sp {alg_softmax, tag::ab, {2, 5000}, 1, stats | candidates, 40},
+            sp {alg_logsoftmax, tag::abc, {2, 3, 77}, 2, stats | candidates,
+                    77},
+            sp {alg_softmax, tag::ab, {1, 19}, 1, stats | candidates, 1},
+            // axis is an outer or a blocked dimension
+            sp {alg_softmax, tag::abcd, {2, 37, 3, 4}, 1, stats | candidates,
+                    5},
+            sp {alg_logsoftmax, tag::aBcd16b, {2, 37, 3, 4}, 1,
+                    stats | candidates, 3},
+            sp {alg_softmax, tag::acdb, {2, 37, 3, 4}, 1, stats, 0});
+};
+
+using softmax_stats_test_f32 = softmax_stats_test_t<float>;
+using softmax_stats_test_bf16 = softmax_stats_test_t<bfloat16_t>;
+
+TEST_P(softmax_stats_test_f32, TestsSoftmaxStats) {}
+INSTANTIATE_TEST_SUITE_P(
+        Test_Softmax_Stats, softmax_stats_test_f32, stats_cases());
+TEST_P(softmax_stats_test_bf16, TestsSoftmaxStats) {}
+INSTANTIATE_TEST_SUITE_P(
+        Test_Softmax_Stats, softmax_stats_test_bf16, stats_cases());
+
+TEST(softmax_stats_test_t, TestsSoftmaxStatsEF) {
+    using pd_t = softmax_forward::primitive_desc;
+    auto eng = get_test_engine();
+    auto md = memory::desc({2, 8}, dt::f32, tag::ab);
+    const auto candidates = softmax_flags::output_candidates;
+    // The number of candidates must be positive and fit the axis.
+    EXPECT_ANY_THROW(pd_t(eng, inference, alg_softmax, md, md, 1, candidates,
+            memory::dim(0)));
+    EXPECT_ANY_THROW(pd_t(eng, inference, alg_softmax, md, md, 1, candidates,
+            memory::dim(9)));
+    // Unknown flags are rejected.
+    EXPECT_ANY_THROW(pd_t(eng, inference, alg_softmax, md, md, 1,
+            static_cast<softmax_flags>(0x80U), memory::dim(0)));
+}
+
 } // namespace dnnl
@@ -0,0 +1,320 @@
+/*******************************************************************************
+* Copyright 2024 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using tag = memory::format_tag;
+
+struct softmax_merge_test_params_t {
+    memory::dims src_dims;
+    memory::dims lse_dims;
+    int axis;
+    // Sum the rescaled chunks up instead of keeping them apart.
+    bool sum;
+    softmax_flags flags;
+    bool expect_to_fail;
+    dnnl_status_t expected_status;
+};
+
+template <typename data_t>
+class softmax_merge_test_t
+    : public ::testing::TestWithParam<softmax_merge_test_params_t> {
+private:
+    softmax_merge_test_params_t p;
+    memory::data_type data_dt;
+
+protected:
+    void SetUp() override {
+        data_dt = data_traits<data_t>::data_type;
+
+        p = ::testing::TestWithParam<softmax_merge_test_params_t>::GetParam();
+
+        SKIP_IF_CUDA(true, "Softmax merge primitive not supported by CUDA");
+        SKIP_IF_HIP(true, "Softmax merge primitive not supported by HIP");
+        SKIP_IF(unsupported_data_type(data_dt),
+                "Engine does not support this data type.");
+        SKIP_IF(get_test_engine().get_kind() != engine::kind::cpu,
+                "Engine does not support this primitive.");
+
+        catch_expected_failures(
+                [&]() { Test(); }, p.expect_to_fail, p.expected_status);
+    }
+
+    void Test() {
+        using pd_t = softmax_merge_forward::primitive_desc;
+        allows_attr_t allowed_attributes {false}; // doesn't support anything
+
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        memory::dims dst_dims = p.src_dims;
+        if (p.sum) dst_dims[p.axis] = 1;
+
+        auto desc_src = memory::desc(p.src_dims, data_dt, plain_tag());
+        auto desc_lse
+                = memory::desc(p.lse_dims, memory::data_type::f32, plain_tag());
+        auto desc_dst = memory::desc(dst_dims, data_dt, tag::any);
+
+        // default pd ctor
+        auto pd = pd_t();
+        // regular pd ctor
+        pd = pd_t(eng, prop_kind::forward_inference, desc_src, desc_lse,
+                desc_dst, p.axis, p.flags);
+        // test all pd ctors
+        test_fwd_pd_constructors<pd_t>(pd, allowed_attributes,
+                prop_kind::forward_inference, desc_src, desc_lse, desc_dst,
+                p.axis, p.flags);
+
+        EXPECT_ANY_THROW(softmax_merge_forward(pd, {}));
+        // default primitive ctor
+        auto prim = softmax_merge_forward();
+        // regular primitive ctor
+        prim = softmax_merge_forward(pd);
+
+        const bool with_stats = static_cast<bool>(
+                p.flags & softmax_flags::output_stats);
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_SRC)
+                == pd.src_desc());
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_SRC_1)
+                == pd.chunk_lse_desc());
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST)
+                == pd.dst_desc());
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST_2)
+                == pd.lse_desc());
+        ASSERT_EQ(pd.get_prop_kind(), prop_kind::forward_inference);
+        ASSERT_EQ(pd.get_axis(), p.axis);
+        ASSERT_EQ(pd.get_flags(), p.flags);
+        ASSERT_EQ(pd.lse_desc().is_zero(), !with_stats);
+
+        const auto test_engine = pd.get_engine();
+        auto mem_src = memory(pd.src_desc(), test_engine);
+        auto mem_lse = memory(pd.chunk_lse_desc(), test_engine);
+        auto mem_dst = memory(pd.dst_desc(), test_engine);
+        memory mem_merged;
+        if (with_stats) mem_merged = memory(pd.lse_desc(), test_engine);
+
+        fill_data<data_t>(pd.src_desc().get_size() / sizeof(data_t), mem_src);
+        {
+            auto lse = map_memory<float>(mem_lse);
+            const auto n = pd.chunk_lse_desc().get_size() / sizeof(float);
+            for (size_t i = 0; i < n; ++i)
+                lse[i] = static_cast<float>((i * 37) % 23) * 0.5f - 5.f;
+            // A chunk that has no keys, e.g. fully masked out.
+            lse[0] = -INFINITY;
+        }
+
+        std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, mem_src},
+                {DNNL_ARG_SRC_1, mem_lse}, {DNNL_ARG_DST, mem_dst}};
+        if (with_stats) args.insert({DNNL_ARG_DST_2, mem_merged});
+        prim.execute(strm, args);
+        strm.wait();
+
+        check_result(mem_src, mem_lse, mem_dst, mem_merged, with_stats);
+    }
+
+    tag plain_tag() const {
+        switch (p.src_dims.size()) {
+            case 2: return tag::ab;
+            case 3: return tag::abc;
+            case 4: return tag::abcd;
+            default: return tag::abcde;
+        }
+    }
+
+    void check_result(const memory &mem_src, const memory &mem_lse,
+            const memory &mem_dst, const memory &mem_merged, bool with_stats) {
+        auto src = map_memory<data_t>(mem_src);
+        auto lse = map_memory<float>(mem_lse);
+        auto dst = map_memory<data_t>(mem_dst);
+        auto merged = with_stats ? map_memory<float>(mem_merged)
+                                 : mapped_ptr_t<float>(nullptr);
+
+        const int nd = static_cast<int>(p.src_dims.size());
+        memory::dim outer = 1, inner = 1, lse_inner = 1;
+        for (int d = 0; d < p.axis; ++d)
+            outer *= p.src_dims[d];
+        for (int d = p.axis + 1; d < nd; ++d) {
+            inner *= p.src_dims[d];
+            lse_inner *= p.lse_dims[d];
+        }
+        const memory::dim nchunks = p.src_dims[p.axis];
+        const memory::dim bcast = inner / lse_inner;
+        const memory::dim dst_nchunks = p.sum ? 1 : nchunks;
+        const float eps = data_dt == memory::data_type::f32 ? 1e-5f : 1e-2f;
+
+        std::vector<double> w(nchunks);
+        for (memory::dim ou = 0; ou < outer; ++ou)
+            for (memory::dim in = 0; in < inner; ++in) {
+                const memory::dim lin = in / bcast;
+                double max = -INFINITY;
+                for (memory::dim c = 0; c < nchunks; ++c)
+                    max = std::max(max,
+                            (double)lse[(ou * nchunks + c) * lse_inner + lin]);
+                double sum = 0;
+                for (memory::dim c = 0; c < nchunks; ++c) {
+                    const double l = lse[(ou * nchunks + c) * lse_inner + lin];
+                    w[c] = std::isinf(max) ? 0. : std::exp(l - max);
+                    sum += w[c];
+                }
+                for (memory::dim c = 0; c < nchunks; ++c)
+                    w[c] = sum > 0 ? w[c] / sum : 0.;
+
+                if (with_stats && in % bcast == 0) {
+                    const float ref_l = sum > 0
+                            ? static_cast<float>(max + std::log(sum))
+                            : -INFINITY;
+                    const float got_l = merged[ou * lse_inner + lin];
+                    if (std::isinf(ref_l))
+                        ASSERT_EQ(got_l, ref_l);
+                    else
+                        ASSERT_NEAR(got_l, ref_l,
+                                1e-5f * std::max(1.f, std::fabs(ref_l)));
+                }
+
+                double acc = 0;
+                for (memory::dim c = 0; c < nchunks; ++c) {
+                    const double s
+                            = (float)src[(ou * nchunks + c) * inner + in];
+                    acc += w[c] * s;
+                    if (p.sum) continue;
+                    const float got
+                            = (float)dst[(ou * dst_nchunks + c) * inner + in];
+                    const float ref = (float)(w[c] * s);
+                    ASSERT_LE(std::fabs(got - ref),
+                            eps * std::max(std::fabs(ref), 1.f))
+                            << "outer " << ou << ", chunk " << c << ", inner "
+                            << in;
+                }
+                if (!p.sum) continue;
+                const float got = (float)dst[ou * inner + in];
+                ASSERT_LE(std::fabs(got - (float)acc),
+                        eps * std::max(std::fabs((float)acc), 1.f))
+                        << "outer " << ou << ", inner " << in;
+            }
+    }
+};
+
+static auto expected_failures = []() {
+    return ::testing::Values(
+            // bad axis
+            softmax_merge_test_params_t {{2, 3, 4}, {2, 3, 4}, 3, false,
+                    softmax_flags::none, true, dnnl_invalid_arguments},
+            // lse and src have different number of chunks
+            softmax_merge_test_params_t {{2, 3, 4}, {2, 2, 4}, 1, false,
+                    softmax_flags::none, true, dnnl_invalid_arguments},
+            // lse is broadcast along a dimension before the axis
+            softmax_merge_test_params_t {{2, 3, 4}, {1, 3, 4}, 1, false,
+                    softmax_flags::none, true, dnnl_invalid_arguments},
+            // lse broadcast dimensions are not trailing
+            softmax_merge_test_params_t {{2, 3, 4, 5}, {2, 3, 1, 5}, 1, true,
+                    softmax_flags::none, true, dnnl_invalid_arguments},
+            // unsupported flags
+            softmax_merge_test_params_t {{2, 3, 4}, {2, 3, 4}, 1, false,
+                    softmax_flags::output_candidates, true,
+                    dnnl_invalid_arguments});
+};
+
+static auto simple_cases = []() {
+    return ::testing::Values(
+            // rescale probabilities of chunks, one lse per chunk row
+            softmax_merge_test_params_t {{6, 4, 100}, {6, 4, 1}, 1, false,
+                    softmax_flags::none},
+            softmax_merge_test_params_t {{6, 4, 100}, {6, 4, 1}, 1, false,
+                    softmax_flags::output_stats},
+            // merge partial attention outputs: N x H x chunks x S x D
+            softmax_merge_test_params_t {{2, 3, 4, 7, 64}, {2, 3, 4, 7, 1}, 2,
+                    true, softmax_flags::output_stats},
+            // lse without broadcast, chunk axis outermost
+            softmax_merge_test_params_t {{5, 3, 300}, {5, 3, 300}, 0, true,
+                    softmax_flags::output_stats},
+            // chunk axis innermost
+            softmax_merge_test_params_t {{9, 8}, {9, 8}, 1, true,
+                    softmax_flags::none},
+            // a single chunk
+            softmax_merge_test_params_t {{4, 1, 33}, {4, 1, 1}, 1, true,
+                    softmax_flags::output_stats});
+};
+
+#define INST_TEST_CASE(test) \
+    TEST_P(test, TestsSoftmaxMerge) {} \
+    INSTANTIATE_TEST_SUITE_P(TestSoftmaxMergeEF, test, expected_failures()); \
+    INSTANTIATE_TEST_SUITE_P(TestSoftmaxMergeSimple, test, simple_cases());
+
+using softmax_merge_test_f32 = softmax_merge_test_t<float>;
+using softmax_merge_test_bf16 = softmax_merge_test_t<bfloat16_t>;
+
+INST_TEST_CASE(softmax_merge_test_f32)
+INST_TEST_CASE(softmax_merge_test_bf16)
+
+// Softmax over a long axis computed chunk by chunk and merged matches softmax
+// over the whole axis.
+TEST(softmax_merge_test_chunked, TestsSoftmaxMerge) {
+    SKIP_IF(get_test_engine().get_kind() != engine::kind::cpu,
+            "Engine does not support this primitive.");
+
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+    const auto f32 = memory::data_type::f32;
+
+    const memory::dim rows = 5, nchunks = 4, chunk = 250;
+    auto full_md = memory::desc({rows, nchunks * chunk}, f32, tag::ab);
+    auto chunked_md = memory::desc({rows, nchunks, chunk}, f32, tag::abc);
+
+    auto full_pd = softmax_forward::primitive_desc(eng,
+            prop_kind::forward_inference, algorithm::softmax_accurate, full_md,
+            full_md, 1);
+    auto chunk_pd = softmax_forward::primitive_desc(eng,
+            prop_kind::forward_inference, algorithm::softmax_accurate,
+            chunked_md, chunked_md, 2, softmax_flags::output_stats);
+    auto merge_pd = softmax_merge_forward::primitive_desc(eng,
+            prop_kind::forward_inference, chunked_md, chunk_pd.lse_desc(),
+            chunked_md, 1, softmax_flags::none);
+
+    auto src = memory(full_md, eng);
+    fill_data<float>(rows * nchunks * chunk, src, 0.f, 8.f);
+    // The same buffer viewed as chunks.
+    auto src_chunked = memory(chunked_md, eng, src.get_data_handle());
+
+    auto dst_full = memory(full_md, eng);
+    auto dst_chunks = memory(chunked_md, eng);
+    auto max = memory(chunk_pd.max_desc(), eng);
+    auto lse = memory(chunk_pd.lse_desc(), eng);
+    auto dst_merged = memory(chunked_md, eng);
+
+    softmax_forward(full_pd).execute(
+            strm, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst_full}});
+    softmax_forward(chunk_pd).execute(strm,
+            {{DNNL_ARG_SRC, src_chunked}, {DNNL_ARG_DST, dst_chunks},
+                    {DNNL_ARG_DST_1, max}, {DNNL_ARG_DST_2, lse}});
+    softmax_merge_forward(merge_pd).execute(strm,
+            {{DNNL_ARG_SRC, dst_chunks}, {DNNL_ARG_SRC_1, lse},
+                    {DNNL_ARG_DST, dst_merged}});
+    strm.wait();
+
+    auto ref = map_memory<float>(dst_full);
+    auto got = map_memory<float>(dst_merged);
+    for (memory::dim i = 0; i < rows * nchunks * chunk; ++i)
+        ASSERT_NEAR(got[i], ref[i], 1e-6f * std::max(1.f, ref[i]));
+}
+
+} // namespace dnnl